@@ -0,0 +1,43 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/scanner_lib/async_file_logger.cpp" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/async_file_logger.cpp.o" "gcc" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/async_file_logger.cpp.o.d"
+  "/root/repo/src/scanner_lib/blocked_bloom_filter.cpp" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/blocked_bloom_filter.cpp.o" "gcc" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/blocked_bloom_filter.cpp.o.d"
+  "/root/repo/src/scanner_lib/cpu_features.cpp" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/cpu_features.cpp.o" "gcc" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/cpu_features.cpp.o.d"
+  "/root/repo/src/scanner_lib/csv_hash_database.cpp" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/csv_hash_database.cpp.o" "gcc" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/csv_hash_database.cpp.o.d"
+  "/root/repo/src/scanner_lib/file_logger.cpp" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/file_logger.cpp.o" "gcc" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/file_logger.cpp.o.d"
+  "/root/repo/src/scanner_lib/file_reader.cpp" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/file_reader.cpp.o" "gcc" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/file_reader.cpp.o.d"
+  "/root/repo/src/scanner_lib/io_uring.cpp" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/io_uring.cpp.o" "gcc" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/io_uring.cpp.o.d"
+  "/root/repo/src/scanner_lib/mapped_file.cpp" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/mapped_file.cpp.o" "gcc" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/mapped_file.cpp.o.d"
+  "/root/repo/src/scanner_lib/mapped_hash_database.cpp" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/mapped_hash_database.cpp.o" "gcc" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/mapped_hash_database.cpp.o.d"
+  "/root/repo/src/scanner_lib/md5_engine.cpp" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/md5_engine.cpp.o" "gcc" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/md5_engine.cpp.o.d"
+  "/root/repo/src/scanner_lib/md5_file_hasher.cpp" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/md5_file_hasher.cpp.o" "gcc" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/md5_file_hasher.cpp.o.d"
+  "/root/repo/src/scanner_lib/md5_multi_buffer.cpp" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/md5_multi_buffer.cpp.o" "gcc" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/md5_multi_buffer.cpp.o.d"
+  "/root/repo/src/scanner_lib/scan_metrics.cpp" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/scan_metrics.cpp.o" "gcc" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/scan_metrics.cpp.o.d"
+  "/root/repo/src/scanner_lib/scan_trace.cpp" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/scan_trace.cpp.o" "gcc" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/scan_trace.cpp.o.d"
+  "/root/repo/src/scanner_lib/sha256_multi_buffer.cpp" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/sha256_multi_buffer.cpp.o" "gcc" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/sha256_multi_buffer.cpp.o.d"
+  "/root/repo/src/scanner_lib/sha_engine.cpp" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/sha_engine.cpp.o" "gcc" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/sha_engine.cpp.o.d"
+  "/root/repo/src/scanner_lib/thread_pool.cpp" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/thread_pool.cpp.o" "gcc" "benchmarks/CMakeFiles/scanner_bench.dir/__/src/scanner_lib/thread_pool.cpp.o.d"
+  "/root/repo/benchmarks/file_hasher_bench.cpp" "benchmarks/CMakeFiles/scanner_bench.dir/file_hasher_bench.cpp.o" "gcc" "benchmarks/CMakeFiles/scanner_bench.dir/file_hasher_bench.cpp.o.d"
+  "/root/repo/benchmarks/hash_bench.cpp" "benchmarks/CMakeFiles/scanner_bench.dir/hash_bench.cpp.o" "gcc" "benchmarks/CMakeFiles/scanner_bench.dir/hash_bench.cpp.o.d"
+  "/root/repo/benchmarks/hash_database_bench.cpp" "benchmarks/CMakeFiles/scanner_bench.dir/hash_database_bench.cpp.o" "gcc" "benchmarks/CMakeFiles/scanner_bench.dir/hash_database_bench.cpp.o.d"
+  "/root/repo/benchmarks/logger_bench.cpp" "benchmarks/CMakeFiles/scanner_bench.dir/logger_bench.cpp.o" "gcc" "benchmarks/CMakeFiles/scanner_bench.dir/logger_bench.cpp.o.d"
+  "/root/repo/benchmarks/scan_bench.cpp" "benchmarks/CMakeFiles/scanner_bench.dir/scan_bench.cpp.o" "gcc" "benchmarks/CMakeFiles/scanner_bench.dir/scan_bench.cpp.o.d"
+  "/root/repo/benchmarks/thread_pool_bench.cpp" "benchmarks/CMakeFiles/scanner_bench.dir/thread_pool_bench.cpp.o" "gcc" "benchmarks/CMakeFiles/scanner_bench.dir/thread_pool_bench.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_bench_build/src/scanner_lib/CMakeFiles/scanner_lib.dir/DependInfo.cmake"
+  "/root/repo/_bench_build/src/scanner_lib/CMakeFiles/scanner_simd.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,55 @@
+file(REMOVE_RECURSE
+  "../bin/scanner_bench"
+  "../bin/scanner_bench.pdb"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/async_file_logger.cpp.o"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/async_file_logger.cpp.o.d"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/blocked_bloom_filter.cpp.o"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/blocked_bloom_filter.cpp.o.d"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/cpu_features.cpp.o"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/cpu_features.cpp.o.d"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/csv_hash_database.cpp.o"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/csv_hash_database.cpp.o.d"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/file_logger.cpp.o"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/file_logger.cpp.o.d"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/file_reader.cpp.o"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/file_reader.cpp.o.d"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/io_uring.cpp.o"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/io_uring.cpp.o.d"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/mapped_file.cpp.o"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/mapped_file.cpp.o.d"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/mapped_hash_database.cpp.o"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/mapped_hash_database.cpp.o.d"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/md5_engine.cpp.o"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/md5_engine.cpp.o.d"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/md5_file_hasher.cpp.o"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/md5_file_hasher.cpp.o.d"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/md5_multi_buffer.cpp.o"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/md5_multi_buffer.cpp.o.d"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/scan_metrics.cpp.o"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/scan_metrics.cpp.o.d"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/scan_trace.cpp.o"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/scan_trace.cpp.o.d"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/sha256_multi_buffer.cpp.o"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/sha256_multi_buffer.cpp.o.d"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/sha_engine.cpp.o"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/sha_engine.cpp.o.d"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/thread_pool.cpp.o"
+  "CMakeFiles/scanner_bench.dir/__/src/scanner_lib/thread_pool.cpp.o.d"
+  "CMakeFiles/scanner_bench.dir/file_hasher_bench.cpp.o"
+  "CMakeFiles/scanner_bench.dir/file_hasher_bench.cpp.o.d"
+  "CMakeFiles/scanner_bench.dir/hash_bench.cpp.o"
+  "CMakeFiles/scanner_bench.dir/hash_bench.cpp.o.d"
+  "CMakeFiles/scanner_bench.dir/hash_database_bench.cpp.o"
+  "CMakeFiles/scanner_bench.dir/hash_database_bench.cpp.o.d"
+  "CMakeFiles/scanner_bench.dir/logger_bench.cpp.o"
+  "CMakeFiles/scanner_bench.dir/logger_bench.cpp.o.d"
+  "CMakeFiles/scanner_bench.dir/scan_bench.cpp.o"
+  "CMakeFiles/scanner_bench.dir/scan_bench.cpp.o.d"
+  "CMakeFiles/scanner_bench.dir/thread_pool_bench.cpp.o"
+  "CMakeFiles/scanner_bench.dir/thread_pool_bench.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/scanner_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
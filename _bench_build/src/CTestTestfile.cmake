@@ -0,0 +1,9 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src
+# Build directory: /root/repo/_bench_build/src
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("scanner_lib")
+subdirs("scanner_cli")
+subdirs("scanner_dbc")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/scanner"
+  "../../bin/scanner.pdb"
+  "CMakeFiles/scanner.dir/main.cpp.o"
+  "CMakeFiles/scanner.dir/main.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/scanner.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
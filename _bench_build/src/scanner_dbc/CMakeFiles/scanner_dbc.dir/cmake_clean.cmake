@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/scanner-dbc"
+  "../../bin/scanner-dbc.pdb"
+  "CMakeFiles/scanner_dbc.dir/main.cpp.o"
+  "CMakeFiles/scanner_dbc.dir/main.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/scanner_dbc.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,50 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/scanner_lib/async_file_logger.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/async_file_logger.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/async_file_logger.cpp.o.d"
+  "/root/repo/src/scanner_lib/blocked_bloom_filter.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/blocked_bloom_filter.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/blocked_bloom_filter.cpp.o.d"
+  "/root/repo/src/scanner_lib/composite_file_hasher.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/composite_file_hasher.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/composite_file_hasher.cpp.o.d"
+  "/root/repo/src/scanner_lib/cpu_features.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/cpu_features.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/cpu_features.cpp.o.d"
+  "/root/repo/src/scanner_lib/csv_hash_database.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/csv_hash_database.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/csv_hash_database.cpp.o.d"
+  "/root/repo/src/scanner_lib/detection_channel.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/detection_channel.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/detection_channel.cpp.o.d"
+  "/root/repo/src/scanner_lib/domain.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/domain.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/domain.cpp.o.d"
+  "/root/repo/src/scanner_lib/file_logger.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/file_logger.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/file_logger.cpp.o.d"
+  "/root/repo/src/scanner_lib/file_reader.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/file_reader.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/file_reader.cpp.o.d"
+  "/root/repo/src/scanner_lib/file_state_cache.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/file_state_cache.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/file_state_cache.cpp.o.d"
+  "/root/repo/src/scanner_lib/file_status.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/file_status.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/file_status.cpp.o.d"
+  "/root/repo/src/scanner_lib/hardlink_tracker.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/hardlink_tracker.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/hardlink_tracker.cpp.o.d"
+  "/root/repo/src/scanner_lib/io_uring.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/io_uring.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/io_uring.cpp.o.d"
+  "/root/repo/src/scanner_lib/largest_first_queue.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/largest_first_queue.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/largest_first_queue.cpp.o.d"
+  "/root/repo/src/scanner_lib/mapped_file.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/mapped_file.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/mapped_file.cpp.o.d"
+  "/root/repo/src/scanner_lib/mapped_hash_database.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/mapped_hash_database.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/mapped_hash_database.cpp.o.d"
+  "/root/repo/src/scanner_lib/md5_engine.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/md5_engine.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/md5_engine.cpp.o.d"
+  "/root/repo/src/scanner_lib/md5_file_hasher.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/md5_file_hasher.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/md5_file_hasher.cpp.o.d"
+  "/root/repo/src/scanner_lib/md5_multi_buffer.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/md5_multi_buffer.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/md5_multi_buffer.cpp.o.d"
+  "/root/repo/src/scanner_lib/parallel_walker.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/parallel_walker.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/parallel_walker.cpp.o.d"
+  "/root/repo/src/scanner_lib/path_filter.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/path_filter.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/path_filter.cpp.o.d"
+  "/root/repo/src/scanner_lib/read_order_queue.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/read_order_queue.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/read_order_queue.cpp.o.d"
+  "/root/repo/src/scanner_lib/scan_metrics.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/scan_metrics.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/scan_metrics.cpp.o.d"
+  "/root/repo/src/scanner_lib/scan_trace.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/scan_trace.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/scan_trace.cpp.o.d"
+  "/root/repo/src/scanner_lib/scanner.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/scanner.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/scanner.cpp.o.d"
+  "/root/repo/src/scanner_lib/scanner_builder.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/scanner_builder.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/scanner_builder.cpp.o.d"
+  "/root/repo/src/scanner_lib/sha256_file_hasher.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/sha256_file_hasher.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/sha256_file_hasher.cpp.o.d"
+  "/root/repo/src/scanner_lib/sha256_multi_buffer.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/sha256_multi_buffer.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/sha256_multi_buffer.cpp.o.d"
+  "/root/repo/src/scanner_lib/sha_engine.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/sha_engine.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/sha_engine.cpp.o.d"
+  "/root/repo/src/scanner_lib/signature_database_compiler.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/signature_database_compiler.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/signature_database_compiler.cpp.o.d"
+  "/root/repo/src/scanner_lib/thread_pool.cpp" "src/scanner_lib/CMakeFiles/scanner_lib.dir/thread_pool.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_lib.dir/thread_pool.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_bench_build/src/scanner_lib/CMakeFiles/scanner_simd.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,71 @@
+file(REMOVE_RECURSE
+  "../../lib/libscanner_lib.pdb"
+  "../../lib/libscanner_lib.so"
+  "CMakeFiles/scanner_lib.dir/async_file_logger.cpp.o"
+  "CMakeFiles/scanner_lib.dir/async_file_logger.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/blocked_bloom_filter.cpp.o"
+  "CMakeFiles/scanner_lib.dir/blocked_bloom_filter.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/composite_file_hasher.cpp.o"
+  "CMakeFiles/scanner_lib.dir/composite_file_hasher.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/cpu_features.cpp.o"
+  "CMakeFiles/scanner_lib.dir/cpu_features.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/csv_hash_database.cpp.o"
+  "CMakeFiles/scanner_lib.dir/csv_hash_database.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/detection_channel.cpp.o"
+  "CMakeFiles/scanner_lib.dir/detection_channel.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/domain.cpp.o"
+  "CMakeFiles/scanner_lib.dir/domain.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/file_logger.cpp.o"
+  "CMakeFiles/scanner_lib.dir/file_logger.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/file_reader.cpp.o"
+  "CMakeFiles/scanner_lib.dir/file_reader.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/file_state_cache.cpp.o"
+  "CMakeFiles/scanner_lib.dir/file_state_cache.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/file_status.cpp.o"
+  "CMakeFiles/scanner_lib.dir/file_status.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/hardlink_tracker.cpp.o"
+  "CMakeFiles/scanner_lib.dir/hardlink_tracker.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/io_uring.cpp.o"
+  "CMakeFiles/scanner_lib.dir/io_uring.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/largest_first_queue.cpp.o"
+  "CMakeFiles/scanner_lib.dir/largest_first_queue.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/mapped_file.cpp.o"
+  "CMakeFiles/scanner_lib.dir/mapped_file.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/mapped_hash_database.cpp.o"
+  "CMakeFiles/scanner_lib.dir/mapped_hash_database.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/md5_engine.cpp.o"
+  "CMakeFiles/scanner_lib.dir/md5_engine.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/md5_file_hasher.cpp.o"
+  "CMakeFiles/scanner_lib.dir/md5_file_hasher.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/md5_multi_buffer.cpp.o"
+  "CMakeFiles/scanner_lib.dir/md5_multi_buffer.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/parallel_walker.cpp.o"
+  "CMakeFiles/scanner_lib.dir/parallel_walker.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/path_filter.cpp.o"
+  "CMakeFiles/scanner_lib.dir/path_filter.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/read_order_queue.cpp.o"
+  "CMakeFiles/scanner_lib.dir/read_order_queue.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/scan_metrics.cpp.o"
+  "CMakeFiles/scanner_lib.dir/scan_metrics.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/scan_trace.cpp.o"
+  "CMakeFiles/scanner_lib.dir/scan_trace.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/scanner.cpp.o"
+  "CMakeFiles/scanner_lib.dir/scanner.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/scanner_builder.cpp.o"
+  "CMakeFiles/scanner_lib.dir/scanner_builder.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/sha256_file_hasher.cpp.o"
+  "CMakeFiles/scanner_lib.dir/sha256_file_hasher.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/sha256_multi_buffer.cpp.o"
+  "CMakeFiles/scanner_lib.dir/sha256_multi_buffer.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/sha_engine.cpp.o"
+  "CMakeFiles/scanner_lib.dir/sha_engine.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/signature_database_compiler.cpp.o"
+  "CMakeFiles/scanner_lib.dir/signature_database_compiler.cpp.o.d"
+  "CMakeFiles/scanner_lib.dir/thread_pool.cpp.o"
+  "CMakeFiles/scanner_lib.dir/thread_pool.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/scanner_lib.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/scanner_lib/md5_lanes_avx2.cpp" "src/scanner_lib/CMakeFiles/scanner_simd.dir/md5_lanes_avx2.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_simd.dir/md5_lanes_avx2.cpp.o.d"
+  "/root/repo/src/scanner_lib/md5_lanes_avx512.cpp" "src/scanner_lib/CMakeFiles/scanner_simd.dir/md5_lanes_avx512.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_simd.dir/md5_lanes_avx512.cpp.o.d"
+  "/root/repo/src/scanner_lib/md5_lanes_sse2.cpp" "src/scanner_lib/CMakeFiles/scanner_simd.dir/md5_lanes_sse2.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_simd.dir/md5_lanes_sse2.cpp.o.d"
+  "/root/repo/src/scanner_lib/sha256_lanes_avx2.cpp" "src/scanner_lib/CMakeFiles/scanner_simd.dir/sha256_lanes_avx2.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_simd.dir/sha256_lanes_avx2.cpp.o.d"
+  "/root/repo/src/scanner_lib/sha256_shani.cpp" "src/scanner_lib/CMakeFiles/scanner_simd.dir/sha256_shani.cpp.o" "gcc" "src/scanner_lib/CMakeFiles/scanner_simd.dir/sha256_shani.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
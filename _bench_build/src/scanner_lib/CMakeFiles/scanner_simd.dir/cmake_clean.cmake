@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "../../lib/libscanner_simd.a"
+  "../../lib/libscanner_simd.pdb"
+  "CMakeFiles/scanner_simd.dir/md5_lanes_avx2.cpp.o"
+  "CMakeFiles/scanner_simd.dir/md5_lanes_avx2.cpp.o.d"
+  "CMakeFiles/scanner_simd.dir/md5_lanes_avx512.cpp.o"
+  "CMakeFiles/scanner_simd.dir/md5_lanes_avx512.cpp.o.d"
+  "CMakeFiles/scanner_simd.dir/md5_lanes_sse2.cpp.o"
+  "CMakeFiles/scanner_simd.dir/md5_lanes_sse2.cpp.o.d"
+  "CMakeFiles/scanner_simd.dir/sha256_lanes_avx2.cpp.o"
+  "CMakeFiles/scanner_simd.dir/sha256_lanes_avx2.cpp.o.d"
+  "CMakeFiles/scanner_simd.dir/sha256_shani.cpp.o"
+  "CMakeFiles/scanner_simd.dir/sha256_shani.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/scanner_simd.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/integration_tests"
+  "../bin/integration_tests.pdb"
+  "CMakeFiles/integration_tests.dir/integration_test.cpp.o"
+  "CMakeFiles/integration_tests.dir/integration_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/integration_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,83 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/scanner_lib/async_file_logger.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/async_file_logger.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/async_file_logger.cpp.o.d"
+  "/root/repo/src/scanner_lib/blocked_bloom_filter.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/blocked_bloom_filter.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/blocked_bloom_filter.cpp.o.d"
+  "/root/repo/src/scanner_lib/composite_file_hasher.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/composite_file_hasher.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/composite_file_hasher.cpp.o.d"
+  "/root/repo/src/scanner_lib/cpu_features.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/cpu_features.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/cpu_features.cpp.o.d"
+  "/root/repo/src/scanner_lib/csv_hash_database.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/csv_hash_database.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/csv_hash_database.cpp.o.d"
+  "/root/repo/src/scanner_lib/detection_channel.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/detection_channel.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/detection_channel.cpp.o.d"
+  "/root/repo/src/scanner_lib/file_logger.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/file_logger.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/file_logger.cpp.o.d"
+  "/root/repo/src/scanner_lib/file_reader.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/file_reader.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/file_reader.cpp.o.d"
+  "/root/repo/src/scanner_lib/file_state_cache.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/file_state_cache.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/file_state_cache.cpp.o.d"
+  "/root/repo/src/scanner_lib/file_status.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/file_status.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/file_status.cpp.o.d"
+  "/root/repo/src/scanner_lib/hardlink_tracker.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/hardlink_tracker.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/hardlink_tracker.cpp.o.d"
+  "/root/repo/src/scanner_lib/io_uring.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/io_uring.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/io_uring.cpp.o.d"
+  "/root/repo/src/scanner_lib/largest_first_queue.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/largest_first_queue.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/largest_first_queue.cpp.o.d"
+  "/root/repo/src/scanner_lib/mapped_file.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/mapped_file.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/mapped_file.cpp.o.d"
+  "/root/repo/src/scanner_lib/mapped_hash_database.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/mapped_hash_database.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/mapped_hash_database.cpp.o.d"
+  "/root/repo/src/scanner_lib/md5_engine.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/md5_engine.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/md5_engine.cpp.o.d"
+  "/root/repo/src/scanner_lib/md5_file_hasher.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/md5_file_hasher.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/md5_file_hasher.cpp.o.d"
+  "/root/repo/src/scanner_lib/md5_multi_buffer.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/md5_multi_buffer.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/md5_multi_buffer.cpp.o.d"
+  "/root/repo/src/scanner_lib/parallel_walker.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/parallel_walker.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/parallel_walker.cpp.o.d"
+  "/root/repo/src/scanner_lib/path_filter.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/path_filter.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/path_filter.cpp.o.d"
+  "/root/repo/src/scanner_lib/read_order_queue.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/read_order_queue.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/read_order_queue.cpp.o.d"
+  "/root/repo/src/scanner_lib/scan_metrics.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/scan_metrics.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/scan_metrics.cpp.o.d"
+  "/root/repo/src/scanner_lib/scan_trace.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/scan_trace.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/scan_trace.cpp.o.d"
+  "/root/repo/src/scanner_lib/scanner.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/scanner.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/scanner.cpp.o.d"
+  "/root/repo/src/scanner_lib/sha256_file_hasher.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/sha256_file_hasher.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/sha256_file_hasher.cpp.o.d"
+  "/root/repo/src/scanner_lib/sha256_multi_buffer.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/sha256_multi_buffer.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/sha256_multi_buffer.cpp.o.d"
+  "/root/repo/src/scanner_lib/sha_engine.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/sha_engine.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/sha_engine.cpp.o.d"
+  "/root/repo/src/scanner_lib/signature_database_compiler.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/signature_database_compiler.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/signature_database_compiler.cpp.o.d"
+  "/root/repo/src/scanner_lib/thread_pool.cpp" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/thread_pool.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/__/src/scanner_lib/thread_pool.cpp.o.d"
+  "/root/repo/tests/async_file_logger_test.cpp" "tests/CMakeFiles/scanner_tests.dir/async_file_logger_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/async_file_logger_test.cpp.o.d"
+  "/root/repo/tests/blocked_bloom_filter_test.cpp" "tests/CMakeFiles/scanner_tests.dir/blocked_bloom_filter_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/blocked_bloom_filter_test.cpp.o.d"
+  "/root/repo/tests/composite_file_hasher_test.cpp" "tests/CMakeFiles/scanner_tests.dir/composite_file_hasher_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/composite_file_hasher_test.cpp.o.d"
+  "/root/repo/tests/csv_hash_database_test.cpp" "tests/CMakeFiles/scanner_tests.dir/csv_hash_database_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/csv_hash_database_test.cpp.o.d"
+  "/root/repo/tests/detection_channel_test.cpp" "tests/CMakeFiles/scanner_tests.dir/detection_channel_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/detection_channel_test.cpp.o.d"
+  "/root/repo/tests/domain_test.cpp" "tests/CMakeFiles/scanner_tests.dir/domain_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/domain_test.cpp.o.d"
+  "/root/repo/tests/file_logger_test.cpp" "tests/CMakeFiles/scanner_tests.dir/file_logger_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/file_logger_test.cpp.o.d"
+  "/root/repo/tests/file_reader_test.cpp" "tests/CMakeFiles/scanner_tests.dir/file_reader_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/file_reader_test.cpp.o.d"
+  "/root/repo/tests/file_state_cache_test.cpp" "tests/CMakeFiles/scanner_tests.dir/file_state_cache_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/file_state_cache_test.cpp.o.d"
+  "/root/repo/tests/hardlink_tracker_test.cpp" "tests/CMakeFiles/scanner_tests.dir/hardlink_tracker_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/hardlink_tracker_test.cpp.o.d"
+  "/root/repo/tests/io_uring_test.cpp" "tests/CMakeFiles/scanner_tests.dir/io_uring_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/io_uring_test.cpp.o.d"
+  "/root/repo/tests/largest_first_queue_test.cpp" "tests/CMakeFiles/scanner_tests.dir/largest_first_queue_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/largest_first_queue_test.cpp.o.d"
+  "/root/repo/tests/mapped_hash_database_test.cpp" "tests/CMakeFiles/scanner_tests.dir/mapped_hash_database_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/mapped_hash_database_test.cpp.o.d"
+  "/root/repo/tests/md5_engine_test.cpp" "tests/CMakeFiles/scanner_tests.dir/md5_engine_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/md5_engine_test.cpp.o.d"
+  "/root/repo/tests/md5_file_hasher_test.cpp" "tests/CMakeFiles/scanner_tests.dir/md5_file_hasher_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/md5_file_hasher_test.cpp.o.d"
+  "/root/repo/tests/md5_multi_buffer_test.cpp" "tests/CMakeFiles/scanner_tests.dir/md5_multi_buffer_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/md5_multi_buffer_test.cpp.o.d"
+  "/root/repo/tests/mpsc_ring_test.cpp" "tests/CMakeFiles/scanner_tests.dir/mpsc_ring_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/mpsc_ring_test.cpp.o.d"
+  "/root/repo/tests/parallel_walker_test.cpp" "tests/CMakeFiles/scanner_tests.dir/parallel_walker_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/parallel_walker_test.cpp.o.d"
+  "/root/repo/tests/path_filter_test.cpp" "tests/CMakeFiles/scanner_tests.dir/path_filter_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/path_filter_test.cpp.o.d"
+  "/root/repo/tests/read_order_queue_test.cpp" "tests/CMakeFiles/scanner_tests.dir/read_order_queue_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/read_order_queue_test.cpp.o.d"
+  "/root/repo/tests/scan_allocation_test.cpp" "tests/CMakeFiles/scanner_tests.dir/scan_allocation_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/scan_allocation_test.cpp.o.d"
+  "/root/repo/tests/scan_metrics_test.cpp" "tests/CMakeFiles/scanner_tests.dir/scan_metrics_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/scan_metrics_test.cpp.o.d"
+  "/root/repo/tests/scan_trace_test.cpp" "tests/CMakeFiles/scanner_tests.dir/scan_trace_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/scan_trace_test.cpp.o.d"
+  "/root/repo/tests/scanner_builder_test.cpp" "tests/CMakeFiles/scanner_tests.dir/scanner_builder_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/scanner_builder_test.cpp.o.d"
+  "/root/repo/tests/scanner_test.cpp" "tests/CMakeFiles/scanner_tests.dir/scanner_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/scanner_test.cpp.o.d"
+  "/root/repo/tests/sha256_file_hasher_test.cpp" "tests/CMakeFiles/scanner_tests.dir/sha256_file_hasher_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/sha256_file_hasher_test.cpp.o.d"
+  "/root/repo/tests/sha256_multi_buffer_test.cpp" "tests/CMakeFiles/scanner_tests.dir/sha256_multi_buffer_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/sha256_multi_buffer_test.cpp.o.d"
+  "/root/repo/tests/sha_engine_test.cpp" "tests/CMakeFiles/scanner_tests.dir/sha_engine_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/sha_engine_test.cpp.o.d"
+  "/root/repo/tests/task_test.cpp" "tests/CMakeFiles/scanner_tests.dir/task_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/task_test.cpp.o.d"
+  "/root/repo/tests/thread_pool_test.cpp" "tests/CMakeFiles/scanner_tests.dir/thread_pool_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/thread_pool_test.cpp.o.d"
+  "/root/repo/tests/work_stealing_deque_test.cpp" "tests/CMakeFiles/scanner_tests.dir/work_stealing_deque_test.cpp.o" "gcc" "tests/CMakeFiles/scanner_tests.dir/work_stealing_deque_test.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_bench_build/src/scanner_lib/CMakeFiles/scanner_lib.dir/DependInfo.cmake"
+  "/root/repo/_bench_build/src/scanner_lib/CMakeFiles/scanner_simd.dir/DependInfo.cmake"
+  "/root/repo/_bench_build/_deps/googletest-build/googletest/CMakeFiles/gtest_main.dir/DependInfo.cmake"
+  "/root/repo/_bench_build/_deps/googletest-build/googlemock/CMakeFiles/gmock.dir/DependInfo.cmake"
+  "/root/repo/_bench_build/_deps/googletest-build/googletest/CMakeFiles/gtest.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
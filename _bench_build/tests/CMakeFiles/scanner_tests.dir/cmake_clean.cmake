@@ -0,0 +1,130 @@
+file(REMOVE_RECURSE
+  "../bin/scanner_tests"
+  "../bin/scanner_tests.pdb"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/async_file_logger.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/async_file_logger.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/blocked_bloom_filter.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/blocked_bloom_filter.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/composite_file_hasher.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/composite_file_hasher.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/cpu_features.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/cpu_features.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/csv_hash_database.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/csv_hash_database.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/detection_channel.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/detection_channel.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/file_logger.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/file_logger.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/file_reader.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/file_reader.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/file_state_cache.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/file_state_cache.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/file_status.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/file_status.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/hardlink_tracker.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/hardlink_tracker.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/io_uring.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/io_uring.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/largest_first_queue.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/largest_first_queue.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/mapped_file.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/mapped_file.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/mapped_hash_database.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/mapped_hash_database.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/md5_engine.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/md5_engine.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/md5_file_hasher.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/md5_file_hasher.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/md5_multi_buffer.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/md5_multi_buffer.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/parallel_walker.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/parallel_walker.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/path_filter.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/path_filter.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/read_order_queue.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/read_order_queue.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/scan_metrics.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/scan_metrics.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/scan_trace.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/scan_trace.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/scanner.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/scanner.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/sha256_file_hasher.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/sha256_file_hasher.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/sha256_multi_buffer.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/sha256_multi_buffer.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/sha_engine.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/sha_engine.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/signature_database_compiler.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/signature_database_compiler.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/thread_pool.cpp.o"
+  "CMakeFiles/scanner_tests.dir/__/src/scanner_lib/thread_pool.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/async_file_logger_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/async_file_logger_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/blocked_bloom_filter_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/blocked_bloom_filter_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/composite_file_hasher_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/composite_file_hasher_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/csv_hash_database_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/csv_hash_database_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/detection_channel_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/detection_channel_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/domain_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/domain_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/file_logger_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/file_logger_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/file_reader_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/file_reader_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/file_state_cache_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/file_state_cache_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/hardlink_tracker_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/hardlink_tracker_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/io_uring_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/io_uring_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/largest_first_queue_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/largest_first_queue_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/mapped_hash_database_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/mapped_hash_database_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/md5_engine_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/md5_engine_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/md5_file_hasher_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/md5_file_hasher_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/md5_multi_buffer_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/md5_multi_buffer_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/mpsc_ring_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/mpsc_ring_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/parallel_walker_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/parallel_walker_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/path_filter_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/path_filter_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/read_order_queue_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/read_order_queue_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/scan_allocation_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/scan_allocation_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/scan_metrics_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/scan_metrics_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/scan_trace_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/scan_trace_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/scanner_builder_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/scanner_builder_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/scanner_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/scanner_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/sha256_file_hasher_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/sha256_file_hasher_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/sha256_multi_buffer_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/sha256_multi_buffer_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/sha_engine_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/sha_engine_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/task_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/task_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/thread_pool_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/thread_pool_test.cpp.o.d"
+  "CMakeFiles/scanner_tests.dir/work_stealing_deque_test.cpp.o"
+  "CMakeFiles/scanner_tests.dir/work_stealing_deque_test.cpp.o.d"
+  "scanner_tests[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/scanner_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,10 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests
+# Build directory: /root/repo/_bench_build/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+include("/root/repo/_bench_build/tests/scanner_tests[1]_include.cmake")
+add_test(integration_tests "/root/repo/_bench_build/bin/integration_tests")
+set_tests_properties(integration_tests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;149;add_test;/root/repo/tests/CMakeLists.txt;0;")
+subdirs("../_deps/googletest-build")
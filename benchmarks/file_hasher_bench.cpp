@@ -0,0 +1,74 @@
+#include <cstdint>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmarks/temp_directory.h"
+#include "src/scanner_lib/md5_file_hasher.h"
+
+namespace scanner::bench {
+namespace {
+
+constexpr std::size_t kFilesPerBatch = 64;
+
+// Hashes one file of state.range(0) bytes per iteration. The file stays in
+// the page cache, so this measures the hasher rather than the disk.
+void BM_Md5HashFile(benchmark::State& state, IoStrategy strategy) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const TempDirectory dir("md5_hash_file");
+  const std::filesystem::path path = dir.Path() / "file.bin";
+  WriteFile(path, MakeContent(size, 1));
+
+  Md5FileHasher hasher(Md5MultiBuffer::BestIsa(), IoOptions{strategy});
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(hasher.HashFile(path));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Hashes kFilesPerBatch small files per iteration with one HashFiles call,
+// the path the scanner takes for small files.
+void BM_Md5HashFiles(benchmark::State& state, IoStrategy strategy) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const TempDirectory dir("md5_hash_files");
+  std::vector<std::filesystem::path> paths;
+  for (std::size_t i = 0; i < kFilesPerBatch; ++i) {
+    paths.push_back(dir.Path() / ("file" + std::to_string(i) + ".bin"));
+    WriteFile(paths.back(), MakeContent(size, i));
+  }
+
+  Md5FileHasher hasher(Md5MultiBuffer::BestIsa(), IoOptions{strategy});
+  std::vector<FileHashResult> results;
+  for (auto _ : state) {
+    hasher.HashFiles(paths, results);
+    benchmark::DoNotOptimize(results.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) *
+                          static_cast<std::int64_t>(kFilesPerBatch));
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(kFilesPerBatch));
+}
+
+void FileSizes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->RangeMultiplier(16)->Range(1024, 64 * 1024 * 1024);
+  benchmark->ArgName("bytes");
+}
+
+void SmallFileSizes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->RangeMultiplier(4)->Range(256, 64 * 1024)->ArgName("bytes");
+}
+
+BENCHMARK_CAPTURE(BM_Md5HashFile, auto, IoStrategy::kAuto)->Apply(FileSizes);
+BENCHMARK_CAPTURE(BM_Md5HashFile, mmap, IoStrategy::kMmap)->Apply(FileSizes);
+BENCHMARK_CAPTURE(BM_Md5HashFile, read, IoStrategy::kRead)->Apply(FileSizes);
+BENCHMARK_CAPTURE(BM_Md5HashFiles, auto, IoStrategy::kAuto)
+    ->Apply(SmallFileSizes);
+BENCHMARK_CAPTURE(BM_Md5HashFiles, io_uring, IoStrategy::kIoUring)
+    ->Apply(SmallFileSizes);
+
+}  // namespace
+}  // namespace scanner::bench
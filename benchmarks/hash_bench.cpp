@@ -0,0 +1,82 @@
+#include <cstdint>
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "src/scanner_lib/md5_multi_buffer.h"
+#include "src/scanner_lib/sha256_multi_buffer.h"
+
+namespace scanner::bench {
+namespace {
+
+constexpr std::size_t kMessagesPerIteration = 64;
+
+// Builds kMessagesPerIteration messages of state.range(0) bytes each, the
+// shape of a batch of equally sized small files.
+class Messages {
+public:
+  explicit Messages(std::size_t size)
+      : data_(kMessagesPerIteration * size) {
+    for (std::size_t i = 0; i < data_.size(); ++i) {
+      data_[i] = static_cast<std::uint8_t>(i * 131 + (i >> 9));
+    }
+    for (std::size_t i = 0; i < kMessagesPerIteration; ++i) {
+      messages_.push_back({data_.data() + i * size, size});
+    }
+  }
+
+  const std::vector<HashMessage>& Get() const {
+    return messages_;
+  }
+
+private:
+  std::vector<std::uint8_t> data_;
+  std::vector<HashMessage> messages_;
+};
+
+void SetCounters(benchmark::State& state) {
+  state.SetBytesProcessed(state.iterations() * state.range(0) *
+                          static_cast<std::int64_t>(kMessagesPerIteration));
+}
+
+void BM_Sha256(benchmark::State& state, Sha256Isa isa) {
+  if (!Sha256MultiBuffer::IsSupported(isa)) {
+    state.SkipWithError("Instruction set not supported by this CPU");
+    return;
+  }
+  const Sha256MultiBuffer multi_buffer(isa);
+  const Messages messages(static_cast<std::size_t>(state.range(0)));
+  std::vector<Sha256Digest> digests(kMessagesPerIteration);
+  for (auto _ : state) {
+    multi_buffer.Hash(messages.Get().data(), kMessagesPerIteration,
+                      digests.data());
+    benchmark::DoNotOptimize(digests.data());
+  }
+  SetCounters(state);
+}
+
+// MD5 on the fastest path, as the baseline SHA-256 is compared against.
+void BM_Md5(benchmark::State& state) {
+  const Md5MultiBuffer multi_buffer;
+  const Messages messages(static_cast<std::size_t>(state.range(0)));
+  std::vector<Md5Digest> digests(kMessagesPerIteration);
+  for (auto _ : state) {
+    multi_buffer.Hash(messages.Get().data(), kMessagesPerIteration,
+                      digests.data());
+    benchmark::DoNotOptimize(digests.data());
+  }
+  SetCounters(state);
+}
+
+void MessageSizes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->Arg(1024)->Arg(16 * 1024)->Arg(128 * 1024)->ArgName("bytes");
+}
+
+BENCHMARK_CAPTURE(BM_Sha256, scalar, Sha256Isa::kScalar)->Apply(MessageSizes);
+BENCHMARK_CAPTURE(BM_Sha256, sha_ni, Sha256Isa::kShaNi)->Apply(MessageSizes);
+BENCHMARK_CAPTURE(BM_Sha256, avx2, Sha256Isa::kAvx2)->Apply(MessageSizes);
+BENCHMARK(BM_Md5)->Apply(MessageSizes);
+
+}  // namespace
+}  // namespace scanner::bench
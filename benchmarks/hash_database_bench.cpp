@@ -0,0 +1,114 @@
+#include <cstdint>
+#include <cstring>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmarks/temp_directory.h"
+#include "scanner/interfaces.h"
+#include "src/scanner_lib/csv_hash_database.h"
+#include "src/scanner_lib/mapped_hash_database.h"
+
+namespace scanner::bench {
+namespace {
+
+constexpr std::size_t kLookupsPerIteration = 4096;
+
+Md5Digest MakeDigest(std::uint64_t seed) {
+  Md5Digest digest;
+  const std::vector<std::uint8_t> bytes = MakeContent(Md5Digest::kSize, seed);
+  std::memcpy(digest.bytes.data(), bytes.data(), Md5Digest::kSize);
+  return digest;
+}
+
+// A CSV database of state.range(0) signatures with a handful of verdicts.
+// Signature i has the digest MakeDigest(i).
+class DatabaseFixture {
+public:
+  DatabaseFixture(const std::string& name, std::size_t entries)
+      : dir_(name), csv_path_(dir_.Path() / "base.csv") {
+    std::ofstream csv(csv_path_);
+    for (std::size_t i = 0; i < entries; ++i) {
+      csv << MakeDigest(i).ToHex() << ";Family" << i % 32 << "\n";
+    }
+  }
+
+  const std::filesystem::path& CsvPath() const {
+    return csv_path_;
+  }
+
+  std::filesystem::path Compile() const {
+    const std::filesystem::path sigdb_path = dir_.Path() / "base.sigdb";
+    CompileSignatureDatabase(csv_path_, sigdb_path);
+    return sigdb_path;
+  }
+
+private:
+  TempDirectory dir_;
+  std::filesystem::path csv_path_;
+};
+
+// Digests to look up: signatures of the database if hit, otherwise digests
+// that are absent from it.
+std::vector<Md5Digest> MakeLookups(std::size_t entries, bool hit) {
+  std::vector<Md5Digest> lookups;
+  for (std::size_t i = 0; i < kLookupsPerIteration; ++i) {
+    lookups.push_back(hit ? MakeDigest(i * 7919 % entries)
+                          : MakeDigest(entries + i));
+  }
+  return lookups;
+}
+
+void RunLookups(benchmark::State& state, const IHashDatabase& db,
+                const std::vector<Md5Digest>& lookups) {
+  for (auto _ : state) {
+    for (const Md5Digest& digest : lookups) {
+      benchmark::DoNotOptimize(db.FindHash(digest));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(lookups.size()));
+}
+
+void BM_CsvLoad(benchmark::State& state) {
+  const auto entries = static_cast<std::size_t>(state.range(0));
+  const DatabaseFixture fixture("csv_load", entries);
+  for (auto _ : state) {
+    CsvHashDatabase db;
+    benchmark::DoNotOptimize(db.Load(fixture.CsvPath()));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_CsvFindHash(benchmark::State& state, bool hit) {
+  const auto entries = static_cast<std::size_t>(state.range(0));
+  const DatabaseFixture fixture("csv_find", entries);
+  CsvHashDatabase db;
+  db.Load(fixture.CsvPath());
+  RunLookups(state, db, MakeLookups(entries, hit));
+}
+
+void BM_MappedFindHash(benchmark::State& state, bool hit) {
+  const auto entries = static_cast<std::size_t>(state.range(0));
+  const DatabaseFixture fixture("mapped_find", entries);
+  MappedHashDatabase db;
+  db.Load(fixture.Compile());
+  RunLookups(state, db, MakeLookups(entries, hit));
+}
+
+void DatabaseSizes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->RangeMultiplier(10)->Range(1000, 1000000)->ArgName("entries");
+}
+
+BENCHMARK(BM_CsvLoad)->Apply(DatabaseSizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_CsvFindHash, hit, true)->Apply(DatabaseSizes);
+BENCHMARK_CAPTURE(BM_CsvFindHash, miss, false)->Apply(DatabaseSizes);
+BENCHMARK_CAPTURE(BM_MappedFindHash, hit, true)->Apply(DatabaseSizes);
+BENCHMARK_CAPTURE(BM_MappedFindHash, miss, false)->Apply(DatabaseSizes);
+
+}  // namespace
+}  // namespace scanner::bench
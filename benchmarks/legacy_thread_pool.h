@@ -0,0 +1,96 @@
+#ifndef BENCHMARKS_LEGACY_THREAD_POOL_H_
+#define BENCHMARKS_LEGACY_THREAD_POOL_H_
+
+#include <condition_variable>
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace scanner::bench {
+
+/**
+ * @class LegacyThreadPool
+ * @brief The original single-queue thread pool, kept as a baseline.
+ *
+ * All workers share one std::queue guarded by one mutex, and every task is a
+ * std::function wrapping a shared std::packaged_task.
+ */
+class LegacyThreadPool {
+public:
+  explicit LegacyThreadPool(std::size_t num_threads) {
+    for (std::size_t i = 0; i < num_threads; ++i) {
+      workers_.emplace_back([this] { Worker(); });
+    }
+  }
+
+  ~LegacyThreadPool() {
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      stop_.store(true);
+    }
+    condition_.notify_all();
+    for (std::thread& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  LegacyThreadPool(const LegacyThreadPool&) = delete;
+  LegacyThreadPool& operator=(const LegacyThreadPool&) = delete;
+
+  template <class F, class... Args>
+  auto Enqueue(F&& f, Args&&... args)
+      -> std::future<std::invoke_result_t<F, Args...>> {
+    using return_type = std::invoke_result_t<F, Args...>;
+
+    auto task = std::make_shared<std::packaged_task<return_type()>>(
+        std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+
+    std::future<return_type> res = task->get_future();
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      if (stop_.load()) {
+        throw std::runtime_error("Enqueue on stopped ThreadPool");
+      }
+      tasks_.emplace([task]() { (*task)(); });
+    }
+    condition_.notify_one();
+    return res;
+  }
+
+private:
+  void Worker() {
+    for (;;) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        condition_.wait(lock,
+                        [this] { return stop_.load() || !tasks_.empty(); });
+        if (stop_.load() && tasks_.empty()) {
+          return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop();
+      }
+      task();
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::queue<std::function<void()>> tasks_;
+  std::mutex queue_mutex_;
+  std::condition_variable condition_;
+  std::atomic<bool> stop_{false};
+};
+
+}  // namespace scanner::bench
+
+#endif  // BENCHMARKS_LEGACY_THREAD_POOL_H_
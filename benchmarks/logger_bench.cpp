@@ -0,0 +1,58 @@
+#include <cstdint>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmarks/temp_directory.h"
+#include "src/scanner_lib/async_file_logger.h"
+#include "src/scanner_lib/file_logger.h"
+
+namespace scanner::bench {
+namespace {
+
+constexpr std::int64_t kDetectionsPerIteration = 1000;
+
+// Logs kDetectionsPerIteration detections per iteration from every
+// benchmark thread into one shared logger, then flushes it.
+template <class Logger>
+void BM_LogDetections(benchmark::State& state) {
+  static std::unique_ptr<TempDirectory> dir;
+  static std::unique_ptr<Logger> logger;
+  if (state.thread_index() == 0) {
+    dir = std::make_unique<TempDirectory>("logger");
+    logger = std::make_unique<Logger>(dir->Path() / "report.log");
+  }
+
+  const std::filesystem::path path =
+      "/srv/data/thread" + std::to_string(state.thread_index()) +
+      "/nested/directory/suspicious_file.exe";
+  Md5Digest digest;
+  digest.bytes.fill(0xAB);
+  const std::string verdict = "Trojan.Generic";
+  for (auto _ : state) {
+    for (std::int64_t i = 0; i < kDetectionsPerIteration; ++i) {
+      logger->LogDetection(path, digest, verdict);
+    }
+    // Concurrent calls from other threads only add to what is written.
+    logger->Flush();
+  }
+  state.SetItemsProcessed(state.iterations() * kDetectionsPerIteration);
+
+  if (state.thread_index() == 0) {
+    logger.reset();
+    dir.reset();
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_LogDetections, FileLogger)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LogDetections, AsyncFileLogger)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace scanner::bench
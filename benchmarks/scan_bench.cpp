@@ -0,0 +1,242 @@
+#include <algorithm>
+#include <cstdint>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "benchmarks/temp_directory.h"
+#include "scanner/interfaces.h"
+#include "src/scanner_lib/md5_engine.h"
+
+namespace scanner::bench {
+namespace {
+
+// Directories per level of the generated tree.
+constexpr std::size_t kFanout = 4;
+// Signatures in the database besides those of the planted samples.
+constexpr std::size_t kDecoySignatures = 10000;
+
+/** @brief The file size distribution of a generated tree. */
+enum SizeProfile : std::int64_t {
+  /** @brief 512 B to 8 KiB, like source trees and mail spools. */
+  kSmall = 0,
+  /** @brief Mostly small files and one file in a hundred of 1 to 8 MiB. */
+  kMixed = 1,
+  /** @brief 256 KiB to 2 MiB, like media and package caches. */
+  kLarge = 2,
+};
+
+std::size_t FileSize(SizeProfile profile, std::size_t index) {
+  const std::size_t jitter = index * 2654435761u % 1024;
+  switch (profile) {
+    case kSmall:
+      return 512 + jitter * 7;
+    case kMixed:
+      return index % 100 == 0 ? (1 << 20) + jitter * 7168 : 512 + jitter * 7;
+    case kLarge:
+      return (256 << 10) + jitter * 1792;
+  }
+  return 0;
+}
+
+// Returns the directory of file `index` in a tree of the given depth, so
+// that files are spread evenly over the leaves.
+std::filesystem::path DirectoryOf(const std::filesystem::path& root,
+                                  std::size_t index, std::int64_t depth) {
+  std::filesystem::path dir = root;
+  for (std::int64_t level = 0; level < depth; ++level) {
+    dir /= "d" + std::to_string(index % kFanout);
+    index /= kFanout;
+  }
+  return dir;
+}
+
+// A generated tree, a database matching a share of its files, and a log.
+class ScanFixture {
+public:
+  ScanFixture(std::size_t file_count, SizeProfile profile, std::int64_t depth,
+              std::int64_t hit_percent)
+      : dir_("scan"), root_(dir_.Path() / "tree") {
+    std::ofstream csv(dir_.Path() / "base.csv");
+    for (std::size_t i = 0; i < file_count; ++i) {
+      const std::filesystem::path dir = DirectoryOf(root_, i, depth);
+      std::filesystem::create_directories(dir);
+      const std::vector<std::uint8_t> content =
+          MakeContent(FileSize(profile, i), i);
+      WriteFile(dir / ("file" + std::to_string(i) + ".bin"), content);
+      total_bytes_ += content.size();
+
+      if (static_cast<std::int64_t>(i % 100) < hit_percent) {
+        Md5Engine engine;
+        engine.Update(content.data(), content.size());
+        csv << engine.Final().ToHex() << ";Planted.Sample\n";
+        expected_detections_++;
+      }
+    }
+    for (std::size_t i = 0; i < kDecoySignatures; ++i) {
+      Md5Engine engine;
+      const std::vector<std::uint8_t> seed = MakeContent(16, ~i);
+      engine.Update(seed.data(), seed.size());
+      csv << engine.Final().ToHex() << ";Decoy\n";
+    }
+  }
+
+  // The builder owns the scanner's dependencies, so it is kept alive along
+  // with the fixture.
+  std::unique_ptr<IScanner> Build(
+      SchedulingMode scheduling = SchedulingMode::kFifo) {
+    builder_ = CreateScannerBuilder();
+    builder_->WithCsvDatabase(dir_.Path() / "base.csv")
+        .WithAsyncFileLogger(dir_.Path() / "report.log")
+        .WithMd5Hasher()
+        .WithThreads(std::max(1u, std::thread::hardware_concurrency()))
+        .WithScheduling(scheduling);
+    return builder_->Build();
+  }
+
+  // Drops the tree's files from the page cache, so that the next scan reads
+  // them from the disk. Returns false where that is not supported.
+  bool EvictFromPageCache() const {
+#ifdef __linux__
+    for (const auto& entry :
+         std::filesystem::recursive_directory_iterator(root_)) {
+      if (!entry.is_regular_file()) {
+        continue;
+      }
+      const int fd = ::open(entry.path().c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd < 0) {
+        return false;
+      }
+      // Dirty pages are not dropped, so freshly written files are synced.
+      ::fdatasync(fd);
+      const bool evicted =
+          ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+      ::close(fd);
+      if (!evicted) {
+        return false;
+      }
+    }
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  const std::filesystem::path& Root() const {
+    return root_;
+  }
+
+  std::uint64_t TotalBytes() const {
+    return total_bytes_;
+  }
+
+  std::uint64_t ExpectedDetections() const {
+    return expected_detections_;
+  }
+
+private:
+  TempDirectory dir_;
+  std::filesystem::path root_;
+  std::unique_ptr<IScannerBuilder> builder_;
+  std::uint64_t total_bytes_ = 0;
+  std::uint64_t expected_detections_ = 0;
+};
+
+// Scans a generated tree end to end through the public API. Arguments:
+// file count, SizeProfile, directory depth and the percentage of files that
+// match a signature. Files stay in the page cache after the first
+// iteration, so this measures the scanner rather than the disk.
+void BM_Scan(benchmark::State& state) {
+  ScanFixture fixture(static_cast<std::size_t>(state.range(0)),
+                            static_cast<SizeProfile>(state.range(1)),
+                            state.range(2), state.range(3));
+  const std::unique_ptr<IScanner> scanner = fixture.Build();
+
+  ScanResult result;
+  for (auto _ : state) {
+    result = scanner->Scan(fixture.Root());
+  }
+  if (result.malicious_files_detected != fixture.ExpectedDetections() ||
+      result.errors != 0) {
+    state.SkipWithError("Scan results do not match the generated tree");
+    return;
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(fixture.TotalBytes()));
+  state.counters["detections"] =
+      static_cast<double>(result.malicious_files_detected);
+  state.counters["tail_latency_ms"] =
+      static_cast<double>(result.tail_latency.count());
+}
+
+BENCHMARK(BM_Scan)
+    ->ArgNames({"files", "profile", "depth", "hit_pct"})
+    ->Args({1000, kSmall, 2, 0})
+    ->Args({10000, kSmall, 2, 0})
+    ->Args({10000, kSmall, 6, 0})
+    ->Args({10000, kSmall, 2, 10})
+    ->Args({10000, kMixed, 3, 1})
+    ->Args({1000, kLarge, 2, 1})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// Scans a generated tree with every file evicted from the page cache before
+// each iteration (Linux only). Arguments: file count, SizeProfile and the
+// SchedulingMode. Files are created round-robin over the leaf directories,
+// so the walk meets them in a different order than they were allocated on
+// disk; the disk-order modes undo that. Only a spinning disk shows the full
+// effect, an SSD or a RAM-backed temporary directory little of it.
+void BM_ScanColdCache(benchmark::State& state) {
+  ScanFixture fixture(static_cast<std::size_t>(state.range(0)),
+                      static_cast<SizeProfile>(state.range(1)), 2, 1);
+  const std::unique_ptr<IScanner> scanner =
+      fixture.Build(static_cast<SchedulingMode>(state.range(2)));
+
+  ScanResult result;
+  for (auto _ : state) {
+    state.PauseTiming();
+    const bool evicted = fixture.EvictFromPageCache();
+    state.ResumeTiming();
+    if (!evicted) {
+      state.SkipWithError("Cannot evict files from the page cache");
+      return;
+    }
+    result = scanner->Scan(fixture.Root());
+  }
+  if (result.malicious_files_detected != fixture.ExpectedDetections() ||
+      result.errors != 0) {
+    state.SkipWithError("Scan results do not match the generated tree");
+    return;
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(fixture.TotalBytes()));
+}
+
+BENCHMARK(BM_ScanColdCache)
+    ->ArgNames({"files", "profile", "schedule"})
+    ->Apply([](benchmark::internal::Benchmark* benchmark) {
+      for (const SchedulingMode mode :
+           {SchedulingMode::kFifo, SchedulingMode::kInodeOrder,
+            SchedulingMode::kExtentOrder}) {
+        benchmark->Args({10000, kSmall, static_cast<std::int64_t>(mode)});
+        benchmark->Args({1000, kLarge, static_cast<std::int64_t>(mode)});
+      }
+    })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace scanner::bench
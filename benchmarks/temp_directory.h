@@ -0,0 +1,72 @@
+#ifndef BENCHMARKS_TEMP_DIRECTORY_H_
+#define BENCHMARKS_TEMP_DIRECTORY_H_
+
+#include <cstdint>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace scanner::bench {
+
+/**
+ * @class TempDirectory
+ * @brief A scratch directory for benchmark fixtures, removed on destruction.
+ */
+class TempDirectory {
+public:
+  explicit TempDirectory(const std::string& name)
+      : path_(std::filesystem::temp_directory_path() /
+              ("scanner_bench_" + name)) {
+    std::error_code ec;
+    std::filesystem::remove_all(path_, ec);
+    std::filesystem::create_directories(path_);
+  }
+
+  ~TempDirectory() {
+    std::error_code ec;
+    std::filesystem::remove_all(path_, ec);
+  }
+
+  TempDirectory(const TempDirectory&) = delete;
+  TempDirectory& operator=(const TempDirectory&) = delete;
+
+  const std::filesystem::path& Path() const {
+    return path_;
+  }
+
+private:
+  std::filesystem::path path_;
+};
+
+/**
+ * @brief Fills a buffer with deterministic, incompressible-looking bytes.
+ * @param size The number of bytes.
+ * @param seed Distinguishes the contents of different files.
+ */
+inline std::vector<std::uint8_t> MakeContent(std::size_t size,
+                                             std::uint64_t seed) {
+  std::vector<std::uint8_t> content(size);
+  std::uint64_t state = seed * 0x9E3779B97F4A7C15ULL + 1;
+  for (std::uint8_t& byte : content) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    byte = static_cast<std::uint8_t>(state);
+  }
+  return content;
+}
+
+/** @brief Writes a buffer to a file, replacing it. */
+inline void WriteFile(const std::filesystem::path& path,
+                      const std::vector<std::uint8_t>& content) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char*>(content.data()),
+             static_cast<std::streamsize>(content.size()));
+}
+
+}  // namespace scanner::bench
+
+#endif  // BENCHMARKS_TEMP_DIRECTORY_H_
@@ -0,0 +1,101 @@
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmarks/legacy_thread_pool.h"
+#include "src/scanner_lib/thread_pool.h"
+
+namespace scanner::bench {
+namespace {
+
+constexpr std::int64_t kTasksPerIteration = 10000;
+
+// A task body small enough for dispatch overhead to dominate.
+void TinyTask(std::atomic<std::int64_t>& remaining) {
+  benchmark::DoNotOptimize(remaining.fetch_sub(1, std::memory_order_acq_rel));
+}
+
+void WaitForZero(const std::atomic<std::int64_t>& remaining) {
+  while (remaining.load(std::memory_order_acquire) > 0) {
+    std::this_thread::yield();
+  }
+}
+
+void SetCounters(benchmark::State& state) {
+  state.SetItemsProcessed(state.iterations() * kTasksPerIteration);
+}
+
+void BM_LegacyPoolEnqueue(benchmark::State& state) {
+  LegacyThreadPool pool(static_cast<std::size_t>(state.range(0)));
+  std::atomic<std::int64_t> remaining{0};
+  for (auto _ : state) {
+    remaining.store(kTasksPerIteration);
+    for (std::int64_t i = 0; i < kTasksPerIteration; ++i) {
+      pool.Enqueue([&remaining] { TinyTask(remaining); });
+    }
+    WaitForZero(remaining);
+  }
+  SetCounters(state);
+}
+
+void BM_ThreadPoolEnqueue(benchmark::State& state) {
+  ThreadPool pool(static_cast<std::size_t>(state.range(0)));
+  std::atomic<std::int64_t> remaining{0};
+  for (auto _ : state) {
+    remaining.store(kTasksPerIteration);
+    for (std::int64_t i = 0; i < kTasksPerIteration; ++i) {
+      pool.Enqueue([&remaining] { TinyTask(remaining); });
+    }
+    WaitForZero(remaining);
+  }
+  SetCounters(state);
+}
+
+void BM_ThreadPoolSubmit(benchmark::State& state) {
+  ThreadPool pool(static_cast<std::size_t>(state.range(0)));
+  std::atomic<std::int64_t> remaining{0};
+  for (auto _ : state) {
+    remaining.store(kTasksPerIteration);
+    for (std::int64_t i = 0; i < kTasksPerIteration; ++i) {
+      pool.Submit([&remaining] { TinyTask(remaining); });
+    }
+    WaitForZero(remaining);
+  }
+  SetCounters(state);
+}
+
+// Tasks submitted from inside a worker go to its lock-free deque and are
+// spread by stealing, as in a parallel directory walk.
+void BM_ThreadPoolSubmitFromWorker(benchmark::State& state) {
+  ThreadPool pool(static_cast<std::size_t>(state.range(0)));
+  std::atomic<std::int64_t> remaining{0};
+  for (auto _ : state) {
+    remaining.store(kTasksPerIteration);
+    pool.Submit([&pool, &remaining] {
+      for (std::int64_t i = 0; i < kTasksPerIteration; ++i) {
+        pool.Submit([&remaining] { TinyTask(remaining); });
+      }
+    });
+    WaitForZero(remaining);
+  }
+  SetCounters(state);
+}
+
+void ThreadCounts(benchmark::internal::Benchmark* benchmark) {
+  const auto max_threads = static_cast<std::int64_t>(
+      std::max(1u, std::thread::hardware_concurrency()));
+  for (std::int64_t threads = 1; threads <= max_threads; threads *= 2) {
+    benchmark->Arg(threads);
+  }
+  benchmark->ArgName("threads")->UseRealTime();
+}
+
+BENCHMARK(BM_LegacyPoolEnqueue)->Apply(ThreadCounts);
+BENCHMARK(BM_ThreadPoolEnqueue)->Apply(ThreadCounts);
+BENCHMARK(BM_ThreadPoolSubmit)->Apply(ThreadCounts);
+BENCHMARK(BM_ThreadPoolSubmitFromWorker)->Apply(ThreadCounts);
+
+}  // namespace
+}  // namespace scanner::bench
@@ -3,14 +3,383 @@
 
 #include <chrono>
 #include <cstdint>
+#include <cstring>
 
+#include <array>
+#include <filesystem>
 #include <iostream>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
 
 #include "scanner/visibility.h"
 
 namespace scanner {
 
+/**
+ * @struct Md5Digest
+ * @brief A 16-byte binary MD5 digest.
+ *
+ * A trivially copyable value type used to carry hashes through the scanning
+ * pipeline without heap allocations. Conversion to hexadecimal text only
+ * happens when a digest has to be presented, e.g., in a detection log entry.
+ */
+struct SCANNER_API Md5Digest {
+  /** @brief The size of an MD5 digest in bytes. */
+  static constexpr std::size_t kSize = 16;
+
+  std::array<std::uint8_t, kSize> bytes{};
+
+  /**
+   * @brief Parses a digest from its hexadecimal representation.
+   * @param hex Exactly 32 hexadecimal characters (case-insensitive).
+   * @return The parsed digest, or std::nullopt if the input is malformed.
+   */
+  static std::optional<Md5Digest> FromHex(std::string_view hex);
+
+  /**
+   * @brief Formats the digest as lowercase hexadecimal.
+   * @return A 32-character string.
+   */
+  std::string ToHex() const;
+};
+
+inline bool operator==(const Md5Digest& lhs, const Md5Digest& rhs) {
+  return lhs.bytes == rhs.bytes;
+}
+
+inline bool operator!=(const Md5Digest& lhs, const Md5Digest& rhs) {
+  return !(lhs == rhs);
+}
+
+/**
+ * @struct Sha1Digest
+ * @brief A 20-byte binary SHA-1 digest.
+ */
+struct SCANNER_API Sha1Digest {
+  /** @brief The size of a SHA-1 digest in bytes. */
+  static constexpr std::size_t kSize = 20;
+
+  std::array<std::uint8_t, kSize> bytes{};
+
+  /**
+   * @brief Parses a digest from its hexadecimal representation.
+   * @param hex Exactly 40 hexadecimal characters (case-insensitive).
+   * @return The parsed digest, or std::nullopt if the input is malformed.
+   */
+  static std::optional<Sha1Digest> FromHex(std::string_view hex);
+
+  /** @brief Formats the digest as 40 lowercase hexadecimal characters. */
+  std::string ToHex() const;
+};
+
+inline bool operator==(const Sha1Digest& lhs, const Sha1Digest& rhs) {
+  return lhs.bytes == rhs.bytes;
+}
+
+inline bool operator!=(const Sha1Digest& lhs, const Sha1Digest& rhs) {
+  return !(lhs == rhs);
+}
+
+/**
+ * @struct Sha256Digest
+ * @brief A 32-byte binary SHA-256 digest.
+ */
+struct SCANNER_API Sha256Digest {
+  /** @brief The size of a SHA-256 digest in bytes. */
+  static constexpr std::size_t kSize = 32;
+
+  std::array<std::uint8_t, kSize> bytes{};
+
+  /**
+   * @brief Parses a digest from its hexadecimal representation.
+   * @param hex Exactly 64 hexadecimal characters (case-insensitive).
+   * @return The parsed digest, or std::nullopt if the input is malformed.
+   */
+  static std::optional<Sha256Digest> FromHex(std::string_view hex);
+
+  /** @brief Formats the digest as 64 lowercase hexadecimal characters. */
+  std::string ToHex() const;
+};
+
+inline bool operator==(const Sha256Digest& lhs, const Sha256Digest& rhs) {
+  return lhs.bytes == rhs.bytes;
+}
+
+inline bool operator!=(const Sha256Digest& lhs, const Sha256Digest& rhs) {
+  return !(lhs == rhs);
+}
+
+/**
+ * @struct DigestHash
+ * @brief Hash functor for using a digest as an unordered container key.
+ *
+ * Digest output is already uniformly distributed, so the first machine word
+ * of the digest is used directly instead of hashing the bytes again.
+ */
+struct DigestHash {
+  template <class Digest>
+  std::size_t operator()(const Digest& digest) const noexcept {
+    static_assert(Digest::kSize >= sizeof(std::size_t));
+    std::size_t value = 0;
+    std::memcpy(&value, digest.bytes.data(), sizeof(value));
+    return value;
+  }
+};
+
+/** @brief The hash functor for Md5Digest keys. */
+using Md5DigestHash = DigestHash;
+
+/**
+ * @enum HashAlgorithm
+ * @brief Identifies a digest algorithm that signatures can be matched by.
+ */
+enum class HashAlgorithm {
+  kMd5,
+  kSha1,
+  kSha256,
+};
+
+/** @brief A digest of any of the supported algorithms. */
+using AnyDigest = std::variant<Md5Digest, Sha1Digest, Sha256Digest>;
+
+/**
+ * @brief Overload for streaming a Md5Digest as lowercase hexadecimal.
+ * @param os The output stream.
+ * @param digest The digest to print.
+ * @return A reference to the output stream.
+ */
+SCANNER_API std::ostream& operator<<(std::ostream& os, const Md5Digest& digest);
+
+/**
+ * @struct PrefilterStats
+ * @brief Describes the probabilistic filter placed in front of a hash
+ * database.
+ */
+struct PrefilterStats {
+  /** @brief The memory used by the filter in bytes. */
+  std::uint64_t memory_bytes = 0;
+  /** @brief The measured fraction of absent digests that pass the filter. */
+  double false_positive_rate = 0.0;
+};
+
+/**
+ * @struct FileCacheStats
+ * @brief Describes how often the persistent file-state cache spared a file
+ * from being hashed.
+ */
+struct FileCacheStats {
+  /** @brief Files whose digest was taken from the cache. */
+  std::uint64_t hits = 0;
+  /** @brief Files that had to be hashed. */
+  std::uint64_t misses = 0;
+};
+
+/**
+ * @brief The number of leading bytes of a sample covered by its prefix
+ * digest, the MD5 digest a signature can carry in addition to its own.
+ */
+inline constexpr std::size_t kSamplePrefixSize = 4096;
+
+/**
+ * @struct SampleIndexStats
+ * @brief Describes how many files the sample size and prefix indexes of the
+ * hash database spared from being hashed in full.
+ */
+struct SampleIndexStats {
+  /** @brief Files skipped because no sample has their size. */
+  std::uint64_t size_rejected = 0;
+  /** @brief Files whose first kSamplePrefixSize bytes were hashed first. */
+  std::uint64_t prefix_checked = 0;
+  /** @brief Files skipped because no sample starts with the same bytes. */
+  std::uint64_t prefix_rejected = 0;
+};
+
+/**
+ * @enum IoStrategy
+ * @brief Selects how file contents are read for hashing.
+ */
+enum class IoStrategy {
+  /**
+   * @brief Reads files with positioned reads, the strategy that is safe for
+   * files changing size while they are read; currently kPread.
+   */
+  kAuto,
+  /**
+   * @brief Maps the file and hints the kernel for sequential access.
+   *
+   * Opt-in: a mapped file truncated by another process raises SIGBUS. While
+   * a mapping is read, the library therefore installs a process-wide SIGBUS
+   * handler, once, which turns such faults into a read error for the file
+   * and passes all other SIGBUS signals on to the handler installed before
+   * it. Programs that manage SIGBUS themselves should not select this
+   * strategy.
+   */
+  kMmap,
+  /** @brief Reads the file with positioned reads into a per-thread buffer. */
+  kPread,
+  /** @brief Reads the file with plain reads of IoOptions::read_block_size. */
+  kRead,
+  /**
+   * @brief Reads batches of small files through io_uring, keeping all their
+   * opens and reads in flight at once. Other files are read as with kAuto.
+   * Falls back to kAuto where io_uring is unavailable.
+   */
+  kIoUring,
+};
+
+/**
+ * @struct IoOptions
+ * @brief Configures the reading of file contents.
+ */
+struct IoOptions {
+  IoStrategy strategy = IoStrategy::kAuto;
+  /** @brief The buffer size used by IoStrategy::kRead, in bytes. */
+  std::size_t read_block_size = 256 * 1024;
+  /**
+   * @brief The io_uring submission queue size of each worker thread used by
+   * IoStrategy::kIoUring. Each queued file takes two entries.
+   */
+  std::size_t io_queue_depth = 64;
+};
+
+/**
+ * @enum WalkerMode
+ * @brief Selects how the scanned directory tree is enumerated.
+ */
+enum class WalkerMode {
+  /**
+   * @brief Every directory is listed by a task of its own, so enumeration
+   * runs on all worker threads.
+   */
+  kParallel,
+  /** @brief A single producer thread walks the tree recursively. */
+  kSequential,
+};
+
+/**
+ * @enum SchedulingMode
+ * @brief Selects the order in which discovered files are hashed.
+ */
+enum class SchedulingMode {
+  /** @brief Files are hashed roughly in the order they are found. */
+  kFifo,
+  /**
+   * @brief Files too large to be batched are hashed largest first
+   * (longest-processing-time-first), so a large file found late does not
+   * leave a single worker busy after the others went idle. Batches of small
+   * files keep flowing in discovery order.
+   */
+  kLargestFirst,
+  /**
+   * @brief Discovered files are collected in windows, and each window is
+   * read in ascending inode order. On filesystems that allocate inodes near
+   * their data (ext4, XFS), this turns the random reads of a spinning disk
+   * into mostly forward seeks. Small files are not batched.
+   */
+  kInodeOrder,
+  /**
+   * @brief Like kInodeOrder, but each window is read in the order of the
+   * physical offsets of the files' first extents, as reported by the FIEMAP
+   * ioctl (Linux only). Files without an extent map, e.g. empty files or
+   * files on filesystems without FIEMAP support, are read last in each
+   * window, in discovery order.
+   */
+  kExtentOrder,
+};
+
+/**
+ * @struct TraversalFilter
+ * @brief Restricts which parts of the scanned tree are enumerated.
+ *
+ * Glob patterns use `*` and `?` within a path component, `[...]` for a
+ * character class (`[!...]` negated) and `**` for any number of components.
+ * A pattern without a `/` matches the name of an entry at any depth; any
+ * other pattern matches its path relative to the scanned directory, with `/`
+ * separators. Excluded directories are pruned: they are never opened and
+ * nothing below them is visited.
+ */
+struct TraversalFilter {
+  /** @brief If not empty, only files matching one of these are scanned. */
+  std::vector<std::string> include;
+  /** @brief Files and directories matching one of these are skipped. */
+  std::vector<std::string> exclude;
+  /** @brief Files larger than this many bytes are skipped. */
+  std::optional<std::uint64_t> max_file_size;
+  /**
+   * @brief The number of directory levels below the scanned directory that
+   * are descended into; 0 scans its own files only.
+   */
+  std::optional<std::size_t> max_depth;
+  /** @brief Skips directories on other filesystems than the scanned one. */
+  bool one_file_system = false;
+};
+
+/**
+ * @enum ScanStage
+ * @brief The stages of a scan whose latency is measured per file.
+ */
+enum class ScanStage {
+  /** @brief Listing one directory (or, with the sequential walker, finding
+   * one entry). */
+  kTraversal,
+  /** @brief Opening a file. */
+  kOpen,
+  /** @brief Reading a file's content, excluding the time spent hashing it
+   * between reads. Page faults on mapped files count as hashing. */
+  kRead,
+  /** @brief Hashing a file's content, excluding opens and reads. */
+  kHash,
+  /** @brief Looking up a file's digests in the database. */
+  kLookup,
+  /** @brief Handing a detection to the logger. */
+  kLog,
+};
+
+/** @brief The number of ScanStage values. */
+inline constexpr std::size_t kScanStageCount = 6;
+
+/**
+ * @brief Returns the lowercase name of a stage, e.g. "traversal".
+ * @param stage The stage.
+ */
+SCANNER_API const char* ToString(ScanStage stage);
+
+/**
+ * @struct StageLatency
+ * @brief Summarizes the latency distribution of one scan stage.
+ *
+ * Percentiles are taken from a log-linear histogram and are accurate to
+ * within about 6%.
+ */
+struct StageLatency {
+  /** @brief The number of measured operations. */
+  std::uint64_t count = 0;
+  /** @brief The sum of all measured latencies. */
+  std::chrono::nanoseconds total{0};
+  std::chrono::nanoseconds p50{0};
+  std::chrono::nanoseconds p90{0};
+  std::chrono::nanoseconds p99{0};
+  std::chrono::nanoseconds max{0};
+};
+
+/**
+ * @struct ScanMetrics
+ * @brief Per-stage latencies and throughput of a scan.
+ */
+struct ScanMetrics {
+  /** @brief The bytes read from files that were hashed. */
+  std::uint64_t bytes_read = 0;
+  /** @brief Processed files per second of wall time. */
+  double files_per_second = 0.0;
+  /** @brief Bytes read per second of wall time, in units of 10^6 bytes. */
+  double megabytes_per_second = 0.0;
+  /** @brief The latencies, indexed by ScanStage. */
+  std::array<StageLatency, kScanStageCount> stages{};
+};
+
 /**
  * @struct ScanResult
  * @brief Holds the final statistics of a completed scan operation.
@@ -20,6 +389,29 @@ struct ScanResult {
   std::uint64_t malicious_files_detected = 0;
   std::uint64_t errors = 0;
   std::chrono::milliseconds execution_time{0};
+  /** @brief The largest number of tasks that were waiting for a worker. */
+  std::uint64_t peak_queue_depth = 0;
+  /**
+   * @brief The time from the last file handed to the workers until all files
+   * were processed; the part of the scan not overlapped by the traversal.
+   */
+  std::chrono::milliseconds tail_latency{0};
+  /**
+   * @brief Paths that were not hashed because another hard link to the same
+   * file was. They are still counted as processed.
+   */
+  std::uint64_t deduplicated_files = 0;
+  /** @brief The bytes that hashing the deduplicated paths would have read. */
+  std::uint64_t deduplicated_bytes = 0;
+  /** @brief Set if the hash database uses a prefilter. */
+  std::optional<PrefilterStats> prefilter;
+  /** @brief Set if the scan uses a file-state cache. */
+  std::optional<FileCacheStats> file_cache;
+  /** @brief Set if the hash database has a sample size or prefix index. */
+  std::optional<SampleIndexStats> sample_index;
+  /** @brief Set if the scan collects metrics; see
+   * IScannerBuilder::WithMetrics. */
+  std::optional<ScanMetrics> metrics;
 };
 
 /**
@@ -31,6 +423,81 @@ struct ScanResult {
 SCANNER_API std::ostream& operator<<(std::ostream& os,
                                      const ScanResult& result);
 
+/**
+ * @brief Formats a ScanResult as a single JSON object, for consumption by
+ * scripts and dashboards.
+ *
+ * Durations are given in nanoseconds, except execution_time_ms and
+ * tail_latency_ms. Optional statistics are omitted when not set.
+ *
+ * @param result The ScanResult to format.
+ * @return The JSON text, without a trailing newline.
+ */
+SCANNER_API std::string ToJson(const ScanResult& result);
+
+/**
+ * @struct ScanProgress
+ * @brief A snapshot of a running scan; see IScanner::SetProgressObserver.
+ */
+struct ScanProgress {
+  /** @brief The regular files the traversal has found so far. */
+  std::uint64_t files_discovered = 0;
+  /** @brief Set once every directory has been listed, so that
+   * files_discovered is final. */
+  bool traversal_complete = false;
+  /** @brief The files that have been processed, as in ScanResult. */
+  std::uint64_t files_processed = 0;
+  /** @brief The size of the processed files whose size is known, counting
+   * each path like files_processed does, hard links deduplicated from
+   * hashing included. */
+  std::uint64_t bytes_processed = 0;
+  std::uint64_t malicious_files_detected = 0;
+  std::uint64_t errors = 0;
+  /** @brief The time since the scan started. */
+  std::chrono::milliseconds elapsed{0};
+  /** @brief Files processed per second since the previous snapshot. */
+  double files_per_second = 0.0;
+  /** @brief Bytes processed per second since the previous snapshot. */
+  double bytes_per_second = 0.0;
+  /**
+   * @brief The estimated time until the scan completes, from the files left
+   * and the average rate so far. Unset until the traversal is complete.
+   */
+  std::optional<std::chrono::seconds> eta;
+};
+
+/**
+ * @brief Formats a ScanProgress as a single line, without a trailing newline.
+ * @param os The output stream.
+ * @param progress The ScanProgress to print.
+ * @return A reference to the output stream.
+ */
+SCANNER_API std::ostream& operator<<(std::ostream& os,
+                                     const ScanProgress& progress);
+
+/**
+ * @brief Formats a ScanProgress as a single JSON object. The ETA is omitted
+ * when not known.
+ * @param progress The ScanProgress to format.
+ * @return The JSON text, without a trailing newline.
+ */
+SCANNER_API std::string ToJson(const ScanProgress& progress);
+
+/**
+ * @struct Detection
+ * @brief A malicious file found by a scan; see IDetectionChannel.
+ */
+struct Detection {
+  /** @brief The path of the file. */
+  std::filesystem::path path;
+  /** @brief The digest of the file that matched the signature. */
+  AnyDigest digest;
+  /** @brief The verdict from the hash database. */
+  std::string verdict;
+  /** @brief The size of the file in bytes, or 0 if it could not be read. */
+  std::uint64_t size = 0;
+};
+
 }  // namespace scanner
 
 #endif  // SCANNER_DOMAIN_H_
\ No newline at end of file
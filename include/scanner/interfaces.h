@@ -1,7 +1,13 @@
 #ifndef SCANNER_INTERFACES_H_
 #define SCANNER_INTERFACES_H_
 
+#include <chrono>
+#include <cstdint>
+
+#include <exception>
 #include <filesystem>
+#include <istream>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -11,6 +17,21 @@
 
 namespace scanner {
 
+/**
+ * @struct FileHashResult
+ * @brief The outcome of hashing one file of a batch.
+ */
+struct FileHashResult {
+  /** @brief Set unless the hasher computes SHA-256 only. */
+  std::optional<Md5Digest> md5;
+  /** @brief Set if the hasher is configured to compute SHA-1 as well. */
+  std::optional<Sha1Digest> sha1;
+  /** @brief Set if the hasher is configured to compute SHA-256. */
+  std::optional<Sha256Digest> sha256;
+  /** @brief Set if the file could not be hashed; digests are unset then. */
+  std::exception_ptr error;
+};
+
 /**
  * @interface IFileHasher
  * @brief Defines the contract for a component that can hash a file's content.
@@ -22,10 +43,64 @@ public:
   /**
    * @brief Calculates the hash of a given file.
    * @param file_path The path to the file to be hashed.
-   * @return A string representing the hexadecimal hash of the file.
+   * @return The binary digest of the file's content.
    * @throws std::runtime_error if the file cannot be opened or read.
    */
-  virtual std::string HashFile(const std::filesystem::path& file_path) = 0;
+  virtual Md5Digest HashFile(const std::filesystem::path& file_path) = 0;
+
+  /**
+   * @brief Calculates every digest the hasher is configured for, reading the
+   * file once.
+   *
+   * The default implementation computes only the MD5 digest with HashFile.
+   *
+   * @param file_path The path to the file to be hashed.
+   * @param result Receives the digests; its error is left untouched.
+   * @throws std::runtime_error if the file cannot be opened or read.
+   */
+  virtual void HashFileDigests(const std::filesystem::path& file_path,
+                               FileHashResult& result) {
+    result.md5 = HashFile(file_path);
+  }
+
+  /**
+   * @brief Calculates the hashes of several files in one call.
+   *
+   * Implementations can use this to hash files concurrently, e.g., one file
+   * per SIMD lane. The default implementation calls HashFile for each path.
+   * Failures are reported per file rather than thrown.
+   *
+   * @param file_paths The files to hash.
+   * @param results Resized to match file_paths and filled in order.
+   */
+  virtual void HashFiles(const std::vector<std::filesystem::path>& file_paths,
+                         std::vector<FileHashResult>& results) {
+    results.resize(file_paths.size());
+    for (std::size_t i = 0; i < file_paths.size(); ++i) {
+      try {
+        results[i].md5 = HashFile(file_paths[i]);
+        results[i].error = nullptr;
+      } catch (...) {
+        results[i].error = std::current_exception();
+      }
+    }
+  }
+
+  /**
+   * @brief Returns how many files HashFiles should receive per call.
+   * @return The preferred batch size; 1 means batching brings no benefit.
+   */
+  virtual std::size_t PreferredBatchSize() const {
+    return 1;
+  }
+
+  /**
+   * @brief Returns the largest file worth hashing as part of a batch.
+   * @return The size limit in bytes; larger files go through HashFile.
+   */
+  virtual std::uintmax_t MaxBatchedFileSize() const {
+    return 0;
+  }
 };
 
 /**
@@ -46,12 +121,82 @@ public:
 
   /**
    * @brief Looks up a hash to see if it is in the database.
-   * @param hash The hash string to look up.
+   * @param hash The digest to look up.
    * @return An optional containing the verdict if the hash is found, otherwise
    * std::nullopt.
    */
-  virtual std::optional<std::string> FindHash(
-      const std::string& hash) const = 0;
+  virtual std::optional<std::string> FindHash(const Md5Digest& hash) const = 0;
+
+  /**
+   * @brief Looks up a SHA-1 digest. Databases holding only MD5 signatures
+   * need not override it.
+   * @param hash The digest to look up.
+   * @return The verdict if the digest is found, otherwise std::nullopt.
+   */
+  virtual std::optional<std::string> FindSha1(const Sha1Digest& hash) const {
+    (void)hash;
+    return std::nullopt;
+  }
+
+  /**
+   * @brief Looks up a SHA-256 digest. Databases holding only MD5 signatures
+   * need not override it.
+   * @param hash The digest to look up.
+   * @return The verdict if the digest is found, otherwise std::nullopt.
+   */
+  virtual std::optional<std::string> FindSha256(
+      const Sha256Digest& hash) const {
+    (void)hash;
+    return std::nullopt;
+  }
+
+  /**
+   * @brief Tells whether the database knows the size of every sample, so
+   * that MayMatchSize can rule files out.
+   * @return True if MayMatchSize is worth consulting before hashing.
+   */
+  virtual bool HasSizeIndex() const {
+    return false;
+  }
+
+  /**
+   * @brief Tells whether a file of the given size can match a signature.
+   * @param size The file size in bytes.
+   * @return False only if no sample has this size.
+   */
+  virtual bool MayMatchSize(std::uint64_t size) const {
+    (void)size;
+    return true;
+  }
+
+  /**
+   * @brief Tells whether the database knows the prefix digest of every
+   * sample larger than kSamplePrefixSize, so that MayMatchPrefix can rule
+   * files out.
+   * @return True if MayMatchPrefix is worth consulting before hashing.
+   */
+  virtual bool HasPrefixIndex() const {
+    return false;
+  }
+
+  /**
+   * @brief Tells whether a file larger than kSamplePrefixSize can match a
+   * signature, given the MD5 digest of its first kSamplePrefixSize bytes.
+   * @param prefix_digest The digest of the file's leading bytes.
+   * @return False only if no sample starts with the same bytes.
+   */
+  virtual bool MayMatchPrefix(const Md5Digest& prefix_digest) const {
+    (void)prefix_digest;
+    return true;
+  }
+
+  /**
+   * @brief Describes the prefilter consulted before the exact lookup.
+   * @return The filter statistics, or std::nullopt if no prefilter is used.
+   */
+  virtual std::optional<PrefilterStats> GetPrefilterStats() const {
+    return std::nullopt;
+  }
 };
 
 /**
@@ -68,12 +213,96 @@ public:
   /**
    * @brief Logs the detection of a malicious file.
    * @param path The path to the detected file.
-   * @param hash The calculated hash of the file.
+   * @param hash The digest of the file that matched the signature.
    * @param verdict The verdict from the hash database.
    */
   virtual void LogDetection(const std::filesystem::path& path,
-                            const std::string& hash,
+                            const AnyDigest& hash,
                             const std::string& verdict) = 0;
+
+  /**
+   * @brief Blocks until every detection logged so far has been written.
+   *
+   * Called by the scanner when a scan completes. Loggers that write
+   * synchronously need not override it.
+   *
+   * @throws std::runtime_error if writing failed.
+   */
+  virtual void Flush() {
+  }
+};
+
+/**
+ * @interface IProgressObserver
+ * @brief Receives snapshots of a running scan.
+ */
+class SCANNER_API IProgressObserver {
+public:
+  virtual ~IProgressObserver() = default;
+
+  /**
+   * @brief Receives a snapshot of the scan.
+   *
+   * Called from a thread of the scanner's own, never concurrently. Blocking
+   * delays the next snapshot but not the scan. Must not throw.
+   *
+   * @param progress The state of the scan.
+   */
+  virtual void OnProgress(const ScanProgress& progress) = 0;
+};
+
+/**
+ * @interface IDetectionChannel
+ * @brief A bounded queue of detections from the scanning threads to a single
+ * consumer, which receives them while the scan runs.
+ *
+ * Create one with CreateDetectionChannel() and pass it to
+ * IScannerBuilder::WithDetectionChannel. Detections are sent in addition to
+ * being logged. The consumer calls Receive() in a loop on a thread of its own
+ * and the owner calls Close() once the last scan has returned.
+ */
+class SCANNER_API IDetectionChannel {
+public:
+  virtual ~IDetectionChannel() = default;
+
+  /**
+   * @brief Queues a detection. Thread-safe.
+   *
+   * The detection is copied into a slot of the channel, which keeps the
+   * buffers of earlier detections, so a steady stream of detections does not
+   * allocate. Blocks while the channel is full, until the consumer makes
+   * space or the channel is closed.
+   *
+   * @param path The path of the file.
+   * @param digest The digest of the file that matched the signature.
+   * @param verdict The verdict from the hash database.
+   * @param size The size of the file in bytes.
+   * @return False if the channel was closed before the detection was
+   * queued; the detection is dropped. A detection for which Send() returns
+   * true is always received.
+   */
+  virtual bool Send(const std::filesystem::path& path, const AnyDigest& digest,
+                    const std::string& verdict, std::uint64_t size) = 0;
+
+  /**
+   * @brief Receives the oldest queued detections. Single consumer only.
+   *
+   * Blocks until at least one detection is queued or the channel is closed.
+   * The received detections are swapped with the slots they were queued in,
+   * so passing the same batch again hands its buffers back to the channel.
+   *
+   * @param batch Replaced by the received detections, in the order sent.
+   * @param max_count The most detections to receive at once; at least 1.
+   * @return False once the channel is closed and every detection received.
+   */
+  virtual bool Receive(std::vector<Detection>& batch,
+                       std::size_t max_count) = 0;
+
+  /**
+   * @brief Closes the channel: Send() drops further detections, and
+   * Receive() returns false once the queued ones are received. Thread-safe.
+   */
+  virtual void Close() = 0;
 };
 
 /**
@@ -84,6 +313,21 @@ class SCANNER_API IScanner {
 public:
   virtual ~IScanner() = default;
 
+  /**
+   * @brief Reports the progress of every subsequent scan to an observer.
+   *
+   * While a scan runs, a snapshot is taken every interval from counters the
+   * scan maintains anyway, so the workers are not slowed down. A final
+   * snapshot follows once every file has been processed. Must not be called
+   * during a scan.
+   *
+   * @param observer The observer, or null to stop reporting. It must outlive
+   * the scans it observes.
+   * @param interval The time between snapshots.
+   */
+  virtual void SetProgressObserver(IProgressObserver* observer,
+                                   std::chrono::milliseconds interval) = 0;
+
   /**
    * @brief Recursively scans a directory for malicious files.
    *
@@ -95,6 +339,23 @@ public:
    * scan.
    */
   virtual ScanResult Scan(const std::filesystem::path& scan_path) = 0;
+
+  /**
+   * @brief Scans the files listed in a stream instead of walking a directory.
+   *
+   * The paths are read on the calling thread while the workers hash, so a
+   * list is never held in memory as a whole; reading pauses while the task
+   * queue is full. Every path is taken to name a regular file and is not
+   * stat'ed before its task runs; paths that cannot be read are reported as
+   * errors. Empty paths are skipped.
+   *
+   * @param paths The stream to read the paths from, e.g. std::cin.
+   * @param delimiter The byte ending every path; the last one may end with
+   * the stream instead. NUL by default, as written by `find -print0`.
+   * @return A ScanResult struct containing the statistics of the completed
+   * scan.
+   */
+  virtual ScanResult ScanFiles(std::istream& paths, char delimiter = '\0') = 0;
 };
 
 /**
@@ -111,6 +372,45 @@ public:
    */
   virtual IScannerBuilder& WithMd5Hasher() = 0;
 
+  /**
+   * @brief Configures the scanner to match files by their SHA-256 digest
+   * only, for databases of SHA-256 signatures.
+   *
+   * The hasher uses the SHA extensions or AVX2 lanes when the CPU has them.
+   * No MD5 digest is computed, so it cannot be combined with
+   * WithHashAlgorithms, WithFileCache or a compiled database, which are
+   * MD5-based. Replaces an MD5 hasher configured earlier, and vice versa.
+   *
+   * @return A reference to this builder for chaining.
+   */
+  virtual IScannerBuilder& WithSha256Hasher() = 0;
+
+  /**
+   * @brief Computes further digests alongside MD5, so that SHA-1 and SHA-256
+   * signatures of the database match as well.
+   *
+   * Every file is still read once: each chunk is fed to all digest engines.
+   * Applies to the hasher whether it is configured before or after this
+   * call. Cannot be combined with WithFileCache, which stores MD5 digests
+   * only, or with a compiled database, which holds MD5 signatures only.
+   *
+   * @param algorithms The algorithms to match by; MD5 is always included.
+   * @return A reference to this builder for chaining.
+   */
+  virtual IScannerBuilder& WithHashAlgorithms(
+      const std::vector<HashAlgorithm>& algorithms) = 0;
+
+  /**
+   * @brief Selects how the hasher reads file contents.
+   *
+   * Applies to the hasher whether it is configured before or after this call.
+   * Defaults to IoStrategy::kAuto.
+   *
+   * @param options The I/O strategy and its parameters.
+   * @return A reference to this builder for chaining.
+   */
+  virtual IScannerBuilder& WithIoOptions(const IoOptions& options) = 0;
+
   /**
    * @brief Configures the hash database from a CSV file.
    * @param path The path to the CSV file.
@@ -119,6 +419,32 @@ public:
   virtual IScannerBuilder& WithCsvDatabase(
       const std::filesystem::path& path) = 0;
 
+  /**
+   * @brief Configures the hash database from a compiled signature file.
+   *
+   * The file is memory-mapped rather than parsed; see
+   * CompileSignatureDatabase. It holds MD5 signatures only, so Build()
+   * rejects it together with SHA-1 or SHA-256 matching.
+   *
+   * @param path The path to the compiled database file.
+   * @return A reference to this builder for chaining.
+   */
+  virtual IScannerBuilder& WithCompiledDatabase(
+      const std::filesystem::path& path) = 0;
+
+  /**
+   * @brief Places a blocked Bloom filter in front of the hash database.
+   *
+   * The filter is built when the database is loaded and rejects most absent
+   * digests with a single cache line access. Applies to the database whether
+   * it is configured before or after this call.
+   *
+   * @param bits_per_key The filter's memory budget per signature; 0 disables
+   * the filter. Around 10 bits give a false-positive rate of about 1%.
+   * @return A reference to this builder for chaining.
+   */
+  virtual IScannerBuilder& WithPrefilter(std::size_t bits_per_key) = 0;
+
   /**
    * @brief Configures the logger to write to a file.
    * @param path The path to the log file.
@@ -127,6 +453,19 @@ public:
   virtual IScannerBuilder& WithFileLogger(
       const std::filesystem::path& path) = 0;
 
+  /**
+   * @brief Configures the logger to write to a file from a background thread.
+   *
+   * Workers hand detections to a lock-free ring instead of contending on the
+   * file; a writer thread writes them in batches. Every detection is written
+   * by the time Scan() returns.
+   *
+   * @param path The path to the log file.
+   * @return A reference to this builder for chaining.
+   */
+  virtual IScannerBuilder& WithAsyncFileLogger(
+      const std::filesystem::path& path) = 0;
+
   /**
    * @brief Sets the number of threads for the scanner.
    * @param num_threads The number of threads to use.
@@ -134,6 +473,125 @@ public:
    */
   virtual IScannerBuilder& WithThreads(std::size_t num_threads) = 0;
 
+  /**
+   * @brief Bounds the number of tasks waiting for a worker.
+   *
+   * The directory traversal pauses while the bound is reached, so memory use
+   * stays flat regardless of the size of the scanned tree.
+   *
+   * @param max_queued_tasks The high-water mark; 0 means unbounded.
+   * @return A reference to this builder for chaining.
+   */
+  virtual IScannerBuilder& WithMaxQueuedTasks(
+      std::size_t max_queued_tasks) = 0;
+
+  /**
+   * @brief Selects how the directory tree is enumerated.
+   *
+   * Defaults to WalkerMode::kParallel; WalkerMode::kSequential keeps the
+   * single producer thread, e.g., for comparison.
+   *
+   * @param mode The walker mode.
+   * @return A reference to this builder for chaining.
+   */
+  virtual IScannerBuilder& WithWalkerMode(WalkerMode mode) = 0;
+
+  /**
+   * @brief Selects the order in which discovered files are hashed.
+   *
+   * Defaults to SchedulingMode::kFifo. SchedulingMode::kLargestFirst shortens
+   * scans whose duration is dominated by a few large files; compare the
+   * reported tail latency. SchedulingMode::kInodeOrder and kExtentOrder cut
+   * the seeks of scans from a spinning disk with a cold page cache.
+   *
+   * @param mode The scheduling mode.
+   * @return A reference to this builder for chaining.
+   */
+  virtual IScannerBuilder& WithScheduling(SchedulingMode mode) = 0;
+
+  /**
+   * @brief Sets how many discovered files are collected and sorted together
+   * with SchedulingMode::kInodeOrder and kExtentOrder.
+   *
+   * Larger windows find longer runs of neighbouring files but hold back the
+   * first reads until the window is full. Defaults to 1024; Build() throws
+   * if it is 0.
+   *
+   * @param files The number of files per window.
+   * @return A reference to this builder for chaining.
+   */
+  virtual IScannerBuilder& WithReadOrderWindow(std::size_t files) = 0;
+
+  /**
+   * @brief Enables incremental scanning with a persistent file-state cache.
+   *
+   * The cache maps each file's (device, inode, size, mtime, ctime) to the
+   * digest computed by the previous scan, so unchanged files are not read
+   * again. Cached digests are still looked up in the current database. The
+   * cache is loaded by Build() and saved at the end of every scan whose walk
+   * completed, keeping the entries of files outside the scanned directory; it
+   * is a no-op on platforms without inode numbers (Windows).
+   *
+   * @param path The cache file; it is created if it does not exist.
+   * @return A reference to this builder for chaining.
+   */
+  virtual IScannerBuilder& WithFileCache(
+      const std::filesystem::path& path) = 0;
+
+  /**
+   * @brief Measures the latency of every scan stage and the throughput.
+   *
+   * Each thread records into histograms of its own, so the cost is two clock
+   * reads per measured operation. The results are reported in
+   * ScanResult::metrics. Build() throws if the library was compiled with
+   * SCANNER_ENABLE_METRICS off.
+   *
+   * @return A reference to this builder for chaining.
+   */
+  virtual IScannerBuilder& WithMetrics() = 0;
+
+  /**
+   * @brief Traces the spans of every scan thread into a Chrome trace.
+   *
+   * Each thread records the enqueueing and queueing of tasks, the tasks
+   * themselves with their file paths, and the traversal, open, read, hash,
+   * lookup and log spans within them into a buffer of its own. At the end of
+   * every scan, the buffers are written to the file, which chrome://tracing
+   * and Perfetto open. Build() throws if the library was compiled with
+   * SCANNER_ENABLE_METRICS off.
+   *
+   * @param path The file the trace is written to; it is overwritten.
+   * @return A reference to this builder for chaining.
+   */
+  virtual IScannerBuilder& WithTrace(const std::filesystem::path& path) = 0;
+
+  /**
+   * @brief Restricts the directory traversal of Scan() by glob patterns, file
+   * size, depth and filesystem.
+   *
+   * The rules are compiled once and applied to the entries as they are
+   * listed, so excluded directories are never opened. Files passed to
+   * IScanner::ScanFiles are not filtered. Build() throws if a pattern is
+   * empty.
+   *
+   * @param filter The rules; see TraversalFilter.
+   * @return A reference to this builder for chaining.
+   */
+  virtual IScannerBuilder& WithTraversalFilter(
+      const TraversalFilter& filter) = 0;
+
+  /**
+   * @brief Sends every detection to a channel as well as to the logger.
+   *
+   * The scanner shares ownership of the channel but never closes it, so that
+   * one channel can serve several scans.
+   *
+   * @param channel The channel, e.g. from CreateDetectionChannel().
+   * @return A reference to this builder for chaining.
+   */
+  virtual IScannerBuilder& WithDetectionChannel(
+      std::shared_ptr<IDetectionChannel> channel) = 0;
+
   /**
    * @brief Builds the final IScanner instance.
    * @return A unique pointer to the configured IScanner.
@@ -145,6 +603,36 @@ public:
 /** @brief Factory function to create a scanner builder instance. */
 SCANNER_API std::unique_ptr<IScannerBuilder> CreateScannerBuilder();
 
+/**
+ * @brief Creates a detection channel.
+ * @param capacity The number of detections the channel holds before Send()
+ * blocks; rounded up to a power of two.
+ * @return The channel, to pass to IScannerBuilder::WithDetectionChannel.
+ */
+SCANNER_API std::shared_ptr<IDetectionChannel> CreateDetectionChannel(
+    std::size_t capacity = 1024);
+
+/**
+ * @brief Compiles a CSV signature database into the binary, memory-mappable
+ * format used by IScannerBuilder::WithCompiledDatabase.
+ *
+ * Hashes are stored as sorted 16-byte digests and verdicts are interned into
+ * a shared string table. The format holds MD5 signatures only; SHA-1 and
+ * SHA-256 lines are skipped with a warning. Sample sizes and prefix digests
+ * are stored as well if every signature gives them, so that the scanner can
+ * rule files out before hashing them. The output is written to a
+ * temporary file and then renamed over @p output_path.
+ *
+ * @param csv_path The path to the source CSV database.
+ * @param output_path The path of the compiled database to write.
+ * @return The number of unique signatures written.
+ * @throws std::runtime_error if the source cannot be read or the output
+ * cannot be written.
+ */
+SCANNER_API std::size_t CompileSignatureDatabase(
+    const std::filesystem::path& csv_path,
+    const std::filesystem::path& output_path);
+
 }  // namespace scanner
 
 #endif  // SCANNER_INTERFACES_H_
\ No newline at end of file
@@ -1,3 +1,4 @@
+import argparse
 import os
 import sys
 import subprocess
@@ -15,6 +16,13 @@ MALICIOUS_PERCENTAGE = 0.01  # 1% of files will be malicious
 FILE_MIN_SIZE_KB = 1
 FILE_MAX_SIZE_KB = 128
 
+IO_STRATEGIES = ["auto", "mmap", "pread", "read", "io_uring"]
+WALKER_MODES = ["sequential", "parallel"]
+SCHEDULING_MODES = ["fifo", "largest-first", "inode", "extent"]
+# Added by --compare-schedules to make the tail of the scan visible.
+NUM_LARGE_FILES = 4
+LARGE_FILE_SIZE_MB = 256
+
 MALICIOUS_CONTENT = {
     "EVIL": "179052c9c6165bf25917781fc5816993;Exploit",
     "MALWARE": "b867e23836356d568aadfe4a2fe9b0e1;Dropper",
@@ -80,8 +88,11 @@ def create_benchmark_data(root_dir):
     return scan_dir, base_path, log_path
 
 
-def run_benchmark(scanner_exe, scan_dir, base_path, log_path):
-    """Runs the scanner and measures its performance."""
+def run_benchmark(scanner_exe, scan_dir, base_path, log_path, extra_args=()):
+    """Runs the scanner and measures its performance.
+
+    Returns the wall-clock duration in seconds, or None if the scanner failed.
+    """
     if not Path(scanner_exe).exists():
         print(f"Error: Scanner executable not found at '{scanner_exe}'")
         print("Please build the 'scanner' target first.")
@@ -95,6 +106,7 @@ def run_benchmark(scanner_exe, scan_dir, base_path, log_path):
         str(base_path),
         "--log",
         str(log_path),
+        *extra_args,
     ]
 
     print(f"\nRunning command: {' '.join(command)}")
@@ -109,7 +121,7 @@ def run_benchmark(scanner_exe, scan_dir, base_path, log_path):
         print("Exit Code:", process.returncode)
         print("Output:\n", process.stdout)
         print("Error:\n", process.stderr)
-        return
+        return None
 
     duration = end_time - start_time
     files_per_sec = NUM_FILES / duration
@@ -119,6 +131,48 @@ def run_benchmark(scanner_exe, scan_dir, base_path, log_path):
     print(f"Total execution time: {duration:.2f} seconds")
     print(f"Performance: {files_per_sec:.2f} files/second")
     print("--------------------------")
+    return duration
+
+
+def compare_option_values(scanner_exe, scan_dir, base_path, log_path, option, values):
+    """Runs the scanner once per value of a command-line option and prints a
+    summary table.
+
+    The dataset is scanned once beforehand so that every run starts with the
+    same (warm) page cache.
+    """
+    run_benchmark(scanner_exe, scan_dir, base_path, log_path)
+
+    results = {}
+    for value in values:
+        results[value] = run_benchmark(
+            scanner_exe,
+            scan_dir,
+            base_path,
+            log_path,
+            [option, value],
+        )
+
+    print(f"\n--- {option} COMPARISON ---")
+    print(f"{'Value':<10} {'Time (s)':>10} {'Files/s':>12}")
+    for value, duration in results.items():
+        if duration is None:
+            print(f"{value:<10} {'failed':>10}")
+        else:
+            print(f"{value:<10} {duration:>10.2f} {NUM_FILES / duration:>12.2f}")
+    print("-------------------------------")
+
+
+def create_large_files(scan_dir):
+    """Adds a few large files that dominate the duration of the scan."""
+    large_dir = scan_dir / "large"
+    large_dir.mkdir(exist_ok=True)
+    block = os.urandom(1024 * 1024)
+    for i in range(NUM_LARGE_FILES):
+        with open(large_dir / f"large_{i}.dat", "wb") as f:
+            for _ in range(LARGE_FILE_SIZE_MB):
+                f.write(block)
+    print(f"Created {NUM_LARGE_FILES} files of {LARGE_FILE_SIZE_MB} MB.")
 
 
 def generate_random_content(size_kb):
@@ -141,15 +195,59 @@ def print_progress_bar(iteration, total, prefix="", suffix="", length=50, fill="
 
 
 def main():
-    if len(sys.argv) != 2:
-        print(f"Usage: python {sys.argv[0]} <path_to_scanner_executable>")
-        sys.exit(1)
+    parser = argparse.ArgumentParser(description="File scanner benchmark.")
+    parser.add_argument("scanner_exe", help="path to the scanner executable")
+    parser.add_argument(
+        "--compare-io",
+        action="store_true",
+        help="run the scan once per --io-strategy and compare the results",
+    )
+    parser.add_argument(
+        "--compare-walkers",
+        action="store_true",
+        help="run the scan once per --walker mode and compare the results",
+    )
+    parser.add_argument(
+        "--compare-schedules",
+        action="store_true",
+        help="add a few large files and compare the --schedule modes",
+    )
+    args = parser.parse_args()
 
-    scanner_exe_path = sys.argv[1]
     benchmark_root = Path("./benchmark_data").resolve()
 
     scan_dir, base_path, log_path = create_benchmark_data(benchmark_root)
-    run_benchmark(scanner_exe_path, scan_dir, base_path, log_path)
+    if args.compare_io or args.compare_walkers or args.compare_schedules:
+        if args.compare_io:
+            compare_option_values(
+                args.scanner_exe,
+                scan_dir,
+                base_path,
+                log_path,
+                "--io-strategy",
+                IO_STRATEGIES,
+            )
+        if args.compare_walkers:
+            compare_option_values(
+                args.scanner_exe,
+                scan_dir,
+                base_path,
+                log_path,
+                "--walker",
+                WALKER_MODES,
+            )
+        if args.compare_schedules:
+            create_large_files(scan_dir)
+            compare_option_values(
+                args.scanner_exe,
+                scan_dir,
+                base_path,
+                log_path,
+                "--schedule",
+                SCHEDULING_MODES,
+            )
+    else:
+        run_benchmark(args.scanner_exe, scan_dir, base_path, log_path)
 
     print("\nCleaning up benchmark data...")
     shutil.rmtree(benchmark_root)
@@ -1,9 +1,14 @@
+#include <chrono>
 #include <cstdlib>
 
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <optional>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "scanner/domain.h"
@@ -11,14 +16,58 @@
 
 namespace {
 
+// Databases produced by scanner-dbc are memory-mapped instead of parsed.
+constexpr char kCompiledDatabaseExtension[] = ".sigdb";
+
 struct Args {
   std::filesystem::path scan_path;
+  // Set instead of scan_path to scan a NUL-delimited list; "-" is stdin.
+  std::optional<std::filesystem::path> files_from;
   std::filesystem::path base_path;
   std::filesystem::path log_path;
+  std::size_t prefilter_bits_per_key = 0;
+  scanner::IoOptions io_options;
+  std::optional<std::size_t> max_queued_tasks;
+  scanner::WalkerMode walker_mode = scanner::WalkerMode::kParallel;
+  scanner::SchedulingMode scheduling = scanner::SchedulingMode::kFifo;
+  std::optional<std::size_t> read_order_window;
+  std::optional<std::filesystem::path> cache_path;
+  std::vector<scanner::HashAlgorithm> algorithms;
+  bool sha256_hasher = false;
+  bool metrics = false;
+  bool json_report = false;
+  std::optional<std::filesystem::path> trace_path;
+  std::optional<std::size_t> progress_seconds;
+  scanner::TraversalFilter filter;
+};
+
+// Prints every snapshot to stderr, keeping stdout for the report.
+class ProgressPrinter final : public scanner::IProgressObserver {
+public:
+  explicit ProgressPrinter(bool json) : json_(json) {
+  }
+
+  void OnProgress(const scanner::ScanProgress& progress) override {
+    if (json_) {
+      std::cerr << scanner::ToJson(progress) << std::endl;
+    } else {
+      std::cerr << progress << std::endl;
+    }
+  }
+
+private:
+  bool json_;
 };
 
 void PrintUsage();
 Args ParseArgs(int argc, char* argv[]);
+std::size_t ParseCount(const std::string& option, const std::string& value);
+scanner::IoStrategy ParseIoStrategy(const std::string& value);
+scanner::WalkerMode ParseWalkerMode(const std::string& value);
+scanner::SchedulingMode ParseSchedulingMode(const std::string& value);
+std::vector<scanner::HashAlgorithm> ParseAlgorithms(const std::string& value);
+std::vector<std::string> ParsePatterns(const std::string& option,
+                                       const std::string& value);
 
 }  // namespace
 
@@ -31,16 +80,68 @@ int main(int argc, char* argv[]) {
     auto builder = scanner::CreateScannerBuilder();
 
     std::cout << "Configuring scanner...\n";
-    builder->WithCsvDatabase(args.base_path)
-        .WithFileLogger(args.log_path)
-        .WithMd5Hasher();
+    if (args.base_path.extension() == kCompiledDatabaseExtension) {
+      builder->WithCompiledDatabase(args.base_path);
+    } else {
+      builder->WithCsvDatabase(args.base_path);
+    }
+    if (args.sha256_hasher) {
+      builder->WithSha256Hasher();
+    } else {
+      builder->WithMd5Hasher();
+    }
+    builder->WithHashAlgorithms(args.algorithms)
+        .WithPrefilter(args.prefilter_bits_per_key)
+        .WithAsyncFileLogger(args.log_path)
+        .WithIoOptions(args.io_options)
+        .WithWalkerMode(args.walker_mode)
+        .WithScheduling(args.scheduling)
+        .WithTraversalFilter(args.filter);
+    if (args.cache_path) {
+      builder->WithFileCache(*args.cache_path);
+    }
+    if (args.max_queued_tasks) {
+      builder->WithMaxQueuedTasks(*args.max_queued_tasks);
+    }
+    if (args.read_order_window) {
+      builder->WithReadOrderWindow(*args.read_order_window);
+    }
+    if (args.metrics) {
+      builder->WithMetrics();
+    }
+    if (args.trace_path) {
+      builder->WithTrace(*args.trace_path);
+    }
 
     auto scanner = builder->Build();
+    ProgressPrinter progress_printer(args.json_report);
+    if (args.progress_seconds) {
+      scanner->SetProgressObserver(
+          &progress_printer, std::chrono::seconds(*args.progress_seconds));
+    }
 
-    std::cout << "Scanning directory: " << args.scan_path << "\n";
-    const scanner::ScanResult result = scanner->Scan(args.scan_path);
+    scanner::ScanResult result;
+    if (!args.files_from) {
+      std::cout << "Scanning directory: " << args.scan_path << "\n";
+      result = scanner->Scan(args.scan_path);
+    } else if (*args.files_from == "-") {
+      std::cout << "Scanning files listed on stdin\n";
+      result = scanner->ScanFiles(std::cin);
+    } else {
+      std::ifstream list(*args.files_from, std::ios::binary);
+      if (!list) {
+        throw std::runtime_error("Failed to open file list: " +
+                                 args.files_from->string());
+      }
+      std::cout << "Scanning files listed in: " << *args.files_from << "\n";
+      result = scanner->ScanFiles(list);
+    }
 
-    std::cout << "\n" << result << std::endl;
+    if (args.json_report) {
+      std::cout << "\n" << scanner::ToJson(result) << std::endl;
+    } else {
+      std::cout << "\n" << result << std::endl;
+    }
   } catch (const std::exception& e) {
     std::cerr << "A critical error occurred: " << e.what() << std::endl;
     return EXIT_FAILURE;
@@ -54,11 +155,88 @@ namespace {
 void PrintUsage() {
   std::cout
       << "Usage: scanner.exe --path <scan_directory> --base <database.csv> "
-         "--log <report.log>\n";
+         "--log <report.log>\n"
+      << "       scanner.exe --files-from <list|-> --base <database.csv> "
+         "--log <report.log>\n"
+      << "       [--prefilter <bits_per_key>]\n"
+      << "       [--io-strategy <auto|mmap|pread|read|io_uring>] "
+         "[--read-block-size <bytes>]\n"
+      << "       [--io-queue-depth <entries>] [--max-queue <tasks>]\n"
+      << "       [--walker <parallel|sequential>] [--cache <file>]\n"
+      << "       [--schedule <fifo|largest-first|inode|extent>] "
+         "[--schedule-window <files>]\n"
+      << "       [--algorithms <md5,sha1,sha256>] "
+         "[--hasher <md5|sha256>] [--metrics <text|json>]\n"
+      << "       [--trace <file>] [--progress <seconds>]\n"
+      << "       [--include <globs>] [--exclude <globs>] "
+         "[--max-file-size <bytes>]\n"
+      << "       [--max-depth <levels>] [--one-file-system <on|off>]\n"
+      << "  --base also accepts a database compiled by scanner-dbc "
+         "(*.sigdb).\n"
+      << "  --prefilter places a Bloom filter in front of the database "
+         "(e.g. 10).\n"
+      << "  --io-strategy selects how files are read; auto uses pread. "
+         "mmap installs a\n"
+      << "    SIGBUS handler for files truncated while mapped. "
+         "--read-block-size applies\n"
+      << "    to 'read'.\n"
+      << "  --io-queue-depth sets the io_uring queue size per thread "
+         "(default 64).\n"
+      << "  --max-queue bounds the tasks waiting for a worker "
+         "(default 4096, 0 = unbounded).\n"
+      << "  --walker selects whether directories are listed by all worker "
+         "threads\n"
+      << "    (parallel, the default) or by a single producer thread.\n"
+      << "  --cache keeps the digests of scanned files so that unchanged "
+         "files are\n"
+      << "    not hashed again by the next scan.\n"
+      << "  --schedule largest-first hashes large files before smaller ones "
+         "found\n"
+      << "    earlier, so no single large file is left for the end.\n"
+      << "  --schedule inode and extent read every window of discovered files "
+         "in inode\n"
+      << "    or on-disk order (extent uses FIEMAP, Linux only), which cuts "
+         "the seeks\n"
+      << "    of a spinning disk; --schedule-window sets the files per window "
+         "(default\n"
+      << "    1024).\n"
+      << "  --algorithms lists the digests signatures are matched by, "
+         "computed in a\n"
+      << "    single read of each file (default md5).\n"
+      << "  --hasher sha256 matches files by their SHA-256 digest only, "
+         "using the SHA\n"
+      << "    extensions or AVX2 where available; it cannot be combined "
+         "with --algorithms,\n"
+      << "    --cache or a compiled database.\n"
+      << "  --metrics reports the latency percentiles of every scan stage "
+         "and the\n"
+      << "    throughput; json prints the whole report as a JSON object.\n"
+      << "  --trace writes the spans of every scan thread to a file in the "
+         "Chrome trace\n"
+      << "    format, for chrome://tracing or Perfetto.\n"
+      << "  --progress prints the files and bytes processed, the current rate "
+         "and the\n"
+      << "    estimated time left to stderr at the given interval, as JSON "
+         "with\n"
+      << "    --metrics json.\n"
+      << "  --files-from scans the NUL-delimited paths in a file, or on stdin "
+         "for -,\n"
+      << "    instead of walking a directory, e.g. from find -print0.\n"
+      << "  --include and --exclude take comma-separated globs (*, ?, [...], "
+         "**); a glob\n"
+      << "    without / matches names at any depth, others match paths "
+         "relative to\n"
+      << "    --path. Excluded directories are never opened. --include "
+         "applies to files.\n"
+      << "  --max-file-size skips larger files, --max-depth limits the "
+         "directory levels\n"
+      << "    descended into and --one-file-system on skips other mounted "
+         "filesystems.\n";
 }
 
 Args ParseArgs(int argc, char* argv[]) {
-  if (argc != 7) {
+  // Every option takes a value, so arguments come in pairs.
+  if (argc < 7 || argc % 2 == 0) {
     PrintUsage();
     exit(EXIT_FAILURE);
   }
@@ -68,9 +246,30 @@ Args ParseArgs(int argc, char* argv[]) {
     args_map[argv[i]] = argv[i + 1];
   }
 
+  const std::unordered_set<std::string> known_options = {
+      "--path",           "--base",          "--log",
+      "--prefilter",      "--io-strategy",   "--read-block-size",
+      "--io-queue-depth", "--max-queue",     "--walker",
+      "--cache",          "--schedule",      "--algorithms",
+      "--hasher",         "--metrics",       "--trace",
+      "--progress",       "--files-from",    "--include",
+      "--exclude",        "--max-file-size", "--max-depth",
+      "--one-file-system", "--schedule-window"};
+  for (const auto& [option, value] : args_map) {
+    if (known_options.count(option) == 0) {
+      std::cerr << "Error: Unknown option: " << option << std::endl;
+      PrintUsage();
+      exit(EXIT_FAILURE);
+    }
+  }
+
   Args args;
   try {
-    args.scan_path = args_map.at("--path");
+    if (const auto it = args_map.find("--files-from"); it != args_map.end()) {
+      args.files_from = it->second;
+    } else {
+      args.scan_path = args_map.at("--path");
+    }
     args.base_path = args_map.at("--base");
     args.log_path = args_map.at("--log");
   } catch (const std::out_of_range&) {
@@ -78,8 +277,111 @@ Args ParseArgs(int argc, char* argv[]) {
     exit(EXIT_FAILURE);
   }
 
-  if (!std::filesystem::exists(args.scan_path) ||
-      !std::filesystem::is_directory(args.scan_path)) {
+  if (const auto it = args_map.find("--prefilter"); it != args_map.end()) {
+    args.prefilter_bits_per_key = ParseCount(it->first, it->second);
+  }
+  if (const auto it = args_map.find("--io-strategy"); it != args_map.end()) {
+    args.io_options.strategy = ParseIoStrategy(it->second);
+  }
+  if (const auto it = args_map.find("--read-block-size");
+      it != args_map.end()) {
+    args.io_options.read_block_size = ParseCount(it->first, it->second);
+    if (args.io_options.read_block_size == 0) {
+      std::cerr << "Error: --read-block-size must be positive" << std::endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+  if (const auto it = args_map.find("--max-queue"); it != args_map.end()) {
+    args.max_queued_tasks = ParseCount(it->first, it->second);
+  }
+  if (const auto it = args_map.find("--cache"); it != args_map.end()) {
+    args.cache_path = it->second;
+  }
+  if (const auto it = args_map.find("--walker"); it != args_map.end()) {
+    args.walker_mode = ParseWalkerMode(it->second);
+  }
+  if (const auto it = args_map.find("--algorithms"); it != args_map.end()) {
+    args.algorithms = ParseAlgorithms(it->second);
+  }
+  if (const auto it = args_map.find("--hasher"); it != args_map.end()) {
+    if (it->second != "md5" && it->second != "sha256") {
+      std::cerr << "Error: Unknown --hasher: " << it->second << std::endl;
+      PrintUsage();
+      exit(EXIT_FAILURE);
+    }
+    args.sha256_hasher = it->second == "sha256";
+  }
+  if (const auto it = args_map.find("--metrics"); it != args_map.end()) {
+    if (it->second != "text" && it->second != "json") {
+      std::cerr << "Error: Unknown --metrics: " << it->second << std::endl;
+      PrintUsage();
+      exit(EXIT_FAILURE);
+    }
+    args.metrics = true;
+    args.json_report = it->second == "json";
+  }
+  if (const auto it = args_map.find("--trace"); it != args_map.end()) {
+    args.trace_path = it->second;
+  }
+  if (const auto it = args_map.find("--progress"); it != args_map.end()) {
+    args.progress_seconds = ParseCount(it->first, it->second);
+    if (*args.progress_seconds == 0) {
+      std::cerr << "Error: --progress must be positive" << std::endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+  if (const auto it = args_map.find("--schedule"); it != args_map.end()) {
+    args.scheduling = ParseSchedulingMode(it->second);
+  }
+  if (const auto it = args_map.find("--schedule-window");
+      it != args_map.end()) {
+    args.read_order_window = ParseCount(it->first, it->second);
+    if (*args.read_order_window == 0) {
+      std::cerr << "Error: --schedule-window must be positive" << std::endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+  if (const auto it = args_map.find("--io-queue-depth");
+      it != args_map.end()) {
+    args.io_options.io_queue_depth = ParseCount(it->first, it->second);
+    if (args.io_options.io_queue_depth < 2) {
+      std::cerr << "Error: --io-queue-depth must be at least 2" << std::endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  if (const auto it = args_map.find("--include"); it != args_map.end()) {
+    args.filter.include = ParsePatterns(it->first, it->second);
+  }
+  if (const auto it = args_map.find("--exclude"); it != args_map.end()) {
+    args.filter.exclude = ParsePatterns(it->first, it->second);
+  }
+  if (const auto it = args_map.find("--max-file-size");
+      it != args_map.end()) {
+    args.filter.max_file_size = ParseCount(it->first, it->second);
+  }
+  if (const auto it = args_map.find("--max-depth"); it != args_map.end()) {
+    args.filter.max_depth = ParseCount(it->first, it->second);
+  }
+  if (const auto it = args_map.find("--one-file-system");
+      it != args_map.end()) {
+    if (it->second != "on" && it->second != "off") {
+      std::cerr << "Error: --one-file-system expects on or off, got: "
+                << it->second << std::endl;
+      PrintUsage();
+      exit(EXIT_FAILURE);
+    }
+    args.filter.one_file_system = it->second == "on";
+  }
+
+  if (args.files_from && args_map.count("--path") != 0) {
+    std::cerr << "Error: --path and --files-from are mutually exclusive"
+              << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (!args.files_from && (!std::filesystem::exists(args.scan_path) ||
+                           !std::filesystem::is_directory(args.scan_path))) {
     std::cerr << "Error: Scan path does not exist or is not a directory: "
               << args.scan_path << std::endl;
     exit(EXIT_FAILURE);
@@ -102,4 +404,116 @@ Args ParseArgs(int argc, char* argv[]) {
   return args;
 }
 
-}  // namespace
\ No newline at end of file
+std::size_t ParseCount(const std::string& option, const std::string& value) {
+  std::size_t parsed_chars = 0;
+  unsigned long long count = 0;
+  // std::stoull accepts a sign and leading whitespace, so require a digit.
+  if (!value.empty() && value.front() >= '0' && value.front() <= '9') {
+    try {
+      count = std::stoull(value, &parsed_chars);
+    } catch (const std::exception&) {
+      parsed_chars = 0;
+    }
+  }
+  if (parsed_chars == 0 || parsed_chars != value.size()) {
+    std::cerr << "Error: " << option
+              << " expects a non-negative integer, got: " << value
+              << std::endl;
+    exit(EXIT_FAILURE);
+  }
+  return static_cast<std::size_t>(count);
+}
+
+scanner::IoStrategy ParseIoStrategy(const std::string& value) {
+  const std::unordered_map<std::string, scanner::IoStrategy> strategies = {
+      {"auto", scanner::IoStrategy::kAuto},
+      {"mmap", scanner::IoStrategy::kMmap},
+      {"pread", scanner::IoStrategy::kPread},
+      {"read", scanner::IoStrategy::kRead},
+      {"io_uring", scanner::IoStrategy::kIoUring},
+  };
+  const auto it = strategies.find(value);
+  if (it == strategies.end()) {
+    std::cerr << "Error: Unknown --io-strategy: " << value << std::endl;
+    PrintUsage();
+    exit(EXIT_FAILURE);
+  }
+  return it->second;
+}
+
+scanner::WalkerMode ParseWalkerMode(const std::string& value) {
+  const std::unordered_map<std::string, scanner::WalkerMode> modes = {
+      {"parallel", scanner::WalkerMode::kParallel},
+      {"sequential", scanner::WalkerMode::kSequential},
+  };
+  const auto it = modes.find(value);
+  if (it == modes.end()) {
+    std::cerr << "Error: Unknown --walker: " << value << std::endl;
+    PrintUsage();
+    exit(EXIT_FAILURE);
+  }
+  return it->second;
+}
+
+scanner::SchedulingMode ParseSchedulingMode(const std::string& value) {
+  const std::unordered_map<std::string, scanner::SchedulingMode> modes = {
+      {"fifo", scanner::SchedulingMode::kFifo},
+      {"largest-first", scanner::SchedulingMode::kLargestFirst},
+      {"inode", scanner::SchedulingMode::kInodeOrder},
+      {"extent", scanner::SchedulingMode::kExtentOrder},
+  };
+  const auto it = modes.find(value);
+  if (it == modes.end()) {
+    std::cerr << "Error: Unknown --schedule: " << value << std::endl;
+    PrintUsage();
+    exit(EXIT_FAILURE);
+  }
+  return it->second;
+}
+
+std::vector<scanner::HashAlgorithm> ParseAlgorithms(const std::string& value) {
+  const std::unordered_map<std::string, scanner::HashAlgorithm> names = {
+      {"md5", scanner::HashAlgorithm::kMd5},
+      {"sha1", scanner::HashAlgorithm::kSha1},
+      {"sha256", scanner::HashAlgorithm::kSha256},
+  };
+  std::vector<scanner::HashAlgorithm> algorithms;
+  std::size_t start = 0;
+  for (;;) {
+    const std::size_t end = value.find(',', start);
+    const std::string name = value.substr(start, end - start);
+    const auto it = names.find(name);
+    if (it == names.end()) {
+      std::cerr << "Error: Unknown algorithm in --algorithms: " << name
+                << std::endl;
+      PrintUsage();
+      exit(EXIT_FAILURE);
+    }
+    algorithms.push_back(it->second);
+    if (end == std::string::npos) {
+      return algorithms;
+    }
+    start = end + 1;
+  }
+}
+
+std::vector<std::string> ParsePatterns(const std::string& option,
+                                       const std::string& value) {
+  std::vector<std::string> patterns;
+  std::size_t start = 0;
+  for (;;) {
+    const std::size_t end = value.find(',', start);
+    patterns.push_back(value.substr(start, end - start));
+    if (patterns.back().empty()) {
+      std::cerr << "Error: " << option << " has an empty pattern: " << value
+                << std::endl;
+      exit(EXIT_FAILURE);
+    }
+    if (end == std::string::npos) {
+      return patterns;
+    }
+    start = end + 1;
+  }
+}
+
+}  // namespace
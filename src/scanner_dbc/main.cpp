@@ -0,0 +1,84 @@
+#include <cstdlib>
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+
+#include "scanner/interfaces.h"
+
+namespace {
+
+struct Args {
+  std::filesystem::path input_path;
+  std::filesystem::path output_path;
+};
+
+void PrintUsage();
+Args ParseArgs(int argc, char* argv[]);
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const Args args = ParseArgs(argc, argv);
+
+  try {
+    std::cout << "Compiling signature database: " << args.input_path << "\n";
+    const std::size_t count =
+        scanner::CompileSignatureDatabase(args.input_path, args.output_path);
+    std::cout << "Wrote " << count << " signatures to " << args.output_path
+              << std::endl;
+  } catch (const std::exception& e) {
+    std::cerr << "A critical error occurred: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+namespace {
+
+void PrintUsage() {
+  std::cout << "Usage: scanner-dbc --input <database.csv> "
+               "--output <database.sigdb>\n";
+}
+
+Args ParseArgs(int argc, char* argv[]) {
+  if (argc != 5) {
+    PrintUsage();
+    exit(EXIT_FAILURE);
+  }
+
+  std::unordered_map<std::string, std::string> args_map;
+  for (int i = 1; i < argc; i += 2) {
+    args_map[argv[i]] = argv[i + 1];
+  }
+
+  Args args;
+  try {
+    args.input_path = args_map.at("--input");
+    args.output_path = args_map.at("--output");
+  } catch (const std::out_of_range&) {
+    PrintUsage();
+    exit(EXIT_FAILURE);
+  }
+
+  if (!std::filesystem::exists(args.input_path) ||
+      !std::filesystem::is_regular_file(args.input_path)) {
+    std::cerr << "Error: Input database does not exist or is not a file: "
+              << args.input_path << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
+  const auto output_parent_dir = args.output_path.parent_path();
+  if (!output_parent_dir.empty() &&
+      !std::filesystem::exists(output_parent_dir)) {
+    std::cerr << "Error: Output file's parent directory does not exist: "
+              << output_parent_dir << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
+  return args;
+}
+
+}  // namespace
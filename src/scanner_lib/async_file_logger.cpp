@@ -0,0 +1,155 @@
+#include "src/scanner_lib/async_file_logger.h"
+
+#include <stdexcept>
+
+#include "src/scanner_lib/file_logger.h"
+
+namespace scanner {
+
+AsyncFileLogger::AsyncFileLogger(const std::filesystem::path& log_path,
+                                 std::size_t capacity, std::size_t flush_bytes,
+                                 std::chrono::milliseconds flush_interval)
+    : log_path_(log_path),
+      ring_(capacity),
+      flush_bytes_(flush_bytes),
+      flush_interval_(flush_interval),
+      wake_interval_(ring_.Capacity() / 2) {
+  log_stream_.open(log_path, std::ios::out | std::ios::app);
+  if (!log_stream_) {
+    throw std::runtime_error("Failed to open log file for writing: " +
+                             log_path.string());
+  }
+  batch_.reserve(flush_bytes_);
+  writer_ = std::thread(&AsyncFileLogger::WriterLoop, this);
+}
+
+AsyncFileLogger::~AsyncFileLogger() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  writer_condition_.notify_one();
+  writer_.join();
+}
+
+void AsyncFileLogger::LogDetection(const std::filesystem::path& path,
+                                   const AnyDigest& hash,
+                                   const std::string& verdict) {
+  // The line is complete before a slot is claimed and is swapped into it,
+  // so nothing can throw between the claim and the publication; a claimed
+  // slot left unpublished would stall the writer for good.
+  thread_local std::string line;
+  line.clear();
+  AppendDetectionJson(line, path, hash, verdict);
+
+  const auto fill = [](std::string& slot) noexcept { slot.swap(line); };
+  for (;;) {
+    const auto position = ring_.TryPush(fill);
+    if (position) {
+      // Waking the writer well before the ring fills up keeps producers
+      // from ever having to wait for it.
+      if ((*position + 1) % wake_interval_ == 0) {
+        WakeWriter();
+      }
+      return;
+    }
+    // Sleeps until the writer has drained the ring at least once more.
+    std::unique_lock<std::mutex> lock(mutex_);
+    wake_ = true;
+    writer_condition_.notify_one();
+    const std::uint64_t drains = drains_;
+    ++waiting_producers_;
+    space_condition_.wait(lock, [&] { return drains_ != drains; });
+    --waiting_producers_;
+  }
+}
+
+void AsyncFileLogger::Flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  const std::uint64_t ticket = ++flush_requests_;
+  writer_condition_.notify_one();
+  flushed_condition_.wait(lock, [&] { return flushes_done_ >= ticket; });
+  if (write_failed_.load()) {
+    throw std::runtime_error("Failed to write log file: " +
+                             log_path_.string());
+  }
+}
+
+void AsyncFileLogger::WakeWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    wake_ = true;
+  }
+  writer_condition_.notify_one();
+}
+
+void AsyncFileLogger::Drain() {
+  while (ring_.TryPop([this](std::string& line) {
+    if (batch_.empty()) {
+      batch_started_ = std::chrono::steady_clock::now();
+    }
+    batch_ += line;
+    batch_ += '\n';
+  })) {
+    if (batch_.size() >= flush_bytes_) {
+      WriteBatch();
+    }
+  }
+}
+
+void AsyncFileLogger::WriteBatch() {
+  if (batch_.empty()) {
+    return;
+  }
+  log_stream_.write(batch_.data(), static_cast<std::streamsize>(batch_.size()));
+  log_stream_.flush();
+  if (!log_stream_) {
+    write_failed_.store(true);
+  }
+  batch_.clear();
+}
+
+void AsyncFileLogger::WriterLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    wake_ = false;
+    const std::uint64_t requested = flush_requests_;
+    const bool stopping = stop_;
+    lock.unlock();
+
+    // Every line pushed before a flush request or the stop is published by
+    // now, so a single drain covers it.
+    Drain();
+    const bool flush = requested != flushes_done_ || stopping;
+    const bool expired =
+        !batch_.empty() &&
+        std::chrono::steady_clock::now() - batch_started_ >= flush_interval_;
+    if (flush || expired) {
+      WriteBatch();
+    }
+
+    lock.lock();
+    ++drains_;
+    if (waiting_producers_ != 0) {
+      space_condition_.notify_all();
+    }
+    if (flush) {
+      flushes_done_ = requested;
+      flushed_condition_.notify_all();
+      if (stopping) {
+        return;
+      }
+    }
+    const auto wake_up = [this, requested] {
+      return wake_ || stop_ || flush_requests_ != requested;
+    };
+    // Producers only wake the writer every wake_interval_ lines, so it also
+    // polls the ring once per interval to bound the latency of a quiet log.
+    const auto deadline =
+        batch_.empty() ? std::chrono::steady_clock::now() + flush_interval_
+                       : batch_started_ + flush_interval_;
+    writer_condition_.wait_until(lock, deadline, wake_up);
+  }
+}
+
+}  // namespace scanner
@@ -0,0 +1,121 @@
+#ifndef SRC_SCANNER_LIB_ASYNC_FILE_LOGGER_H_
+#define SRC_SCANNER_LIB_ASYNC_FILE_LOGGER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "scanner/interfaces.h"
+#include "src/scanner_lib/mpsc_ring.h"
+
+namespace scanner {
+
+/**
+ * @class AsyncFileLogger
+ * @brief An implementation of ILogger that writes detections to a file from
+ * a background thread.
+ *
+ * Workers format a detection into a per-thread buffer and copy it into a
+ * slot of a lock-free MpscRing, so they never wait for each other or for the
+ * file. A writer thread drains the ring into a batch and writes the batch once
+ * it reaches a size threshold, once its oldest line is older than a time
+ * threshold, or when Flush() is called. If the ring is full, workers wake the
+ * writer and sleep until it has drained the ring, which bounds memory use.
+ *
+ * Flush() and the destructor write every detection logged before them. The
+ * file is opened upon construction.
+ */
+class AsyncFileLogger final : public ILogger {
+public:
+  /** @brief The default number of detections the ring holds. */
+  static constexpr std::size_t kDefaultCapacity = 4096;
+  /** @brief The default batch size at which the writer writes, in bytes. */
+  static constexpr std::size_t kDefaultFlushBytes = 64 * 1024;
+  /** @brief The default age at which a pending batch is written. */
+  static constexpr std::chrono::milliseconds kDefaultFlushInterval{100};
+
+  /**
+   * @brief Constructs an AsyncFileLogger, opens the log file and starts the
+   * writer thread.
+   * @param log_path The path to the log file.
+   * @param capacity The number of detections the ring holds.
+   * @param flush_bytes The batch size at which the writer writes.
+   * @param flush_interval The age at which a pending batch is written.
+   * @throws std::runtime_error if the file cannot be opened for writing.
+   */
+  explicit AsyncFileLogger(
+      const std::filesystem::path& log_path,
+      std::size_t capacity = kDefaultCapacity,
+      std::size_t flush_bytes = kDefaultFlushBytes,
+      std::chrono::milliseconds flush_interval = kDefaultFlushInterval);
+
+  /** @brief Writes all pending detections and stops the writer thread. */
+  ~AsyncFileLogger() override;
+
+  AsyncFileLogger(const AsyncFileLogger&) = delete;
+  AsyncFileLogger& operator=(const AsyncFileLogger&) = delete;
+
+  /**
+   * @brief Queues a malicious file detection for writing. Thread-safe.
+   * @param path The path to the detected file.
+   * @param hash The matching digest of the file, written as hexadecimal.
+   * @param verdict The verdict from the hash database.
+   */
+  void LogDetection(const std::filesystem::path& path, const AnyDigest& hash,
+                    const std::string& verdict) override;
+
+  /**
+   * @brief Blocks until every detection logged so far is written and flushed.
+   * @throws std::runtime_error if writing the file failed.
+   */
+  void Flush() override;
+
+private:
+  void WriterLoop();
+  // Moves every published line from the ring into the batch, writing the
+  // batch whenever it reaches the size threshold.
+  void Drain();
+  void WriteBatch();
+  void WakeWriter();
+
+  std::filesystem::path log_path_;
+  std::ofstream log_stream_;
+  MpscRing<std::string> ring_;
+  const std::size_t flush_bytes_;
+  const std::chrono::milliseconds flush_interval_;
+  // Producers wake the writer each time this many lines have been pushed.
+  const std::size_t wake_interval_;
+
+  // Owned by the writer thread.
+  std::string batch_;
+  std::chrono::steady_clock::time_point batch_started_;
+
+  std::mutex mutex_;
+  std::condition_variable writer_condition_;
+  std::condition_variable flushed_condition_;
+  // Wakes producers waiting for the ring to have space.
+  std::condition_variable space_condition_;
+  // Guarded by mutex_.
+  bool wake_ = false;
+  // Counts the writer's drains, so that a full ring's producers can wait
+  // for the next one.
+  std::uint64_t drains_ = 0;
+  std::size_t waiting_producers_ = 0;
+  bool stop_ = false;
+  std::uint64_t flush_requests_ = 0;
+  std::uint64_t flushes_done_ = 0;
+
+  std::atomic<bool> write_failed_{false};
+  std::thread writer_;
+};
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_ASYNC_FILE_LOGGER_H_
@@ -0,0 +1,67 @@
+#include "src/scanner_lib/blocked_bloom_filter.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace scanner {
+namespace {
+
+constexpr std::uint32_t kMaxProbes = 8;
+
+std::uint64_t SplitMix64(std::uint64_t& state) {
+  std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+}  // namespace
+
+BlockedBloomFilter::BlockedBloomFilter(std::size_t expected_keys,
+                                       std::size_t bits_per_key) {
+  bits_per_key = std::max<std::size_t>(bits_per_key, 1);
+  const std::size_t total_bits = std::max<std::size_t>(expected_keys, 1) *
+                                 bits_per_key;
+  const std::size_t num_blocks =
+      (total_bits + kBitsPerBlock - 1) / kBitsPerBlock;
+  blocks_.assign(num_blocks, Block{});
+
+  // The optimal probe count for a classic Bloom filter is bits_per_key * ln 2.
+  const auto probes = static_cast<std::uint32_t>(
+      std::lround(static_cast<double>(bits_per_key) * 0.69314718));
+  num_probes_ = std::clamp<std::uint32_t>(probes, 1, kMaxProbes);
+}
+
+void BlockedBloomFilter::Add(const Md5Digest& digest) {
+  const Probe probe = ProbeFor(digest);
+  Block& block = blocks_[probe.block];
+  std::uint32_t bit = probe.first_bit;
+  for (std::uint32_t i = 0; i < num_probes_; ++i) {
+    block.words[bit / 64] |= std::uint64_t{1} << (bit % 64);
+    bit = (bit + probe.step) % kBitsPerBlock;
+  }
+}
+
+double BlockedBloomFilter::EstimateFalsePositiveRate(
+    std::size_t samples) const {
+  if (samples == 0) {
+    return 0.0;
+  }
+
+  // A fixed seed keeps the reported rate stable across runs.
+  std::uint64_t state = 0x5CA77E4F11E75ULL;
+  std::size_t positives = 0;
+  for (std::size_t i = 0; i < samples; ++i) {
+    Md5Digest digest;
+    const std::uint64_t low = SplitMix64(state);
+    const std::uint64_t high = SplitMix64(state);
+    std::memcpy(digest.bytes.data(), &low, sizeof(low));
+    std::memcpy(digest.bytes.data() + 8, &high, sizeof(high));
+    if (MayContain(digest)) {
+      positives++;
+    }
+  }
+  return static_cast<double>(positives) / static_cast<double>(samples);
+}
+
+}  // namespace scanner
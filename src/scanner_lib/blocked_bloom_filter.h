@@ -0,0 +1,99 @@
+#ifndef SRC_SCANNER_LIB_BLOCKED_BLOOM_FILTER_H_
+#define SRC_SCANNER_LIB_BLOCKED_BLOOM_FILTER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <vector>
+
+#include "scanner/domain.h"
+
+namespace scanner {
+
+/**
+ * @class BlockedBloomFilter
+ * @brief A cache-friendly approximate membership filter for MD5 digests.
+ *
+ * All bits of a key live in a single 64-byte block, so a query touches exactly
+ * one cache line. The filter never reports false negatives; a positive answer
+ * must be confirmed against the exact signature table. Since MD5 digests are
+ * uniformly distributed, their bytes are used directly as hash values. This
+ * class is an internal, non-exported component of the scanner library.
+ */
+class BlockedBloomFilter {
+public:
+  /**
+   * @brief Constructs an empty filter sized for the expected number of keys.
+   * @param expected_keys The number of keys that will be added.
+   * @param bits_per_key The memory budget per key; 8-12 is typical.
+   */
+  BlockedBloomFilter(std::size_t expected_keys, std::size_t bits_per_key);
+
+  /** @brief Adds a digest to the filter. */
+  void Add(const Md5Digest& digest);
+
+  /**
+   * @brief Tests whether a digest may be in the filter.
+   * @return false if the digest was definitely never added.
+   */
+  bool MayContain(const Md5Digest& digest) const {
+    const Probe probe = ProbeFor(digest);
+    const Block& block = blocks_[probe.block];
+    std::uint32_t bit = probe.first_bit;
+    for (std::uint32_t i = 0; i < num_probes_; ++i) {
+      if ((block.words[bit / 64] & (std::uint64_t{1} << (bit % 64))) == 0) {
+        return false;
+      }
+      bit = (bit + probe.step) % kBitsPerBlock;
+    }
+    return true;
+  }
+
+  /** @brief Returns the memory used by the filter's bit array in bytes. */
+  std::size_t MemoryBytes() const {
+    return blocks_.size() * sizeof(Block);
+  }
+
+  /**
+   * @brief Measures the false-positive rate by querying synthetic digests
+   * that were never added.
+   * @param samples The number of queries to run.
+   * @return The fraction of queries that passed the filter.
+   */
+  double EstimateFalsePositiveRate(std::size_t samples = 1 << 16) const;
+
+private:
+  static constexpr std::uint32_t kBitsPerBlock = 512;
+
+  struct alignas(64) Block {
+    std::uint64_t words[kBitsPerBlock / 64];
+  };
+
+  struct Probe {
+    std::size_t block;
+    std::uint32_t first_bit;
+    std::uint32_t step;
+  };
+
+  // The leading digest bytes key the exact hash tables, so the filter uses
+  // the trailing ones to keep the two independent.
+  Probe ProbeFor(const Md5Digest& digest) const {
+    std::uint64_t hash;
+    std::memcpy(&hash, digest.bytes.data() + 8, sizeof(hash));
+    Probe probe;
+    probe.block = static_cast<std::size_t>(
+        ((hash >> 32) * static_cast<std::uint64_t>(blocks_.size())) >> 32);
+    probe.first_bit = static_cast<std::uint32_t>(hash % kBitsPerBlock);
+    // An odd step visits distinct bits of the power-of-two sized block.
+    probe.step = static_cast<std::uint32_t>((hash >> 9) % kBitsPerBlock) | 1;
+    return probe;
+  }
+
+  std::vector<Block> blocks_;
+  std::uint32_t num_probes_;
+};
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_BLOCKED_BLOOM_FILTER_H_
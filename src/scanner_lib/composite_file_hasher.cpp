@@ -0,0 +1,131 @@
+#include "src/scanner_lib/composite_file_hasher.h"
+
+#include <algorithm>
+
+#include "src/scanner_lib/md5_engine.h"
+#include "src/scanner_lib/md5_file_hasher.h"
+#include "src/scanner_lib/sha_engine.h"
+
+namespace scanner {
+
+CompositeFileHasher::CompositeFileHasher(
+    const std::vector<HashAlgorithm>& algorithms, Md5Isa isa,
+    const IoOptions& io_options)
+    : multi_buffer_(isa), reader_(io_options) {
+  for (const HashAlgorithm algorithm : algorithms) {
+    sha1_ = sha1_ || algorithm == HashAlgorithm::kSha1;
+    sha256_ = sha256_ || algorithm == HashAlgorithm::kSha256;
+  }
+}
+
+Md5Digest CompositeFileHasher::HashFile(
+    const std::filesystem::path& file_path) {
+  FileHashResult result;
+  HashFileDigests(file_path, result);
+  return *result.md5;
+}
+
+void CompositeFileHasher::HashFileDigests(
+    const std::filesystem::path& file_path, FileHashResult& result) {
+  Md5Engine md5;
+  Sha1Engine sha1;
+  Sha256Engine sha256;
+  reader_.Read(file_path, [&](const std::uint8_t* data, std::size_t size) {
+    md5.Update(data, size);
+    if (sha1_) {
+      sha1.Update(data, size);
+    }
+    if (sha256_) {
+      sha256.Update(data, size);
+    }
+  });
+  result.md5 = md5.Final();
+  result.sha1.reset();
+  result.sha256.reset();
+  if (sha1_) {
+    result.sha1 = sha1.Final();
+  }
+  if (sha256_) {
+    result.sha256 = sha256.Final();
+  }
+}
+
+void CompositeFileHasher::HashContent(const std::vector<std::uint8_t>& content,
+                                      FileHashResult& result) const {
+  if (sha1_) {
+    Sha1Engine engine;
+    engine.Update(content.data(), content.size());
+    result.sha1 = engine.Final();
+  }
+  if (sha256_) {
+    Sha256Engine engine;
+    engine.Update(content.data(), content.size());
+    result.sha256 = engine.Final();
+  }
+}
+
+void CompositeFileHasher::HashFiles(
+    const std::vector<std::filesystem::path>& file_paths,
+    std::vector<FileHashResult>& results) {
+  // Buffers are kept per thread so that steady-state batches reuse memory.
+  thread_local std::vector<FileReader::BatchEntry> entries;
+  thread_local std::vector<HashMessage> messages;
+  thread_local std::vector<std::size_t> message_files;
+  thread_local std::vector<Md5Digest> digests;
+
+  results.resize(file_paths.size());
+  messages.clear();
+  message_files.clear();
+  for (FileHashResult& result : results) {
+    result.sha1.reset();
+    result.sha256.reset();
+  }
+
+  try {
+    reader_.ReadBatch(file_paths, Md5FileHasher::kMaxBatchedFileSize,
+                      entries);
+  } catch (...) {
+    for (FileHashResult& result : results) {
+      result.error = std::current_exception();
+    }
+    return;
+  }
+
+  for (std::size_t i = 0; i < file_paths.size(); ++i) {
+    results[i].error = entries[i].error;
+    if (results[i].error) {
+      continue;
+    }
+    if (entries[i].too_large) {
+      try {
+        HashFileDigests(file_paths[i], results[i]);
+      } catch (...) {
+        results[i].error = std::current_exception();
+      }
+      continue;
+    }
+    HashContent(entries[i].content, results[i]);
+    messages.push_back({entries[i].content.data(), entries[i].content.size()});
+    message_files.push_back(i);
+  }
+
+  digests.resize(messages.size());
+  multi_buffer_.Hash(messages.data(), messages.size(), digests.data());
+  for (std::size_t i = 0; i < messages.size(); ++i) {
+    results[message_files[i]].md5 = digests[i];
+  }
+}
+
+std::size_t CompositeFileHasher::PreferredBatchSize() const {
+  if (reader_.Options().strategy == IoStrategy::kIoUring) {
+    return std::max(multi_buffer_.Lanes(),
+                    Md5FileHasher::kMinIoUringBatchSize);
+  }
+  return multi_buffer_.Lanes();
+}
+
+std::uintmax_t CompositeFileHasher::MaxBatchedFileSize() const {
+  return PreferredBatchSize() > 1 ? Md5FileHasher::kMaxBatchedFileSize : 0;
+}
+
+}  // namespace scanner
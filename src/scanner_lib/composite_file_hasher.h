@@ -0,0 +1,90 @@
+#ifndef SRC_SCANNER_LIB_COMPOSITE_FILE_HASHER_H_
+#define SRC_SCANNER_LIB_COMPOSITE_FILE_HASHER_H_
+
+#include <cstdint>
+
+#include <filesystem>
+#include <vector>
+
+#include "scanner/domain.h"
+#include "scanner/interfaces.h"
+#include "src/scanner_lib/file_reader.h"
+#include "src/scanner_lib/md5_multi_buffer.h"
+
+namespace scanner {
+
+/**
+ * @class CompositeFileHasher
+ * @brief An implementation of IFileHasher that computes several digests of
+ * each file in a single pass.
+ *
+ * Every chunk read by the FileReader is fed to an MD5 engine and to the
+ * SHA-1 and SHA-256 engines that are enabled, so the I/O cost is one read
+ * per file however many algorithms are configured. MD5 is always computed,
+ * since the scanner identifies files by it; the other digests let the
+ * database match SHA-1 and SHA-256 signatures. Batches of small files are
+ * read whole, MD5-hashed across SIMD lanes and SHA-hashed from the same
+ * buffers. It is an internal, non-exported class.
+ */
+class CompositeFileHasher final : public IFileHasher {
+public:
+  /**
+   * @brief Constructs a hasher.
+   * @param algorithms The digests to compute besides MD5; kMd5 entries are
+   * accepted and ignored.
+   * @param isa The instruction set used for MD5 batches; defaults to the best
+   * one supported by the CPU.
+   * @param io_options How file contents are read.
+   */
+  explicit CompositeFileHasher(const std::vector<HashAlgorithm>& algorithms,
+                               Md5Isa isa = Md5MultiBuffer::BestIsa(),
+                               const IoOptions& io_options = {});
+
+  /**
+   * @brief Calculates the MD5 hash of a given file; equivalent to the MD5
+   * digest of HashFileDigests.
+   * @throws std::runtime_error if the file cannot be opened or read.
+   */
+  Md5Digest HashFile(const std::filesystem::path& file_path) override;
+
+  /**
+   * @brief Calculates every configured digest of a file in one read.
+   * @param file_path The path to the file to be hashed.
+   * @param result Receives the digests.
+   * @throws std::runtime_error if the file cannot be opened or read.
+   */
+  void HashFileDigests(const std::filesystem::path& file_path,
+                       FileHashResult& result) override;
+
+  /**
+   * @brief Hashes a batch of files, each read once.
+   *
+   * Files up to Md5FileHasher::kMaxBatchedFileSize are read into per-thread
+   * buffers; larger ones fall back to HashFileDigests.
+   *
+   * @param file_paths The files to hash.
+   * @param results Resized to match file_paths and filled in order.
+   */
+  void HashFiles(const std::vector<std::filesystem::path>& file_paths,
+                 std::vector<FileHashResult>& results) override;
+
+  /** @copydoc Md5FileHasher::PreferredBatchSize */
+  std::size_t PreferredBatchSize() const override;
+
+  /** @copydoc Md5FileHasher::MaxBatchedFileSize */
+  std::uintmax_t MaxBatchedFileSize() const override;
+
+private:
+  // Computes the enabled SHA digests of an in-memory file.
+  void HashContent(const std::vector<std::uint8_t>& content,
+                   FileHashResult& result) const;
+
+  bool sha1_ = false;
+  bool sha256_ = false;
+  Md5MultiBuffer multi_buffer_;
+  FileReader reader_;
+};
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_COMPOSITE_FILE_HASHER_H_
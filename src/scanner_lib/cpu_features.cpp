@@ -0,0 +1,84 @@
+#include "src/scanner_lib/cpu_features.h"
+
+#include <cstdint>
+
+#ifdef SCANNER_ARCH_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace scanner {
+namespace {
+
+#ifdef SCANNER_ARCH_X86
+
+void Cpuid(std::uint32_t leaf, std::uint32_t subleaf, std::uint32_t regs[4]) {
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+  for (int i = 0; i < 4; ++i) {
+    regs[i] = static_cast<std::uint32_t>(info[i]);
+  }
+#else
+  __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+std::uint64_t ReadXcr0() {
+#if defined(_MSC_VER)
+  return _xgetbv(0);
+#else
+  std::uint32_t eax = 0;
+  std::uint32_t edx = 0;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (std::uint64_t{edx} << 32) | eax;
+#endif
+}
+
+CpuFeatures Detect() {
+  CpuFeatures features;
+  std::uint32_t regs[4];  // eax, ebx, ecx, edx
+
+  Cpuid(0, 0, regs);
+  const std::uint32_t max_leaf = regs[0];
+
+  Cpuid(1, 0, regs);
+  features.sse2 = (regs[3] & (1U << 26)) != 0;
+  features.sse41 = (regs[2] & (1U << 19)) != 0;
+  const bool osxsave = (regs[2] & (1U << 27)) != 0;
+  const bool avx = (regs[2] & (1U << 28)) != 0;
+
+  // XCR0 tells whether the OS preserves the YMM (bits 1-2) and ZMM/opmask
+  // (bits 5-7) registers across context switches.
+  const std::uint64_t xcr0 = osxsave ? ReadXcr0() : 0;
+  const bool os_ymm = (xcr0 & 0x6) == 0x6;
+  const bool os_zmm = (xcr0 & 0xE6) == 0xE6;
+
+  if (max_leaf >= 7) {
+    Cpuid(7, 0, regs);
+    features.avx2 = avx && os_ymm && (regs[1] & (1U << 5)) != 0;
+    features.avx512f = os_zmm && (regs[1] & (1U << 16)) != 0;
+    features.sha = (regs[1] & (1U << 29)) != 0;
+  }
+  return features;
+}
+
+#else
+
+CpuFeatures Detect() {
+  return CpuFeatures{};
+}
+
+#endif  // SCANNER_ARCH_X86
+
+}  // namespace
+
+const CpuFeatures& GetCpuFeatures() {
+  static const CpuFeatures features = Detect();
+  return features;
+}
+
+}  // namespace scanner
@@ -0,0 +1,37 @@
+#ifndef SRC_SCANNER_LIB_CPU_FEATURES_H_
+#define SRC_SCANNER_LIB_CPU_FEATURES_H_
+
+// Defined when compiling for x86, where SIMD kernels are available.
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+    defined(_M_IX86)
+#define SCANNER_ARCH_X86 1
+#endif
+
+namespace scanner {
+
+/**
+ * @struct CpuFeatures
+ * @brief The instruction set extensions usable by the current process.
+ *
+ * A feature is only reported when both the CPU and the operating system
+ * support it (i.e., the OS saves the corresponding register state).
+ */
+struct CpuFeatures {
+  bool sse2 = false;
+  bool sse41 = false;
+  bool avx2 = false;
+  bool avx512f = false;
+  bool sha = false;
+};
+
+/**
+ * @brief Detects the features of the running CPU.
+ *
+ * Detection runs once; later calls return the cached result. On non-x86
+ * targets all features are reported as unavailable.
+ */
+const CpuFeatures& GetCpuFeatures();
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_CPU_FEATURES_H_
@@ -1,35 +1,105 @@
 #include "src/scanner_lib/csv_hash_database.h"
 
+#include <algorithm>
+#include <charconv>
 #include <fstream>
 #include <iostream>
-#include <sstream>
+#include <iterator>
 #include <stdexcept>
 #include <string>
-#include <vector>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <variant>
 
 namespace scanner {
 namespace {
 
-std::vector<std::string> Split(const std::string& s, char delimiter) {
-  std::vector<std::string> tokens;
-  std::string token;
-  std::istringstream token_stream(s);
-  while (std::getline(token_stream, token, delimiter)) {
-    tokens.push_back(token);
+std::optional<AnyDigest> ParseDigest(std::string_view hex) {
+  switch (hex.size()) {
+    case Md5Digest::kSize * 2:
+      if (const auto digest = Md5Digest::FromHex(hex)) {
+        return *digest;
+      }
+      break;
+    case Sha1Digest::kSize * 2:
+      if (const auto digest = Sha1Digest::FromHex(hex)) {
+        return *digest;
+      }
+      break;
+    case Sha256Digest::kSize * 2:
+      if (const auto digest = Sha256Digest::FromHex(hex)) {
+        return *digest;
+      }
+      break;
   }
-  return tokens;
+  return std::nullopt;
+}
+
+std::optional<std::uint64_t> ParseSize(std::string_view text) {
+  std::uint64_t size = 0;
+  const char* end = text.data() + text.size();
+  const auto [ptr, ec] = std::from_chars(text.data(), end, size);
+  if (text.empty() || ec != std::errc() || ptr != end) {
+    return std::nullopt;
+  }
+  return size;
+}
+
+// Parses "hash;verdict[;size[;prefix]]"; every present field must be valid.
+std::optional<CsvSignature> ParseLine(std::string_view line) {
+  // Empty trailing fields are ignored, as a line may end in a separator.
+  while (!line.empty() && line.back() == ';') {
+    line.remove_suffix(1);
+  }
+  std::string_view fields[4];
+  std::size_t count = 0;
+  for (;;) {
+    if (count == std::size(fields)) {
+      return std::nullopt;
+    }
+    const auto separator = line.find(';');
+    fields[count++] = line.substr(0, separator);
+    if (separator == std::string_view::npos) {
+      break;
+    }
+    line.remove_prefix(separator + 1);
+  }
+  if (count < 2 || fields[1].empty()) {
+    return std::nullopt;
+  }
+
+  const std::optional<AnyDigest> digest = ParseDigest(fields[0]);
+  if (!digest) {
+    return std::nullopt;
+  }
+  CsvSignature signature{*digest, fields[1], std::nullopt, std::nullopt};
+  if (count > 2) {
+    signature.size = ParseSize(fields[2]);
+    if (!signature.size) {
+      return std::nullopt;
+    }
+  }
+  if (count > 3) {
+    signature.prefix_digest = Md5Digest::FromHex(fields[3]);
+    if (!signature.prefix_digest) {
+      return std::nullopt;
+    }
+  }
+  return signature;
 }
 
 }  // namespace
 
-std::size_t CsvHashDatabase::Load(const std::filesystem::path& source_path) {
+std::size_t ReadCsvSignatures(const std::filesystem::path& source_path,
+                              const SignatureCallback& on_signature) {
   std::ifstream db_file(source_path);
   if (!db_file) {
     throw std::runtime_error("Failed to open hash database file: " +
                              source_path.string());
   }
 
-  signatures_.clear();
+  std::size_t signatures_read = 0;
   std::string line;
   std::size_t line_number = 0;
   while (std::getline(db_file, line)) {
@@ -38,24 +108,89 @@ std::size_t CsvHashDatabase::Load(const std::filesystem::path& source_path) {
       continue;
     }
 
-    const auto parts = Split(line, ';');
-    if (parts.size() != 2 || parts[0].empty() || parts[1].empty()) {
+    const std::optional<CsvSignature> signature = ParseLine(line);
+    if (!signature) {
       std::cerr << "Warning: Malformed line " << line_number
                 << " in database file, skipping: " << source_path.string()
                 << std::endl;
       continue;
     }
 
-    const std::string& hash = parts[0];
-    const std::string& verdict = parts[1];
-    signatures_[hash] = verdict;
+    on_signature(*signature);
+    signatures_read++;
+  }
+
+  return signatures_read;
+}
+
+void SampleIndex::Add(const CsvSignature& signature) {
+  added_ = true;
+  if (signature.size) {
+    sizes_.push_back(*signature.size);
+  } else {
+    has_sizes_ = false;
+  }
+  if (signature.prefix_digest) {
+    prefixes_.push_back(*signature.prefix_digest);
+  } else if (!signature.size || *signature.size > kSamplePrefixSize) {
+    has_prefixes_ = false;
   }
+}
 
-  return signatures_.size();
+void SampleIndex::Finish() {
+  std::sort(sizes_.begin(), sizes_.end());
+  sizes_.erase(std::unique(sizes_.begin(), sizes_.end()), sizes_.end());
+  std::sort(prefixes_.begin(), prefixes_.end(),
+            [](const Md5Digest& lhs, const Md5Digest& rhs) {
+              return lhs.bytes < rhs.bytes;
+            });
+  prefixes_.erase(std::unique(prefixes_.begin(), prefixes_.end()),
+                  prefixes_.end());
+}
+
+CsvHashDatabase::CsvHashDatabase(std::size_t prefilter_bits_per_key)
+    : prefilter_bits_per_key_(prefilter_bits_per_key) {
+}
+
+std::size_t CsvHashDatabase::Load(const std::filesystem::path& source_path) {
+  std::unordered_map<Md5Digest, std::string, DigestHash> signatures;
+  std::unordered_map<Sha1Digest, std::string, DigestHash> sha1_signatures;
+  std::unordered_map<Sha256Digest, std::string, DigestHash> sha256_signatures;
+  SampleIndex sample_index;
+  ReadCsvSignatures(source_path, [&](const CsvSignature& signature) {
+    const AnyDigest& digest = signature.digest;
+    const std::string_view verdict = signature.verdict;
+    sample_index.Add(signature);
+    if (const auto* md5 = std::get_if<Md5Digest>(&digest)) {
+      signatures[*md5] = verdict;
+    } else if (const auto* sha1 = std::get_if<Sha1Digest>(&digest)) {
+      sha1_signatures[*sha1] = verdict;
+    } else {
+      sha256_signatures[std::get<Sha256Digest>(digest)] = verdict;
+    }
+  });
+
+  signatures_ = std::move(signatures);
+  sha1_signatures_ = std::move(sha1_signatures);
+  sha256_signatures_ = std::move(sha256_signatures);
+  sample_index.Finish();
+  sample_index_ = std::move(sample_index);
+  prefilter_.reset();
+  if (prefilter_bits_per_key_ > 0) {
+    prefilter_.emplace(signatures_.size(), prefilter_bits_per_key_);
+    for (const auto& signature : signatures_) {
+      prefilter_->Add(signature.first);
+    }
+  }
+  return signatures_.size() + sha1_signatures_.size() +
+         sha256_signatures_.size();
 }
 
 std::optional<std::string> CsvHashDatabase::FindHash(
-    const std::string& hash) const {
+    const Md5Digest& hash) const {
+  if (prefilter_ && !prefilter_->MayContain(hash)) {
+    return std::nullopt;
+  }
   const auto it = signatures_.find(hash);
   if (it != signatures_.end()) {
     return it->second;
@@ -63,4 +198,53 @@ std::optional<std::string> CsvHashDatabase::FindHash(
   return std::nullopt;
 }
 
-}  // namespace scanner
\ No newline at end of file
+std::optional<std::string> CsvHashDatabase::FindSha1(
+    const Sha1Digest& hash) const {
+  const auto it = sha1_signatures_.find(hash);
+  if (it != sha1_signatures_.end()) {
+    return it->second;
+  }
+  return std::nullopt;
+}
+
+std::optional<std::string> CsvHashDatabase::FindSha256(
+    const Sha256Digest& hash) const {
+  const auto it = sha256_signatures_.find(hash);
+  if (it != sha256_signatures_.end()) {
+    return it->second;
+  }
+  return std::nullopt;
+}
+
+bool CsvHashDatabase::HasSizeIndex() const {
+  return sample_index_.HasSizes();
+}
+
+bool CsvHashDatabase::MayMatchSize(std::uint64_t size) const {
+  const auto& sizes = sample_index_.Sizes();
+  return !HasSizeIndex() ||
+         std::binary_search(sizes.begin(), sizes.end(), size);
+}
+
+bool CsvHashDatabase::HasPrefixIndex() const {
+  return sample_index_.HasPrefixes();
+}
+
+bool CsvHashDatabase::MayMatchPrefix(const Md5Digest& prefix_digest) const {
+  const auto& prefixes = sample_index_.Prefixes();
+  return !HasPrefixIndex() ||
+         std::binary_search(prefixes.begin(), prefixes.end(), prefix_digest,
+                            [](const Md5Digest& lhs, const Md5Digest& rhs) {
+                              return lhs.bytes < rhs.bytes;
+                            });
+}
+
+std::optional<PrefilterStats> CsvHashDatabase::GetPrefilterStats() const {
+  if (!prefilter_) {
+    return std::nullopt;
+  }
+  return PrefilterStats{prefilter_->MemoryBytes(),
+                        prefilter_->EstimateFalsePositiveRate()};
+}
+
+}  // namespace scanner
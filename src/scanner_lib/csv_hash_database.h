@@ -1,32 +1,132 @@
 #ifndef SRC_SCANNER_LIB_CSV_HASH_DATABASE_H_
 #define SRC_SCANNER_LIB_CSV_HASH_DATABASE_H_
 
+#include <cstdint>
+
 #include <filesystem>
+#include <functional>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "scanner/interfaces.h"
+#include "src/scanner_lib/blocked_bloom_filter.h"
 
 namespace scanner {
 
+/**
+ * @struct CsvSignature
+ * @brief One parsed line of a signature file. The verdict view is only valid
+ * for the duration of the SignatureCallback call.
+ */
+struct CsvSignature {
+  AnyDigest digest;
+  std::string_view verdict;
+  /** @brief The size of the sample in bytes, if given. */
+  std::optional<std::uint64_t> size;
+  /** @brief The MD5 digest of the sample's first kSamplePrefixSize bytes. */
+  std::optional<Md5Digest> prefix_digest;
+};
+
+/** @brief Receives one parsed signature. */
+using SignatureCallback = std::function<void(const CsvSignature& signature)>;
+
+/**
+ * @brief Parses a semicolon-separated signature file.
+ *
+ * Each non-empty line must contain a hexadecimal hash and a non-empty
+ * verdict, optionally followed by the decimal size of the sample and then by
+ * the hexadecimal MD5 digest of its first kSamplePrefixSize bytes. The
+ * algorithm is told by the length of the hash: 32 characters for MD5, 40 for
+ * SHA-1 and 64 for SHA-256, so feeds of all three can be mixed in one file.
+ * Malformed lines are skipped, and a warning is printed to stderr. Shared by
+ * CsvHashDatabase and the signature database compiler.
+ *
+ * @param source_path The path to the CSV database file.
+ * @param on_signature Invoked for every valid line, in file order.
+ * @return The number of valid lines read.
+ * @throws std::runtime_error if the file cannot be opened.
+ */
+std::size_t ReadCsvSignatures(const std::filesystem::path& source_path,
+                              const SignatureCallback& on_signature);
+
+/**
+ * @class SampleIndex
+ * @brief The sizes and prefix digests of a set of samples, and whether they
+ * are complete enough to rule files out.
+ *
+ * Either index is only usable if it covers every signature: a single sample
+ * of unknown size makes every file size possible. Samples no larger than
+ * kSamplePrefixSize need no prefix digest, as files that small are never
+ * checked by prefix. Shared by CsvHashDatabase and the signature database
+ * compiler.
+ */
+class SampleIndex {
+public:
+  /** @brief Records the size and prefix digest of one signature. */
+  void Add(const CsvSignature& signature);
+
+  /** @brief Sorts and deduplicates the collected values; call once. */
+  void Finish();
+
+  /** @brief Returns true if every signature came with a size. */
+  bool HasSizes() const {
+    return has_sizes_ && added_;
+  }
+
+  /** @brief Returns true if every sample that needs one has a prefix. */
+  bool HasPrefixes() const {
+    return has_prefixes_ && added_;
+  }
+
+  /** @brief The distinct sample sizes, sorted once Finish() is called. */
+  const std::vector<std::uint64_t>& Sizes() const {
+    return sizes_;
+  }
+
+  /** @brief The distinct prefix digests, sorted once Finish() is called. */
+  const std::vector<Md5Digest>& Prefixes() const {
+    return prefixes_;
+  }
+
+private:
+  std::vector<std::uint64_t> sizes_;
+  std::vector<Md5Digest> prefixes_;
+  bool added_ = false;
+  bool has_sizes_ = true;
+  bool has_prefixes_ = true;
+};
+
 /**
  * @class CsvHashDatabase
  * @brief An implementation of IHashDatabase that loads signatures from a CSV
  * file.
  *
  * This class parses a semicolon-separated CSV file where each line contains
- * a hash and its corresponding verdict. It stores these signatures in an
- * unordered_map for efficient lookups. This class is an internal, non-exported
- * component of the scanner library.
+ * a hexadecimal MD5, SHA-1 or SHA-256 hash and its corresponding verdict.
+ * Hashes are stored as binary digests in one unordered_map per algorithm for
+ * efficient, allocation-free lookups. The prefilter covers MD5 only, the
+ * digest every file is looked up by. If the lines give the sizes and prefix
+ * digests of the samples, they are kept as a SampleIndex.
+ * This class is an internal, non-exported component of the scanner library.
  */
 class CsvHashDatabase final : public IHashDatabase {
 public:
+  /**
+   * @brief Constructs an empty database.
+   * @param prefilter_bits_per_key If non-zero, a BlockedBloomFilter with this
+   * budget per signature is built on Load and consulted before the table.
+   */
+  explicit CsvHashDatabase(std::size_t prefilter_bits_per_key = 0);
+
   /**
    * @brief Loads malicious signatures from a specified CSV file.
    *
-   * Clears any existing data and reads the file line by line. Malformed lines
-   * are skipped, and a warning is printed to stderr.
+   * Replaces any existing data with the signatures read by
+   * ReadCsvSignatures. If a hash appears more than once, the last verdict
+   * wins.
    *
    * @param source_path The path to the CSV database file.
    * @return The total number of signatures successfully loaded.
@@ -37,14 +137,42 @@ public:
   /**
    * @brief Looks up a hash in the loaded database.
    *
-   * @param hash The hash string to look up.
+   * @param hash The digest to look up.
    * @return An optional containing the verdict if the hash is found, otherwise
    * std::nullopt.
    */
-  std::optional<std::string> FindHash(const std::string& hash) const override;
+  std::optional<std::string> FindHash(const Md5Digest& hash) const override;
+
+  /** @copydoc IHashDatabase::FindSha1 */
+  std::optional<std::string> FindSha1(const Sha1Digest& hash) const override;
+
+  /** @copydoc IHashDatabase::FindSha256 */
+  std::optional<std::string> FindSha256(
+      const Sha256Digest& hash) const override;
+
+  /** @copydoc IHashDatabase::HasSizeIndex */
+  bool HasSizeIndex() const override;
+
+  /** @copydoc IHashDatabase::MayMatchSize */
+  bool MayMatchSize(std::uint64_t size) const override;
+
+  /** @copydoc IHashDatabase::HasPrefixIndex */
+  bool HasPrefixIndex() const override;
+
+  /** @copydoc IHashDatabase::MayMatchPrefix */
+  bool MayMatchPrefix(const Md5Digest& prefix_digest) const override;
+
+  /** @copydoc IHashDatabase::GetPrefilterStats */
+  std::optional<PrefilterStats> GetPrefilterStats() const override;
 
 private:
-  std::unordered_map<std::string, std::string> signatures_;
+  SampleIndex sample_index_;
+  std::unordered_map<Md5Digest, std::string, DigestHash> signatures_;
+  std::unordered_map<Sha1Digest, std::string, DigestHash> sha1_signatures_;
+  std::unordered_map<Sha256Digest, std::string, DigestHash>
+      sha256_signatures_;
+  std::size_t prefilter_bits_per_key_;
+  std::optional<BlockedBloomFilter> prefilter_;
 };
 
 }  // namespace scanner
@@ -0,0 +1,144 @@
+#include "src/scanner_lib/detection_channel.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace scanner {
+
+DetectionChannel::DetectionChannel(std::size_t capacity) : ring_(capacity) {
+}
+
+bool DetectionChannel::Send(const std::filesystem::path& path,
+                            const AnyDigest& digest, const std::string& verdict,
+                            std::uint64_t size) {
+  // Counted before closed_ is read, so that Receive() does not report the
+  // end of the stream while this detection may still be pushed.
+  senders_.fetch_add(1);
+  const bool sent = Push(path, digest, verdict, size);
+  senders_.fetch_sub(1);
+  return sent;
+}
+
+bool DetectionChannel::Push(const std::filesystem::path& path,
+                            const AnyDigest& digest, const std::string& verdict,
+                            std::uint64_t size) {
+  if (closed_.load()) {
+    return false;
+  }
+  // Copied before a slot is claimed, so that nothing can throw between the
+  // claim and the publication; the copy is swapped into the slot, and the
+  // slot's old buffers are reused by the next detection of this thread.
+  thread_local Detection prepared;
+  prepared.path = path;
+  prepared.digest = digest;
+  prepared.verdict = verdict;
+  prepared.size = size;
+  const auto fill = [](Detection& slot) noexcept { std::swap(slot, prepared); };
+
+  for (;;) {
+    const std::uint64_t drains = drains_.load();
+    const auto position = ring_.TryPush(fill);
+    // Pairs with the fence in Receive(): either the consumer sees the
+    // detection before sleeping, or this thread sees it waiting.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (consumer_waiting_.load(std::memory_order_relaxed)) {
+      WakeConsumer();
+    }
+    if (position) {
+      return true;
+    }
+
+    // The ring is full: sleep until the consumer has drained it since the
+    // push failed, or the channel is closed.
+    std::unique_lock<std::mutex> lock(mutex_);
+    full_senders_.fetch_add(1);
+    space_condition_.wait(lock, [&] {
+      return drains_.load() != drains || closed_.load();
+    });
+    full_senders_.fetch_sub(1);
+    if (closed_.load()) {
+      return false;
+    }
+  }
+}
+
+bool DetectionChannel::Receive(std::vector<Detection>& batch,
+                               std::size_t max_count) {
+  max_count = std::max<std::size_t>(max_count, 1);
+  for (;;) {
+    // Read before draining, so that nothing sent before the close is missed:
+    // once closed, no sender is past its check of closed_ unless counted.
+    const bool closed = closed_.load() && senders_.load() == 0;
+    if (Drain(batch, max_count) != 0) {
+      return true;
+    }
+    if (closed) {
+      batch.clear();
+      return false;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      wake_ = false;
+    }
+    consumer_waiting_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (Drain(batch, max_count) != 0) {
+      consumer_waiting_.store(false, std::memory_order_relaxed);
+      return true;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    consumer_condition_.wait(lock, [this] {
+      return wake_ || closed_.load(std::memory_order_acquire);
+    });
+    consumer_waiting_.store(false, std::memory_order_relaxed);
+  }
+}
+
+void DetectionChannel::Close() {
+  closed_.store(true);
+  WakeConsumer();
+  space_condition_.notify_all();
+}
+
+std::size_t DetectionChannel::Drain(std::vector<Detection>& batch,
+                                    std::size_t max_count) {
+  std::size_t count = 0;
+  while (count < max_count && ring_.TryPop([&](Detection& slot) {
+    if (count == batch.size()) {
+      batch.emplace_back();
+    }
+    std::swap(batch[count], slot);
+  })) {
+    count++;
+  }
+  if (count != 0) {
+    batch.resize(count);
+    // Pairs with the count senders raise before sleeping on a full ring:
+    // either they see this drain, or it sees them waiting.
+    drains_.fetch_add(1);
+    if (full_senders_.load() != 0) {
+      {
+        // A sender holds the mutex from checking drains_ until it sleeps.
+        std::lock_guard<std::mutex> lock(mutex_);
+      }
+      space_condition_.notify_all();
+    }
+  }
+  return count;
+}
+
+void DetectionChannel::WakeConsumer() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    wake_ = true;
+  }
+  consumer_condition_.notify_one();
+}
+
+std::shared_ptr<IDetectionChannel> CreateDetectionChannel(
+    std::size_t capacity) {
+  return std::make_shared<DetectionChannel>(capacity);
+}
+
+}  // namespace scanner
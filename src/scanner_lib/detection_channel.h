@@ -0,0 +1,78 @@
+#ifndef SRC_SCANNER_LIB_DETECTION_CHANNEL_H_
+#define SRC_SCANNER_LIB_DETECTION_CHANNEL_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "scanner/interfaces.h"
+#include "src/scanner_lib/mpsc_ring.h"
+
+namespace scanner {
+
+/**
+ * @class DetectionChannel
+ * @brief An implementation of IDetectionChannel on a lock-free MpscRing.
+ *
+ * Workers copy a detection into a per-thread buffer and swap it into a ring
+ * slot, so the path and verdict buffers circulate between workers, slots and
+ * the consumer instead of being reallocated, and only take the mutex to wake
+ * the consumer when it is waiting. The consumer swaps slots with the elements
+ * of its batch, so detections reach it without a further copy and its old
+ * buffers return to the ring. If the ring is full, workers sleep until the
+ * consumer has drained it, which bounds memory use.
+ *
+ * Senders in progress are counted, so that a Send() racing Close() either
+ * returns false or queues a detection that Receive() still returns.
+ */
+class DetectionChannel final : public IDetectionChannel {
+public:
+  /**
+   * @brief Constructs an empty, open channel.
+   * @param capacity The number of detections the ring holds.
+   */
+  explicit DetectionChannel(std::size_t capacity);
+
+  DetectionChannel(const DetectionChannel&) = delete;
+  DetectionChannel& operator=(const DetectionChannel&) = delete;
+
+  bool Send(const std::filesystem::path& path, const AnyDigest& digest,
+            const std::string& verdict, std::uint64_t size) override;
+  bool Receive(std::vector<Detection>& batch, std::size_t max_count) override;
+  void Close() override;
+
+private:
+  // Queues a detection unless the channel is closed.
+  bool Push(const std::filesystem::path& path, const AnyDigest& digest,
+            const std::string& verdict, std::uint64_t size);
+  // Swaps up to max_count published detections into the batch.
+  std::size_t Drain(std::vector<Detection>& batch, std::size_t max_count);
+  void WakeConsumer();
+
+  MpscRing<Detection> ring_;
+  std::atomic<bool> closed_{false};
+  // Set by the consumer before it sleeps; producers only take the mutex then.
+  std::atomic<bool> consumer_waiting_{false};
+  // The Send() calls in progress.
+  std::atomic<std::size_t> senders_{0};
+  // The senders sleeping on a full ring, and the consumer's drains that may
+  // have made space for them.
+  std::atomic<std::size_t> full_senders_{0};
+  std::atomic<std::uint64_t> drains_{0};
+
+  std::mutex mutex_;
+  std::condition_variable consumer_condition_;
+  std::condition_variable space_condition_;
+  // Guarded by mutex_.
+  bool wake_ = false;
+};
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_DETECTION_CHANNEL_H_
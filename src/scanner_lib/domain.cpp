@@ -1,8 +1,111 @@
 #include "scanner/domain.h"
 
+#include <iomanip>
 #include <ostream>
+#include <sstream>
+#include <type_traits>
 
 namespace scanner {
+namespace {
+
+static_assert(std::is_trivially_copyable_v<Md5Digest>,
+              "Md5Digest must stay cheap to copy between pipeline stages");
+static_assert(sizeof(Md5Digest) == Md5Digest::kSize,
+              "Md5Digest must not carry padding");
+static_assert(sizeof(Sha1Digest) == Sha1Digest::kSize &&
+                  sizeof(Sha256Digest) == Sha256Digest::kSize,
+              "Digests must not carry padding");
+
+constexpr char kHexDigits[] = "0123456789abcdef";
+
+int HexValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+template <class Digest>
+std::optional<Digest> ParseHex(std::string_view hex) {
+  if (hex.size() != Digest::kSize * 2) {
+    return std::nullopt;
+  }
+
+  Digest digest;
+  for (std::size_t i = 0; i < Digest::kSize; ++i) {
+    const int high = HexValue(hex[i * 2]);
+    const int low = HexValue(hex[i * 2 + 1]);
+    if (high < 0 || low < 0) {
+      return std::nullopt;
+    }
+    digest.bytes[i] = static_cast<std::uint8_t>((high << 4) | low);
+  }
+  return digest;
+}
+
+template <class Digest>
+std::string FormatHex(const Digest& digest) {
+  std::string hex(Digest::kSize * 2, '\0');
+  for (std::size_t i = 0; i < Digest::kSize; ++i) {
+    hex[i * 2] = kHexDigits[digest.bytes[i] >> 4];
+    hex[i * 2 + 1] = kHexDigits[digest.bytes[i] & 0x0F];
+  }
+  return hex;
+}
+
+}  // namespace
+
+std::optional<Md5Digest> Md5Digest::FromHex(std::string_view hex) {
+  return ParseHex<Md5Digest>(hex);
+}
+
+std::string Md5Digest::ToHex() const {
+  return FormatHex(*this);
+}
+
+std::optional<Sha1Digest> Sha1Digest::FromHex(std::string_view hex) {
+  return ParseHex<Sha1Digest>(hex);
+}
+
+std::string Sha1Digest::ToHex() const {
+  return FormatHex(*this);
+}
+
+std::optional<Sha256Digest> Sha256Digest::FromHex(std::string_view hex) {
+  return ParseHex<Sha256Digest>(hex);
+}
+
+std::string Sha256Digest::ToHex() const {
+  return FormatHex(*this);
+}
+
+std::ostream& operator<<(std::ostream& os, const Md5Digest& digest) {
+  return os << digest.ToHex();
+}
+
+const char* ToString(ScanStage stage) {
+  switch (stage) {
+    case ScanStage::kTraversal:
+      return "traversal";
+    case ScanStage::kOpen:
+      return "open";
+    case ScanStage::kRead:
+      return "read";
+    case ScanStage::kHash:
+      return "hash";
+    case ScanStage::kLookup:
+      return "lookup";
+    case ScanStage::kLog:
+      return "log";
+  }
+  return "unknown";
+}
 
 std::ostream& operator<<(std::ostream& os, const ScanResult& result) {
   os << "--- Scan Report ---\n"
@@ -10,8 +113,153 @@ std::ostream& operator<<(std::ostream& os, const ScanResult& result) {
      << "Malicious detections: " << result.malicious_files_detected << "\n"
      << "Errors: " << result.errors << "\n"
      << "Execution time: " << result.execution_time.count() << " ms\n"
-     << "-------------------";
+     << "Peak queue depth: " << result.peak_queue_depth << " tasks\n"
+     << "Tail latency: " << result.tail_latency.count() << " ms\n"
+     << "Deduplicated hard links: " << result.deduplicated_files
+     << " files, " << result.deduplicated_bytes << " bytes\n";
+  if (result.prefilter) {
+    const auto flags = os.flags();
+    const auto precision = os.precision();
+    os << "Prefilter memory: " << result.prefilter->memory_bytes << " bytes\n"
+       << "Prefilter false positive rate: " << std::fixed
+       << std::setprecision(3)
+       << result.prefilter->false_positive_rate * 100.0 << "%\n";
+    os.flags(flags);
+    os.precision(precision);
+  }
+  if (result.file_cache) {
+    const std::uint64_t lookups =
+        result.file_cache->hits + result.file_cache->misses;
+    const double hit_rate =
+        lookups == 0 ? 0.0 : 100.0 * result.file_cache->hits / lookups;
+    const auto flags = os.flags();
+    const auto precision = os.precision();
+    os << "File cache hit rate: " << std::fixed << std::setprecision(2)
+       << hit_rate << "% (" << result.file_cache->hits << " of " << lookups
+       << " files)\n";
+    os.flags(flags);
+    os.precision(precision);
+  }
+  if (result.sample_index) {
+    os << "Skipped by sample size: " << result.sample_index->size_rejected
+       << " files\n"
+       << "Skipped by sample prefix: "
+       << result.sample_index->prefix_rejected << " of "
+       << result.sample_index->prefix_checked << " files\n";
+  }
+  if (result.metrics) {
+    const ScanMetrics& metrics = *result.metrics;
+    const auto flags = os.flags();
+    const auto precision = os.precision();
+    const auto micros = [](std::chrono::nanoseconds duration) {
+      return duration.count() / 1000.0;
+    };
+    os << std::fixed << std::setprecision(1)
+       << "Throughput: " << metrics.files_per_second << " files/s, "
+       << metrics.megabytes_per_second << " MB/s (" << metrics.bytes_read
+       << " bytes read)\n"
+       << "Stage latency (us): count, p50, p90, p99, max\n";
+    for (std::size_t i = 0; i < kScanStageCount; ++i) {
+      const StageLatency& stage = metrics.stages[i];
+      os << "  " << std::left << std::setw(10)
+         << ToString(static_cast<ScanStage>(i)) << std::right << stage.count
+         << ", " << micros(stage.p50) << ", " << micros(stage.p90) << ", "
+         << micros(stage.p99) << ", " << micros(stage.max) << "\n";
+    }
+    os.flags(flags);
+    os.precision(precision);
+  }
+  os << "-------------------";
+  return os;
+}
+
+std::string ToJson(const ScanResult& result) {
+  std::ostringstream os;
+  os << std::setprecision(6);
+  os << "{\"total_files_processed\": " << result.total_files_processed
+     << ", \"malicious_files_detected\": " << result.malicious_files_detected
+     << ", \"errors\": " << result.errors
+     << ", \"execution_time_ms\": " << result.execution_time.count()
+     << ", \"peak_queue_depth\": " << result.peak_queue_depth
+     << ", \"tail_latency_ms\": " << result.tail_latency.count()
+     << ", \"deduplicated_files\": " << result.deduplicated_files
+     << ", \"deduplicated_bytes\": " << result.deduplicated_bytes;
+  if (result.prefilter) {
+    os << ", \"prefilter\": {\"memory_bytes\": "
+       << result.prefilter->memory_bytes << ", \"false_positive_rate\": "
+       << result.prefilter->false_positive_rate << "}";
+  }
+  if (result.file_cache) {
+    os << ", \"file_cache\": {\"hits\": " << result.file_cache->hits
+       << ", \"misses\": " << result.file_cache->misses << "}";
+  }
+  if (result.sample_index) {
+    os << ", \"sample_index\": {\"size_rejected\": "
+       << result.sample_index->size_rejected << ", \"prefix_checked\": "
+       << result.sample_index->prefix_checked << ", \"prefix_rejected\": "
+       << result.sample_index->prefix_rejected << "}";
+  }
+  if (result.metrics) {
+    const ScanMetrics& metrics = *result.metrics;
+    os << ", \"metrics\": {\"bytes_read\": " << metrics.bytes_read
+       << ", \"files_per_second\": " << metrics.files_per_second
+       << ", \"megabytes_per_second\": " << metrics.megabytes_per_second
+       << ", \"stages\": {";
+    for (std::size_t i = 0; i < kScanStageCount; ++i) {
+      const StageLatency& stage = metrics.stages[i];
+      os << (i == 0 ? "" : ", ") << "\""
+         << ToString(static_cast<ScanStage>(i)) << "\": {\"count\": "
+         << stage.count << ", \"total_ns\": " << stage.total.count()
+         << ", \"p50_ns\": " << stage.p50.count()
+         << ", \"p90_ns\": " << stage.p90.count()
+         << ", \"p99_ns\": " << stage.p99.count()
+         << ", \"max_ns\": " << stage.max.count() << "}";
+    }
+    os << "}}";
+  }
+  os << "}";
+  return os.str();
+}
+
+std::ostream& operator<<(std::ostream& os, const ScanProgress& progress) {
+  const auto flags = os.flags();
+  const auto precision = os.precision();
+  os << "Progress: " << progress.files_processed << " of "
+     << progress.files_discovered << (progress.traversal_complete ? "" : "+")
+     << " files, " << progress.bytes_processed << " bytes, "
+     << progress.malicious_files_detected << " detections, "
+     << progress.errors << " errors, " << std::fixed << std::setprecision(1)
+     << progress.files_per_second << " files/s, "
+     << progress.bytes_per_second / 1e6 << " MB/s, ETA ";
+  if (progress.eta) {
+    os << progress.eta->count() << " s";
+  } else {
+    os << "unknown";
+  }
+  os.flags(flags);
+  os.precision(precision);
   return os;
 }
 
+std::string ToJson(const ScanProgress& progress) {
+  std::ostringstream os;
+  os << std::setprecision(6);
+  os << "{\"files_discovered\": " << progress.files_discovered
+     << ", \"traversal_complete\": "
+     << (progress.traversal_complete ? "true" : "false")
+     << ", \"files_processed\": " << progress.files_processed
+     << ", \"bytes_processed\": " << progress.bytes_processed
+     << ", \"malicious_files_detected\": "
+     << progress.malicious_files_detected
+     << ", \"errors\": " << progress.errors
+     << ", \"elapsed_ms\": " << progress.elapsed.count()
+     << ", \"files_per_second\": " << progress.files_per_second
+     << ", \"bytes_per_second\": " << progress.bytes_per_second;
+  if (progress.eta) {
+    os << ", \"eta_s\": " << progress.eta->count();
+  }
+  os << "}";
+  return os.str();
+}
+
 }  // namespace scanner
\ No newline at end of file
@@ -1,10 +1,50 @@
 #include "src/scanner_lib/file_logger.h"
 
-#include <iomanip>
-#include <sstream>
+#include <cstdint>
+
 #include <stdexcept>
+#include <string_view>
+#include <variant>
 
 namespace scanner {
+namespace {
+
+void AppendQuoted(std::string& line, std::string_view value) {
+  line += '"';
+  for (const char c : value) {
+    if (c == '"' || c == '\\') {
+      line += '\\';
+    }
+    line += c;
+  }
+  line += '"';
+}
+
+}  // namespace
+
+void AppendDetectionJson(std::string& line, const std::filesystem::path& path,
+                         const AnyDigest& hash, const std::string& verdict) {
+  static constexpr char kHexDigits[] = "0123456789abcdef";
+  line += "{\"path\": ";
+  // On POSIX native() is the string itself; elsewhere it has to be converted.
+#ifdef _WIN32
+  AppendQuoted(line, path.string());
+#else
+  AppendQuoted(line, path.native());
+#endif
+  line += ", \"hash\": \"";
+  std::visit(
+      [&line](const auto& digest) {
+        for (const std::uint8_t byte : digest.bytes) {
+          line += kHexDigits[byte >> 4];
+          line += kHexDigits[byte & 0x0F];
+        }
+      },
+      hash);
+  line += "\", \"verdict\": ";
+  AppendQuoted(line, verdict);
+  line += '}';
+}
 
 FileLogger::FileLogger(const std::filesystem::path& log_path) {
   log_stream_.open(log_path, std::ios::out | std::ios::app);
@@ -15,15 +55,19 @@ FileLogger::FileLogger(const std::filesystem::path& log_path) {
 }
 
 void FileLogger::LogDetection(const std::filesystem::path& path,
-                              const std::string& hash,
+                              const AnyDigest& hash,
                               const std::string& verdict) {
-  std::stringstream json_line;
-  json_line << "{\"path\": " << std::quoted(path.string(), '"', '\\')
-            << ", \"hash\": " << std::quoted(hash)
-            << ", \"verdict\": " << std::quoted(verdict) << "}";
+  thread_local std::string line;
+  line.clear();
+  AppendDetectionJson(line, path, hash, verdict);
+
+  const std::lock_guard<std::mutex> lock(mutex_);
+  log_stream_ << line << std::endl;
+}
 
+void FileLogger::Flush() {
   const std::lock_guard<std::mutex> lock(mutex_);
-  log_stream_ << json_line.str() << std::endl;
+  log_stream_.flush();
 }
 
 }  // namespace scanner
\ No newline at end of file
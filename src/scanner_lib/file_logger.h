@@ -10,6 +10,21 @@
 
 namespace scanner {
 
+/**
+ * @brief Appends a detection to a line as a JSON object, without a newline.
+ *
+ * Strings are quoted with backslash escapes for quotes and backslashes. No
+ * stream or temporary string is involved, so formatting allocates only when
+ * the line has to grow.
+ *
+ * @param line The string to append to.
+ * @param path The path to the detected file.
+ * @param hash The digest of the file, written as hexadecimal.
+ * @param verdict The verdict from the hash database.
+ */
+void AppendDetectionJson(std::string& line, const std::filesystem::path& path,
+                         const AnyDigest& hash, const std::string& verdict);
+
 /**
  * @class FileLogger
  * @brief An implementation of ILogger that writes detections to a file.
@@ -31,12 +46,15 @@ public:
   /**
    * @brief Logs a malicious file detection to the file in a thread-safe manner.
    * @param path The path to the detected file.
-   * @param hash The calculated hash of the file.
+   * @param hash The matching digest of the file, written as hexadecimal.
    * @param verdict The verdict from the hash database.
    */
-  void LogDetection(const std::filesystem::path& path, const std::string& hash,
+  void LogDetection(const std::filesystem::path& path, const AnyDigest& hash,
                     const std::string& verdict) override;
 
+  /** @brief Flushes the file; every detection is already flushed anyway. */
+  void Flush() override;
+
 private:
   std::ofstream log_stream_;
   std::mutex mutex_;
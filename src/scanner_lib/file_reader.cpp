@@ -0,0 +1,609 @@
+#include "src/scanner_lib/file_reader.h"
+
+#include <cerrno>
+#include <cstdint>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+#include "src/scanner_lib/io_uring.h"
+#include "src/scanner_lib/scan_metrics.h"
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace scanner {
+namespace {
+
+// Resizes a reused buffer. Its capacity grows geometrically, so that files
+// of slowly increasing sizes do not reallocate it on every read.
+void ResizeBuffer(std::vector<std::uint8_t>& buffer, std::size_t size) {
+  if (buffer.capacity() < size) {
+    buffer.reserve(std::max(size, 2 * buffer.capacity()));
+  }
+  buffer.resize(size);
+}
+
+// Returns a per-thread buffer of at least the requested size. Workers hash
+// one file at a time, so the buffer is reused for every file they read.
+std::uint8_t* ThreadBuffer(std::size_t size) {
+  thread_local std::vector<std::uint8_t> buffer;
+  if (buffer.size() < size) {
+    ResizeBuffer(buffer, size);
+  }
+  return buffer.data();
+}
+
+#ifndef _WIN32
+
+// Owns a file descriptor opened for reading.
+class FileDescriptor {
+public:
+  explicit FileDescriptor(const std::filesystem::path& path) {
+    {
+      StageTimer timer(ScanStage::kOpen);
+      fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    }
+    if (fd_ < 0) {
+      throw std::runtime_error("Failed to open file: " + path.string());
+    }
+  }
+
+  ~FileDescriptor() {
+    ::close(fd_);
+  }
+
+  FileDescriptor(const FileDescriptor&) = delete;
+  FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+  int Get() const {
+    return fd_;
+  }
+
+private:
+  int fd_;
+};
+
+std::uint64_t FileSize(const FileDescriptor& file,
+                       const std::filesystem::path& path) {
+  struct stat file_stat;
+  if (::fstat(file.Get(), &file_stat) != 0) {
+    throw std::runtime_error("Failed to query file size: " + path.string());
+  }
+  return static_cast<std::uint64_t>(file_stat.st_size);
+}
+
+// Reads up to size bytes at offset, retrying short and interrupted reads.
+// Returns fewer bytes only at end of file.
+std::size_t PreadFully(const FileDescriptor& file, std::uint8_t* data,
+                       std::size_t size, std::uint64_t offset,
+                       const std::filesystem::path& path) {
+  std::size_t total = 0;
+  while (total < size) {
+    const ssize_t result =
+        ::pread(file.Get(), data + total, size - total,
+                static_cast<off_t>(offset + total));
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error("Failed to read file: " + path.string());
+    }
+    if (result == 0) {
+      break;
+    }
+    total += static_cast<std::size_t>(result);
+  }
+  return total;
+}
+
+void ReadWithPread(const FileDescriptor& file, std::uint64_t file_size,
+                   const std::filesystem::path& path,
+                   const FileReader::ChunkConsumer& consumer) {
+  const std::size_t chunk_size = static_cast<std::size_t>(
+      std::min<std::uint64_t>(file_size, FileReader::kMaxPreadSize));
+  std::uint8_t* buffer = ThreadBuffer(chunk_size);
+  // Only the reads count, not the consumer's work between them.
+  StageAccumulator read_time(ScanStage::kRead);
+  std::uint64_t offset = 0;
+  while (offset < file_size) {
+    std::size_t bytes = 0;
+    {
+      StageAccumulator::Section section(read_time);
+      bytes = PreadFully(file, buffer, chunk_size, offset, path);
+    }
+    RecordBytesRead(bytes);
+    if (bytes == 0) {
+      break;  // The file was truncated while being read.
+    }
+    consumer(buffer, bytes);
+    offset += bytes;
+  }
+}
+
+void ReadWithRead(const FileDescriptor& file, std::size_t block_size,
+                  const std::filesystem::path& path,
+                  const FileReader::ChunkConsumer& consumer) {
+  std::uint8_t* buffer = ThreadBuffer(block_size);
+  StageAccumulator read_time(ScanStage::kRead);
+  while (true) {
+    ssize_t result = 0;
+    {
+      StageAccumulator::Section section(read_time);
+      result = ::read(file.Get(), buffer, block_size);
+    }
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error("Failed to read file: " + path.string());
+    }
+    if (result == 0) {
+      return;
+    }
+    RecordBytesRead(static_cast<std::uint64_t>(result));
+    consumer(buffer, static_cast<std::size_t>(result));
+  }
+}
+
+// Pages of a mapping past the end of its file raise SIGBUS when touched,
+// which happens if another process truncates a file while it is hashed.
+// While a thread hands a mapping to a consumer, faults inside it are
+// absorbed: the handler maps zero pages over the lost range and flags the
+// read, so the consumer returns normally and the read fails afterwards.
+// Jumping out of the consumer instead would skip its destructors. mmap is
+// not on the list of async-signal-safe functions, but it is a plain system
+// call on the platforms that map files, which is why the strategy using it
+// is opt-in (see IoStrategy::kMmap) and kAuto reads with pread.
+struct MappingGuard {
+  const volatile char* begin = nullptr;
+  const volatile char* end = nullptr;
+  volatile sig_atomic_t truncated = 0;
+};
+
+// Touched before a mapping is published, so that the handler never
+// allocates the thread's storage.
+thread_local MappingGuard mapping_guard;
+
+struct sigaction previous_sigbus_action;
+std::uintptr_t page_size = 0;
+
+void HandleSigbus(int signal, siginfo_t* info, void* context) {
+  MappingGuard& guard = mapping_guard;
+  const auto* addr = static_cast<const volatile char*>(info->si_addr);
+  if (guard.begin != nullptr && addr >= guard.begin && addr < guard.end) {
+    const auto page = reinterpret_cast<std::uintptr_t>(addr) & ~(page_size - 1);
+    const auto end = reinterpret_cast<std::uintptr_t>(guard.end);
+    if (::mmap(reinterpret_cast<void*>(page), end - page, PROT_READ,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) != MAP_FAILED) {
+      guard.truncated = 1;
+      return;
+    }
+  }
+  // Not ours: let whoever handled SIGBUS before handle it, or let the
+  // faulting access kill the process as it would have.
+  if ((previous_sigbus_action.sa_flags & SA_SIGINFO) != 0 &&
+      previous_sigbus_action.sa_sigaction != nullptr) {
+    previous_sigbus_action.sa_sigaction(signal, info, context);
+    return;
+  }
+  ::sigaction(SIGBUS, &previous_sigbus_action, nullptr);
+}
+
+void InstallSigbusHandler() {
+  static std::once_flag installed;
+  std::call_once(installed, [] {
+    page_size = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+    struct sigaction action = {};
+    action.sa_sigaction = HandleSigbus;
+    action.sa_flags = SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    ::sigaction(SIGBUS, &action, &previous_sigbus_action);
+  });
+}
+
+// Guards a mapping for the lifetime of the object.
+class ScopedMappingGuard {
+public:
+  ScopedMappingGuard(const void* addr, std::size_t size) {
+    InstallSigbusHandler();
+    mapping_guard.truncated = 0;
+    mapping_guard.end = static_cast<const char*>(addr) + size;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    mapping_guard.begin = static_cast<const char*>(addr);
+  }
+
+  ~ScopedMappingGuard() {
+    mapping_guard.begin = nullptr;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+  }
+
+  ScopedMappingGuard(const ScopedMappingGuard&) = delete;
+  ScopedMappingGuard& operator=(const ScopedMappingGuard&) = delete;
+
+  bool Truncated() const {
+    return mapping_guard.truncated != 0;
+  }
+};
+
+// Returns false if the file cannot be mapped, e.g. because it is not a
+// regular file, so that the caller can fall back to reading it.
+// Throws if the file shrinks while the consumer reads the mapping.
+bool ReadWithMmap(const FileDescriptor& file, std::uint64_t file_size,
+                  const std::filesystem::path& path,
+                  const FileReader::ChunkConsumer& consumer) {
+  const auto size = static_cast<std::size_t>(file_size);
+  void* addr = nullptr;
+  {
+    // The pages are read by the faults of the consumer, which count as
+    // hashing.
+    StageTimer timer(ScanStage::kRead);
+    addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file.Get(), 0);
+    if (addr == MAP_FAILED) {
+      return false;
+    }
+    // Sequential access lets the kernel read ahead aggressively and drop
+    // pages behind the reader.
+    ::madvise(addr, size, MADV_SEQUENTIAL);
+  }
+  RecordBytesRead(file_size);
+
+  struct Unmapper {
+    void* addr;
+    std::size_t size;
+    ~Unmapper() {
+      ::munmap(addr, size);
+    }
+  } unmapper{addr, size};
+
+  const ScopedMappingGuard guard(addr, size);
+  consumer(static_cast<const std::uint8_t*>(addr), size);
+  if (guard.Truncated()) {
+    throw std::runtime_error("File was truncated while being read: " +
+                             path.string());
+  }
+  return true;
+}
+
+#endif  // _WIN32
+
+}  // namespace
+
+FileReader::FileReader(const IoOptions& options) : options_(options) {
+  if (options_.read_block_size == 0) {
+    throw std::invalid_argument("Read block size must be positive");
+  }
+  if (options_.io_queue_depth < 2) {
+    throw std::invalid_argument("io_uring queue depth must be at least 2");
+  }
+}
+
+IoStrategy FileReader::StrategyFor(std::uint64_t) const {
+  // Mapping is opt-in, as it needs a SIGBUS handler for files that shrink
+  // while being read; see IoStrategy::kMmap.
+  if (options_.strategy == IoStrategy::kAuto ||
+      options_.strategy == IoStrategy::kIoUring) {
+    return IoStrategy::kPread;
+  }
+  return options_.strategy;
+}
+
+#ifdef _WIN32
+
+void FileReader::Read(const std::filesystem::path& path,
+                      const ChunkConsumer& consumer) const {
+  std::ifstream file_stream(path, std::ios::binary);
+  if (!file_stream) {
+    throw std::runtime_error("Failed to open file: " + path.string());
+  }
+  file_stream.exceptions(std::ifstream::badbit);
+
+  std::uint8_t* buffer = ThreadBuffer(options_.read_block_size);
+  StageAccumulator read_time(ScanStage::kRead);
+  while (file_stream) {
+    {
+      StageAccumulator::Section section(read_time);
+      file_stream.read(reinterpret_cast<char*>(buffer),
+                       static_cast<std::streamsize>(options_.read_block_size));
+    }
+    const auto bytes = static_cast<std::size_t>(file_stream.gcount());
+    RecordBytesRead(bytes);
+    if (bytes > 0) {
+      consumer(buffer, bytes);
+    }
+  }
+}
+
+bool FileReader::ReadAllUpTo(const std::filesystem::path& path,
+                             std::uint64_t max_size,
+                             std::vector<std::uint8_t>& buffer) {
+  std::ifstream file_stream(path, std::ios::binary | std::ios::ate);
+  if (!file_stream) {
+    throw std::runtime_error("Failed to open file: " + path.string());
+  }
+  file_stream.exceptions(std::ifstream::badbit);
+
+  const auto size = static_cast<std::uint64_t>(file_stream.tellg());
+  if (size > max_size) {
+    return false;
+  }
+  file_stream.seekg(0);
+  ResizeBuffer(buffer, static_cast<std::size_t>(size));
+  {
+    StageTimer timer(ScanStage::kRead);
+    file_stream.read(reinterpret_cast<char*>(buffer.data()),
+                     static_cast<std::streamsize>(size));
+  }
+  buffer.resize(static_cast<std::size_t>(file_stream.gcount()));
+  RecordBytesRead(buffer.size());
+  return true;
+}
+
+std::size_t FileReader::ReadPrefix(const std::filesystem::path& path,
+                                  std::uint8_t* data, std::size_t size) {
+  std::ifstream file_stream(path, std::ios::binary);
+  if (!file_stream) {
+    throw std::runtime_error("Failed to open file: " + path.string());
+  }
+  file_stream.exceptions(std::ifstream::badbit);
+  file_stream.read(reinterpret_cast<char*>(data),
+                   static_cast<std::streamsize>(size));
+  return static_cast<std::size_t>(file_stream.gcount());
+}
+
+void FileReader::ReadBatch(const std::vector<std::filesystem::path>& paths,
+                           std::uint64_t max_size,
+                           std::vector<BatchEntry>& entries) const {
+  ReadBatchSequentially(paths, 0, paths.size(), max_size, entries);
+}
+
+#else
+
+void FileReader::Read(const std::filesystem::path& path,
+                      const ChunkConsumer& consumer) const {
+  const FileDescriptor file(path);
+  const std::uint64_t file_size = FileSize(file, path);
+
+  switch (StrategyFor(file_size)) {
+    case IoStrategy::kMmap:
+      if (file_size == 0 || ReadWithMmap(file, file_size, path, consumer)) {
+        return;
+      }
+      break;
+    case IoStrategy::kPread:
+      ReadWithPread(file, file_size, path, consumer);
+      return;
+    case IoStrategy::kAuto:
+    case IoStrategy::kIoUring:
+    case IoStrategy::kRead:
+      // StrategyFor() resolves kAuto and kIoUring, as io_uring only reads
+      // batches; should either reach here, plain reads are the fallback.
+      break;
+  }
+  ReadWithRead(file, options_.read_block_size, path, consumer);
+}
+
+bool FileReader::ReadAllUpTo(const std::filesystem::path& path,
+                             std::uint64_t max_size,
+                             std::vector<std::uint8_t>& buffer) {
+  const FileDescriptor file(path);
+  const std::uint64_t size = FileSize(file, path);
+  if (size > max_size) {
+    return false;
+  }
+  ResizeBuffer(buffer, static_cast<std::size_t>(size));
+  {
+    StageTimer timer(ScanStage::kRead);
+    buffer.resize(PreadFully(file, buffer.data(), buffer.size(), 0, path));
+  }
+  RecordBytesRead(buffer.size());
+  return true;
+}
+
+std::size_t FileReader::ReadPrefix(const std::filesystem::path& path,
+                                  std::uint8_t* data, std::size_t size) {
+  const FileDescriptor file(path);
+  StageTimer timer(ScanStage::kRead);
+  const std::size_t bytes = PreadFully(file, data, size, 0, path);
+  RecordBytesRead(bytes);
+  return bytes;
+}
+
+void FileReader::ReadBatch(const std::vector<std::filesystem::path>& paths,
+                           std::uint64_t max_size,
+                           std::vector<BatchEntry>& entries) const {
+  if (entries.size() < paths.size()) {
+    entries.resize(paths.size());
+  }
+
+#ifdef __linux__
+  IoUring* ring = nullptr;
+  if (options_.strategy == IoStrategy::kIoUring) {
+    ring = ThreadRing(static_cast<unsigned>(std::min<std::size_t>(
+        options_.io_queue_depth, std::numeric_limits<unsigned>::max())));
+  }
+  if (ring != nullptr) {
+    // Every file needs two submission entries: its open and its statx.
+    const std::size_t files_per_round = ring->Capacity() / 2;
+    for (std::size_t first = 0; first < paths.size();
+         first += files_per_round) {
+      const std::size_t last =
+          std::min(paths.size(), first + files_per_round);
+      ReadRoundWithIoUring(*ring, paths, first, last, max_size, entries);
+    }
+    return;
+  }
+#endif  // __linux__
+  ReadBatchSequentially(paths, 0, paths.size(), max_size, entries);
+}
+
+#ifdef __linux__
+
+IoUring* FileReader::ThreadRing(unsigned entries) {
+  // Each worker thread owns a ring, so no synchronization is needed. A
+  // failed creation is remembered to avoid retrying it for every batch.
+  thread_local std::unique_ptr<IoUring> ring;
+  thread_local bool unavailable = false;
+  if (unavailable) {
+    return nullptr;
+  }
+  if (!ring || ring->Capacity() < entries) {
+    ring = IoUring::Create(entries);
+    unavailable = !ring;
+  }
+  return ring.get();
+}
+
+void FileReader::ReadRoundWithIoUring(
+    IoUring& ring, const std::vector<std::filesystem::path>& paths,
+    std::size_t first, std::size_t last, std::uint64_t max_size,
+    std::vector<BatchEntry>& entries) {
+  // The opens, reads and closes of a round overlap, so the round counts as
+  // one read per file.
+  StageTimer timer(ScanStage::kRead, last - first);
+  struct FileState {
+    int fd = -1;
+    int open_result = 0;
+    int statx_result = 0;
+    struct statx stx;
+    // Set while the file has a read in flight or still to submit.
+    bool reading = false;
+    std::size_t bytes_read = 0;
+  };
+  thread_local std::vector<FileState> states;
+  states.assign(last - first, FileState{});
+
+  // Round 1: open and query the size of every file at once.
+  for (std::size_t i = first; i < last; ++i) {
+    const char* path = paths[i].c_str();
+    const std::uint64_t index = i - first;
+    ring.PrepareOpenAt(path, O_RDONLY | O_CLOEXEC, 2 * index);
+    ring.PrepareStatx(path, STATX_SIZE, &states[index].stx, 2 * index + 1);
+  }
+  ring.SubmitAndWait([](std::uint64_t user_data, std::int32_t result) {
+    FileState& state = states[user_data / 2];
+    if (user_data % 2 == 0) {
+      state.open_result = result;
+      state.fd = result;
+    } else {
+      state.statx_result = result;
+    }
+  });
+
+  // Round 2: read every file that opened and fits into its buffer. A short
+  // read is continued by another round; only end of file stops a file
+  // early, when it was truncated after its size was queried.
+  std::size_t pending = 0;
+  for (std::size_t i = first; i < last; ++i) {
+    FileState& state = states[i - first];
+    BatchEntry& entry = entries[i];
+    entry.too_large = false;
+    entry.error = nullptr;
+    entry.content.clear();
+    if (state.open_result < 0) {
+      entry.error = std::make_exception_ptr(
+          std::runtime_error("Failed to open file: " + paths[i].string()));
+      continue;
+    }
+    if (state.statx_result < 0) {
+      entry.error = std::make_exception_ptr(std::runtime_error(
+          "Failed to query file size: " + paths[i].string()));
+      continue;
+    }
+    const std::uint64_t size = state.stx.stx_size;
+    if (size > max_size || size > std::numeric_limits<unsigned>::max()) {
+      entry.too_large = true;
+      continue;
+    }
+    ResizeBuffer(entry.content, static_cast<std::size_t>(size));
+    if (size > 0) {
+      state.reading = true;
+      ++pending;
+    }
+  }
+  while (pending > 0) {
+    for (std::size_t i = first; i < last; ++i) {
+      const FileState& state = states[i - first];
+      if (state.reading) {
+        std::vector<std::uint8_t>& content = entries[i].content;
+        ring.PrepareRead(state.fd, content.data() + state.bytes_read,
+                         static_cast<unsigned>(content.size() -
+                                               state.bytes_read),
+                         state.bytes_read, i);
+      }
+    }
+    ring.SubmitAndWait([&](std::uint64_t user_data, std::int32_t result) {
+      FileState& state = states[user_data - first];
+      BatchEntry& entry = entries[user_data];
+      if (result == -EINTR || result == -EAGAIN) {
+        return;  // Retried by the next round.
+      }
+      if (result < 0) {
+        entry.error = std::make_exception_ptr(std::runtime_error(
+            "Failed to read file: " + paths[user_data].string()));
+      } else {
+        state.bytes_read += static_cast<std::size_t>(result);
+        RecordBytesRead(static_cast<std::uint64_t>(result));
+        if (result > 0 && state.bytes_read < entry.content.size()) {
+          return;
+        }
+        entry.content.resize(state.bytes_read);
+      }
+      state.reading = false;
+      --pending;
+    });
+  }
+
+  // Round 3: close the files.
+  bool any_open = false;
+  for (const FileState& state : states) {
+    if (state.fd >= 0) {
+      ring.PrepareClose(state.fd, 0);
+      any_open = true;
+    }
+  }
+  if (any_open) {
+    ring.SubmitAndWait([](std::uint64_t, std::int32_t) {});
+  }
+}
+
+#endif  // __linux__
+
+#endif  // _WIN32
+
+void FileReader::ReadAll(const std::filesystem::path& path,
+                         std::vector<std::uint8_t>& buffer) {
+  ReadAllUpTo(path, std::numeric_limits<std::uint64_t>::max(), buffer);
+}
+
+void FileReader::ReadBatchSequentially(
+    const std::vector<std::filesystem::path>& paths, std::size_t first,
+    std::size_t last, std::uint64_t max_size,
+    std::vector<BatchEntry>& entries) {
+  if (entries.size() < last) {
+    entries.resize(last);
+  }
+  for (std::size_t i = first; i < last; ++i) {
+    BatchEntry& entry = entries[i];
+    entry.error = nullptr;
+    try {
+      entry.too_large = !ReadAllUpTo(paths[i], max_size, entry.content);
+    } catch (...) {
+      entry.too_large = false;
+      entry.error = std::current_exception();
+    }
+  }
+}
+
+}  // namespace scanner
@@ -0,0 +1,140 @@
+#ifndef SRC_SCANNER_LIB_FILE_READER_H_
+#define SRC_SCANNER_LIB_FILE_READER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <vector>
+
+#include "scanner/domain.h"
+
+namespace scanner {
+
+class IoUring;
+
+/**
+ * @class FileReader
+ * @brief Reads file contents using a configurable I/O strategy.
+ *
+ * Bypasses iostreams in favor of the operating system's primitives: files
+ * are read with positioned reads into a reusable per-thread buffer, and
+ * memory mapping with a sequential access hint and plain block-sized reads
+ * are available as alternatives. Batches of whole
+ * files can be read through io_uring. On platforms without these primitives,
+ * reads go through std::ifstream. This class is an internal, non-exported
+ * component of the scanner library.
+ */
+class FileReader {
+public:
+  /** @brief Receives consecutive pieces of a file's content. */
+  using ChunkConsumer =
+      std::function<void(const std::uint8_t* data, std::size_t size)>;
+
+  /** @brief The largest single read issued by IoStrategy::kPread. */
+  static constexpr std::size_t kMaxPreadSize = 8 * 1024 * 1024;
+
+  /** @brief The outcome of reading one file of a batch. */
+  struct BatchEntry {
+    /** @brief The file's content; its capacity is reused across batches. */
+    std::vector<std::uint8_t> content;
+    /** @brief Set if the file exceeds the batch's size limit. */
+    bool too_large = false;
+    /** @brief Set if the file could not be read. */
+    std::exception_ptr error;
+  };
+
+  /**
+   * @brief Constructs a reader.
+   * @param options The I/O strategy and its parameters.
+   * @throws std::invalid_argument if the read block size is zero or the
+   * io_uring queue depth is below 2.
+   */
+  explicit FileReader(const IoOptions& options = {});
+
+  /**
+   * @brief Feeds a file's content to the consumer, in order.
+   * @param path The file to read.
+   * @param consumer Called once per chunk; not called for empty files.
+   * @throws std::runtime_error if the file cannot be opened or read.
+   */
+  void Read(const std::filesystem::path& path,
+            const ChunkConsumer& consumer) const;
+
+  /**
+   * @brief Reads a whole file into a buffer with as few reads as possible.
+   * @param path The file to read.
+   * @param buffer Receives the content; its capacity is reused.
+   * @throws std::runtime_error if the file cannot be opened or read.
+   */
+  static void ReadAll(const std::filesystem::path& path,
+                      std::vector<std::uint8_t>& buffer);
+
+  /**
+   * @brief Reads the leading bytes of a file.
+   * @param path The file to read.
+   * @param data Receives the bytes.
+   * @param size The number of bytes to read.
+   * @return The number of bytes read; less than size only at end of file.
+   * @throws std::runtime_error if the file cannot be opened or read.
+   */
+  static std::size_t ReadPrefix(const std::filesystem::path& path,
+                                std::uint8_t* data, std::size_t size);
+
+  /**
+   * @brief Reads several whole files.
+   *
+   * With IoStrategy::kIoUring, the opens, size queries and reads of up to
+   * half the queue depth of files are in flight at once on a per-thread ring.
+   * Otherwise, or if io_uring is unavailable, the files are read one by one.
+   *
+   * @param paths The files to read.
+   * @param max_size Files larger than this are flagged as too large instead
+   * of being read.
+   * @param entries Grown to at least paths.size(); entry i describes
+   * paths[i]. Failures are reported per entry rather than thrown.
+   */
+  void ReadBatch(const std::vector<std::filesystem::path>& paths,
+                 std::uint64_t max_size,
+                 std::vector<BatchEntry>& entries) const;
+
+  /** @brief Returns the strategy used for a file of the given size. */
+  IoStrategy StrategyFor(std::uint64_t file_size) const;
+
+  /** @brief Returns the options the reader was constructed with. */
+  const IoOptions& Options() const {
+    return options_;
+  }
+
+private:
+  // Reads a whole file unless it exceeds max_size; returns false if it does.
+  static bool ReadAllUpTo(const std::filesystem::path& path,
+                          std::uint64_t max_size,
+                          std::vector<std::uint8_t>& buffer);
+
+  // Reads paths[first, last) one by one into entries.
+  static void ReadBatchSequentially(
+      const std::vector<std::filesystem::path>& paths, std::size_t first,
+      std::size_t last, std::uint64_t max_size,
+      std::vector<BatchEntry>& entries);
+
+#ifdef __linux__
+  // Returns the calling thread's ring with at least the given number of
+  // entries, or nullptr if io_uring is unavailable.
+  static IoUring* ThreadRing(unsigned entries);
+
+  // Reads paths[first, last) with all operations of each step in flight.
+  static void ReadRoundWithIoUring(
+      IoUring& ring, const std::vector<std::filesystem::path>& paths,
+      std::size_t first, std::size_t last, std::uint64_t max_size,
+      std::vector<BatchEntry>& entries);
+#endif  // __linux__
+
+  IoOptions options_;
+};
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_FILE_READER_H_
@@ -0,0 +1,222 @@
+#include "src/scanner_lib/file_state_cache.h"
+
+#include <chrono>
+#include <cstring>
+
+#include <fstream>
+#include <istream>
+#include <stdexcept>
+#include <system_error>
+#include <unordered_set>
+#include <utility>
+
+namespace scanner {
+namespace {
+
+constexpr char kMagic[8] = {'S', 'C', 'N', 'C', 'A', 'C', 'H', 'E'};
+constexpr std::uint32_t kVersion = 2;
+constexpr std::uint32_t kByteOrderMark = 0x01020304;
+
+struct FileHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t byte_order_mark;
+  std::uint64_t entry_count;
+};
+
+static_assert(sizeof(FileHeader) == 24, "FileHeader layout must be stable");
+
+// Followed by the file's path, path_length characters in the native encoding.
+struct Record {
+  FileState state;
+  Md5Digest digest;
+  std::uint64_t path_length;
+};
+
+static_assert(sizeof(Record) == 64, "Record layout must be stable");
+
+using PathString = std::filesystem::path::string_type;
+
+struct SavedEntry {
+  FileState state;
+  Md5Digest digest;
+  PathString path;
+};
+
+bool ReadPath(std::istream& in, std::uint64_t length, PathString& path) {
+  constexpr std::uint64_t kMaxPathLength = 1 << 16;
+  if (length > kMaxPathLength) {
+    return false;
+  }
+  path.resize(length);
+  return static_cast<bool>(
+      in.read(reinterpret_cast<char*>(path.data()),
+              static_cast<std::streamsize>(length * sizeof(path[0]))));
+}
+
+std::int64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+// Makes a path absolute and lexically normal, so that paths spelled
+// differently by different scans compare equal.
+PathString NormalPath(const std::filesystem::path& path,
+                       const std::filesystem::path& current_directory) {
+  if (path.is_absolute()) {
+    return path.lexically_normal().native();
+  }
+  return (current_directory / path).lexically_normal().native();
+}
+
+bool IsUnder(const PathString& path, const PathString& root) {
+  constexpr auto kSeparator = std::filesystem::path::preferred_separator;
+  std::size_t length = root.size();
+  // A normal directory path may end in a separator, as "/" always does.
+  if (length > 0 && root[length - 1] == kSeparator) {
+    --length;
+  }
+  return path.size() > length && path[length] == kSeparator &&
+         path.compare(0, length, root, 0, length) == 0;
+}
+
+}  // namespace
+
+FileStateCache::FileStateCache(std::filesystem::path path)
+    : path_(std::move(path)) {
+}
+
+void FileStateCache::Load() {
+  entries_.clear();
+
+  std::ifstream in(path_, std::ios::binary);
+  if (!in) {
+    return;  // No previous scan.
+  }
+
+  FileHeader header{};
+  if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+    throw std::runtime_error("Not a file cache: " + path_.string());
+  }
+  if (header.version != kVersion || header.byte_order_mark != kByteOrderMark) {
+    return;  // Rebuilt from scratch by this scan.
+  }
+
+  entries_.reserve(header.entry_count);
+  Record record;
+  PathString path;
+  for (std::uint64_t i = 0; i < header.entry_count; ++i) {
+    if (!in.read(reinterpret_cast<char*>(&record), sizeof(record)) ||
+        !ReadPath(in, record.path_length, path)) {
+      entries_.clear();
+      throw std::runtime_error("Truncated file cache: " + path_.string());
+    }
+    entries_.try_emplace(record.state, record.digest, std::move(path));
+  }
+}
+
+void FileStateCache::Save(
+    const std::optional<std::filesystem::path>& scanned_root) {
+  std::error_code ec;
+  const std::filesystem::path current_directory =
+      std::filesystem::current_path(ec);
+
+  std::vector<SavedEntry> saved;
+  std::unordered_set<PathString> inserted_paths;
+  for (Shard& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    for (const auto& [state, digest, path] : shard.inserted) {
+      saved.push_back({state, digest, NormalPath(path, current_directory)});
+      inserted_paths.insert(saved.back().path);
+    }
+  }
+
+  const std::optional<PathString> root =
+      scanned_root ? std::optional<PathString>(
+                         NormalPath(*scanned_root, current_directory))
+                   : std::nullopt;
+  for (const auto& [state, entry] : entries_) {
+    // An unused entry under the scanned root, or one replaced by a newer
+    // digest for the same path, describes a file that no longer exists.
+    if (!entry.used.load(std::memory_order_relaxed) &&
+        ((root && IsUnder(entry.path, *root)) ||
+         inserted_paths.count(entry.path) != 0)) {
+      continue;
+    }
+    saved.push_back({state, entry.digest, entry.path});
+  }
+
+  FileHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(header.magic));
+  header.version = kVersion;
+  header.byte_order_mark = kByteOrderMark;
+  header.entry_count = saved.size();
+
+  // Write next to the destination and rename into place, so an interrupted
+  // save leaves the previous cache intact.
+  std::filesystem::path temp_path = path_;
+  temp_path += ".tmp";
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      throw std::runtime_error("Failed to open file cache for writing: " +
+                               temp_path.string());
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const SavedEntry& entry : saved) {
+      const Record record{entry.state, entry.digest, entry.path.size()};
+      out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+      out.write(reinterpret_cast<const char*>(entry.path.data()),
+                static_cast<std::streamsize>(entry.path.size() *
+                                             sizeof(entry.path[0])));
+    }
+    out.close();
+    if (!out) {
+      throw std::runtime_error("Failed to write file cache: " +
+                               temp_path.string());
+    }
+  }
+
+  std::filesystem::rename(temp_path, path_, ec);
+  if (ec) {
+    std::filesystem::remove(temp_path, ec);
+    throw std::runtime_error("Failed to replace file cache: " +
+                             path_.string());
+  }
+
+  // The inserted entries are only dropped once they are on disk.
+  for (Shard& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.inserted.clear();
+  }
+  entries_.clear();
+  entries_.reserve(saved.size());
+  for (SavedEntry& entry : saved) {
+    entries_.try_emplace(entry.state, entry.digest, std::move(entry.path));
+  }
+}
+
+std::optional<Md5Digest> FileStateCache::Find(const FileState& state) const {
+  const auto it = entries_.find(state);
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+  if (!it->second.used.load(std::memory_order_relaxed)) {
+    it->second.used.store(true, std::memory_order_relaxed);
+  }
+  return it->second.digest;
+}
+
+void FileStateCache::Insert(const FileState& state, const Md5Digest& digest,
+                            const std::filesystem::path& path) {
+  if (state.mtime_ns > NowNs() - kRacyWindowNs) {
+    return;
+  }
+  Shard& shard = shards_[FileStateHash()(state) % kShardCount];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  shard.inserted.emplace_back(state, digest, path);
+}
+
+}  // namespace scanner
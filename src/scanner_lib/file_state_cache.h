@@ -0,0 +1,135 @@
+#ifndef SRC_SCANNER_LIB_FILE_STATE_CACHE_H_
+#define SRC_SCANNER_LIB_FILE_STATE_CACHE_H_
+
+#include <cstdint>
+
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "scanner/domain.h"
+#include "src/scanner_lib/file_status.h"
+
+namespace scanner {
+
+/**
+ * @class FileStateCache
+ * @brief A persistent map from file states to the digests of their content.
+ *
+ * Lets a rescan skip hashing files that have not changed since the previous
+ * scan; StatFile() provides a file's current state. Only digests are cached,
+ * not verdicts, so cached digests are looked up in the current signature
+ * database like freshly computed ones.
+ *
+ * The entries loaded from disk are read-only during a scan, so Find() takes
+ * no lock. Digests computed during the scan are collected in sharded lists and
+ * merged when the cache is saved. Each entry records the path of the file it
+ * was computed for, so that saving can tell which unused entries belong to
+ * the scanned tree: those describe files that have changed or disappeared and
+ * are dropped, while entries for other trees are kept for their next scan.
+ *
+ * The file is stored in the byte order of the machine that wrote it. Files
+ * from another version of the format or another byte order are ignored.
+ */
+class FileStateCache {
+public:
+  /**
+   * @brief Files modified within this many nanoseconds before being hashed
+   * are not cached: on filesystems with coarse timestamps they could change
+   * again without their modification time moving.
+   */
+  static constexpr std::int64_t kRacyWindowNs = 2'000'000'000;
+
+  /**
+   * @brief Constructs an empty cache backed by a file.
+   * @param path The file the cache is loaded from and saved to.
+   */
+  explicit FileStateCache(std::filesystem::path path);
+
+  FileStateCache(const FileStateCache&) = delete;
+  FileStateCache& operator=(const FileStateCache&) = delete;
+
+  /**
+   * @brief Loads the entries saved by a previous scan, replacing the current
+   * ones. A missing file, or one written by an incompatible version, leaves
+   * the cache empty.
+   * @throws std::runtime_error if the file is truncated or not a cache file.
+   */
+  void Load();
+
+  /**
+   * @brief Writes the cache, replacing the file atomically, and keeps its
+   * entries for the next scan.
+   *
+   * Entries found or inserted since the last save are kept. An entry that was
+   * not is dropped if its file lies under scanned_root, or if a newer digest
+   * was inserted for the same path; others are kept. Paths are compared
+   * lexically, relative ones taken against the current directory.
+   *
+   * @param scanned_root The directory the scan walked in full, if any.
+   * @throws std::runtime_error if the file cannot be written.
+   */
+  void Save(const std::optional<std::filesystem::path>& scanned_root =
+                std::nullopt);
+
+  /**
+   * @brief Looks up the digest of a file state. This method is thread-safe.
+   * @param state The current state of the file.
+   * @return The cached digest, or std::nullopt if the state is unknown.
+   */
+  std::optional<Md5Digest> Find(const FileState& state) const;
+
+  /**
+   * @brief Records the digest of a file state. This method is thread-safe.
+   *
+   * The entry becomes visible to Find() only after the next Save(). It is
+   * dropped if the file was modified within kRacyWindowNs.
+   *
+   * @param state The state of the file before it was hashed.
+   * @param digest The digest of the file's content.
+   * @param path The file that was hashed.
+   */
+  void Insert(const FileState& state, const Md5Digest& digest,
+              const std::filesystem::path& path);
+
+  /** @brief Returns the number of entries visible to Find(). */
+  std::size_t Size() const {
+    return entries_.size();
+  }
+
+private:
+  struct Entry {
+    Entry(const Md5Digest& entry_digest,
+          std::filesystem::path::string_type entry_path)
+        : digest(entry_digest), path(std::move(entry_path)) {
+    }
+
+    Md5Digest digest;
+    // Absolute and lexically normal.
+    std::filesystem::path::string_type path;
+    // Set when the entry is found, so that it is kept by the next save.
+    mutable std::atomic<bool> used{false};
+  };
+
+  struct Shard {
+    std::mutex mutex;
+    std::vector<std::tuple<FileState, Md5Digest, std::filesystem::path>>
+        inserted;
+  };
+
+  static constexpr std::size_t kShardCount = 16;
+
+  std::filesystem::path path_;
+  std::unordered_map<FileState, Entry, FileStateHash> entries_;
+  std::array<Shard, kShardCount> shards_;
+};
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_FILE_STATE_CACHE_H_
@@ -0,0 +1,100 @@
+#include "src/scanner_lib/file_status.h"
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/fiemap.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+namespace scanner {
+
+std::size_t FileStateHash::operator()(const FileState& state) const noexcept {
+  // Inodes are nearly unique on their own; the rest is mixed in cheaply.
+  std::uint64_t hash = state.inode * 0x9E3779B97F4A7C15ULL;
+  hash ^= state.device + (hash << 6) + (hash >> 2);
+  hash ^= static_cast<std::uint64_t>(state.mtime_ns) + (hash << 6) +
+          (hash >> 2);
+  hash ^= state.size + (hash << 6) + (hash >> 2);
+  return static_cast<std::size_t>(hash);
+}
+
+std::optional<FileStatus> StatFile(const std::filesystem::path& path) {
+#ifdef _WIN32
+  (void)path;
+  return std::nullopt;
+#else
+  struct stat status;
+  if (::stat(path.c_str(), &status) != 0 || !S_ISREG(status.st_mode)) {
+    return std::nullopt;
+  }
+#ifdef __APPLE__
+  const struct timespec& mtime = status.st_mtimespec;
+  const struct timespec& ctime = status.st_ctimespec;
+#else
+  const struct timespec& mtime = status.st_mtim;
+  const struct timespec& ctime = status.st_ctim;
+#endif
+  FileStatus file;
+  FileState& state = file.state;
+  state.device = static_cast<std::uint64_t>(status.st_dev);
+  state.inode = static_cast<std::uint64_t>(status.st_ino);
+  state.size = static_cast<std::uint64_t>(status.st_size);
+  state.mtime_ns = std::int64_t{mtime.tv_sec} * 1'000'000'000 + mtime.tv_nsec;
+  state.ctime_ns = std::int64_t{ctime.tv_sec} * 1'000'000'000 + ctime.tv_nsec;
+  file.link_count = static_cast<std::uint64_t>(status.st_nlink);
+  return file;
+#endif
+}
+
+std::optional<std::uint64_t> DeviceOf(const std::filesystem::path& path) {
+#ifdef _WIN32
+  (void)path;
+  return std::nullopt;
+#else
+  struct stat status;
+  if (::stat(path.c_str(), &status) != 0) {
+    return std::nullopt;
+  }
+  return static_cast<std::uint64_t>(status.st_dev);
+#endif
+}
+
+std::optional<std::uint64_t> PhysicalOffset(const std::filesystem::path& path) {
+#ifdef __linux__
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return std::nullopt;
+  }
+  // Room for the header and the single extent asked for.
+  alignas(struct fiemap) unsigned char
+      buffer[sizeof(struct fiemap) + sizeof(struct fiemap_extent)] = {};
+  auto* map = reinterpret_cast<struct fiemap*>(buffer);
+  map->fm_start = 0;
+  map->fm_length = FIEMAP_MAX_OFFSET;
+  map->fm_extent_count = 1;
+  const bool mapped = ::ioctl(fd, FS_IOC_FIEMAP, map) == 0;
+  ::close(fd);
+  // An unknown location is as good as none, and an offset of 0 is the
+  // placeholder some filesystems report for data not yet allocated.
+  if (!mapped || map->fm_mapped_extents == 0) {
+    return std::nullopt;
+  }
+  const struct fiemap_extent& extent = map->fm_extents[0];
+  if ((extent.fe_flags & FIEMAP_EXTENT_UNKNOWN) != 0 ||
+      extent.fe_physical == 0) {
+    return std::nullopt;
+  }
+  return static_cast<std::uint64_t>(extent.fe_physical);
+#else
+  (void)path;
+  return std::nullopt;
+#endif
+}
+
+}  // namespace scanner
@@ -0,0 +1,78 @@
+#ifndef SRC_SCANNER_LIB_FILE_STATUS_H_
+#define SRC_SCANNER_LIB_FILE_STATUS_H_
+
+#include <cstdint>
+
+#include <filesystem>
+#include <optional>
+
+namespace scanner {
+
+/**
+ * @struct FileState
+ * @brief Identifies a version of a file by its inode and metadata.
+ *
+ * Rewriting a file changes its size or modification time, and replacing it
+ * changes its inode or change time, so a file whose state is unchanged still
+ * has the content it had when its state was recorded.
+ */
+struct FileState {
+  std::uint64_t device = 0;
+  std::uint64_t inode = 0;
+  std::uint64_t size = 0;
+  std::int64_t mtime_ns = 0;
+  std::int64_t ctime_ns = 0;
+};
+
+inline bool operator==(const FileState& lhs, const FileState& rhs) {
+  return lhs.device == rhs.device && lhs.inode == rhs.inode &&
+         lhs.size == rhs.size && lhs.mtime_ns == rhs.mtime_ns &&
+         lhs.ctime_ns == rhs.ctime_ns;
+}
+
+/** @brief Hash functor for using FileState as an unordered container key. */
+struct FileStateHash {
+  std::size_t operator()(const FileState& state) const noexcept;
+};
+
+/**
+ * @struct FileStatus
+ * @brief The metadata of a file that the scanner acts on before hashing it.
+ */
+struct FileStatus {
+  FileState state;
+  /** @brief The number of hard links to the file. */
+  std::uint64_t link_count = 1;
+};
+
+/**
+ * @brief Reads the status of a regular file, following symbolic links.
+ * @param path The file to inspect.
+ * @return The file's status, or std::nullopt if it cannot be read, is not a
+ * regular file, or the platform provides no inode numbers (Windows).
+ */
+std::optional<FileStatus> StatFile(const std::filesystem::path& path);
+
+/**
+ * @brief Reads the device a file or directory resides on, following symbolic
+ * links.
+ * @param path The file or directory to inspect.
+ * @return The device ID, or std::nullopt if it cannot be read or the platform
+ * provides none (Windows).
+ */
+std::optional<std::uint64_t> DeviceOf(const std::filesystem::path& path);
+
+/**
+ * @brief Reads where the data of a file starts on its device, using the
+ * FIEMAP ioctl.
+ * @param path The file to inspect.
+ * @return The physical byte offset of the file's first extent, or
+ * std::nullopt if the file has no extents (e.g. it is empty or its data is
+ * inlined), cannot be opened, its filesystem does not support FIEMAP, or the
+ * platform is not Linux.
+ */
+std::optional<std::uint64_t> PhysicalOffset(const std::filesystem::path& path);
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_FILE_STATUS_H_
@@ -0,0 +1,60 @@
+#include "src/scanner_lib/hardlink_tracker.h"
+
+#include <utility>
+
+namespace scanner {
+
+HardlinkTracker::Claim HardlinkTracker::Register(
+    const FileStatus& status, const std::filesystem::path& path,
+    FileHashResult& result) {
+  const Key key{status.state.device, status.state.inode};
+  Shard& shard = ShardOf(key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  const auto [it, inserted] = shard.entries.try_emplace(key);
+  Entry& entry = it->second;
+  if (inserted) {
+    entry.unseen_links = status.link_count > 0 ? status.link_count - 1 : 0;
+    return Claim::kFirst;
+  }
+  if (entry.unseen_links > 0) {
+    --entry.unseen_links;
+  }
+  if (entry.resolved) {
+    result = entry.result;
+    if (entry.unseen_links == 0) {
+      shard.entries.erase(it);
+    }
+    return Claim::kResolved;
+  }
+  entry.queued.push_back(path);
+  return Claim::kQueued;
+}
+
+std::vector<std::filesystem::path> HardlinkTracker::Resolve(
+    const FileState& state, const FileHashResult& result) {
+  const Key key{state.device, state.inode};
+  Shard& shard = ShardOf(key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  const auto it = shard.entries.find(key);
+  if (it == shard.entries.end()) {
+    return {};
+  }
+  std::vector<std::filesystem::path> queued = std::move(it->second.queued);
+  if (it->second.unseen_links == 0) {
+    shard.entries.erase(it);
+  } else {
+    it->second.resolved = true;
+    it->second.result = result;
+    it->second.queued.clear();
+  }
+  return queued;
+}
+
+void HardlinkTracker::Clear() {
+  for (Shard& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.entries.clear();
+  }
+}
+
+}  // namespace scanner
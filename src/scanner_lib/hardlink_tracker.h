@@ -0,0 +1,110 @@
+#ifndef SRC_SCANNER_LIB_HARDLINK_TRACKER_H_
+#define SRC_SCANNER_LIB_HARDLINK_TRACKER_H_
+
+#include <cstdint>
+
+#include <array>
+#include <filesystem>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "scanner/interfaces.h"
+#include "src/scanner_lib/file_status.h"
+
+namespace scanner {
+
+/**
+ * @class HardlinkTracker
+ * @brief Ensures a file reachable through several hard links is hashed once.
+ *
+ * Files are identified by (device, inode). The first path registered for a
+ * file claims it: the caller hashes the file and publishes the outcome with
+ * Resolve(). Paths registered while the file is being hashed are queued and
+ * handed back by Resolve(); paths registered afterwards receive the outcome
+ * immediately. No caller ever waits for another, so workers keep running.
+ *
+ * Only files with more than one link need to be registered. A file is
+ * forgotten once as many paths as it has links have been registered, so the
+ * map holds only files with links still to be found; links outside the
+ * scanned tree keep theirs until Clear(). The map is sharded by inode so
+ * that concurrent registrations rarely contend.
+ */
+class HardlinkTracker {
+public:
+  /** @brief The outcome of registering a path. */
+  enum class Claim {
+    /** @brief The caller must hash the file and call Resolve(). */
+    kFirst,
+    /** @brief The file was already hashed; the outcome has been copied. */
+    kResolved,
+    /** @brief The file is being hashed; Resolve() will return the path. */
+    kQueued,
+  };
+
+  /**
+   * @brief Registers a path of a file. This method is thread-safe.
+   * @param status The status of the file; its device and inode identify it,
+   * and its link count bounds the paths registered for it.
+   * @param path The path through which the file was found.
+   * @param result Receives the outcome if the file was already hashed.
+   * @return How the caller has to proceed with the path.
+   */
+  Claim Register(const FileStatus& status, const std::filesystem::path& path,
+                 FileHashResult& result);
+
+  /**
+   * @brief Publishes the outcome of hashing a file claimed with kFirst.
+   * This method is thread-safe.
+   * @param state The state the file was registered with.
+   * @param result The digest of the file, or the error hashing it raised.
+   * @return The paths queued while the file was being hashed.
+   */
+  std::vector<std::filesystem::path> Resolve(const FileState& state,
+                                             const FileHashResult& result);
+
+  /** @brief Forgets every file, e.g., before a new scan. */
+  void Clear();
+
+private:
+  struct Key {
+    std::uint64_t device;
+    std::uint64_t inode;
+
+    bool operator==(const Key& other) const {
+      return device == other.device && inode == other.inode;
+    }
+  };
+
+  struct KeyHash {
+    std::size_t operator()(const Key& key) const noexcept {
+      return static_cast<std::size_t>(
+          (key.inode ^ (key.device << 32)) * 0x9E3779B97F4A7C15ULL);
+    }
+  };
+
+  struct Entry {
+    // The links not registered yet, as counted when the first one was.
+    std::uint64_t unseen_links = 0;
+    bool resolved = false;
+    FileHashResult result;
+    std::vector<std::filesystem::path> queued;
+  };
+
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_map<Key, Entry, KeyHash> entries;
+  };
+
+  static constexpr std::size_t kShardCount = 64;
+
+  Shard& ShardOf(const Key& key) {
+    return shards_[KeyHash()(key) % kShardCount];
+  }
+
+  std::array<Shard, kShardCount> shards_;
+};
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_HARDLINK_TRACKER_H_
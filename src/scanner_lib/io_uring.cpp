@@ -0,0 +1,257 @@
+#include "src/scanner_lib/io_uring.h"
+
+#include <stdexcept>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+#endif
+
+// IORING_FEAT_RW_CUR_POS arrived with Linux 5.6 together with the openat,
+// statx, read and close operations used below.
+#ifdef IORING_FEAT_RW_CUR_POS
+#define SCANNER_HAS_IO_URING 1
+#endif
+
+#ifdef SCANNER_HAS_IO_URING
+#include <cerrno>
+#include <cstring>
+
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace scanner {
+
+#ifdef SCANNER_HAS_IO_URING
+
+namespace {
+
+int Setup(unsigned entries, io_uring_params* params) {
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int Enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+  return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit,
+                                    min_complete, flags, nullptr, 0));
+}
+
+int Register(int fd, unsigned opcode, void* arg, unsigned nr_args) {
+  return static_cast<int>(
+      ::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+bool SupportsRequiredOps(int fd) {
+  constexpr unsigned kMaxOps = 256;
+  std::vector<unsigned char> storage(sizeof(io_uring_probe) +
+                                     kMaxOps * sizeof(io_uring_probe_op));
+  auto* probe = reinterpret_cast<io_uring_probe*>(storage.data());
+  if (Register(fd, IORING_REGISTER_PROBE, probe, kMaxOps) < 0) {
+    return false;
+  }
+  for (const unsigned op : {IORING_OP_OPENAT, IORING_OP_STATX,
+                            IORING_OP_READ, IORING_OP_CLOSE}) {
+    if (op > probe->last_op ||
+        (probe->ops[op].flags & IO_URING_OP_SUPPORTED) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <class T>
+T* At(void* base, unsigned offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+}  // namespace
+
+std::unique_ptr<IoUring> IoUring::Create(unsigned entries) {
+  io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+  const int fd = Setup(entries, &params);
+  if (fd < 0) {
+    return nullptr;
+  }
+
+  std::unique_ptr<IoUring> ring(new IoUring());
+  ring->ring_fd_ = fd;
+  // Rings created before Linux 5.4 would need two mappings; those kernels
+  // also lack the operations below, so they are simply not supported.
+  if ((params.features & IORING_FEAT_SINGLE_MMAP) == 0 ||
+      !SupportsRequiredOps(fd)) {
+    return nullptr;
+  }
+
+  const std::size_t sq_size =
+      params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  const std::size_t cq_size =
+      params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  ring->ring_size_ = sq_size > cq_size ? sq_size : cq_size;
+  void* ring_mem = ::mmap(nullptr, ring->ring_size_, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  if (ring_mem == MAP_FAILED) {
+    return nullptr;
+  }
+  ring->ring_ = ring_mem;
+
+  ring->sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  void* sqes = ::mmap(nullptr, ring->sqes_size_, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    return nullptr;
+  }
+  ring->sqes_ = sqes;
+
+  ring->sq_entries_ = params.sq_entries;
+  ring->sq_head_ = At<unsigned>(ring_mem, params.sq_off.head);
+  ring->sq_tail_ = At<unsigned>(ring_mem, params.sq_off.tail);
+  ring->sq_mask_ = *At<unsigned>(ring_mem, params.sq_off.ring_mask);
+  ring->cq_head_ = At<unsigned>(ring_mem, params.cq_off.head);
+  ring->cq_tail_ = At<unsigned>(ring_mem, params.cq_off.tail);
+  ring->cq_mask_ = *At<unsigned>(ring_mem, params.cq_off.ring_mask);
+  ring->cqes_ = At<io_uring_cqe>(ring_mem, params.cq_off.cqes);
+
+  // Submission entries are always used in ring order, so the indirection
+  // array is the identity.
+  unsigned* array = At<unsigned>(ring_mem, params.sq_off.array);
+  for (unsigned i = 0; i < params.sq_entries; ++i) {
+    array[i] = i;
+  }
+  return ring;
+}
+
+IoUring::~IoUring() {
+  if (sqes_ != nullptr) {
+    ::munmap(sqes_, sqes_size_);
+  }
+  if (ring_ != nullptr) {
+    ::munmap(ring_, ring_size_);
+  }
+  if (ring_fd_ >= 0) {
+    ::close(ring_fd_);
+  }
+}
+
+void* IoUring::NextEntry() {
+  const unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  const unsigned tail = *sq_tail_ + queued_;
+  if (tail - head >= sq_entries_) {
+    throw std::logic_error("io_uring submission queue is full");
+  }
+  auto* sqe = static_cast<io_uring_sqe*>(sqes_) + (tail & sq_mask_);
+  std::memset(sqe, 0, sizeof(*sqe));
+  queued_++;
+  return sqe;
+}
+
+void IoUring::PrepareOpenAt(const char* path, int flags,
+                            std::uint64_t user_data) {
+  auto* sqe = static_cast<io_uring_sqe*>(NextEntry());
+  sqe->opcode = IORING_OP_OPENAT;
+  sqe->fd = AT_FDCWD;
+  sqe->addr = reinterpret_cast<std::uint64_t>(path);
+  sqe->open_flags = static_cast<std::uint32_t>(flags);
+  sqe->user_data = user_data;
+}
+
+void IoUring::PrepareStatx(const char* path, unsigned mask, struct statx* out,
+                           std::uint64_t user_data) {
+  auto* sqe = static_cast<io_uring_sqe*>(NextEntry());
+  sqe->opcode = IORING_OP_STATX;
+  sqe->fd = AT_FDCWD;
+  sqe->addr = reinterpret_cast<std::uint64_t>(path);
+  sqe->len = mask;
+  sqe->off = reinterpret_cast<std::uint64_t>(out);
+  sqe->user_data = user_data;
+}
+
+void IoUring::PrepareRead(int fd, void* buffer, unsigned size,
+                          std::uint64_t offset, std::uint64_t user_data) {
+  auto* sqe = static_cast<io_uring_sqe*>(NextEntry());
+  sqe->opcode = IORING_OP_READ;
+  sqe->fd = fd;
+  sqe->addr = reinterpret_cast<std::uint64_t>(buffer);
+  sqe->len = size;
+  sqe->off = offset;
+  sqe->user_data = user_data;
+}
+
+void IoUring::PrepareClose(int fd, std::uint64_t user_data) {
+  auto* sqe = static_cast<io_uring_sqe*>(NextEntry());
+  sqe->opcode = IORING_OP_CLOSE;
+  sqe->fd = fd;
+  sqe->user_data = user_data;
+}
+
+void IoUring::SubmitAndWait(const CompletionHandler& handler) {
+  // Publish the queued entries to the kernel.
+  __atomic_store_n(sq_tail_, *sq_tail_ + queued_, __ATOMIC_RELEASE);
+  unsigned to_submit = queued_;
+  unsigned pending = queued_;
+  queued_ = 0;
+
+  while (pending > 0) {
+    const int submitted =
+        Enter(ring_fd_, to_submit, 1, IORING_ENTER_GETEVENTS);
+    if (submitted >= 0) {
+      to_submit -= static_cast<unsigned>(submitted);
+    } else if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+      throw std::runtime_error("io_uring_enter failed: " +
+                               std::string(std::strerror(errno)));
+    }
+
+    unsigned head = *cq_head_;
+    const unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head) {
+      const io_uring_cqe& cqe =
+          static_cast<const io_uring_cqe*>(cqes_)[head & cq_mask_];
+      handler(cqe.user_data, cqe.res);
+      pending--;
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  }
+}
+
+#else  // SCANNER_HAS_IO_URING
+
+std::unique_ptr<IoUring> IoUring::Create(unsigned) {
+  return nullptr;
+}
+
+IoUring::~IoUring() = default;
+
+void* IoUring::NextEntry() {
+  throw std::logic_error("io_uring is not supported on this platform");
+}
+
+void IoUring::PrepareOpenAt(const char*, int, std::uint64_t) {
+  NextEntry();
+}
+
+void IoUring::PrepareStatx(const char*, unsigned, struct statx*,
+                           std::uint64_t) {
+  NextEntry();
+}
+
+void IoUring::PrepareRead(int, void*, unsigned, std::uint64_t,
+                          std::uint64_t) {
+  NextEntry();
+}
+
+void IoUring::PrepareClose(int, std::uint64_t) {
+  NextEntry();
+}
+
+void IoUring::SubmitAndWait(const CompletionHandler&) {
+}
+
+#endif  // SCANNER_HAS_IO_URING
+
+}  // namespace scanner
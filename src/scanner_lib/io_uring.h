@@ -0,0 +1,98 @@
+#ifndef SRC_SCANNER_LIB_IO_URING_H_
+#define SRC_SCANNER_LIB_IO_URING_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <functional>
+#include <memory>
+
+struct statx;
+
+namespace scanner {
+
+/**
+ * @class IoUring
+ * @brief A minimal io_uring submission and completion ring.
+ *
+ * Talks to the kernel through raw system calls, so no liburing is required.
+ * Operations are queued with the Prepare* methods and submitted together, which
+ * keeps many opens and reads in flight from a single thread. An instance must
+ * only be used by one thread at a time. This class is an internal,
+ * non-exported component of the scanner library.
+ */
+class IoUring {
+public:
+  /** @brief Receives the user data and result of a completed operation. */
+  using CompletionHandler =
+      std::function<void(std::uint64_t user_data, std::int32_t result)>;
+
+  /**
+   * @brief Creates a ring if the kernel supports every operation used here.
+   * @param entries The submission queue size; rounded up to a power of two.
+   * @return The ring, or nullptr if io_uring is unavailable, e.g. on other
+   * platforms, old kernels, or when disabled by the system administrator.
+   */
+  static std::unique_ptr<IoUring> Create(unsigned entries);
+
+  ~IoUring();
+
+  IoUring(const IoUring&) = delete;
+  IoUring& operator=(const IoUring&) = delete;
+
+  /** @brief Returns how many operations can be queued before submitting. */
+  unsigned Capacity() const {
+    return sq_entries_;
+  }
+
+  /** @brief Queues an openat(AT_FDCWD, path, flags); path must stay alive. */
+  void PrepareOpenAt(const char* path, int flags, std::uint64_t user_data);
+
+  /** @brief Queues a statx of path for the given mask into out. */
+  void PrepareStatx(const char* path, unsigned mask, struct statx* out,
+                    std::uint64_t user_data);
+
+  /** @brief Queues a read of size bytes at offset into buffer. */
+  void PrepareRead(int fd, void* buffer, unsigned size, std::uint64_t offset,
+                   std::uint64_t user_data);
+
+  /** @brief Queues a close of fd. */
+  void PrepareClose(int fd, std::uint64_t user_data);
+
+  /**
+   * @brief Submits the queued operations and waits for all of them.
+   *
+   * A negative result is a negated errno value.
+   *
+   * @param handler Called once per completed operation.
+   * @throws std::runtime_error if the kernel rejects the submission.
+   */
+  void SubmitAndWait(const CompletionHandler& handler);
+
+private:
+  IoUring() = default;
+
+  // Returns the next free submission entry, cleared, or nullptr if full.
+  void* NextEntry();
+
+  int ring_fd_ = -1;
+  void* ring_ = nullptr;
+  std::size_t ring_size_ = 0;
+  void* sqes_ = nullptr;
+  std::size_t sqes_size_ = 0;
+
+  unsigned sq_entries_ = 0;
+  unsigned* sq_head_ = nullptr;
+  unsigned* sq_tail_ = nullptr;
+  unsigned sq_mask_ = 0;
+  unsigned* cq_head_ = nullptr;
+  unsigned* cq_tail_ = nullptr;
+  unsigned cq_mask_ = 0;
+  void* cqes_ = nullptr;
+
+  unsigned queued_ = 0;
+};
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_IO_URING_H_
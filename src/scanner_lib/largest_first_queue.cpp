@@ -0,0 +1,25 @@
+#include "src/scanner_lib/largest_first_queue.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace scanner {
+
+void LargestFirstQueue::Push(std::filesystem::path path, std::uint64_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  heap_.push_back(Entry{size, std::move(path)});
+  std::push_heap(heap_.begin(), heap_.end(), BySize);
+}
+
+std::optional<std::filesystem::path> LargestFirstQueue::Pop() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (heap_.empty()) {
+    return std::nullopt;
+  }
+  std::pop_heap(heap_.begin(), heap_.end(), BySize);
+  std::filesystem::path path = std::move(heap_.back().path);
+  heap_.pop_back();
+  return path;
+}
+
+}  // namespace scanner
@@ -0,0 +1,55 @@
+#ifndef SRC_SCANNER_LIB_LARGEST_FIRST_QUEUE_H_
+#define SRC_SCANNER_LIB_LARGEST_FIRST_QUEUE_H_
+
+#include <cstdint>
+
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace scanner {
+
+/**
+ * @class LargestFirstQueue
+ * @brief Hands out the largest of the files discovered so far.
+ *
+ * Used for longest-processing-time-first scheduling: instead of a task per
+ * file, the scanner pushes the file here and submits a task that pops
+ * whichever file is largest when a worker gets to it. A large file found late
+ * in the walk therefore overtakes the smaller files queued before it, rather
+ * than leaving a single worker hashing it after all others went idle.
+ */
+class LargestFirstQueue {
+public:
+  /**
+   * @brief Adds a file. This method is thread-safe.
+   * @param path The path of the file.
+   * @param size The size of the file in bytes.
+   */
+  void Push(std::filesystem::path path, std::uint64_t size);
+
+  /**
+   * @brief Removes the largest file. This method is thread-safe.
+   * @return The path of the file, or std::nullopt if the queue is empty.
+   */
+  std::optional<std::filesystem::path> Pop();
+
+private:
+  struct Entry {
+    std::uint64_t size;
+    std::filesystem::path path;
+  };
+
+  static bool BySize(const Entry& lhs, const Entry& rhs) {
+    return lhs.size < rhs.size;
+  }
+
+  std::mutex mutex_;
+  // A max-heap by size.
+  std::vector<Entry> heap_;
+};
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_LARGEST_FIRST_QUEUE_H_
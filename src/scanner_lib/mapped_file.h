@@ -0,0 +1,59 @@
+#ifndef SRC_SCANNER_LIB_MAPPED_FILE_H_
+#define SRC_SCANNER_LIB_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <filesystem>
+
+namespace scanner {
+
+/**
+ * @class MappedFile
+ * @brief A read-only memory mapping of an entire file.
+ *
+ * The mapping is shared with the operating system's page cache, so several
+ * processes mapping the same file use a single physical copy of its pages.
+ * The mapping is released when the object is destroyed. This class is an
+ * internal, non-exported component of the scanner library.
+ */
+class MappedFile {
+public:
+  /** @brief Constructs an empty mapping. */
+  MappedFile() = default;
+
+  /**
+   * @brief Maps the specified file into memory for reading.
+   * @param path The path to the file to map.
+   * @throws std::runtime_error if the file cannot be opened or mapped.
+   */
+  explicit MappedFile(const std::filesystem::path& path);
+
+  /** @brief Destructor. Unmaps the file if it is mapped. */
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  /** @brief Returns the first byte of the mapping, or nullptr if empty. */
+  const std::uint8_t* Data() const {
+    return data_;
+  }
+
+  /** @brief Returns the size of the mapping in bytes. */
+  std::size_t Size() const {
+    return size_;
+  }
+
+private:
+  void Reset() noexcept;
+
+  const std::uint8_t* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_MAPPED_FILE_H_
@@ -0,0 +1,204 @@
+#include "src/scanner_lib/mapped_hash_database.h"
+
+#include <cstring>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "src/scanner_lib/signature_database_format.h"
+
+namespace scanner {
+namespace {
+
+bool SectionFits(std::uint64_t offset, std::uint64_t count,
+                 std::uint64_t element_size, std::uint64_t file_size) {
+  if (offset % sigdb::kAlignment != 0 || offset > file_size) {
+    return false;
+  }
+  return count <= (file_size - offset) / element_size;
+}
+
+}  // namespace
+
+MappedHashDatabase::MappedHashDatabase(std::size_t prefilter_bits_per_key)
+    : prefilter_bits_per_key_(prefilter_bits_per_key) {
+}
+
+std::size_t MappedHashDatabase::Load(const std::filesystem::path& source_path) {
+  MappedFile file(source_path);
+  const auto invalid = [&source_path](const char* reason) {
+    return std::runtime_error("Invalid compiled database (" +
+                              std::string(reason) +
+                              "): " + source_path.string());
+  };
+
+  // Fields added after version 1 stay zero for version 1 files.
+  sigdb::FileHeader header{};
+  if (file.Size() < sigdb::kVersion1HeaderSize) {
+    throw invalid("truncated header");
+  }
+  std::memcpy(&header, file.Data(), sigdb::kVersion1HeaderSize);
+  if (std::memcmp(header.magic, sigdb::kMagic, sizeof(header.magic)) != 0) {
+    throw invalid("bad magic");
+  }
+  if (header.byte_order_mark != sigdb::kByteOrderMark) {
+    throw invalid("foreign byte order");
+  }
+  if (header.version < sigdb::kMinVersion ||
+      header.version > sigdb::kVersion) {
+    throw invalid("unsupported version");
+  }
+  if (header.version > sigdb::kMinVersion) {
+    if (file.Size() < sizeof(header)) {
+      throw invalid("truncated header");
+    }
+    std::memcpy(&header, file.Data(), sizeof(header));
+  }
+  if (header.bucket_bits > sigdb::kMaxBucketBits) {
+    throw invalid("bad bucket table");
+  }
+
+  const std::uint64_t size = file.Size();
+  const std::uint64_t bucket_count = (std::uint64_t{1} << header.bucket_bits);
+  if (!SectionFits(header.buckets_offset, bucket_count + 1,
+                   sizeof(std::uint32_t), size) ||
+      !SectionFits(header.digests_offset, header.entry_count, Md5Digest::kSize,
+                   size) ||
+      !SectionFits(header.verdict_ids_offset, header.entry_count,
+                   sizeof(std::uint32_t), size) ||
+      !SectionFits(header.verdict_offsets_offset,
+                   std::uint64_t{header.verdict_count} + 1,
+                   sizeof(std::uint32_t), size) ||
+      !SectionFits(header.strings_offset, header.strings_size, 1, size) ||
+      (header.size_count > 0 &&
+       !SectionFits(header.sizes_offset, header.size_count,
+                    sizeof(std::uint64_t), size)) ||
+      (header.prefix_count > 0 &&
+       !SectionFits(header.prefixes_offset, header.prefix_count,
+                    Md5Digest::kSize, size))) {
+    throw invalid("section out of bounds");
+  }
+
+  const std::uint8_t* base = file.Data();
+  const auto* buckets =
+      reinterpret_cast<const std::uint32_t*>(base + header.buckets_offset);
+  if (buckets[bucket_count] != header.entry_count) {
+    throw invalid("bad bucket table");
+  }
+
+  file_ = std::move(file);
+  bucket_bits_ = header.bucket_bits;
+  verdict_count_ = header.verdict_count;
+  entry_count_ = header.entry_count;
+  buckets_ = buckets;
+  digests_ = base + header.digests_offset;
+  verdict_ids_ =
+      reinterpret_cast<const std::uint32_t*>(base + header.verdict_ids_offset);
+  verdict_offsets_ = reinterpret_cast<const std::uint32_t*>(
+      base + header.verdict_offsets_offset);
+  strings_ = reinterpret_cast<const char*>(base + header.strings_offset);
+  strings_size_ = header.strings_size;
+  size_count_ = header.size_count;
+  sizes_ = reinterpret_cast<const std::uint64_t*>(base + header.sizes_offset);
+  prefix_count_ = header.prefix_count;
+  prefixes_ = base + header.prefixes_offset;
+
+  prefilter_.reset();
+  if (prefilter_bits_per_key_ > 0) {
+    prefilter_.emplace(static_cast<std::size_t>(entry_count_),
+                       prefilter_bits_per_key_);
+    for (std::uint64_t i = 0; i < entry_count_; ++i) {
+      Md5Digest digest;
+      std::memcpy(digest.bytes.data(), digests_ + i * Md5Digest::kSize,
+                  Md5Digest::kSize);
+      prefilter_->Add(digest);
+    }
+  }
+  return static_cast<std::size_t>(entry_count_);
+}
+
+std::optional<std::string> MappedHashDatabase::FindHash(
+    const Md5Digest& hash) const {
+  if (entry_count_ == 0) {
+    return std::nullopt;
+  }
+  if (prefilter_ && !prefilter_->MayContain(hash)) {
+    return std::nullopt;
+  }
+
+  const std::uint32_t bucket = sigdb::BucketOf(hash.bytes.data(), bucket_bits_);
+  // Bucket bounds are only trusted up to the entry count, so a corrupted
+  // table can produce a wrong answer but never an out-of-bounds read.
+  const std::uint64_t end = std::min<std::uint64_t>(buckets_[bucket + 1],
+                                                    entry_count_);
+  for (std::uint64_t i = buckets_[bucket]; i < end; ++i) {
+    const int order = std::memcmp(digests_ + i * Md5Digest::kSize,
+                                  hash.bytes.data(), Md5Digest::kSize);
+    if (order < 0) {
+      continue;
+    }
+    if (order > 0) {
+      break;  // Digests are sorted, so the hash is not in this bucket.
+    }
+
+    const std::uint32_t verdict_id = verdict_ids_[i];
+    if (verdict_id >= verdict_count_) {
+      return std::nullopt;
+    }
+    const std::uint32_t begin_offset = verdict_offsets_[verdict_id];
+    const std::uint32_t end_offset = verdict_offsets_[verdict_id + 1];
+    if (begin_offset > end_offset || end_offset > strings_size_) {
+      return std::nullopt;
+    }
+    return std::string(strings_ + begin_offset, end_offset - begin_offset);
+  }
+  return std::nullopt;
+}
+
+bool MappedHashDatabase::HasSizeIndex() const {
+  return size_count_ > 0;
+}
+
+bool MappedHashDatabase::MayMatchSize(std::uint64_t size) const {
+  return size_count_ == 0 ||
+         std::binary_search(sizes_, sizes_ + size_count_, size);
+}
+
+bool MappedHashDatabase::HasPrefixIndex() const {
+  return prefix_count_ > 0;
+}
+
+bool MappedHashDatabase::MayMatchPrefix(const Md5Digest& prefix_digest) const {
+  if (prefix_count_ == 0) {
+    return true;
+  }
+  // Binary search over the sorted 16-byte digests.
+  std::uint64_t low = 0;
+  std::uint64_t high = prefix_count_;
+  while (low < high) {
+    const std::uint64_t middle = low + (high - low) / 2;
+    const int order =
+        std::memcmp(prefixes_ + middle * Md5Digest::kSize,
+                    prefix_digest.bytes.data(), Md5Digest::kSize);
+    if (order == 0) {
+      return true;
+    }
+    if (order < 0) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return false;
+}
+
+std::optional<PrefilterStats> MappedHashDatabase::GetPrefilterStats() const {
+  if (!prefilter_) {
+    return std::nullopt;
+  }
+  return PrefilterStats{prefilter_->MemoryBytes(),
+                        prefilter_->EstimateFalsePositiveRate()};
+}
+
+}  // namespace scanner
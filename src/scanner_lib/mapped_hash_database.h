@@ -0,0 +1,97 @@
+#ifndef SRC_SCANNER_LIB_MAPPED_HASH_DATABASE_H_
+#define SRC_SCANNER_LIB_MAPPED_HASH_DATABASE_H_
+
+#include <cstdint>
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include "scanner/interfaces.h"
+#include "src/scanner_lib/blocked_bloom_filter.h"
+#include "src/scanner_lib/mapped_file.h"
+
+namespace scanner {
+
+/**
+ * @class MappedHashDatabase
+ * @brief An implementation of IHashDatabase backed by a compiled, memory-mapped
+ * signature file.
+ *
+ * The file is produced by CompileSignatureDatabase and is used in place: Load
+ * only maps it and validates the header, so startup time does not depend on
+ * the number of signatures, and concurrent scanner processes share the same
+ * page cache copy. If the file has a sample size or prefix index, it is
+ * searched in place as well. Lookups perform no parsing and no heap allocation unless a
+ * verdict is returned. This class is an internal, non-exported component of
+ * the scanner library.
+ */
+class MappedHashDatabase final : public IHashDatabase {
+public:
+  /**
+   * @brief Constructs an empty database.
+   * @param prefilter_bits_per_key If non-zero, a BlockedBloomFilter with this
+   * budget per signature is built on Load and consulted before the table.
+   * Building it is linear in the number of signatures.
+   */
+  explicit MappedHashDatabase(std::size_t prefilter_bits_per_key = 0);
+
+  /**
+   * @brief Maps a compiled signature database.
+   *
+   * Releases any previously mapped database.
+   *
+   * @param source_path The path to the compiled database file.
+   * @return The number of signatures in the database.
+   * @throws std::runtime_error if the file cannot be mapped or is not a valid
+   * compiled database.
+   */
+  std::size_t Load(const std::filesystem::path& source_path) override;
+
+  /**
+   * @brief Looks up a hash in the mapped database.
+   *
+   * @param hash The digest to look up.
+   * @return An optional containing the verdict if the hash is found, otherwise
+   * std::nullopt.
+   */
+  std::optional<std::string> FindHash(const Md5Digest& hash) const override;
+
+  /** @copydoc IHashDatabase::HasSizeIndex */
+  bool HasSizeIndex() const override;
+
+  /** @copydoc IHashDatabase::MayMatchSize */
+  bool MayMatchSize(std::uint64_t size) const override;
+
+  /** @copydoc IHashDatabase::HasPrefixIndex */
+  bool HasPrefixIndex() const override;
+
+  /** @copydoc IHashDatabase::MayMatchPrefix */
+  bool MayMatchPrefix(const Md5Digest& prefix_digest) const override;
+
+  /** @copydoc IHashDatabase::GetPrefilterStats */
+  std::optional<PrefilterStats> GetPrefilterStats() const override;
+
+private:
+  std::size_t prefilter_bits_per_key_;
+  std::optional<BlockedBloomFilter> prefilter_;
+
+  MappedFile file_;
+  std::uint32_t bucket_bits_ = 0;
+  std::uint32_t verdict_count_ = 0;
+  std::uint64_t entry_count_ = 0;
+  const std::uint32_t* buckets_ = nullptr;
+  const std::uint8_t* digests_ = nullptr;
+  const std::uint32_t* verdict_ids_ = nullptr;
+  const std::uint32_t* verdict_offsets_ = nullptr;
+  const char* strings_ = nullptr;
+  std::uint64_t strings_size_ = 0;
+  std::uint64_t size_count_ = 0;
+  const std::uint64_t* sizes_ = nullptr;
+  std::uint64_t prefix_count_ = 0;
+  const std::uint8_t* prefixes_ = nullptr;
+};
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_MAPPED_HASH_DATABASE_H_
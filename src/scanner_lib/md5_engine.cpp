@@ -0,0 +1,207 @@
+#include "src/scanner_lib/md5_engine.h"
+
+#include <cstring>
+
+#include <algorithm>
+
+namespace scanner {
+namespace md5 {
+namespace {
+
+inline std::uint32_t RotateLeft(std::uint32_t x, int bits) {
+  return (x << bits) | (x >> (32 - bits));
+}
+
+inline std::uint32_t LoadLittleEndian(const std::uint8_t* p) {
+  return std::uint32_t{p[0]} | (std::uint32_t{p[1]} << 8) |
+         (std::uint32_t{p[2]} << 16) | (std::uint32_t{p[3]} << 24);
+}
+
+// The auxiliary functions from RFC 1321, in forms that avoid a NOT where
+// possible.
+#define MD5_F(x, y, z) ((z) ^ ((x) & ((y) ^ (z))))
+#define MD5_G(x, y, z) ((y) ^ ((z) & ((x) ^ (y))))
+#define MD5_H(x, y, z) ((x) ^ (y) ^ (z))
+#define MD5_I(x, y, z) ((y) ^ ((x) | ~(z)))
+
+#define MD5_STEP(f, a, b, c, d, word, constant, shift)                  \
+  a = b + RotateLeft(a + MD5_##f(b, c, d) + w[word] + (constant), shift)
+
+void TransformBlock(std::uint32_t state[4], const std::uint8_t* block) {
+  std::uint32_t w[16];
+  for (int i = 0; i < 16; ++i) {
+    w[i] = LoadLittleEndian(block + i * 4);
+  }
+
+  std::uint32_t a = state[0];
+  std::uint32_t b = state[1];
+  std::uint32_t c = state[2];
+  std::uint32_t d = state[3];
+
+  MD5_STEP(F, a, b, c, d, 0, 0xd76aa478, 7);
+  MD5_STEP(F, d, a, b, c, 1, 0xe8c7b756, 12);
+  MD5_STEP(F, c, d, a, b, 2, 0x242070db, 17);
+  MD5_STEP(F, b, c, d, a, 3, 0xc1bdceee, 22);
+  MD5_STEP(F, a, b, c, d, 4, 0xf57c0faf, 7);
+  MD5_STEP(F, d, a, b, c, 5, 0x4787c62a, 12);
+  MD5_STEP(F, c, d, a, b, 6, 0xa8304613, 17);
+  MD5_STEP(F, b, c, d, a, 7, 0xfd469501, 22);
+  MD5_STEP(F, a, b, c, d, 8, 0x698098d8, 7);
+  MD5_STEP(F, d, a, b, c, 9, 0x8b44f7af, 12);
+  MD5_STEP(F, c, d, a, b, 10, 0xffff5bb1, 17);
+  MD5_STEP(F, b, c, d, a, 11, 0x895cd7be, 22);
+  MD5_STEP(F, a, b, c, d, 12, 0x6b901122, 7);
+  MD5_STEP(F, d, a, b, c, 13, 0xfd987193, 12);
+  MD5_STEP(F, c, d, a, b, 14, 0xa679438e, 17);
+  MD5_STEP(F, b, c, d, a, 15, 0x49b40821, 22);
+  MD5_STEP(G, a, b, c, d, 1, 0xf61e2562, 5);
+  MD5_STEP(G, d, a, b, c, 6, 0xc040b340, 9);
+  MD5_STEP(G, c, d, a, b, 11, 0x265e5a51, 14);
+  MD5_STEP(G, b, c, d, a, 0, 0xe9b6c7aa, 20);
+  MD5_STEP(G, a, b, c, d, 5, 0xd62f105d, 5);
+  MD5_STEP(G, d, a, b, c, 10, 0x02441453, 9);
+  MD5_STEP(G, c, d, a, b, 15, 0xd8a1e681, 14);
+  MD5_STEP(G, b, c, d, a, 4, 0xe7d3fbc8, 20);
+  MD5_STEP(G, a, b, c, d, 9, 0x21e1cde6, 5);
+  MD5_STEP(G, d, a, b, c, 14, 0xc33707d6, 9);
+  MD5_STEP(G, c, d, a, b, 3, 0xf4d50d87, 14);
+  MD5_STEP(G, b, c, d, a, 8, 0x455a14ed, 20);
+  MD5_STEP(G, a, b, c, d, 13, 0xa9e3e905, 5);
+  MD5_STEP(G, d, a, b, c, 2, 0xfcefa3f8, 9);
+  MD5_STEP(G, c, d, a, b, 7, 0x676f02d9, 14);
+  MD5_STEP(G, b, c, d, a, 12, 0x8d2a4c8a, 20);
+  MD5_STEP(H, a, b, c, d, 5, 0xfffa3942, 4);
+  MD5_STEP(H, d, a, b, c, 8, 0x8771f681, 11);
+  MD5_STEP(H, c, d, a, b, 11, 0x6d9d6122, 16);
+  MD5_STEP(H, b, c, d, a, 14, 0xfde5380c, 23);
+  MD5_STEP(H, a, b, c, d, 1, 0xa4beea44, 4);
+  MD5_STEP(H, d, a, b, c, 4, 0x4bdecfa9, 11);
+  MD5_STEP(H, c, d, a, b, 7, 0xf6bb4b60, 16);
+  MD5_STEP(H, b, c, d, a, 10, 0xbebfbc70, 23);
+  MD5_STEP(H, a, b, c, d, 13, 0x289b7ec6, 4);
+  MD5_STEP(H, d, a, b, c, 0, 0xeaa127fa, 11);
+  MD5_STEP(H, c, d, a, b, 3, 0xd4ef3085, 16);
+  MD5_STEP(H, b, c, d, a, 6, 0x04881d05, 23);
+  MD5_STEP(H, a, b, c, d, 9, 0xd9d4d039, 4);
+  MD5_STEP(H, d, a, b, c, 12, 0xe6db99e5, 11);
+  MD5_STEP(H, c, d, a, b, 15, 0x1fa27cf8, 16);
+  MD5_STEP(H, b, c, d, a, 2, 0xc4ac5665, 23);
+  MD5_STEP(I, a, b, c, d, 0, 0xf4292244, 6);
+  MD5_STEP(I, d, a, b, c, 7, 0x432aff97, 10);
+  MD5_STEP(I, c, d, a, b, 14, 0xab9423a7, 15);
+  MD5_STEP(I, b, c, d, a, 5, 0xfc93a039, 21);
+  MD5_STEP(I, a, b, c, d, 12, 0x655b59c3, 6);
+  MD5_STEP(I, d, a, b, c, 3, 0x8f0ccc92, 10);
+  MD5_STEP(I, c, d, a, b, 10, 0xffeff47d, 15);
+  MD5_STEP(I, b, c, d, a, 1, 0x85845dd1, 21);
+  MD5_STEP(I, a, b, c, d, 8, 0x6fa87e4f, 6);
+  MD5_STEP(I, d, a, b, c, 15, 0xfe2ce6e0, 10);
+  MD5_STEP(I, c, d, a, b, 6, 0xa3014314, 15);
+  MD5_STEP(I, b, c, d, a, 13, 0x4e0811a1, 21);
+  MD5_STEP(I, a, b, c, d, 4, 0xf7537e82, 6);
+  MD5_STEP(I, d, a, b, c, 11, 0xbd3af235, 10);
+  MD5_STEP(I, c, d, a, b, 2, 0x2ad7d2bb, 15);
+  MD5_STEP(I, b, c, d, a, 9, 0xeb86d391, 21);
+
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+}
+
+#undef MD5_STEP
+#undef MD5_I
+#undef MD5_H
+#undef MD5_G
+#undef MD5_F
+
+}  // namespace
+
+void Transform(std::uint32_t state[4], const std::uint8_t* blocks,
+               std::size_t num_blocks) {
+  for (std::size_t i = 0; i < num_blocks; ++i) {
+    TransformBlock(state, blocks + i * kBlockSize);
+  }
+}
+
+std::size_t PadFinalBlocks(const std::uint8_t* tail, std::size_t tail_size,
+                           std::uint64_t message_size, std::uint8_t* out) {
+  // The message is followed by a 0x80 byte, zero padding, and the 64-bit
+  // little-endian bit length, which must fit into the last block.
+  const std::size_t num_blocks = tail_size + 9 <= kBlockSize ? 1 : 2;
+  const std::size_t padded_size = num_blocks * kBlockSize;
+  if (tail_size > 0) {
+    std::memcpy(out, tail, tail_size);
+  }
+  out[tail_size] = 0x80;
+  std::memset(out + tail_size + 1, 0, padded_size - tail_size - 1 - 8);
+  const std::uint64_t bit_length = message_size * 8;
+  for (int i = 0; i < 8; ++i) {
+    out[padded_size - 8 + i] = static_cast<std::uint8_t>(bit_length >> (8 * i));
+  }
+  return num_blocks;
+}
+
+Md5Digest StateToDigest(const std::uint32_t state[4]) {
+  Md5Digest digest;
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      digest.bytes[i * 4 + j] = static_cast<std::uint8_t>(state[i] >> (8 * j));
+    }
+  }
+  return digest;
+}
+
+}  // namespace md5
+
+Md5Engine::Md5Engine() {
+  Reset();
+}
+
+void Md5Engine::Update(const std::uint8_t* data, std::size_t size) {
+  if (size == 0) {
+    return;
+  }
+  message_size_ += size;
+
+  if (buffer_size_ > 0) {
+    const std::size_t take = std::min(size, md5::kBlockSize - buffer_size_);
+    std::memcpy(buffer_ + buffer_size_, data, take);
+    buffer_size_ += take;
+    data += take;
+    size -= take;
+    if (buffer_size_ < md5::kBlockSize) {
+      return;
+    }
+    md5::Transform(state_, buffer_, 1);
+    buffer_size_ = 0;
+  }
+
+  const std::size_t full_blocks = size / md5::kBlockSize;
+  md5::Transform(state_, data, full_blocks);
+  data += full_blocks * md5::kBlockSize;
+  size -= full_blocks * md5::kBlockSize;
+
+  if (size > 0) {
+    std::memcpy(buffer_, data, size);
+    buffer_size_ = size;
+  }
+}
+
+Md5Digest Md5Engine::Final() {
+  std::uint8_t final_blocks[2 * md5::kBlockSize];
+  const std::size_t num_blocks =
+      md5::PadFinalBlocks(buffer_, buffer_size_, message_size_, final_blocks);
+  md5::Transform(state_, final_blocks, num_blocks);
+  const Md5Digest digest = md5::StateToDigest(state_);
+  Reset();
+  return digest;
+}
+
+void Md5Engine::Reset() {
+  std::memcpy(state_, md5::kInitialState, sizeof(state_));
+  buffer_size_ = 0;
+  message_size_ = 0;
+}
+
+}  // namespace scanner
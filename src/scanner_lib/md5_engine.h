@@ -0,0 +1,77 @@
+#ifndef SRC_SCANNER_LIB_MD5_ENGINE_H_
+#define SRC_SCANNER_LIB_MD5_ENGINE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "scanner/domain.h"
+
+namespace scanner {
+namespace md5 {
+
+/** @brief The MD5 block size in bytes. */
+inline constexpr std::size_t kBlockSize = 64;
+
+/** @brief The MD5 chaining state before any block is processed. */
+inline constexpr std::uint32_t kInitialState[4] = {0x67452301, 0xefcdab89,
+                                                   0x98badcfe, 0x10325476};
+
+/**
+ * @brief Runs the MD5 compression function over consecutive blocks.
+ * @param state The four-word chaining state, updated in place.
+ * @param blocks The input; must hold num_blocks * kBlockSize bytes.
+ * @param num_blocks The number of blocks to process.
+ */
+void Transform(std::uint32_t state[4], const std::uint8_t* blocks,
+               std::size_t num_blocks);
+
+/**
+ * @brief Builds the padded final block(s) of a message.
+ * @param tail The trailing bytes of the message that do not fill a block.
+ * @param tail_size The number of trailing bytes; must be < kBlockSize.
+ * @param message_size The total length of the message in bytes.
+ * @param out Receives the padded blocks; must hold 2 * kBlockSize bytes.
+ * @return The number of blocks written to out (1 or 2).
+ */
+std::size_t PadFinalBlocks(const std::uint8_t* tail, std::size_t tail_size,
+                           std::uint64_t message_size, std::uint8_t* out);
+
+/** @brief Serializes a final chaining state into a digest. */
+Md5Digest StateToDigest(const std::uint32_t state[4]);
+
+}  // namespace md5
+
+/**
+ * @class Md5Engine
+ * @brief An incremental, portable MD5 implementation.
+ *
+ * Data can be fed in arbitrarily sized pieces; the digest is produced by
+ * Final(). This class is an internal, non-exported component of the scanner
+ * library.
+ */
+class Md5Engine {
+public:
+  Md5Engine();
+
+  /** @brief Appends data to the message. */
+  void Update(const std::uint8_t* data, std::size_t size);
+
+  /**
+   * @brief Completes the message and returns its digest.
+   *
+   * The engine is reset afterwards and can hash another message.
+   */
+  Md5Digest Final();
+
+private:
+  void Reset();
+
+  std::uint32_t state_[4];
+  std::uint8_t buffer_[md5::kBlockSize];
+  std::size_t buffer_size_ = 0;
+  std::uint64_t message_size_ = 0;
+};
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_MD5_ENGINE_H_
@@ -1,22 +1,79 @@
 #include "src/scanner_lib/md5_file_hasher.h"
 
-#include <fstream>
-#include <stdexcept>
+#include <algorithm>
 
-#include <md5.h>
+#include "src/scanner_lib/md5_engine.h"
 
 namespace scanner {
 
-std::string Md5FileHasher::HashFile(const std::filesystem::path& file_path) {
-  std::ifstream file_stream(file_path, std::ios::binary);
-  if (!file_stream) {
-    throw std::runtime_error("Failed to open file: " + file_path.string());
+Md5FileHasher::Md5FileHasher(Md5Isa isa, const IoOptions& io_options)
+    : multi_buffer_(isa), reader_(io_options) {
+}
+
+Md5Digest Md5FileHasher::HashFile(const std::filesystem::path& file_path) {
+  Md5Engine engine;
+  reader_.Read(file_path,
+               [&engine](const std::uint8_t* data, std::size_t size) {
+                 engine.Update(data, size);
+               });
+  return engine.Final();
+}
+
+void Md5FileHasher::HashFiles(
+    const std::vector<std::filesystem::path>& file_paths,
+    std::vector<FileHashResult>& results) {
+  // Buffers are kept per thread so that steady-state batches reuse memory.
+  thread_local std::vector<FileReader::BatchEntry> entries;
+  thread_local std::vector<HashMessage> messages;
+  thread_local std::vector<std::size_t> message_files;
+  thread_local std::vector<Md5Digest> digests;
+
+  results.resize(file_paths.size());
+  messages.clear();
+  message_files.clear();
+
+  try {
+    reader_.ReadBatch(file_paths, kMaxBatchedFileSize, entries);
+  } catch (...) {
+    for (FileHashResult& result : results) {
+      result.error = std::current_exception();
+    }
+    return;
   }
 
-  // Set the stream to throw an exception on read errors.
-  file_stream.exceptions(std::ifstream::badbit);
+  for (std::size_t i = 0; i < file_paths.size(); ++i) {
+    results[i].error = entries[i].error;
+    if (results[i].error) {
+      continue;
+    }
+    if (entries[i].too_large) {
+      try {
+        results[i].md5 = HashFile(file_paths[i]);
+      } catch (...) {
+        results[i].error = std::current_exception();
+      }
+      continue;
+    }
+    messages.push_back({entries[i].content.data(), entries[i].content.size()});
+    message_files.push_back(i);
+  }
+
+  digests.resize(messages.size());
+  multi_buffer_.Hash(messages.data(), messages.size(), digests.data());
+  for (std::size_t i = 0; i < messages.size(); ++i) {
+    results[message_files[i]].md5 = digests[i];
+  }
+}
+
+std::size_t Md5FileHasher::PreferredBatchSize() const {
+  if (reader_.Options().strategy == IoStrategy::kIoUring) {
+    return std::max(multi_buffer_.Lanes(), kMinIoUringBatchSize);
+  }
+  return multi_buffer_.Lanes();
+}
 
-  return md5_lib::CalculateMD5(file_stream);
+std::uintmax_t Md5FileHasher::MaxBatchedFileSize() const {
+  return PreferredBatchSize() > 1 ? kMaxBatchedFileSize : 0;
 }
 
-}  // namespace scanner
\ No newline at end of file
+}  // namespace scanner
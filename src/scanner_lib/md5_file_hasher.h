@@ -1,10 +1,15 @@
 #ifndef SRC_SCANNER_LIB_MD5_FILE_HASHER_H_
 #define SRC_SCANNER_LIB_MD5_FILE_HASHER_H_
 
+#include <cstdint>
+
 #include <filesystem>
-#include <string>
+#include <vector>
 
+#include "scanner/domain.h"
 #include "scanner/interfaces.h"
+#include "src/scanner_lib/file_reader.h"
+#include "src/scanner_lib/md5_multi_buffer.h"
 
 namespace scanner {
 
@@ -12,25 +17,70 @@ namespace scanner {
  * @class Md5FileHasher
  * @brief An implementation of IFileHasher that calculates MD5 hashes.
  *
- * This class uses a streaming approach to handle files of any size without
- * consuming large amounts of memory. It is an internal, non-exported class.
+ * Single files are streamed through a FileReader, so files of any size are
+ * hashed without consuming large amounts of memory. Batches of small files
+ * are read whole and hashed together by a multi-buffer SIMD engine selected
+ * for the running CPU. It is an internal, non-exported class.
  */
 class Md5FileHasher final : public IFileHasher {
 public:
+  /** @brief The largest file hashed in memory as part of a batch. */
+  static constexpr std::uintmax_t kMaxBatchedFileSize = 128 * 1024;
+
+  /**
+   * @brief The smallest batch requested with IoStrategy::kIoUring, so that
+   * enough reads are in flight even without SIMD lanes to fill.
+   */
+  static constexpr std::size_t kMinIoUringBatchSize = 32;
+
+  /**
+   * @brief Constructs a hasher.
+   * @param isa The instruction set used for batches; defaults to the best one
+   * supported by the CPU.
+   * @param io_options How file contents are read.
+   */
+  explicit Md5FileHasher(Md5Isa isa = Md5MultiBuffer::BestIsa(),
+                         const IoOptions& io_options = {});
+
   /**
    * @brief Calculates the MD5 hash of a given file.
    *
-   * Opens the file and reads it in chunks, feeding them into the MD5
-   * algorithm.
+   * Reads the file with the configured I/O strategy, feeding its content
+   * into the MD5 algorithm.
    *
    * @param file_path The path to the file to be hashed.
-   * @return A string representing the lowercase hexadecimal MD5 hash.
-   * @throws std::runtime_error if the file cannot be opened.
-   * @throws std::ios_base::failure on stream reading errors.
+   * @return The binary MD5 digest of the file.
+   * @throws std::runtime_error if the file cannot be opened or read.
+   */
+  Md5Digest HashFile(const std::filesystem::path& file_path) override;
+
+  /**
+   * @brief Hashes a batch of files across SIMD lanes.
+   *
+   * Files up to kMaxBatchedFileSize are read into per-thread buffers, through
+   * io_uring if configured, and hashed together; larger ones fall back to
+   * HashFile.
+   *
+   * @param file_paths The files to hash.
+   * @param results Resized to match file_paths and filled in order.
    */
-  std::string HashFile(const std::filesystem::path& file_path) override;
+  void HashFiles(const std::vector<std::filesystem::path>& file_paths,
+                 std::vector<FileHashResult>& results) override;
+
+  /**
+   * @brief Returns the SIMD lane count, raised to at least
+   * kMinIoUringBatchSize with IoStrategy::kIoUring.
+   */
+  std::size_t PreferredBatchSize() const override;
+
+  /** @brief Returns kMaxBatchedFileSize, or 0 if batching is pointless. */
+  std::uintmax_t MaxBatchedFileSize() const override;
+
+private:
+  Md5MultiBuffer multi_buffer_;
+  FileReader reader_;
 };
 
 }  // namespace scanner
 
-#endif  // SRC_SCANNER_LIB_MD5_FILE_HASHER_H_
\ No newline at end of file
+#endif  // SRC_SCANNER_LIB_MD5_FILE_HASHER_H_
@@ -0,0 +1,121 @@
+// MD5 compression for 16 independent lanes using AVX-512F. This file is
+// compiled with AVX-512 code generation enabled; see
+// src/scanner_lib/CMakeLists.txt.
+
+#include "src/scanner_lib/cpu_features.h"
+#include "src/scanner_lib/md5_lanes.h"
+
+#ifdef SCANNER_ARCH_X86
+
+#include <immintrin.h>
+
+namespace scanner {
+namespace md5 {
+namespace {
+
+// Transposes an 8x8 matrix of 32-bit words held in eight rows.
+void Transpose8x8(__m256i r[8]) {
+  const __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+  const __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+  const __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+  const __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+  const __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+  const __m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+  const __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+  const __m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+
+  const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+  const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+  const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+  const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+  const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+  const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+  const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+  const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+
+  r[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+  r[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+  r[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+  r[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+  r[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+  r[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+  r[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+  r[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+// The unmasked forms of some intrinsics are defined by GCC in terms of an
+// _mm512_undefined_epi32() source, which trips -Wmaybe-uninitialized once
+// inlined. Their zero-masked forms with every lane selected compile to the
+// same instructions without it.
+constexpr __mmask16 kAllWords = 0xFFFF;
+constexpr __mmask8 kAllQuadwords = 0xFF;
+
+struct Avx512 {
+  using V = __m512i;
+  static constexpr std::size_t kLanes = 16;
+
+  static V Load(const std::uint32_t* p) {
+    return _mm512_loadu_si512(p);
+  }
+  static void Store(std::uint32_t* p, V v) {
+    _mm512_storeu_si512(p, v);
+  }
+  static V Set1(std::uint32_t x) {
+    return _mm512_set1_epi32(static_cast<int>(x));
+  }
+  static V Add(V x, V y) {
+    return _mm512_add_epi32(x, y);
+  }
+  template <int kBits>
+  static V RotateLeft(V x) {
+    return _mm512_maskz_rol_epi32(kAllWords, x, kBits);
+  }
+  // Each auxiliary function is a single ternary-logic instruction; the
+  // immediates are the functions' truth tables.
+  static V F(V x, V y, V z) {
+    return _mm512_ternarylogic_epi32(x, y, z, 0xCA);
+  }
+  static V G(V x, V y, V z) {
+    return _mm512_ternarylogic_epi32(x, y, z, 0xE4);
+  }
+  static V H(V x, V y, V z) {
+    return _mm512_ternarylogic_epi32(x, y, z, 0x96);
+  }
+  static V I(V x, V y, V z) {
+    return _mm512_ternarylogic_epi32(x, y, z, 0x39);
+  }
+
+  // Transposes each 8-lane, 8-word quadrant with AVX2 and joins the lane
+  // groups into 16-lane vectors.
+  static void LoadMessage(const std::uint8_t* const* ptrs, V w[16]) {
+    for (int half = 0; half < 2; ++half) {
+      __m256i low[8];
+      __m256i high[8];
+      for (int lane = 0; lane < 8; ++lane) {
+        low[lane] = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(ptrs[lane] + half * 32));
+        high[lane] = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(ptrs[lane + 8] + half * 32));
+      }
+      Transpose8x8(low);
+      Transpose8x8(high);
+      for (int word = 0; word < 8; ++word) {
+        w[half * 8 + word] = _mm512_maskz_inserti64x4(
+            kAllQuadwords, _mm512_castsi256_si512(low[word]), high[word], 1);
+      }
+    }
+  }
+};
+
+}  // namespace
+
+void CompressLanesAvx512(std::uint32_t* state,
+                         const std::uint8_t* const* blocks,
+                         std::size_t num_blocks) {
+  CompressLanes<Avx512>(state, blocks, num_blocks);
+}
+
+}  // namespace md5
+}  // namespace scanner
+
+#endif  // SCANNER_ARCH_X86
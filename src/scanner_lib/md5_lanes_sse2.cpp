@@ -0,0 +1,79 @@
+// MD5 compression for 4 independent lanes using SSE2.
+
+#include "src/scanner_lib/cpu_features.h"
+#include "src/scanner_lib/md5_lanes.h"
+
+#ifdef SCANNER_ARCH_X86
+
+#include <emmintrin.h>
+
+namespace scanner {
+namespace md5 {
+namespace {
+
+struct Sse2 {
+  using V = __m128i;
+  static constexpr std::size_t kLanes = 4;
+
+  static V Load(const std::uint32_t* p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  }
+  static void Store(std::uint32_t* p, V v) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+  }
+  static V Set1(std::uint32_t x) {
+    return _mm_set1_epi32(static_cast<int>(x));
+  }
+  static V Add(V x, V y) {
+    return _mm_add_epi32(x, y);
+  }
+  template <int kBits>
+  static V RotateLeft(V x) {
+    return _mm_or_si128(_mm_slli_epi32(x, kBits),
+                        _mm_srli_epi32(x, 32 - kBits));
+  }
+  static V F(V x, V y, V z) {
+    return _mm_xor_si128(z, _mm_and_si128(x, _mm_xor_si128(y, z)));
+  }
+  static V G(V x, V y, V z) {
+    return _mm_xor_si128(y, _mm_and_si128(z, _mm_xor_si128(x, y)));
+  }
+  static V H(V x, V y, V z) {
+    return _mm_xor_si128(_mm_xor_si128(x, y), z);
+  }
+  static V I(V x, V y, V z) {
+    return _mm_xor_si128(y, _mm_or_si128(x, _mm_xor_si128(z, Set1(~0U))));
+  }
+
+  // Loads one block per lane and transposes it so that w[i] holds message
+  // word i of every lane.
+  static void LoadMessage(const std::uint8_t* const* ptrs, V w[16]) {
+    for (int quarter = 0; quarter < 4; ++quarter) {
+      V r[4];
+      for (int lane = 0; lane < 4; ++lane) {
+        r[lane] = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(ptrs[lane] + quarter * 16));
+      }
+      const V t0 = _mm_unpacklo_epi32(r[0], r[1]);
+      const V t1 = _mm_unpacklo_epi32(r[2], r[3]);
+      const V t2 = _mm_unpackhi_epi32(r[0], r[1]);
+      const V t3 = _mm_unpackhi_epi32(r[2], r[3]);
+      w[quarter * 4 + 0] = _mm_unpacklo_epi64(t0, t1);
+      w[quarter * 4 + 1] = _mm_unpackhi_epi64(t0, t1);
+      w[quarter * 4 + 2] = _mm_unpacklo_epi64(t2, t3);
+      w[quarter * 4 + 3] = _mm_unpackhi_epi64(t2, t3);
+    }
+  }
+};
+
+}  // namespace
+
+void CompressLanesSse2(std::uint32_t* state, const std::uint8_t* const* blocks,
+                       std::size_t num_blocks) {
+  CompressLanes<Sse2>(state, blocks, num_blocks);
+}
+
+}  // namespace md5
+}  // namespace scanner
+
+#endif  // SCANNER_ARCH_X86
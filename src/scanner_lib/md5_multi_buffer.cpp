@@ -0,0 +1,105 @@
+#include "src/scanner_lib/md5_multi_buffer.h"
+
+#include <stdexcept>
+
+#include "src/scanner_lib/cpu_features.h"
+#include "src/scanner_lib/md5_engine.h"
+#include "src/scanner_lib/multi_buffer.h"
+
+namespace scanner {
+namespace {
+
+// Adapts the MD5 primitives to multi_buffer::HashInLanes.
+struct Md5Traits {
+  using Digest = Md5Digest;
+  static constexpr std::size_t kBlockSize = md5::kBlockSize;
+  static constexpr std::size_t kStateWords = 4;
+  static constexpr const std::uint32_t* kInitialState = md5::kInitialState;
+
+  static std::size_t PadFinalBlocks(const std::uint8_t* tail,
+                                    std::size_t tail_size,
+                                    std::uint64_t message_size,
+                                    std::uint8_t* out) {
+    return md5::PadFinalBlocks(tail, tail_size, message_size, out);
+  }
+  static void Transform(std::uint32_t* state, const std::uint8_t* blocks,
+                        std::size_t num_blocks) {
+    md5::Transform(state, blocks, num_blocks);
+  }
+  static Md5Digest StateToDigest(const std::uint32_t* state) {
+    return md5::StateToDigest(state);
+  }
+};
+
+void HashScalar(const HashMessage* messages, std::size_t count,
+                Md5Digest* digests) {
+  for (std::size_t i = 0; i < count; ++i) {
+    Md5Engine engine;
+    engine.Update(messages[i].data, messages[i].size);
+    digests[i] = engine.Final();
+  }
+}
+
+}  // namespace
+
+Md5MultiBuffer::Md5MultiBuffer(Md5Isa isa)
+    : isa_(isa), lanes_(1), kernel_(nullptr) {
+  if (!IsSupported(isa)) {
+    throw std::runtime_error("MD5 instruction set is not supported by CPU");
+  }
+#ifdef SCANNER_ARCH_X86
+  switch (isa) {
+    case Md5Isa::kScalar:
+      break;
+    case Md5Isa::kSse2:
+      lanes_ = 4;
+      kernel_ = md5::CompressLanesSse2;
+      break;
+    case Md5Isa::kAvx2:
+      lanes_ = 8;
+      kernel_ = md5::CompressLanesAvx2;
+      break;
+    case Md5Isa::kAvx512:
+      lanes_ = 16;
+      kernel_ = md5::CompressLanesAvx512;
+      break;
+  }
+#endif
+}
+
+Md5Isa Md5MultiBuffer::BestIsa() {
+  for (const Md5Isa isa : {Md5Isa::kAvx512, Md5Isa::kAvx2, Md5Isa::kSse2}) {
+    if (IsSupported(isa)) {
+      return isa;
+    }
+  }
+  return Md5Isa::kScalar;
+}
+
+bool Md5MultiBuffer::IsSupported(Md5Isa isa) {
+  const CpuFeatures& features = GetCpuFeatures();
+  switch (isa) {
+    case Md5Isa::kScalar:
+      return true;
+    case Md5Isa::kSse2:
+      return features.sse2;
+    case Md5Isa::kAvx2:
+      return features.avx2;
+    case Md5Isa::kAvx512:
+      return features.avx512f && features.avx2;
+  }
+  return false;
+}
+
+void Md5MultiBuffer::Hash(const HashMessage* messages, std::size_t count,
+                          Md5Digest* digests) const {
+  if (kernel_ == nullptr || count < 2) {
+    HashScalar(messages, count, digests);
+    return;
+  }
+
+  multi_buffer::HashInLanes<Md5Traits>(messages, count, digests, lanes_,
+                                       kernel_);
+}
+
+}  // namespace scanner
@@ -0,0 +1,69 @@
+#ifndef SRC_SCANNER_LIB_MD5_MULTI_BUFFER_H_
+#define SRC_SCANNER_LIB_MD5_MULTI_BUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "scanner/domain.h"
+#include "src/scanner_lib/md5_lanes.h"
+#include "src/scanner_lib/multi_buffer.h"
+
+namespace scanner {
+
+/** @brief The instruction sets a Md5MultiBuffer can run on. */
+enum class Md5Isa { kScalar, kSse2, kAvx2, kAvx512 };
+
+/**
+ * @class Md5MultiBuffer
+ * @brief Hashes several independent messages at once using SIMD lanes.
+ *
+ * MD5 is serial within a message, but independent messages can be
+ * interleaved: each SIMD lane carries one message's state, so an AVX2 kernel
+ * advances 8 messages per compression and AVX-512 advances 16. When a message
+ * finishes, the next pending one takes over its lane. This pays off for many
+ * small messages (e.g., whole small files); a single message is best hashed
+ * with Md5Engine. This class is an internal, non-exported component of the
+ * scanner library.
+ */
+class Md5MultiBuffer {
+public:
+  /**
+   * @brief Constructs an engine for the given instruction set.
+   * @param isa The instruction set to use; must satisfy IsSupported().
+   */
+  explicit Md5MultiBuffer(Md5Isa isa = BestIsa());
+
+  /** @brief Returns the widest instruction set supported by this CPU. */
+  static Md5Isa BestIsa();
+
+  /** @brief Returns whether this CPU can run the given instruction set. */
+  static bool IsSupported(Md5Isa isa);
+
+  /** @brief Returns the instruction set used by this engine. */
+  Md5Isa Isa() const {
+    return isa_;
+  }
+
+  /** @brief Returns the number of messages hashed in parallel. */
+  std::size_t Lanes() const {
+    return lanes_;
+  }
+
+  /**
+   * @brief Computes the digests of a set of messages.
+   * @param messages The messages to hash.
+   * @param count The number of messages.
+   * @param digests Receives one digest per message, in order.
+   */
+  void Hash(const HashMessage* messages, std::size_t count,
+            Md5Digest* digests) const;
+
+private:
+  Md5Isa isa_;
+  std::size_t lanes_;
+  md5::LanesKernel kernel_;
+};
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_MD5_MULTI_BUFFER_H_
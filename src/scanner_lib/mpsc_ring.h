@@ -0,0 +1,124 @@
+#ifndef SRC_SCANNER_LIB_MPSC_RING_H_
+#define SRC_SCANNER_LIB_MPSC_RING_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <memory>
+#include <optional>
+
+namespace scanner {
+
+/**
+ * @class MpscRing
+ * @brief A bounded lock-free queue for many producers and a single consumer.
+ *
+ * Follows Dmitry Vyukov's bounded queue: every slot carries a sequence
+ * number telling whether it is free for the producer of a given position or
+ * holds the item for the consumer of that position. Producers claim a
+ * position with a single compare-and-swap and publish the item with a release
+ * store, so a slow producer never blocks the others. Items are filled and
+ * drained in place, which lets slots keep their allocations (e.g., string
+ * capacity) from one use to the next. This class is an internal, non-exported
+ * component of the scanner library.
+ *
+ * @tparam T The slot type; it must be default-constructible.
+ */
+template <class T>
+class MpscRing {
+public:
+  /**
+   * @brief Constructs an empty ring.
+   * @param capacity The number of slots; rounded up to a power of two.
+   */
+  explicit MpscRing(std::size_t capacity) {
+    std::size_t rounded = 2;
+    while (rounded < capacity) {
+      rounded <<= 1;
+    }
+    mask_ = rounded - 1;
+    cells_ = std::make_unique<Cell[]>(rounded);
+    for (std::size_t i = 0; i < rounded; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpscRing(const MpscRing&) = delete;
+  MpscRing& operator=(const MpscRing&) = delete;
+
+  /** @brief Returns the number of slots. */
+  std::size_t Capacity() const {
+    return mask_ + 1;
+  }
+
+  /**
+   * @brief Claims a slot and fills it. Any thread.
+   *
+   * A claimed slot must be published before the consumer can pass it, so
+   * work that may throw, such as allocating, belongs before the call: fill
+   * should only move or swap prepared values into the slot.
+   *
+   * @param fill Called with the claimed slot; it must not throw.
+   * @return The position of the item in the stream of all items pushed, or
+   * std::nullopt if the ring is full.
+   */
+  template <class Fill>
+  std::optional<std::size_t> TryPush(Fill&& fill) {
+    std::size_t position = tail_.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+      cell = &cells_[position & mask_];
+      const std::size_t sequence =
+          cell->sequence.load(std::memory_order_acquire);
+      const auto difference = static_cast<std::intptr_t>(sequence) -
+                              static_cast<std::intptr_t>(position);
+      if (difference == 0) {
+        if (tail_.compare_exchange_weak(position, position + 1,
+                                        std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        return std::nullopt;  // The consumer has not freed this slot yet.
+      } else {
+        position = tail_.load(std::memory_order_relaxed);
+      }
+    }
+    fill(cell->value);
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return position;
+  }
+
+  /**
+   * @brief Drains the oldest item, if it has been published. Consumer only.
+   * @param drain Called with the slot holding the item.
+   * @return False if no item is ready.
+   */
+  template <class Drain>
+  bool TryPop(Drain&& drain) {
+    Cell& cell = cells_[head_ & mask_];
+    if (cell.sequence.load(std::memory_order_acquire) != head_ + 1) {
+      return false;
+    }
+    drain(cell.value);
+    cell.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+    head_++;
+    return true;
+  }
+
+private:
+  struct alignas(64) Cell {
+    std::atomic<std::size_t> sequence{0};
+    T value{};
+  };
+
+  std::unique_ptr<Cell[]> cells_;
+  std::size_t mask_ = 0;
+  // Producers contend on the tail; the consumer owns the head.
+  alignas(64) std::atomic<std::size_t> tail_{0};
+  alignas(64) std::size_t head_ = 0;
+};
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_MPSC_RING_H_
@@ -0,0 +1,173 @@
+#ifndef SRC_SCANNER_LIB_MULTI_BUFFER_H_
+#define SRC_SCANNER_LIB_MULTI_BUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+
+namespace scanner {
+
+/**
+ * @struct HashMessage
+ * @brief A complete in-memory message to be hashed by a multi-buffer engine.
+ */
+struct HashMessage {
+  const std::uint8_t* data;
+  std::size_t size;
+};
+
+namespace multi_buffer {
+
+/** @brief The most lanes any multi-lane kernel runs. */
+inline constexpr std::size_t kMaxLanes = 16;
+
+/**
+ * @brief Hashes messages by interleaving them across the lanes of a kernel.
+ *
+ * Each lane carries one message's state; when a message finishes, the next
+ * pending one takes over its lane. A message is processed as two segments:
+ * its whole blocks, read in place, followed by the padded final block(s).
+ * Shared by Md5MultiBuffer and Sha256MultiBuffer.
+ *
+ * `Traits` supplies the `Digest` type, `kBlockSize`, `kStateWords`,
+ * `kInitialState`, and the single-message `PadFinalBlocks`, `Transform` and
+ * `StateToDigest` functions of the algorithm.
+ *
+ * @param messages The messages to hash.
+ * @param count The number of messages; must be at least 2.
+ * @param digests Receives one digest per message, in order.
+ * @param lanes The kernel's lane count; at most kMaxLanes.
+ * @param kernel Runs the compression function over the same number of
+ * blocks in every lane, with the state in structure-of-arrays layout.
+ */
+template <class Traits, class Kernel>
+void HashInLanes(const HashMessage* messages, std::size_t count,
+                 typename Traits::Digest* digests, std::size_t lanes,
+                 Kernel kernel) {
+  constexpr std::size_t kBlockSize = Traits::kBlockSize;
+  constexpr std::size_t kStateWords = Traits::kStateWords;
+
+  struct Lane {
+    std::size_t message = 0;
+    const std::uint8_t* next_block = nullptr;
+    std::size_t blocks_left = 0;
+    bool in_tail = false;
+    std::size_t tail_blocks = 0;
+    std::uint8_t tail[2 * kBlockSize];
+  };
+
+  Lane lane_states[kMaxLanes];
+  bool active[kMaxLanes] = {};
+  alignas(64) std::uint32_t state[kStateWords * kMaxLanes];
+  const std::uint8_t* blocks[kMaxLanes];
+
+  std::size_t next_message = 0;
+  std::size_t num_active = 0;
+  const auto assign = [&](std::size_t lane) {
+    const HashMessage& message = messages[next_message];
+    const std::size_t whole_blocks = message.size / kBlockSize;
+    Lane& current = lane_states[lane];
+    current.message = next_message;
+    current.tail_blocks = Traits::PadFinalBlocks(
+        message.data + whole_blocks * kBlockSize, message.size % kBlockSize,
+        message.size, current.tail);
+    if (whole_blocks > 0) {
+      current.next_block = message.data;
+      current.blocks_left = whole_blocks;
+      current.in_tail = false;
+    } else {
+      current.next_block = current.tail;
+      current.blocks_left = current.tail_blocks;
+      current.in_tail = true;
+    }
+    next_message++;
+    for (std::size_t word = 0; word < kStateWords; ++word) {
+      state[word * lanes + lane] = Traits::kInitialState[word];
+    }
+  };
+  const auto lane_state = [&](std::size_t lane, std::uint32_t* out) {
+    for (std::size_t word = 0; word < kStateWords; ++word) {
+      out[word] = state[word * lanes + lane];
+    }
+  };
+
+  for (std::size_t lane = 0; lane < lanes && next_message < count; ++lane) {
+    assign(lane);
+    active[lane] = true;
+    num_active++;
+  }
+
+  while (num_active > 0) {
+    // Once a single message remains, the scalar code is faster than running
+    // a full-width kernel with one useful lane.
+    if (num_active == 1 && next_message == count) {
+      break;
+    }
+
+    // Run every lane up to the end of the shortest current segment. Idle
+    // lanes mirror an active lane's input and their results are discarded.
+    std::size_t step = 0;
+    const std::uint8_t* any_block = nullptr;
+    for (std::size_t lane = 0; lane < lanes; ++lane) {
+      if (active[lane]) {
+        step = step == 0 ? lane_states[lane].blocks_left
+                         : std::min(step, lane_states[lane].blocks_left);
+        any_block = lane_states[lane].next_block;
+      }
+    }
+    for (std::size_t lane = 0; lane < lanes; ++lane) {
+      blocks[lane] = active[lane] ? lane_states[lane].next_block : any_block;
+    }
+
+    kernel(state, blocks, step);
+
+    for (std::size_t lane = 0; lane < lanes; ++lane) {
+      if (!active[lane]) {
+        continue;
+      }
+      Lane& current = lane_states[lane];
+      current.next_block += step * kBlockSize;
+      current.blocks_left -= step;
+      if (current.blocks_left > 0) {
+        continue;
+      }
+      if (!current.in_tail) {
+        current.next_block = current.tail;
+        current.blocks_left = current.tail_blocks;
+        current.in_tail = true;
+        continue;
+      }
+
+      std::uint32_t final_state[kStateWords];
+      lane_state(lane, final_state);
+      digests[current.message] = Traits::StateToDigest(final_state);
+      if (next_message < count) {
+        assign(lane);
+      } else {
+        active[lane] = false;
+        num_active--;
+      }
+    }
+  }
+
+  // Finish the last message, if any, on the scalar path.
+  for (std::size_t lane = 0; lane < lanes; ++lane) {
+    if (!active[lane]) {
+      continue;
+    }
+    Lane& current = lane_states[lane];
+    std::uint32_t final_state[kStateWords];
+    lane_state(lane, final_state);
+    Traits::Transform(final_state, current.next_block, current.blocks_left);
+    if (!current.in_tail) {
+      Traits::Transform(final_state, current.tail, current.tail_blocks);
+    }
+    digests[current.message] = Traits::StateToDigest(final_state);
+  }
+}
+
+}  // namespace multi_buffer
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_MULTI_BUFFER_H_
@@ -0,0 +1,357 @@
+#include "src/scanner_lib/parallel_walker.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <optional>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include "src/scanner_lib/file_status.h"
+
+#ifdef __linux__
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace scanner {
+
+class ParallelWalker::PendingDirectory {
+public:
+  explicit PendingDirectory(ParallelWalker& walker) : walker_(walker) {
+  }
+
+  ~PendingDirectory() {
+    if (walker_.pending_directories_.fetch_sub(1) == 1 &&
+        walker_.on_listed_) {
+      walker_.on_listed_();
+    }
+  }
+
+  PendingDirectory(const PendingDirectory&) = delete;
+  PendingDirectory& operator=(const PendingDirectory&) = delete;
+
+private:
+  ParallelWalker& walker_;
+};
+
+namespace {
+
+// The entry lists of a directory listing. They are taken from the spares of
+// the listing thread and given back when the listing is done, so that the
+// thread's next listing reuses their capacity.
+struct SpareLists {
+  SpareLists()
+      : files(std::move(SpareFiles())),
+        subdirectories(std::move(SpareSubdirectories())) {
+  }
+
+  ~SpareLists() {
+    files.clear();
+    subdirectories.clear();
+    SpareFiles() = std::move(files);
+    SpareSubdirectories() = std::move(subdirectories);
+  }
+
+  SpareLists(const SpareLists&) = delete;
+  SpareLists& operator=(const SpareLists&) = delete;
+
+  static std::vector<WalkedFile>& SpareFiles() {
+    thread_local std::vector<WalkedFile> spare;
+    return spare;
+  }
+
+  static std::vector<std::filesystem::path>& SpareSubdirectories() {
+    thread_local std::vector<std::filesystem::path> spare;
+    return spare;
+  }
+
+  std::vector<WalkedFile> files;
+  std::vector<std::filesystem::path> subdirectories;
+};
+
+}  // namespace
+
+#ifdef __linux__
+
+namespace {
+
+constexpr int kDirectoryFlags = O_RDONLY | O_DIRECTORY | O_CLOEXEC;
+
+// getdents64() fills this buffer with as many entries as fit, so a larger
+// buffer means fewer system calls for large directories.
+constexpr std::size_t kDirentBufferSize = 64 * 1024;
+
+bool IsDotOrDotDot(const char* name) {
+  return name[0] == '.' &&
+         (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+}
+
+// Composes the path of a directory entry from the native strings. The
+// operator/ of std::filesystem::path copies the parent and then extends its
+// components, which takes several more allocations per file.
+std::filesystem::path ChildPath(const std::filesystem::path& parent,
+                                const char* name) {
+  const std::string& base = parent.native();
+  const std::size_t length = std::strlen(name);
+  std::string child;
+  child.reserve(base.size() + 1 + length);
+  child.append(base);
+  if (!base.empty() && base.back() != '/') {
+    child.push_back('/');
+  }
+  child.append(name, length);
+  return std::filesystem::path(std::move(child));
+}
+
+unsigned char TypeFromMode(mode_t mode) {
+  if (S_ISDIR(mode)) {
+    return DT_DIR;
+  }
+  if (S_ISREG(mode)) {
+    return DT_REG;
+  }
+  if (S_ISLNK(mode)) {
+    return DT_LNK;
+  }
+  return DT_UNKNOWN;
+}
+
+}  // namespace
+
+// A directory descriptor shared by the tasks of its subdirectories, which
+// open themselves relative to it.
+struct ParallelWalker::OpenDirectory {
+  OpenDirectory(int descriptor, std::atomic<std::size_t>& open_count)
+      : fd(descriptor), count(open_count) {
+    count.fetch_add(1);
+  }
+
+  ~OpenDirectory() {
+    ::close(fd);
+    count.fetch_sub(1);
+  }
+
+  OpenDirectory(const OpenDirectory&) = delete;
+  OpenDirectory& operator=(const OpenDirectory&) = delete;
+
+  const int fd;
+  std::atomic<std::size_t>& count;
+};
+
+void ParallelWalker::VisitDirectory(
+    const std::shared_ptr<OpenDirectory>& parent,
+    const std::filesystem::path& path) {
+  const PendingDirectory pending(*this);
+  ScopedThreadMetrics metrics_scope(metrics_);
+  // Ends before the files are handed on, which may hash them inline.
+  std::optional<StageTimer> listing(std::in_place, ScanStage::kTraversal);
+
+  // Subdirectories are opened without following symbolic links, so that a
+  // directory replaced by a link during the walk is not descended into.
+  // The same goes for directories opened by full path, except for the root.
+  const int flags = kDirectoryFlags | (path == root_ ? 0 : O_NOFOLLOW);
+  const int fd = parent ? ::openat(parent->fd, path.filename().c_str(), flags)
+                        : ::open(path.c_str(), flags);
+  if (fd < 0) {
+    // Unreadable subdirectories are skipped, but a root that cannot be
+    // listed fails the walk like any other error.
+    if (errno != EACCES || path == root_) {
+      on_error_(path, std::strerror(errno));
+    }
+    return;
+  }
+  const auto directory = std::make_shared<OpenDirectory>(fd, open_directories_);
+
+  // Entries are collected before any task is submitted: a full pool runs
+  // submissions inline, which would reuse the buffer. The entry lists are
+  // taken from the thread's spares instead, so a nested listing finds none
+  // and allocates its own.
+  thread_local std::vector<char> buffer(kDirentBufferSize);
+  SpareLists spares;
+  std::vector<WalkedFile>& files = spares.files;
+  std::vector<std::filesystem::path>& subdirectories = spares.subdirectories;
+  for (;;) {
+    const long bytes =
+        ::syscall(SYS_getdents64, fd, buffer.data(), buffer.size());
+    if (bytes == 0) {
+      break;
+    }
+    if (bytes < 0) {
+      on_error_(path, std::strerror(errno));
+      break;
+    }
+    for (long offset = 0; offset < bytes;) {
+      const auto* entry =
+          reinterpret_cast<const struct dirent64*>(buffer.data() + offset);
+      offset += entry->d_reclen;
+      const char* name = entry->d_name;
+      if (IsDotOrDotDot(name)) {
+        continue;
+      }
+
+      struct stat status;
+      unsigned char type = entry->d_type;
+      if (type == DT_UNKNOWN) {
+        // Some filesystems do not report entry types.
+        if (::fstatat(fd, name, &status, AT_SYMLINK_NOFOLLOW) != 0) {
+          continue;
+        }
+        type = TypeFromMode(status.st_mode);
+      }
+
+      if (type == DT_DIR) {
+        std::filesystem::path subdirectory = ChildPath(path, name);
+        if (filter_ && ExcludesDirectory(subdirectory)) {
+          continue;
+        }
+        // AT_NO_AUTOMOUNT keeps a mount point from being mounted only to be
+        // skipped.
+        if (root_device_ &&
+            ::fstatat(fd, name, &status,
+                      AT_SYMLINK_NOFOLLOW | AT_NO_AUTOMOUNT) == 0 &&
+            static_cast<std::uint64_t>(status.st_dev) != *root_device_) {
+          continue;
+        }
+        subdirectories.push_back(std::move(subdirectory));
+      } else if (type == DT_REG || type == DT_LNK) {
+        std::filesystem::path file = ChildPath(path, name);
+        if (filter_ && ExcludesFile(file)) {
+          continue;
+        }
+        // Following the link tells whether it points to a regular file.
+        const bool has_status = ::fstatat(fd, name, &status, 0) == 0;
+        if (has_status && S_ISREG(status.st_mode)) {
+          const auto size = static_cast<std::uint64_t>(status.st_size);
+          if (filter_ && filter_->ExceedsSize(size)) {
+            continue;
+          }
+          files.push_back({std::move(file), size,
+                           static_cast<std::uint64_t>(status.st_ino)});
+        } else if (!has_status && type == DT_REG) {
+          // Hashing the file will report why it cannot be accessed.
+          files.push_back({std::move(file), 0,
+                           static_cast<std::uint64_t>(entry->d_ino)});
+        }
+      }
+    }
+  }
+
+  listing.reset();
+  if (!files.empty()) {
+    on_files_(files);
+  }
+
+  // Keeping every descriptor open until its subdirectories are listed could
+  // exhaust the descriptor limit on wide trees.
+  const std::shared_ptr<OpenDirectory> shared =
+      open_directories_.load() < kMaxOpenDirectories ? directory : nullptr;
+  pending_directories_.fetch_add(subdirectories.size());
+  for (auto& subdirectory : subdirectories) {
+    pool_.Submit([this, shared, subdirectory = std::move(subdirectory)] {
+      VisitDirectory(shared, subdirectory);
+    });
+  }
+}
+
+#else
+
+struct ParallelWalker::OpenDirectory {};
+
+void ParallelWalker::VisitDirectory(
+    const std::shared_ptr<OpenDirectory>& /*parent*/,
+    const std::filesystem::path& path) {
+  const PendingDirectory pending(*this);
+  ScopedThreadMetrics metrics_scope(metrics_);
+  std::optional<StageTimer> listing(std::in_place, ScanStage::kTraversal);
+
+  SpareLists spares;
+  std::vector<WalkedFile>& files = spares.files;
+  std::vector<std::filesystem::path>& subdirectories = spares.subdirectories;
+  std::error_code ec;
+  // As above, only an unreadable root is reported.
+  using std::filesystem::directory_options;
+  std::filesystem::directory_iterator it(
+      path,
+      path == root_ ? directory_options::none
+                    : directory_options::skip_permission_denied,
+      ec);
+  for (; !ec && it != std::filesystem::directory_iterator(); it.increment(ec)) {
+    const std::filesystem::directory_entry& entry = *it;
+    std::error_code entry_ec;
+    if (entry.is_directory(entry_ec) && !entry.is_symlink(entry_ec)) {
+      if (filter_ && ExcludesDirectory(entry.path())) {
+        continue;
+      }
+      if (root_device_ && DeviceOf(entry.path()).value_or(*root_device_) !=
+                              *root_device_) {
+        continue;
+      }
+      subdirectories.push_back(entry.path());
+    } else if (entry.is_regular_file(entry_ec)) {
+      if (filter_ && ExcludesFile(entry.path())) {
+        continue;
+      }
+      const std::uintmax_t size = entry.file_size(entry_ec);
+      if (!entry_ec && filter_ && filter_->ExceedsSize(size)) {
+        continue;
+      }
+      files.push_back({entry.path(), entry_ec ? 0 : size});
+    }
+  }
+  if (ec) {
+    on_error_(path, ec.message());
+  }
+
+  listing.reset();
+  if (!files.empty()) {
+    on_files_(files);
+  }
+  pending_directories_.fetch_add(subdirectories.size());
+  for (auto& subdirectory : subdirectories) {
+    pool_.Submit([this, subdirectory = std::move(subdirectory)] {
+      VisitDirectory(nullptr, subdirectory);
+    });
+  }
+}
+
+#endif
+
+ParallelWalker::ParallelWalker(ThreadPool& pool, FilesCallback on_files,
+                               ErrorCallback on_error,
+                               ScanMetricsRecorder* metrics,
+                               ListedCallback on_listed,
+                               const PathFilter* filter)
+    : pool_(pool),
+      on_files_(std::move(on_files)),
+      on_error_(std::move(on_error)),
+      metrics_(metrics),
+      on_listed_(std::move(on_listed)),
+      filter_(filter) {
+}
+
+bool ParallelWalker::ExcludesDirectory(
+    const std::filesystem::path& path) const {
+  return filter_->ExcludesDirectory(
+      PathFilter::RelativeText(path, prefix_length_));
+}
+
+bool ParallelWalker::ExcludesFile(const std::filesystem::path& path) const {
+  return filter_->ExcludesFile(PathFilter::RelativeText(path, prefix_length_));
+}
+
+void ParallelWalker::Walk(const std::filesystem::path& root) {
+  root_ = root;
+  prefix_length_ = PathFilter::PrefixLength(root_);
+  root_device_ = filter_ && filter_->OneFileSystem() ? DeviceOf(root_)
+                                                     : std::nullopt;
+  pending_directories_.store(1);
+  pool_.Submit([this] { VisitDirectory(nullptr, root_); });
+  pool_.WaitIdle();
+}
+
+}  // namespace scanner
@@ -0,0 +1,144 @@
+#ifndef SRC_SCANNER_LIB_PARALLEL_WALKER_H_
+#define SRC_SCANNER_LIB_PARALLEL_WALKER_H_
+
+#include <cstdint>
+
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "src/scanner_lib/path_filter.h"
+#include "src/scanner_lib/scan_metrics.h"
+#include "src/scanner_lib/thread_pool.h"
+
+namespace scanner {
+
+/**
+ * @struct WalkedFile
+ * @brief A regular file found by the ParallelWalker.
+ */
+struct WalkedFile {
+  std::filesystem::path path;
+  /** @brief The file size in bytes, or 0 if it could not be determined. */
+  std::uint64_t size = 0;
+  /** @brief The inode number, or 0 if it is unknown. */
+  std::uint64_t inode = 0;
+};
+
+/**
+ * @class ParallelWalker
+ * @brief Enumerates a directory tree with the worker threads of a pool.
+ *
+ * Every directory becomes a task of its own, so directories are listed
+ * concurrently and idle workers steal the subdirectories found by others.
+ * On Linux a directory is opened relative to its parent's descriptor with
+ * openat() and listed with getdents64(), taking the entry type from the
+ * directory entry and calling fstatat() only for regular files and symbolic
+ * links. Other platforms list each directory with
+ * std::filesystem::directory_iterator.
+ *
+ * The walk matches std::filesystem::recursive_directory_iterator with
+ * skip_permission_denied: symbolic links to files are reported, symbolic
+ * links to directories are not followed, and directories that cannot be
+ * opened for lack of permission are skipped silently.
+ *
+ * An optional PathFilter is applied as entries are listed. Names and paths
+ * are matched before an entry is stat'ed, so a pruned subtree is never opened
+ * and an excluded file never stat'ed; sizes are checked once a file has been
+ * stat'ed for its size anyway. Only the one-filesystem rule costs a stat of
+ * each subdirectory, without triggering automounts.
+ */
+class ParallelWalker {
+public:
+  /**
+   * @brief Receives the regular files of one directory.
+   *
+   * Called on a worker thread once per directory that contains files. The
+   * callback may take the paths out of the vector and may submit tasks to the
+   * pool; it must not throw.
+   */
+  using FilesCallback = std::function<void(std::vector<WalkedFile>& files)>;
+
+  /** @brief Receives a failure to list a directory; must not throw. */
+  using ErrorCallback = std::function<void(const std::filesystem::path& path,
+                                           const std::string& message)>;
+
+  /**
+   * @brief Called once every directory has been listed, while the tasks
+   * submitted by the callbacks may still run; must not throw.
+   */
+  using ListedCallback = std::function<void()>;
+
+  /**
+   * @brief The number of directory descriptors kept open for opening
+   * subdirectories relative to them. Beyond it, subdirectories are opened by
+   * their full path instead.
+   */
+  static constexpr std::size_t kMaxOpenDirectories = 256;
+
+  /**
+   * @brief Constructs a walker.
+   * @param pool The pool whose workers list the directories.
+   * @param on_files Receives the regular files found.
+   * @param on_error Receives the directories that could not be listed.
+   * @param metrics If set, receives the time spent listing each directory as
+   * ScanStage::kTraversal.
+   * @param on_listed If set, called once every directory has been listed.
+   * @param filter If set, decides which entries are skipped; it must outlive
+   * the walker.
+   */
+  ParallelWalker(ThreadPool& pool, FilesCallback on_files,
+                 ErrorCallback on_error,
+                 ScanMetricsRecorder* metrics = nullptr,
+                 ListedCallback on_listed = nullptr,
+                 const PathFilter* filter = nullptr);
+
+  /**
+   * @brief Walks the tree below a directory.
+   *
+   * Returns once every directory has been listed and every task submitted to
+   * the pool in the meantime, including those submitted by the callbacks, has
+   * completed. Must not be called from a worker of the pool.
+   *
+   * @param root The directory to walk; it may be a symbolic link.
+   */
+  void Walk(const std::filesystem::path& root);
+
+private:
+  struct OpenDirectory;
+
+  // Lists a directory, reports its files and submits its subdirectories.
+  // parent is null for the root and for directories opened by full path.
+  void VisitDirectory(const std::shared_ptr<OpenDirectory>& parent,
+                      const std::filesystem::path& path);
+
+  // Applies the filter's name, path and depth rules to an entry.
+  bool ExcludesDirectory(const std::filesystem::path& path) const;
+  bool ExcludesFile(const std::filesystem::path& path) const;
+
+  // Counts a directory as listed once destroyed, after its subdirectories
+  // have been counted as pending.
+  class PendingDirectory;
+
+  ThreadPool& pool_;
+  FilesCallback on_files_;
+  ErrorCallback on_error_;
+  ScanMetricsRecorder* metrics_;
+  ListedCallback on_listed_;
+  const PathFilter* filter_;
+  std::filesystem::path root_;
+  // Set by Walk() for the filter.
+  std::size_t prefix_length_ = 0;
+  std::optional<std::uint64_t> root_device_;
+  std::atomic<std::size_t> open_directories_{0};
+  // Directories submitted but not yet listed.
+  std::atomic<std::size_t> pending_directories_{0};
+};
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_PARALLEL_WALKER_H_
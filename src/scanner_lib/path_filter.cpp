@@ -0,0 +1,245 @@
+#include "src/scanner_lib/path_filter.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace scanner {
+namespace {
+
+// Parses the class starting after a '[' and returns the position after its
+// ']', or std::string_view::npos if it is not terminated.
+std::size_t ParseClass(std::string_view pattern, std::size_t position,
+                       std::bitset<256>& chars) {
+  bool negated = false;
+  if (position < pattern.size() &&
+      (pattern[position] == '!' || pattern[position] == '^')) {
+    negated = true;
+    position++;
+  }
+  const std::size_t first = position;
+  for (; position < pattern.size(); ++position) {
+    const auto c = static_cast<unsigned char>(pattern[position]);
+    // A ']' right after the '[' is a member, not the end.
+    if (c == ']' && position != first) {
+      if (negated) {
+        chars.flip();
+      }
+      chars.reset('/');
+      return position + 1;
+    }
+    if (position + 2 < pattern.size() && pattern[position + 1] == '-' &&
+        pattern[position + 2] != ']') {
+      const auto last = static_cast<unsigned char>(pattern[position + 2]);
+      for (unsigned int member = c; member <= last; ++member) {
+        chars.set(member);
+      }
+      position += 2;
+    } else {
+      chars.set(c);
+    }
+  }
+  return std::string_view::npos;
+}
+
+}  // namespace
+
+Glob::Glob(std::string_view pattern) {
+  if (!pattern.empty() && pattern.front() == '/') {
+    matches_paths_ = true;
+    pattern.remove_prefix(1);
+  }
+  matches_paths_ = matches_paths_ || pattern.find('/') != pattern.npos;
+
+  const auto append_literal = [this](char c) {
+    if (tokens_.empty() || tokens_.back().kind != Token::Kind::kLiteral) {
+      tokens_.push_back({Token::Kind::kLiteral, {}, {}});
+    }
+    tokens_.back().literal += c;
+  };
+  for (std::size_t i = 0; i < pattern.size(); ++i) {
+    const char c = pattern[i];
+    if (c == '*') {
+      const bool double_star = i + 1 < pattern.size() && pattern[i + 1] == '*';
+      const bool at_boundary = i == 0 || pattern[i - 1] == '/';
+      if (double_star && at_boundary && i + 2 == pattern.size()) {
+        tokens_.push_back({Token::Kind::kGlobstarTail, {}, {}});
+        break;
+      }
+      if (double_star && at_boundary && pattern[i + 2] == '/') {
+        tokens_.push_back({Token::Kind::kGlobstar, {}, {}});
+        i += 2;  // The '/' belongs to the globstar.
+        continue;
+      }
+      // Any other run of stars matches like a single one.
+      while (i + 1 < pattern.size() && pattern[i + 1] == '*') {
+        i++;
+      }
+      tokens_.push_back({Token::Kind::kStar, {}, {}});
+    } else if (c == '?') {
+      tokens_.push_back({Token::Kind::kAnyChar, {}, {}});
+    } else if (c == '[') {
+      Token token{Token::Kind::kClass, {}, {}};
+      const std::size_t end = ParseClass(pattern, i + 1, token.chars);
+      if (end == std::string_view::npos) {
+        append_literal(c);
+        continue;
+      }
+      tokens_.push_back(std::move(token));
+      i = end - 1;
+    } else if (c == '\\' && i + 1 < pattern.size()) {
+      append_literal(pattern[++i]);
+    } else {
+      append_literal(c);
+    }
+  }
+
+  if (tokens_.empty()) {
+    literal_.emplace();
+  } else if (tokens_.size() == 1 &&
+             tokens_.front().kind == Token::Kind::kLiteral) {
+    literal_ = tokens_.front().literal;
+  }
+}
+
+bool Glob::Matches(std::string_view text) const {
+  return Match(0, text);
+}
+
+bool Glob::Match(std::size_t token, std::string_view text) const {
+  for (; token < tokens_.size(); ++token) {
+    const Token& current = tokens_[token];
+    switch (current.kind) {
+      case Token::Kind::kLiteral:
+        if (text.substr(0, current.literal.size()) != current.literal) {
+          return false;
+        }
+        text.remove_prefix(current.literal.size());
+        break;
+      case Token::Kind::kAnyChar:
+        if (text.empty() || text.front() == '/') {
+          return false;
+        }
+        text.remove_prefix(1);
+        break;
+      case Token::Kind::kClass:
+        if (text.empty() ||
+            !current.chars.test(static_cast<unsigned char>(text.front()))) {
+          return false;
+        }
+        text.remove_prefix(1);
+        break;
+      case Token::Kind::kStar:
+        for (std::size_t length = 0;; ++length) {
+          if (Match(token + 1, text.substr(length))) {
+            return true;
+          }
+          if (length == text.size() || text[length] == '/') {
+            return false;
+          }
+        }
+      case Token::Kind::kGlobstar:
+        // Tries zero components, then every component boundary.
+        for (std::size_t start = 0;;) {
+          if (Match(token + 1, text.substr(start))) {
+            return true;
+          }
+          const std::size_t slash = text.find('/', start);
+          if (slash == text.npos) {
+            return false;
+          }
+          start = slash + 1;
+        }
+      case Token::Kind::kGlobstarTail:
+        return true;
+    }
+  }
+  return text.empty();
+}
+
+void PathFilter::Patterns::Add(const std::string& pattern) {
+  if (pattern.empty()) {
+    throw std::runtime_error("Empty pattern in traversal filter");
+  }
+  Glob glob(pattern);
+  if (glob.MatchesPaths()) {
+    path_globs.push_back(std::move(glob));
+  } else if (glob.Literal()) {
+    const std::string& name = *glob.Literal();
+    names.insert(std::upper_bound(names.begin(), names.end(), name), name);
+  } else {
+    name_globs.push_back(std::move(glob));
+  }
+}
+
+bool PathFilter::Patterns::Empty() const {
+  return names.empty() && name_globs.empty() && path_globs.empty();
+}
+
+bool PathFilter::Patterns::Match(std::string_view relative) const {
+  const std::string_view name = relative.substr(relative.rfind('/') + 1);
+  if (std::binary_search(names.begin(), names.end(), name)) {
+    return true;
+  }
+  const auto matches = [](std::string_view text) {
+    return [text](const Glob& glob) { return glob.Matches(text); };
+  };
+  return std::any_of(name_globs.begin(), name_globs.end(), matches(name)) ||
+         std::any_of(path_globs.begin(), path_globs.end(), matches(relative));
+}
+
+PathFilter::PathFilter(const TraversalFilter& filter)
+    : max_file_size_(filter.max_file_size),
+      max_depth_(filter.max_depth),
+      one_file_system_(filter.one_file_system) {
+  for (const std::string& pattern : filter.include) {
+    include_.Add(pattern);
+  }
+  for (const std::string& pattern : filter.exclude) {
+    exclude_.Add(pattern);
+  }
+  active_ = !include_.Empty() || !exclude_.Empty() || max_file_size_ ||
+            max_depth_ || one_file_system_;
+}
+
+bool PathFilter::ExcludesDirectory(std::string_view relative) const {
+  if (max_depth_) {
+    // Children of the scanned directory are at depth 1.
+    const auto depth =
+        static_cast<std::size_t>(
+            std::count(relative.begin(), relative.end(), '/')) +
+        1;
+    if (depth > *max_depth_) {
+      return true;
+    }
+  }
+  return !exclude_.Empty() && exclude_.Match(relative);
+}
+
+bool PathFilter::ExcludesFile(std::string_view relative) const {
+  if (!exclude_.Empty() && exclude_.Match(relative)) {
+    return true;
+  }
+  return !include_.Empty() && !include_.Match(relative);
+}
+
+std::size_t PathFilter::PrefixLength(const std::filesystem::path& root) {
+#ifdef _WIN32
+  const std::string text = root.generic_string();
+#else
+  const std::string& text = root.native();
+#endif
+  return text.empty() || text.back() == '/' ? text.size() : text.size() + 1;
+}
+
+PathFilter::Text PathFilter::RelativeText(const std::filesystem::path& path,
+                                          std::size_t prefix_length) {
+#ifdef _WIN32
+  std::string text = path.generic_string();
+  return prefix_length < text.size() ? text.substr(prefix_length) : Text();
+#else
+  const std::string_view text = path.native();
+  return prefix_length < text.size() ? text.substr(prefix_length) : Text();
+#endif
+}
+
+}  // namespace scanner
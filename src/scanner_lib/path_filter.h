@@ -0,0 +1,177 @@
+#ifndef SRC_SCANNER_LIB_PATH_FILTER_H_
+#define SRC_SCANNER_LIB_PATH_FILTER_H_
+
+#include <cstdint>
+
+#include <bitset>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "scanner/domain.h"
+
+namespace scanner {
+
+/**
+ * @class Glob
+ * @brief A glob pattern parsed once into tokens, in the syntax described by
+ * TraversalFilter.
+ */
+class Glob {
+public:
+  /**
+   * @brief Parses a pattern. A leading `/` anchors it at the scanned
+   * directory like any other pattern containing a `/`. An unterminated `[`
+   * and a trailing `\` match themselves.
+   * @param pattern The pattern; must not be empty.
+   */
+  explicit Glob(std::string_view pattern);
+
+  /** @brief Returns true if the pattern matches the whole text. */
+  bool Matches(std::string_view text) const;
+
+  /** @brief True if the pattern matches relative paths rather than names. */
+  bool MatchesPaths() const {
+    return matches_paths_;
+  }
+
+  /** @brief The literal name the pattern matches, if it has no wildcards. */
+  const std::optional<std::string>& Literal() const {
+    return literal_;
+  }
+
+private:
+  struct Token {
+    enum class Kind {
+      kLiteral,
+      /** @brief `?`: one character other than `/`. */
+      kAnyChar,
+      /** @brief `[...]`: one character of a set, never `/`. */
+      kClass,
+      /** @brief `*`: any run of characters other than `/`. */
+      kStar,
+      /** @brief `**` followed by `/`: zero or more whole components. */
+      kGlobstar,
+      /** @brief `**` at the end: everything that is left. */
+      kGlobstarTail,
+    };
+    Kind kind = Kind::kLiteral;
+    std::string literal;
+    std::bitset<256> chars;
+  };
+
+  bool Match(std::size_t token, std::string_view text) const;
+
+  std::vector<Token> tokens_;
+  bool matches_paths_ = false;
+  std::optional<std::string> literal_;
+};
+
+/**
+ * @class PathFilter
+ * @brief Decides which entries of a traversal are skipped, from the rules of
+ * a TraversalFilter compiled once.
+ *
+ * The walkers consult it with what the directory listing already provides:
+ * names and paths are checked before an entry is stat'ed, sizes once a file
+ * has been stat'ed anyway. Patterns without wildcards are kept in a sorted
+ * table of names, so the common exclusions (`.git`, `node_modules`) cost a
+ * binary search rather than a match per pattern. This class is an internal,
+ * non-exported component of the scanner library.
+ */
+class PathFilter {
+public:
+  /** @brief Constructs a filter that skips nothing. */
+  PathFilter() = default;
+
+  /**
+   * @brief Compiles the rules of a filter.
+   * @param filter The rules.
+   * @throws std::runtime_error if a pattern is empty.
+   */
+  explicit PathFilter(const TraversalFilter& filter);
+
+  /** @brief Returns true if any rule is set, i.e. the filter may skip. */
+  bool Active() const {
+    return active_;
+  }
+
+  /** @brief Returns true if directories on other filesystems are skipped. */
+  bool OneFileSystem() const {
+    return one_file_system_;
+  }
+
+  /**
+   * @brief Returns true if a directory is pruned by an exclusion or by the
+   * depth limit.
+   * @param relative The path relative to the scanned directory, with `/`
+   * separators; see RelativeText().
+   */
+  bool ExcludesDirectory(std::string_view relative) const;
+
+  /**
+   * @brief Returns true if a file is skipped by an exclusion or for not
+   * matching any inclusion.
+   * @param relative The path relative to the scanned directory, with `/`
+   * separators; see RelativeText().
+   */
+  bool ExcludesFile(std::string_view relative) const;
+
+  /** @brief Returns true if a file of this size is skipped. */
+  bool ExceedsSize(std::uint64_t size) const {
+    return max_file_size_ && size > *max_file_size_;
+  }
+
+  /** @brief Returns true if ExceedsSize() may skip a file, so sizes count. */
+  bool LimitsSize() const {
+    return max_file_size_.has_value();
+  }
+
+  /**
+   * @brief The number of leading characters RelativeText() strips from the
+   * paths below a root.
+   * @param root The scanned directory, as passed to the walker.
+   */
+  static std::size_t PrefixLength(const std::filesystem::path& root);
+
+#ifdef _WIN32
+  /** @brief Native paths are wide, so the relative text is converted. */
+  using Text = std::string;
+#else
+  /** @brief A view into the native path, which already uses `/`. */
+  using Text = std::string_view;
+#endif
+
+  /**
+   * @brief Returns the path of an entry relative to the scanned directory.
+   * @param path A path below the root, as composed by the walker.
+   * @param prefix_length The result of PrefixLength() for the root.
+   */
+  static Text RelativeText(const std::filesystem::path& path,
+                           std::size_t prefix_length);
+
+private:
+  // A name or path pattern list, with literal names split off.
+  struct Patterns {
+    std::vector<std::string> names;  // Sorted.
+    std::vector<Glob> name_globs;
+    std::vector<Glob> path_globs;
+
+    void Add(const std::string& pattern);
+    bool Empty() const;
+    bool Match(std::string_view relative) const;
+  };
+
+  Patterns include_;
+  Patterns exclude_;
+  std::optional<std::uint64_t> max_file_size_;
+  std::optional<std::size_t> max_depth_;
+  bool one_file_system_ = false;
+  bool active_ = false;
+};
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_PATH_FILTER_H_
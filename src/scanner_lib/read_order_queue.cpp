@@ -0,0 +1,48 @@
+#include "src/scanner_lib/read_order_queue.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace scanner {
+
+ReadOrderQueue::ReadOrderQueue(std::size_t window)
+    : window_(std::max<std::size_t>(window, 1)) {
+}
+
+std::size_t ReadOrderQueue::Push(std::filesystem::path path,
+                                 std::uint64_t key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  pending_.push_back(Entry{key, std::move(path)});
+  return pending_.size() >= window_ ? Release() : 0;
+}
+
+std::size_t ReadOrderQueue::Flush() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Release();
+}
+
+std::optional<std::filesystem::path> ReadOrderQueue::Pop() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (ready_.empty()) {
+    return std::nullopt;
+  }
+  std::filesystem::path path = std::move(ready_.front());
+  ready_.pop_front();
+  return path;
+}
+
+std::size_t ReadOrderQueue::Release() {
+  // Stable, so that files with equal keys keep their discovery order.
+  std::stable_sort(pending_.begin(), pending_.end(),
+                   [](const Entry& lhs, const Entry& rhs) {
+                     return lhs.key < rhs.key;
+                   });
+  for (Entry& entry : pending_) {
+    ready_.push_back(std::move(entry.path));
+  }
+  const std::size_t released = pending_.size();
+  pending_.clear();
+  return released;
+}
+
+}  // namespace scanner
@@ -0,0 +1,76 @@
+#ifndef SRC_SCANNER_LIB_READ_ORDER_QUEUE_H_
+#define SRC_SCANNER_LIB_READ_ORDER_QUEUE_H_
+
+#include <cstdint>
+
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace scanner {
+
+/**
+ * @class ReadOrderQueue
+ * @brief Releases discovered files in windows sorted by where they lie on
+ * disk.
+ *
+ * Used for the disk-order scheduling modes: the scanner pushes every file
+ * with its key (an inode number or a physical offset) and holds off hashing
+ * until a window of files has been collected. The full window is sorted by
+ * key and appended to the files ready to be read, and one task is submitted
+ * per released file. Each task pops the first ready file, so the workers
+ * issue their reads in key order regardless of how the pool distributes the
+ * tasks.
+ */
+class ReadOrderQueue {
+public:
+  /**
+   * @brief Constructs a queue.
+   * @param window The number of files sorted together; at least 1.
+   */
+  explicit ReadOrderQueue(std::size_t window);
+
+  /**
+   * @brief Adds a file to the current window. This method is thread-safe.
+   * @param path The path of the file.
+   * @param key Where the file lies on disk; files are read by ascending key.
+   * @return The number of files released for reading, i.e. the window size
+   * if this file completed the window and 0 otherwise.
+   */
+  std::size_t Push(std::filesystem::path path, std::uint64_t key);
+
+  /**
+   * @brief Releases the files of the current, partial window. This method is
+   * thread-safe.
+   * @return The number of files released for reading.
+   */
+  std::size_t Flush();
+
+  /**
+   * @brief Removes the first file released for reading. This method is
+   * thread-safe.
+   * @return The path of the file, or std::nullopt if no file is released.
+   */
+  std::optional<std::filesystem::path> Pop();
+
+private:
+  struct Entry {
+    std::uint64_t key;
+    std::filesystem::path path;
+  };
+
+  // Sorts the window into ready_ and returns the number of files moved.
+  // Expects mutex_ to be held.
+  std::size_t Release();
+
+  const std::size_t window_;
+  std::mutex mutex_;
+  std::vector<Entry> pending_;
+  std::deque<std::filesystem::path> ready_;
+};
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_READ_ORDER_QUEUE_H_
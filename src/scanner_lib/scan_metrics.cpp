@@ -0,0 +1,233 @@
+#include "src/scanner_lib/scan_metrics.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+namespace scanner {
+namespace {
+
+std::atomic<std::uint64_t> next_generation{1};
+
+// Pairs the queued events of a task; 0 means untraced.
+std::atomic<std::uint64_t> next_trace_id{1};
+
+thread_local ThreadMetrics* current_metrics = nullptr;
+
+// Returns the index of the most significant set bit of a nonzero value.
+unsigned MostSignificantBit(std::uint64_t value) {
+  unsigned bit = 0;
+  while (value >>= 1) {
+    ++bit;
+  }
+  return bit;
+}
+
+StageLatency Summarize(const LatencyHistogram& histogram) {
+  StageLatency latency;
+  latency.count = histogram.Count();
+  latency.total = std::chrono::nanoseconds(histogram.Total());
+  latency.p50 = std::chrono::nanoseconds(histogram.Quantile(0.50));
+  latency.p90 = std::chrono::nanoseconds(histogram.Quantile(0.90));
+  latency.p99 = std::chrono::nanoseconds(histogram.Quantile(0.99));
+  latency.max = std::chrono::nanoseconds(histogram.Max());
+  return latency;
+}
+
+}  // namespace
+
+std::size_t LatencyHistogram::BucketOf(std::uint64_t value) {
+  constexpr std::uint64_t kSubBuckets = std::uint64_t{1} << kSubBucketBits;
+  if (value < kSubBuckets) {
+    return static_cast<std::size_t>(value);
+  }
+  const unsigned shift = MostSignificantBit(value) - kSubBucketBits;
+  return (static_cast<std::size_t>(shift + 1) << kSubBucketBits) +
+         static_cast<std::size_t>((value >> shift) & (kSubBuckets - 1));
+}
+
+std::uint64_t LatencyHistogram::BucketUpperBound(std::size_t bucket) {
+  constexpr std::size_t kSubBuckets = std::size_t{1} << kSubBucketBits;
+  if (bucket < kSubBuckets) {
+    return bucket;
+  }
+  const unsigned shift = static_cast<unsigned>(bucket >> kSubBucketBits) - 1;
+  const std::uint64_t lower = static_cast<std::uint64_t>(
+                                  kSubBuckets + (bucket & (kSubBuckets - 1)))
+                              << shift;
+  return lower + ((std::uint64_t{1} << shift) - 1);
+}
+
+void LatencyHistogram::Record(std::uint64_t value, std::uint64_t count) {
+  buckets_[BucketOf(value)] += count;
+  count_ += count;
+  total_ += value * count;
+  max_ = std::max(max_, value);
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other) {
+  for (std::size_t i = 0; i < kBucketCount; ++i) {
+    buckets_[i] += other.buckets_[i];
+  }
+  count_ += other.count_;
+  total_ += other.total_;
+  max_ = std::max(max_, other.max_);
+}
+
+std::uint64_t LatencyHistogram::Quantile(double quantile) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  const double clamped = std::min(std::max(quantile, 0.0), 1.0);
+  const auto rank = std::max<std::uint64_t>(
+      1, static_cast<std::uint64_t>(
+             std::ceil(clamped * static_cast<double>(count_))));
+  std::uint64_t seen = 0;
+  for (std::size_t i = 0; i < kBucketCount; ++i) {
+    seen += buckets_[i];
+    if (seen >= rank) {
+      return std::min(BucketUpperBound(i), max_);
+    }
+  }
+  return max_;
+}
+
+void ThreadMetrics::Record(ScanStage stage, std::uint64_t nanoseconds,
+                           std::uint64_t count) {
+  if (count == 0) {
+    return;
+  }
+  stages[static_cast<std::size_t>(stage)].Record(nanoseconds / count, count);
+  if (stage == ScanStage::kOpen || stage == ScanStage::kRead) {
+    io_nanoseconds += nanoseconds;
+  }
+}
+
+void ThreadMetrics::Trace(const char* name,
+                          std::chrono::steady_clock::time_point start,
+                          std::chrono::steady_clock::time_point end,
+                          std::uint64_t files,
+                          const std::filesystem::path* path) {
+  TraceEvent event;
+  event.name = name;
+  event.start = start;
+  event.duration = end - start;
+  event.files = files;
+  if (path != nullptr) {
+    event.path = path->string();
+  }
+  trace.push_back(std::move(event));
+}
+
+void ScanMetricsRecorder::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  threads_.clear();
+  origin_ = std::chrono::steady_clock::now();
+  generation_ = next_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+ThreadMetrics& ScanMetricsRecorder::ForThisThread() {
+  // Threads usually serve a single scan at a time, so one cached slot
+  // suffices; a thread switching recorders registers another slot.
+  thread_local std::uint64_t cached_generation = 0;
+  thread_local ThreadMetrics* cached = nullptr;
+  if (cached_generation != generation_ || cached == nullptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    threads_.push_back(std::make_unique<ThreadMetrics>());
+    cached = threads_.back().get();
+    cached->tracing = trace_;
+    cached_generation = generation_;
+  }
+  return *cached;
+}
+
+ScanMetrics ScanMetricsRecorder::Collect(
+    std::uint64_t files_processed, std::chrono::nanoseconds elapsed) const {
+  ThreadMetrics merged;
+  for (const auto& thread : threads_) {
+    for (std::size_t i = 0; i < kScanStageCount; ++i) {
+      merged.stages[i].Merge(thread->stages[i]);
+    }
+    merged.bytes_read += thread->bytes_read;
+  }
+
+  ScanMetrics metrics;
+  metrics.bytes_read = merged.bytes_read;
+  const double seconds = std::chrono::duration<double>(elapsed).count();
+  if (seconds > 0) {
+    metrics.files_per_second = static_cast<double>(files_processed) / seconds;
+    metrics.megabytes_per_second =
+        static_cast<double>(merged.bytes_read) / 1e6 / seconds;
+  }
+  for (std::size_t i = 0; i < kScanStageCount; ++i) {
+    metrics.stages[i] = Summarize(merged.stages[i]);
+  }
+  return metrics;
+}
+
+void ScanMetricsRecorder::WriteTrace(const std::filesystem::path& path) const {
+  std::vector<const std::vector<TraceEvent>*> threads;
+  threads.reserve(threads_.size());
+  for (const auto& thread : threads_) {
+    threads.push_back(&thread->trace);
+  }
+  std::ofstream file(path, std::ios::out | std::ios::trunc);
+  if (!file) {
+    throw std::runtime_error("Failed to open trace file for writing: " +
+                             path.string());
+  }
+  WriteChromeTrace(file, threads, origin_);
+  file.flush();
+  if (!file) {
+    throw std::runtime_error("Failed to write trace file: " + path.string());
+  }
+}
+
+ThreadMetrics* CurrentThreadMetrics() {
+  return current_metrics;
+}
+
+ScopedThreadMetrics::ScopedThreadMetrics(ScanMetricsRecorder* recorder)
+    : previous_(current_metrics) {
+  current_metrics = recorder ? &recorder->ForThisThread() : nullptr;
+}
+
+ScopedThreadMetrics::~ScopedThreadMetrics() {
+  current_metrics = previous_;
+}
+
+#if SCANNER_ENABLE_METRICS
+
+std::uint64_t TraceEnqueued() {
+  ThreadMetrics* metrics = current_metrics;
+  if (metrics == nullptr || !metrics->tracing) {
+    return 0;
+  }
+  TraceEvent event;
+  event.name = "queued";
+  event.phase = TraceEvent::Phase::kAsyncBegin;
+  event.start = std::chrono::steady_clock::now();
+  event.id = next_trace_id.fetch_add(1, std::memory_order_relaxed);
+  metrics->trace.push_back(event);
+  return event.id;
+}
+
+void TraceDequeued(std::uint64_t id) {
+  ThreadMetrics* metrics = current_metrics;
+  if (id == 0 || metrics == nullptr || !metrics->tracing) {
+    return;
+  }
+  TraceEvent event;
+  event.name = "queued";
+  event.phase = TraceEvent::Phase::kAsyncEnd;
+  event.start = std::chrono::steady_clock::now();
+  event.id = id;
+  metrics->trace.push_back(std::move(event));
+}
+
+#endif  // SCANNER_ENABLE_METRICS
+
+}  // namespace scanner
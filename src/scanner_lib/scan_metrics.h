@@ -0,0 +1,426 @@
+#ifndef SRC_SCANNER_LIB_SCAN_METRICS_H_
+#define SRC_SCANNER_LIB_SCAN_METRICS_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "scanner/domain.h"
+#include "src/scanner_lib/scan_trace.h"
+
+// Set to 0 to compile the stage timers below to nothing.
+#ifndef SCANNER_ENABLE_METRICS
+#define SCANNER_ENABLE_METRICS 1
+#endif
+
+namespace scanner {
+
+/**
+ * @class LatencyHistogram
+ * @brief Counts latencies in log-linear buckets of fixed memory.
+ *
+ * Values below 16 get a bucket each; above, every power of two is split into
+ * 16 buckets, so a bucket's width is at most 1/16 of its values. Recording is
+ * a few integer operations. The histogram is not thread-safe; every thread
+ * records into its own and the histograms are merged once the threads are
+ * done.
+ */
+class LatencyHistogram {
+public:
+  /** @brief The number of buckets per power of two. */
+  static constexpr unsigned kSubBucketBits = 4;
+  /** @brief The number of buckets needed for 64-bit values. */
+  static constexpr std::size_t kBucketCount =
+      (64 - kSubBucketBits + 1) << kSubBucketBits;
+
+  /**
+   * @brief Records count occurrences of a value.
+   * @param value The value, e.g. a latency in nanoseconds.
+   * @param count The number of occurrences.
+   */
+  void Record(std::uint64_t value, std::uint64_t count = 1);
+
+  /** @brief Adds the values recorded by another histogram. */
+  void Merge(const LatencyHistogram& other);
+
+  /**
+   * @brief Returns an upper bound of the value below which the given
+   * fraction of the recorded values lie, or 0 if nothing was recorded.
+   * @param quantile The fraction, between 0 and 1.
+   */
+  std::uint64_t Quantile(double quantile) const;
+
+  std::uint64_t Count() const {
+    return count_;
+  }
+  std::uint64_t Total() const {
+    return total_;
+  }
+  std::uint64_t Max() const {
+    return max_;
+  }
+
+  /** @brief Returns the bucket a value is counted in. */
+  static std::size_t BucketOf(std::uint64_t value);
+
+  /** @brief Returns the largest value counted in a bucket. */
+  static std::uint64_t BucketUpperBound(std::size_t bucket);
+
+private:
+  std::array<std::uint64_t, kBucketCount> buckets_{};
+  std::uint64_t count_ = 0;
+  std::uint64_t total_ = 0;
+  std::uint64_t max_ = 0;
+};
+
+/**
+ * @struct ThreadMetrics
+ * @brief The measurements of one thread during one scan.
+ */
+struct ThreadMetrics {
+  /** @brief The latencies in nanoseconds, indexed by ScanStage. */
+  std::array<LatencyHistogram, kScanStageCount> stages;
+  std::uint64_t bytes_read = 0;
+  /** @brief The time spent in kOpen and kRead, which the hash stage
+   * excludes. */
+  std::uint64_t io_nanoseconds = 0;
+  /** @brief Set if the spans of the thread are traced. */
+  bool tracing = false;
+  /** @brief The traced events, in the order they ended. */
+  std::vector<TraceEvent> trace;
+
+  /**
+   * @brief Records the latency of count operations of a stage.
+   * @param stage The stage.
+   * @param nanoseconds The latency of all operations together.
+   * @param count The number of operations; the latency is split evenly.
+   */
+  void Record(ScanStage stage, std::uint64_t nanoseconds,
+              std::uint64_t count = 1);
+
+  /**
+   * @brief Traces a span.
+   * @param name The name of the span; must have static storage duration.
+   * @param start The start of the span.
+   * @param end The end of the span.
+   * @param files The number of files the span covers, or 0.
+   * @param path The file the span covers, if a single one.
+   */
+  void Trace(const char* name, std::chrono::steady_clock::time_point start,
+             std::chrono::steady_clock::time_point end, std::uint64_t files = 0,
+             const std::filesystem::path* path = nullptr);
+};
+
+/**
+ * @class ScanMetricsRecorder
+ * @brief Collects the ThreadMetrics of every thread taking part in a scan.
+ *
+ * Each thread registers a slot of its own on its first measurement, so the
+ * hot path takes no lock and shares no cache line with other threads.
+ */
+class ScanMetricsRecorder {
+public:
+  /**
+   * @param trace If set, the threads also keep every span they measure, to
+   * be written by WriteTrace().
+   */
+  explicit ScanMetricsRecorder(bool trace = false) : trace_(trace) {
+  }
+
+  /**
+   * @brief Discards all measurements. Must not run concurrently with
+   * measurements or with Collect().
+   */
+  void Reset();
+
+  /**
+   * @brief Returns the calling thread's slot, registering it if needed.
+   * This method is thread-safe.
+   */
+  ThreadMetrics& ForThisThread();
+
+  /**
+   * @brief Merges the measurements of all threads. Must only be called
+   * once the threads are done measuring.
+   * @param files_processed The number of files the scan processed.
+   * @param elapsed The wall time of the scan.
+   */
+  ScanMetrics Collect(std::uint64_t files_processed,
+                      std::chrono::nanoseconds elapsed) const;
+
+  /**
+   * @brief Writes the spans traced since the last Reset() as a Chrome trace,
+   * with one track per thread. Must only be called once the threads are done
+   * measuring.
+   * @param path The file to write.
+   * @throws std::runtime_error if the file cannot be written.
+   */
+  void WriteTrace(const std::filesystem::path& path) const;
+
+private:
+  const bool trace_;
+  // The time of the last Reset(), timestamp 0 of the trace.
+  std::chrono::steady_clock::time_point origin_;
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<ThreadMetrics>> threads_;
+  // Identifies the current set of slots across all recorders and resets, so
+  // that a thread's cached slot is never one of a previous scan.
+  std::uint64_t generation_ = 0;
+};
+
+/**
+ * @brief Returns the slot the calling thread currently measures into, or
+ * null if it measures nothing.
+ */
+ThreadMetrics* CurrentThreadMetrics();
+
+/**
+ * @class ScopedThreadMetrics
+ * @brief Makes the calling thread measure into a recorder until destroyed.
+ *
+ * Tasks of a scan open one at their entry, so that the stage timers of the
+ * components they call know where to record. A null recorder disables the
+ * measurements of the scope.
+ */
+class ScopedThreadMetrics {
+public:
+  explicit ScopedThreadMetrics(ScanMetricsRecorder* recorder);
+  ~ScopedThreadMetrics();
+
+  ScopedThreadMetrics(const ScopedThreadMetrics&) = delete;
+  ScopedThreadMetrics& operator=(const ScopedThreadMetrics&) = delete;
+
+private:
+  ThreadMetrics* previous_;
+};
+
+#if SCANNER_ENABLE_METRICS
+
+/**
+ * @class StageTimer
+ * @brief Measures the time until its destruction as operations of a stage.
+ *
+ * Does nothing, not even reading the clock, if the thread measures nothing.
+ */
+class StageTimer {
+public:
+  /**
+   * @param stage The stage.
+   * @param count The number of operations measured together.
+   * @param exclude_io If set, the time that kOpen and kRead timers measure
+   * meanwhile on the same thread is subtracted.
+   */
+  explicit StageTimer(ScanStage stage, std::uint64_t count = 1,
+                      bool exclude_io = false)
+      : metrics_(CurrentThreadMetrics()), stage_(stage), count_(count) {
+    if (metrics_ != nullptr) {
+      io_start_ = exclude_io ? metrics_->io_nanoseconds : kNoIoExclusion;
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~StageTimer() {
+    if (metrics_ == nullptr || count_ == 0) {
+      return;
+    }
+    const auto end = std::chrono::steady_clock::now();
+    if (metrics_->tracing) {
+      metrics_->Trace(ToString(stage_), start_, end, count_);
+    }
+    std::uint64_t elapsed = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start_)
+            .count());
+    if (io_start_ != kNoIoExclusion) {
+      const std::uint64_t io = metrics_->io_nanoseconds - io_start_;
+      elapsed = elapsed > io ? elapsed - io : 0;
+    }
+    metrics_->Record(stage_, elapsed, count_);
+  }
+
+  StageTimer(const StageTimer&) = delete;
+  StageTimer& operator=(const StageTimer&) = delete;
+
+private:
+  static constexpr std::uint64_t kNoIoExclusion = ~std::uint64_t{0};
+
+  ThreadMetrics* metrics_;
+  ScanStage stage_;
+  std::uint64_t count_;
+  std::uint64_t io_start_ = kNoIoExclusion;
+  std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @class StageAccumulator
+ * @brief Sums the time of several sections, e.g. the reads of one file, and
+ * records it as a single operation of a stage when destroyed.
+ */
+class StageAccumulator {
+public:
+  /** @brief Adds the time until its destruction to an accumulator. */
+  class Section {
+  public:
+    explicit Section(StageAccumulator& accumulator)
+        : accumulator_(accumulator) {
+      if (accumulator_.metrics_ != nullptr) {
+        start_ = std::chrono::steady_clock::now();
+      }
+    }
+
+    ~Section() {
+      ThreadMetrics* metrics = accumulator_.metrics_;
+      if (metrics != nullptr) {
+        const auto end = std::chrono::steady_clock::now();
+        accumulator_.total_ += end - start_;
+        // Every section is a span of its own, e.g. one per chunk read.
+        if (metrics->tracing) {
+          metrics->Trace(ToString(accumulator_.stage_), start_, end);
+        }
+      }
+    }
+
+    Section(const Section&) = delete;
+    Section& operator=(const Section&) = delete;
+
+  private:
+    StageAccumulator& accumulator_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  explicit StageAccumulator(ScanStage stage)
+      : metrics_(CurrentThreadMetrics()), stage_(stage) {
+  }
+
+  ~StageAccumulator() {
+    if (metrics_ != nullptr) {
+      metrics_->Record(
+          stage_, static_cast<std::uint64_t>(
+                      std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          total_)
+                          .count()));
+    }
+  }
+
+  StageAccumulator(const StageAccumulator&) = delete;
+  StageAccumulator& operator=(const StageAccumulator&) = delete;
+
+private:
+  ThreadMetrics* metrics_;
+  ScanStage stage_;
+  std::chrono::steady_clock::duration total_{0};
+};
+
+/** @brief Counts bytes read by the calling thread, if it measures. */
+inline void RecordBytesRead(std::uint64_t bytes) {
+  if (ThreadMetrics* metrics = CurrentThreadMetrics()) {
+    metrics->bytes_read += bytes;
+  }
+}
+
+/**
+ * @class TraceSpan
+ * @brief Traces the time until its destruction as a span that is not a
+ * ScanStage, e.g. a whole task.
+ *
+ * Does nothing, not even reading the clock, if the thread traces nothing.
+ */
+class TraceSpan {
+public:
+  /**
+   * @param name The name of the span; must have static storage duration.
+   * @param files The number of files the span covers, or 0.
+   * @param path The file the span covers, if a single one. It must outlive
+   * the span.
+   */
+  explicit TraceSpan(const char* name, std::uint64_t files = 0,
+                     const std::filesystem::path* path = nullptr)
+      : metrics_(CurrentThreadMetrics()),
+        name_(name),
+        files_(files),
+        path_(path) {
+    if (metrics_ != nullptr && !metrics_->tracing) {
+      metrics_ = nullptr;
+    }
+    if (metrics_ != nullptr) {
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~TraceSpan() {
+    if (metrics_ != nullptr) {
+      metrics_->Trace(name_, start_, std::chrono::steady_clock::now(), files_,
+                      path_);
+    }
+  }
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+  ThreadMetrics* metrics_;
+  const char* name_;
+  std::uint64_t files_;
+  const std::filesystem::path* path_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @brief Marks a task as queued, if the calling thread traces.
+ * @return The id to pass to TraceDequeued() when the task starts, or 0.
+ */
+std::uint64_t TraceEnqueued();
+
+/**
+ * @brief Ends the queued span of a task, if the calling thread traces.
+ * @param id The id TraceEnqueued() returned when the task was queued.
+ */
+void TraceDequeued(std::uint64_t id);
+
+#else  // SCANNER_ENABLE_METRICS
+
+class StageTimer {
+public:
+  explicit StageTimer(ScanStage, std::uint64_t = 1, bool = false) {
+  }
+};
+
+class StageAccumulator {
+public:
+  class Section {
+  public:
+    explicit Section(StageAccumulator&) {
+    }
+  };
+
+  explicit StageAccumulator(ScanStage) {
+  }
+};
+
+inline void RecordBytesRead(std::uint64_t) {
+}
+
+class TraceSpan {
+public:
+  explicit TraceSpan(const char*, std::uint64_t = 0,
+                     const std::filesystem::path* = nullptr) {
+  }
+};
+
+inline std::uint64_t TraceEnqueued() {
+  return 0;
+}
+
+inline void TraceDequeued(std::uint64_t) {
+}
+
+#endif  // SCANNER_ENABLE_METRICS
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_SCAN_METRICS_H_
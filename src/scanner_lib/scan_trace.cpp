@@ -0,0 +1,80 @@
+#include "src/scanner_lib/scan_trace.h"
+
+#include <iomanip>
+#include <string_view>
+
+namespace scanner {
+namespace {
+
+void WriteQuoted(std::ostream& os, std::string_view value) {
+  static constexpr char kHexDigits[] = "0123456789abcdef";
+  os << '"';
+  for (const char c : value) {
+    if (c == '"' || c == '\\') {
+      os << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      os << "\\u00" << kHexDigits[(c >> 4) & 0x0F] << kHexDigits[c & 0x0F];
+    } else {
+      os << c;
+    }
+  }
+  os << '"';
+}
+
+// Microseconds with nanosecond digits, the unit of the trace format.
+void WriteMicroseconds(std::ostream& os, std::chrono::nanoseconds duration) {
+  const auto nanoseconds = duration.count();
+  if (nanoseconds < 0) {
+    os << '-';
+  }
+  const auto magnitude = nanoseconds < 0 ? -nanoseconds : nanoseconds;
+  os << magnitude / 1000 << '.' << std::setw(3) << std::setfill('0')
+     << magnitude % 1000 << std::setfill(' ');
+}
+
+void WriteEvent(std::ostream& os, const TraceEvent& event, std::size_t tid,
+                std::chrono::steady_clock::time_point origin) {
+  os << "{\"name\": ";
+  WriteQuoted(os, event.name);
+  os << ", \"cat\": \"scan\", \"ph\": \"" << static_cast<char>(event.phase)
+     << "\", \"pid\": 1, \"tid\": " << tid << ", \"ts\": ";
+  WriteMicroseconds(os, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            event.start - origin));
+  if (event.phase == TraceEvent::Phase::kComplete) {
+    os << ", \"dur\": ";
+    WriteMicroseconds(os, event.duration);
+  } else {
+    os << ", \"id\": " << event.id;
+  }
+  if (event.files != 0 || !event.path.empty()) {
+    os << ", \"args\": {";
+    if (event.files != 0) {
+      os << "\"files\": " << event.files;
+    }
+    if (!event.path.empty()) {
+      os << (event.files != 0 ? ", " : "") << "\"path\": ";
+      WriteQuoted(os, event.path);
+    }
+    os << '}';
+  }
+  os << '}';
+}
+
+}  // namespace
+
+void WriteChromeTrace(std::ostream& os,
+                      const std::vector<const std::vector<TraceEvent>*>& threads,
+                      std::chrono::steady_clock::time_point origin) {
+  os << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n"
+     << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 0, "
+        "\"args\": {\"name\": \"scanner\"}}";
+  for (std::size_t i = 0; i < threads.size(); ++i) {
+    for (const TraceEvent& event : *threads[i]) {
+      os << ",\n";
+      WriteEvent(os, event, i + 1, origin);
+    }
+  }
+  os << "\n]}\n";
+}
+
+}  // namespace scanner
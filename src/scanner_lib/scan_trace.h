@@ -0,0 +1,59 @@
+#ifndef SRC_SCANNER_LIB_SCAN_TRACE_H_
+#define SRC_SCANNER_LIB_SCAN_TRACE_H_
+
+#include <chrono>
+#include <cstdint>
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace scanner {
+
+/**
+ * @struct TraceEvent
+ * @brief One event of a scan trace, in the terms of the Chrome trace format.
+ */
+struct TraceEvent {
+  /** @brief The kinds of events, with their Chrome trace phase letters. */
+  enum class Phase : char {
+    /** @brief A span on the recording thread. */
+    kComplete = 'X',
+    /** @brief The start of a span that may end on another thread. */
+    kAsyncBegin = 'b',
+    /** @brief The end of a span started by a kAsyncBegin of the same id. */
+    kAsyncEnd = 'e',
+  };
+
+  /** @brief The name of the event; must have static storage duration. */
+  const char* name = "";
+  Phase phase = Phase::kComplete;
+  std::chrono::steady_clock::time_point start;
+  /** @brief The duration of a kComplete span. */
+  std::chrono::nanoseconds duration{0};
+  /** @brief The id pairing kAsyncBegin and kAsyncEnd events. */
+  std::uint64_t id = 0;
+  /** @brief The number of files a span covers, or 0 if not applicable. */
+  std::uint64_t files = 0;
+  /** @brief The path of the file a span covers, if it covers a single one. */
+  std::string path;
+};
+
+/**
+ * @brief Writes the events of several threads as a Chrome trace in the JSON
+ * object format, which chrome://tracing and Perfetto load.
+ *
+ * The threads are numbered from 1 in the order given. Timestamps are in
+ * microseconds since the origin.
+ *
+ * @param os The stream to write to.
+ * @param threads The events of every thread.
+ * @param origin The time that becomes timestamp 0, e.g. the start of a scan.
+ */
+void WriteChromeTrace(std::ostream& os,
+                      const std::vector<const std::vector<TraceEvent>*>& threads,
+                      std::chrono::steady_clock::time_point origin);
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_SCAN_TRACE_H_
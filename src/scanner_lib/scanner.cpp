@@ -1,81 +1,754 @@
 #include "src/scanner_lib/scanner.h"
 
 #include <chrono>
+#include <cmath>
 
 #include <atomic>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <string>
 #include <thread>
+#include <utility>
 
+#include "src/scanner_lib/file_reader.h"
+#include "src/scanner_lib/file_status.h"
+#include "src/scanner_lib/md5_engine.h"
+#include "src/scanner_lib/parallel_walker.h"
 #include "src/scanner_lib/thread_pool.h"
 
 namespace scanner {
 
 Scanner::Scanner(IHashDatabase& db, ILogger& logger, IFileHasher& hasher,
-                 std::size_t num_threads)
-    : db_(db), logger_(logger), hasher_(hasher), num_threads_(num_threads) {
+                 std::size_t num_threads, ScannerOptions options)
+    : db_(db),
+      logger_(logger),
+      hasher_(hasher),
+      num_threads_(num_threads),
+      max_queued_tasks_(options.max_queued_tasks),
+      walker_mode_(options.walker_mode),
+      cache_(options.cache),
+      scheduling_(options.scheduling),
+      read_order_(options.read_order_window),
+      collect_metrics_(options.collect_metrics),
+      trace_path_(std::move(options.trace_path)),
+      metrics_(collect_metrics_ || trace_path_
+                   ? std::make_unique<ScanMetricsRecorder>(
+                         trace_path_.has_value())
+                   : nullptr),
+      detections_(std::move(options.detections)),
+      filter_(options.filter) {
 }
 
-void Scanner::ConsumerTask(const std::filesystem::path& path) {
+bool Scanner::RejectSize(std::uint64_t size) {
+  if (!db_.HasSizeIndex() || db_.MayMatchSize(size)) {
+    return false;
+  }
+  size_rejected_++;
+  bytes_processed_.fetch_add(size, std::memory_order_relaxed);
+  total_files_processed_++;
+  return true;
+}
+
+bool Scanner::RejectPrefix(const std::filesystem::path& path,
+                           const PendingFile& file) {
+  if (!file.status || file.status->state.size <= kSamplePrefixSize ||
+      !db_.HasPrefixIndex()) {
+    return false;
+  }
+  std::uint8_t prefix[kSamplePrefixSize];
   try {
-    const std::string hash = hasher_.HashFile(path);
-    const auto verdict = db_.FindHash(hash);
-    if (verdict) {
-      logger_.LogDetection(path, hash, *verdict);
-      malicious_files_detected_++;
+    if (FileReader::ReadPrefix(path, prefix, sizeof(prefix)) !=
+        sizeof(prefix)) {
+      return false;  // Truncated meanwhile; the full hash decides.
+    }
+  } catch (const std::exception&) {
+    FileHashResult result;
+    result.error = std::current_exception();
+    CompleteFile(path, file, result, false);
+    return true;
+  }
+  prefix_checked_++;
+
+  Md5Engine engine;
+  engine.Update(prefix, sizeof(prefix));
+  if (db_.MayMatchPrefix(engine.Final())) {
+    return false;
+  }
+  prefix_rejected_++;
+  // No digest and no error: the file and its other links count as clean.
+  CompleteFile(path, file, FileHashResult{}, false);
+  return true;
+}
+
+bool Scanner::SkipHashing(const std::filesystem::path& path,
+                          PendingFile& file) {
+  file.status = StatFile(path);
+  if (file.status && RejectSize(file.status->state.size)) {
+    return true;
+  }
+
+  if (file.status && file.status->link_count > 1) {
+    FileHashResult shared;
+    switch (hardlinks_.Register(*file.status, path, shared)) {
+      case HardlinkTracker::Claim::kFirst:
+        file.owns_links = true;
+        break;
+      case HardlinkTracker::Claim::kResolved:
+        deduplicated_files_++;
+        deduplicated_bytes_ += file.status->state.size;
+        ProcessResult(path, shared, file.status->state.size);
+        return true;
+      case HardlinkTracker::Claim::kQueued:
+        // Processed by the owner of the first link once hashed.
+        deduplicated_files_++;
+        deduplicated_bytes_ += file.status->state.size;
+        return true;
+    }
+  }
+
+  if (cache_) {
+    const std::optional<Md5Digest> digest =
+        file.status ? cache_->Find(file.status->state) : std::nullopt;
+    if (digest) {
+      cache_hits_++;
+      // The verdict is looked up again, so database updates apply to cached
+      // files as well.
+      FileHashResult result;
+      result.md5 = *digest;
+      CompleteFile(path, file, result, false);
+      return true;
     }
+    cache_misses_++;
+  }
+  return RejectPrefix(path, file);
+}
+
+void Scanner::CompleteFile(const std::filesystem::path& path,
+                           const PendingFile& file,
+                           const FileHashResult& result, bool computed) {
+  if (computed && cache_ && file.status && !result.error && result.md5) {
+    cache_->Insert(file.status->state, *result.md5, path);
+  }
+  const std::uint64_t size = file.status ? file.status->state.size : 0;
+  ProcessResult(path, result, size);
+  if (file.owns_links) {
+    for (const auto& link : hardlinks_.Resolve(file.status->state, result)) {
+      ProcessResult(link, result, size);
+    }
+  }
+}
+
+void Scanner::ProcessResult(const std::filesystem::path& path,
+                            const FileHashResult& result, std::uint64_t size) {
+  if (result.error) {
+    ReportError(path, result.error);
+  } else {
+    try {
+      ProcessDigests(path, result, size);
+    } catch (const std::exception&) {
+      ReportError(path, std::current_exception());
+    }
+  }
+  // Counted together, so that every path counted as processed, hard links
+  // included, adds its size to the progress.
+  bytes_processed_.fetch_add(size, std::memory_order_relaxed);
+  total_files_processed_++;
+}
+
+void Scanner::ProcessDigests(const std::filesystem::path& path,
+                             const FileHashResult& result,
+                             std::uint64_t size) {
+  std::optional<std::string> verdict;
+  AnyDigest matched;
+  {
+    StageTimer timer(ScanStage::kLookup);
+    if (result.md5) {
+      verdict = db_.FindHash(*result.md5);
+      matched = *result.md5;
+    }
+    if (!verdict && result.sha1) {
+      verdict = db_.FindSha1(*result.sha1);
+      matched = *result.sha1;
+    }
+    if (!verdict && result.sha256) {
+      verdict = db_.FindSha256(*result.sha256);
+      matched = *result.sha256;
+    }
+  }
+  if (verdict) {
+    {
+      StageTimer timer(ScanStage::kLog);
+      logger_.LogDetection(path, matched, *verdict);
+      if (detections_) {
+        detections_->Send(path, matched, *verdict, size);
+      }
+    }
+    malicious_files_detected_++;
+  }
+}
+
+void Scanner::ReportError(const std::filesystem::path& path,
+                          const std::exception_ptr& error) {
+  try {
+    std::rethrow_exception(error);
   } catch (const std::exception& e) {
     std::cerr << "Error processing file " << path.string() << ": " << e.what()
               << std::endl;
-    errors_++;
+  } catch (...) {
+    std::cerr << "Error processing file " << path.string() << std::endl;
+  }
+  errors_++;
+}
+
+void Scanner::ConsumerTask(const std::filesystem::path& path,
+                           std::uint64_t queued) {
+  ScopedThreadMetrics metrics_scope(metrics_.get());
+  TraceDequeued(queued);
+  TraceSpan span("file", 1, &path);
+  PendingFile file;
+  if (SkipHashing(path, file)) {
+    return;
+  }
+  FileHashResult result;
+  try {
+    StageTimer timer(ScanStage::kHash, 1, /*exclude_io=*/true);
+    hasher_.HashFileDigests(path, result);
+  } catch (const std::exception&) {
+    result.error = std::current_exception();
+  }
+  CompleteFile(path, file, result, true);
+}
+
+void Scanner::ConsumeLargestFileTask(std::uint64_t queued) {
+  // Every task is submitted along with a file, so the queue is never empty
+  // here; which file the task gets depends only on the sizes.
+  if (const auto path = largest_first_.Pop()) {
+    ConsumerTask(*path, queued);
+  }
+}
+
+void Scanner::ConsumeNextReadTask(std::uint64_t queued) {
+  // Tasks are submitted only for released files, one per file.
+  if (const auto path = read_order_.Pop()) {
+    ConsumerTask(*path, queued);
+  }
+}
+
+void Scanner::ConsumeBatchTask(std::vector<std::filesystem::path>& paths,
+                               std::uint64_t queued) {
+  thread_local std::vector<FileHashResult> results;
+  thread_local std::vector<PendingFile> files;
+  thread_local std::vector<std::filesystem::path> remaining;
+  ScopedThreadMetrics metrics_scope(metrics_.get());
+  TraceDequeued(queued);
+  TraceSpan span("batch", paths.size());
+
+  // Only the files that cannot be skipped are hashed. The paths are moved
+  // aside only once a file has actually been skipped.
+  files.clear();
+  remaining.clear();
+  bool skipped_any = false;
+  for (std::size_t i = 0; i < paths.size(); ++i) {
+    PendingFile file;
+    if (SkipHashing(paths[i], file)) {
+      if (!skipped_any) {
+        remaining.assign(std::make_move_iterator(paths.begin()),
+                         std::make_move_iterator(paths.begin() + i));
+        skipped_any = true;
+      }
+      continue;
+    }
+    if (skipped_any) {
+      remaining.push_back(std::move(paths[i]));
+    }
+    files.push_back(std::move(file));
+  }
+  const std::vector<std::filesystem::path>& to_hash =
+      skipped_any ? remaining : paths;
+  if (to_hash.empty()) {
+    return;
+  }
+
+  {
+    // Files of a batch are hashed together; each counts with the average.
+    StageTimer timer(ScanStage::kHash, to_hash.size(), /*exclude_io=*/true);
+    hasher_.HashFiles(to_hash, results);
+  }
+  for (std::size_t i = 0; i < to_hash.size(); ++i) {
+    CompleteFile(to_hash[i], files[i], results[i], true);
+  }
+}
+
+void Scanner::SubmitBatch(ThreadPool& pool,
+                          std::vector<std::filesystem::path>& batch) {
+  if (!batch.empty()) {
+    // Covers the wait for space in a full queue.
+    TraceSpan span("enqueue", batch.size());
+    const std::uint64_t queued = TraceEnqueued();
+    pool.Submit([this, paths = std::move(batch), queued]() mutable {
+      ConsumeBatchTask(paths, queued);
+      RecycleBatch(paths);
+    });
+    batch = TakeSpareBatch();
+    RecordSubmission();
   }
-  total_files_processed_++;
+}
+
+std::vector<std::filesystem::path> Scanner::TakeSpareBatch() {
+  std::lock_guard<std::mutex> lock(spare_batches_mutex_);
+  if (spare_batches_.empty()) {
+    return {};
+  }
+  std::vector<std::filesystem::path> batch = std::move(spare_batches_.back());
+  spare_batches_.pop_back();
+  return batch;
+}
+
+void Scanner::RecycleBatch(std::vector<std::filesystem::path>& batch) {
+  batch.clear();
+  if (batch.capacity() == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(spare_batches_mutex_);
+  spare_batches_.push_back(std::move(batch));
+}
+
+std::uint64_t Scanner::ReadOrderKey(const std::filesystem::path& path,
+                                    std::uint64_t inode) const {
+  if (scheduling_ == SchedulingMode::kExtentOrder) {
+    // Files without extents sort last and keep their discovery order.
+    return PhysicalOffset(path).value_or(
+        std::numeric_limits<std::uint64_t>::max());
+  }
+  if (inode == 0) {
+    // The sequential walker and path lists do not provide inode numbers.
+    // SubmitFile() calls this from a pool task then.
+    const std::optional<FileStatus> status = StatFile(path);
+    inode = status ? status->state.inode : 0;
+  }
+  return inode;
+}
+
+void Scanner::SubmitReleasedFiles(ThreadPool& pool, std::size_t released) {
+  if (released == 0) {
+    return;
+  }
+  for (; released > 0; --released) {
+    const std::uint64_t queued = TraceEnqueued();
+    pool.Submit([this, queued] { ConsumeNextReadTask(queued); });
+  }
+  RecordSubmission();
+}
+
+void Scanner::SubmitFile(ThreadPool& pool, std::filesystem::path path,
+                         std::uintmax_t size, std::uint64_t inode) {
+  TraceSpan span("enqueue", 1);
+  if (ReadsInDiskOrder()) {
+    if (inode == 0 || scheduling_ == SchedulingMode::kExtentOrder) {
+      // The key costs a system call, which the workers make in parallel
+      // rather than the traversal or path list in turn. RunScan() waits for
+      // these tasks before releasing the last window.
+      pool.Submit([this, &pool, path = std::move(path)]() mutable {
+        const std::uint64_t key = ReadOrderKey(path, 0);
+        SubmitReleasedFiles(pool, read_order_.Push(std::move(path), key));
+      });
+      return;
+    }
+    SubmitReleasedFiles(pool, read_order_.Push(std::move(path), inode));
+    return;
+  }
+  const std::uint64_t queued = TraceEnqueued();
+  if (scheduling_ == SchedulingMode::kLargestFirst) {
+    largest_first_.Push(std::move(path), size);
+    pool.Submit([this, queued] { ConsumeLargestFileTask(queued); });
+  } else {
+    pool.Submit([this, path = std::move(path), queued] {
+      ConsumerTask(path, queued);
+    });
+  }
+  RecordSubmission();
+}
+
+void Scanner::RecordSubmission() {
+  // Concurrent walkers may store slightly out of order; the error is far
+  // below the millisecond resolution of the report.
+  last_submission_.store(
+      std::chrono::steady_clock::now().time_since_epoch().count(),
+      std::memory_order_relaxed);
 }
 
 void Scanner::ProducerTask(const std::filesystem::path& scan_path,
                            ThreadPool& pool,
                            std::promise<void>& producer_promise) {
+  ScopedThreadMetrics metrics_scope(metrics_.get());
+  const std::size_t batch_size = BatchSize();
+  const std::uintmax_t max_batched_size = hasher_.MaxBatchedFileSize();
+  // Unlike the parallel walker, the iterator costs a stat per file size.
+  const bool needs_size = batch_size > 1 ||
+                          scheduling_ == SchedulingMode::kLargestFirst ||
+                          db_.HasSizeIndex() || filter_.LimitsSize();
+  const PathFilter* filter = filter_.Active() ? &filter_ : nullptr;
+  std::vector<std::filesystem::path> batch = TakeSpareBatch();
+  const auto flush_batch = [&] { SubmitBatch(pool, batch); };
+
   try {
     if (!std::filesystem::exists(scan_path) ||
         !std::filesystem::is_directory(scan_path)) {
       throw std::runtime_error("Invalid scan path: " + scan_path.string());
     }
+    const std::size_t prefix_length = PathFilter::PrefixLength(scan_path);
+    // Plain values rather than an optional, which GCC takes for possibly
+    // uninitialized in the loop below.
+    const std::optional<std::uint64_t> scan_device =
+        filter && filter->OneFileSystem() ? DeviceOf(scan_path) : std::nullopt;
+    const bool one_file_system = scan_device.has_value();
+    const std::uint64_t root_device = scan_device.value_or(0);
 
     const auto iter_options =
         std::filesystem::directory_options::skip_permission_denied;
-    for (const auto& dir_entry : std::filesystem::recursive_directory_iterator(
-             scan_path, iter_options)) {
-      if (dir_entry.is_regular_file()) {
-        pool.Enqueue(&Scanner::ConsumerTask, this, dir_entry.path());
+    // Each step of the iterator counts as a traversal of one entry.
+    const auto advance = [](std::filesystem::recursive_directory_iterator& it) {
+      StageTimer timer(ScanStage::kTraversal);
+      ++it;
+    };
+    for (std::filesystem::recursive_directory_iterator
+             it(scan_path, iter_options),
+         end;
+         it != end; advance(it)) {
+      const std::filesystem::directory_entry& dir_entry = *it;
+      std::error_code ec;
+      // The entry type comes from the listing, so pruning costs no stat;
+      // symbolic links to directories are not descended into anyway.
+      if (filter && dir_entry.is_directory(ec) && !dir_entry.is_symlink(ec)) {
+        if (filter->ExcludesDirectory(
+                PathFilter::RelativeText(dir_entry.path(), prefix_length)) ||
+            (one_file_system &&
+             DeviceOf(dir_entry.path()).value_or(root_device) !=
+                 root_device)) {
+          it.disable_recursion_pending();
+        }
+        continue;
+      }
+      if (!dir_entry.is_regular_file()) {
+        continue;
+      }
+      if (filter && filter->ExcludesFile(PathFilter::RelativeText(
+                        dir_entry.path(), prefix_length))) {
+        continue;
       }
+      std::uintmax_t size = 0;
+      bool sized = false;
+      if (needs_size) {
+        size = dir_entry.file_size(ec);
+        sized = !ec;
+        if (!sized) {
+          size = 0;
+        } else if (filter_.ExceedsSize(size)) {
+          continue;
+        }
+      }
+      files_discovered_.fetch_add(1, std::memory_order_relaxed);
+      if (sized) {
+        if (RejectSize(size)) {
+          continue;
+        }
+        if (batch_size > 1 && size <= max_batched_size) {
+          batch.push_back(dir_entry.path());
+          if (batch.size() == batch_size) {
+            flush_batch();
+          }
+          continue;
+        }
+      }
+      SubmitFile(pool, dir_entry.path(), size);
     }
+    flush_batch();
+    RecycleBatch(batch);
     producer_promise.set_value();  // Signal successful completion.
   } catch (const std::exception& e) {
+    // Files discovered before the failure are still scanned.
+    flush_batch();
+    RecycleBatch(batch);
     std::cerr << "Error during directory traversal: " << e.what() << std::endl;
     producer_promise.set_exception(std::current_exception());
   }
 }
 
+void Scanner::SubmitFiles(ThreadPool& pool, std::vector<WalkedFile>& files) {
+  const std::size_t batch_size = BatchSize();
+  const std::uintmax_t max_batched_size = hasher_.MaxBatchedFileSize();
+  files_discovered_.fetch_add(files.size(), std::memory_order_relaxed);
+  std::vector<std::filesystem::path> batch = TakeSpareBatch();
+  for (WalkedFile& file : files) {
+    // A size of 0 may stand for an unknown size, which is checked again once
+    // the file is stat'ed by its task.
+    if (file.size > 0 && RejectSize(file.size)) {
+      continue;
+    }
+    if (batch_size > 1 && file.size <= max_batched_size) {
+      batch.push_back(std::move(file.path));
+      if (batch.size() == batch_size) {
+        SubmitBatch(pool, batch);
+      }
+      continue;
+    }
+    SubmitFile(pool, std::move(file.path), file.size, file.inode);
+  }
+  SubmitBatch(pool, batch);
+  RecycleBatch(batch);
+}
+
+void Scanner::SubmitListedFiles(std::istream& paths, char delimiter,
+                                ThreadPool& pool) {
+  // Chunks amortize the submission over several batches without holding
+  // back the first files of a slowly written stream for long.
+  constexpr std::size_t kChunkSize = 256;
+  std::vector<WalkedFile> chunk;
+  chunk.reserve(kChunkSize);
+  std::string line;
+  while (std::getline(paths, line, delimiter)) {
+    if (line.empty()) {
+      continue;
+    }
+    // Sizes are left unknown: a stat here would serialize on this thread
+    // what the tasks do in parallel anyway.
+    chunk.push_back({line, 0});
+    if (chunk.size() == kChunkSize) {
+      SubmitFiles(pool, chunk);
+      chunk.clear();
+    }
+  }
+  SubmitFiles(pool, chunk);
+  if (paths.bad()) {
+    std::cerr << "Error reading the list of files to scan" << std::endl;
+    errors_++;
+  }
+}
+
+bool Scanner::WalkInParallel(const std::filesystem::path& scan_path,
+                             ThreadPool& pool) {
+  if (!std::filesystem::exists(scan_path) ||
+      !std::filesystem::is_directory(scan_path)) {
+    std::cerr << "Error during directory traversal: Invalid scan path: "
+              << scan_path.string() << std::endl;
+    errors_++;
+    return false;
+  }
+
+  // Batches do not span directories, so that each directory's files are
+  // submitted as soon as it has been listed.
+  const auto on_files = [this, &pool](std::vector<WalkedFile>& files) {
+    SubmitFiles(pool, files);
+  };
+  std::atomic<bool> complete{true};
+  const auto on_error = [this, &complete](const std::filesystem::path& path,
+                                          const std::string& message) {
+    std::cerr << "Error during directory traversal: " << path.string() << ": "
+              << message << std::endl;
+    errors_++;
+    complete.store(false, std::memory_order_relaxed);
+  };
+
+  const auto on_listed = [this] { traversal_complete_.store(true); };
+
+  ParallelWalker(pool, on_files, on_error, metrics_.get(), on_listed,
+                 filter_.Active() ? &filter_ : nullptr)
+      .Walk(scan_path);
+  return complete.load(std::memory_order_relaxed);
+}
+
+void Scanner::SetProgressObserver(IProgressObserver* observer,
+                                  std::chrono::milliseconds interval) {
+  progress_observer_ = observer;
+  progress_interval_ = interval;
+}
+
+ScanProgress Scanner::SampleProgress(
+    std::chrono::steady_clock::time_point start_time,
+    ProgressSample& previous) const {
+  // Relaxed loads suffice: the counters are independent and only need to be
+  // roughly consistent with each other.
+  ScanProgress progress;
+  progress.traversal_complete =
+      traversal_complete_.load(std::memory_order_relaxed);
+  progress.files_discovered =
+      files_discovered_.load(std::memory_order_relaxed);
+  progress.files_processed =
+      total_files_processed_.load(std::memory_order_relaxed);
+  progress.bytes_processed = bytes_processed_.load(std::memory_order_relaxed);
+  progress.malicious_files_detected =
+      malicious_files_detected_.load(std::memory_order_relaxed);
+  progress.errors = errors_.load(std::memory_order_relaxed);
+
+  const auto now = std::chrono::steady_clock::now();
+  progress.elapsed =
+      std::chrono::duration_cast<std::chrono::milliseconds>(now - start_time);
+  const double interval =
+      std::chrono::duration<double>(now - previous.time).count();
+  if (interval > 0) {
+    progress.files_per_second =
+        static_cast<double>(progress.files_processed -
+                            previous.files_processed) /
+        interval;
+    progress.bytes_per_second =
+        static_cast<double>(progress.bytes_processed -
+                            previous.bytes_processed) /
+        interval;
+  }
+  previous = {now, progress.files_processed, progress.bytes_processed};
+
+  // Until the traversal is done, the number of files left is unknown.
+  const double elapsed = std::chrono::duration<double>(now - start_time).count();
+  if (progress.traversal_complete && progress.files_processed > 0 &&
+      elapsed > 0) {
+    const std::uint64_t remaining =
+        progress.files_discovered > progress.files_processed
+            ? progress.files_discovered - progress.files_processed
+            : 0;
+    const double average_rate =
+        static_cast<double>(progress.files_processed) / elapsed;
+    progress.eta = std::chrono::seconds(static_cast<std::int64_t>(
+        std::ceil(static_cast<double>(remaining) / average_rate)));
+  }
+  return progress;
+}
+
+void Scanner::ProgressTask(std::chrono::steady_clock::time_point start_time,
+                           ProgressSample& previous) {
+  std::unique_lock<std::mutex> lock(progress_mutex_);
+  while (!progress_condition_.wait_for(lock, progress_interval_,
+                                       [this] { return scan_done_; })) {
+    // The scan may finish while the observer runs.
+    lock.unlock();
+    progress_observer_->OnProgress(SampleProgress(start_time, previous));
+    lock.lock();
+  }
+}
+
 ScanResult Scanner::Scan(const std::filesystem::path& scan_path) {
+  return RunScan(
+      [this, &scan_path](ThreadPool& pool) {
+        if (walker_mode_ == WalkerMode::kParallel) {
+          return WalkInParallel(scan_path, pool);
+        }
+        std::promise<void> producer_promise;
+        auto producer_future = producer_promise.get_future();
+
+        std::thread producer_thread(&Scanner::ProducerTask, this, scan_path,
+                                    std::ref(pool),
+                                    std::ref(producer_promise));
+
+        producer_thread.join();
+        traversal_complete_.store(true);
+
+        try {
+          producer_future.get();
+        } catch (const std::exception&) {
+          errors_++;
+          return false;
+        }
+        return true;
+      },
+      &scan_path);
+}
+
+ScanResult Scanner::ScanFiles(std::istream& paths, char delimiter) {
+  return RunScan(
+      [this, &paths, delimiter](ThreadPool& pool) {
+        SubmitListedFiles(paths, delimiter, pool);
+        return true;
+      },
+      nullptr);
+}
+
+ScanResult Scanner::RunScan(const std::function<bool(ThreadPool&)>& produce,
+                            const std::filesystem::path* scanned_root) {
   const auto start_time = std::chrono::steady_clock::now();
   total_files_processed_.store(0);
   malicious_files_detected_.store(0);
   errors_.store(0);
+  cache_hits_.store(0);
+  cache_misses_.store(0);
+  deduplicated_files_.store(0);
+  deduplicated_bytes_.store(0);
+  size_rejected_.store(0);
+  prefix_checked_.store(0);
+  prefix_rejected_.store(0);
+  hardlinks_.Clear();
+  if (metrics_) {
+    metrics_->Reset();
+  }
+  last_submission_.store(start_time.time_since_epoch().count());
+  std::uint64_t peak_queue_depth = 0;
+  bytes_processed_.store(0);
+  files_discovered_.store(0);
+  traversal_complete_.store(false);
 
+  ProgressSample progress_sample{start_time};
+  std::thread progress_thread;
+  if (progress_observer_) {
+    scan_done_ = false;
+    progress_thread = std::thread(&Scanner::ProgressTask, this, start_time,
+                                  std::ref(progress_sample));
+  }
+
+  bool enumerated = false;
   {  // Inner scope to control the ThreadPool's lifetime
-    ThreadPool pool(num_threads_);
-    std::promise<void> producer_promise;
-    auto producer_future = producer_promise.get_future();
+    ThreadPool pool(num_threads_, max_queued_tasks_);
+    enumerated = produce(pool);
+    // The last window of a disk-order scan is partial, and complete only
+    // once the tasks looking up the keys of its files have run.
+    if (ReadsInDiskOrder()) {
+      pool.WaitIdle();
+    }
+    SubmitReleasedFiles(pool, read_order_.Flush());
+    // Every task has been submitted, so the peak is final.
+    peak_queue_depth = pool.PeakQueuedTasks();
+  }
+  // Also covers a scan path that could not be walked at all, and path lists.
+  traversal_complete_.store(true);
 
-    std::thread producer_thread(&Scanner::ProducerTask, this, scan_path,
-                                std::ref(pool), std::ref(producer_promise));
+  if (progress_observer_) {
+    {
+      std::lock_guard<std::mutex> lock(progress_mutex_);
+      scan_done_ = true;
+    }
+    progress_condition_.notify_one();
+    progress_thread.join();
+    progress_observer_->OnProgress(SampleProgress(start_time, progress_sample));
+  }
+  const std::chrono::steady_clock::time_point last_submission(
+      std::chrono::steady_clock::duration(last_submission_.load()));
+  const auto tail_latency = std::chrono::steady_clock::now() - last_submission;
 
-    producer_thread.join();
+  try {
+    logger_.Flush();
+  } catch (const std::exception& e) {
+    std::cerr << "Error writing detection log: " << e.what() << std::endl;
+    errors_++;
+  }
 
+  // A failed walk has not seen every file under the root, so saving would
+  // drop the entries of the files it missed.
+  if (cache_ && enumerated) {
     try {
-      producer_future.get();
-    } catch (const std::exception&) {
+      cache_->Save(scanned_root ? std::optional<std::filesystem::path>(
+                                      *scanned_root)
+                                : std::nullopt);
+    } catch (const std::exception& e) {
+      std::cerr << "Error saving file cache: " << e.what() << std::endl;
+      errors_++;
+    }
+  }
+
+  if (trace_path_) {
+    try {
+      metrics_->WriteTrace(*trace_path_);
+    } catch (const std::exception& e) {
+      std::cerr << "Error writing trace: " << e.what() << std::endl;
       errors_++;
     }
   }
@@ -87,6 +760,24 @@ ScanResult Scanner::Scan(const std::filesystem::path& scan_path) {
   result.errors = errors_.load();
   result.execution_time = std::chrono::duration_cast<std::chrono::milliseconds>(
       end_time - start_time);
+  result.peak_queue_depth = peak_queue_depth;
+  result.tail_latency =
+      std::chrono::duration_cast<std::chrono::milliseconds>(tail_latency);
+  result.deduplicated_files = deduplicated_files_.load();
+  result.deduplicated_bytes = deduplicated_bytes_.load();
+  result.prefilter = db_.GetPrefilterStats();
+  if (cache_) {
+    result.file_cache =
+        FileCacheStats{cache_hits_.load(), cache_misses_.load()};
+  }
+  if (db_.HasSizeIndex() || db_.HasPrefixIndex()) {
+    result.sample_index = SampleIndexStats{
+        size_rejected_.load(), prefix_checked_.load(), prefix_rejected_.load()};
+  }
+  if (collect_metrics_) {
+    result.metrics =
+        metrics_->Collect(result.total_files_processed, end_time - start_time);
+  }
   return result;
 }
 
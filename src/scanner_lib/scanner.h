@@ -1,17 +1,83 @@
 #ifndef SRC_SCANNER_LIB_SCANNER_H_
 #define SRC_SCANNER_LIB_SCANNER_H_
 
+#include <chrono>
 #include <cstdint>
 
 #include <atomic>
+#include <condition_variable>
+#include <exception>
 #include <filesystem>
+#include <functional>
 #include <future>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
 
 #include "scanner/interfaces.h"
+#include "src/scanner_lib/file_state_cache.h"
+#include "src/scanner_lib/file_status.h"
+#include "src/scanner_lib/hardlink_tracker.h"
+#include "src/scanner_lib/largest_first_queue.h"
+#include "src/scanner_lib/parallel_walker.h"
+#include "src/scanner_lib/path_filter.h"
+#include "src/scanner_lib/read_order_queue.h"
+#include "src/scanner_lib/scan_metrics.h"
 #include "src/scanner_lib/thread_pool.h"
 
 namespace scanner {
 
+/**
+ * @struct ScannerOptions
+ * @brief The optional settings of a Scanner, which ScannerBuilder fills in.
+ */
+struct ScannerOptions {
+  /** @brief The default high-water mark of the task queue. */
+  static constexpr std::size_t kDefaultMaxQueuedTasks = 4096;
+
+  /** @brief The default number of files sorted together for disk order. */
+  static constexpr std::size_t kDefaultReadOrderWindow = 1024;
+
+  /**
+   * @brief The high-water mark of the task queue; the directory traversal
+   * pauses while it is reached. 0 means unbounded.
+   */
+  std::size_t max_queued_tasks = kDefaultMaxQueuedTasks;
+  /** @brief How the directory tree is enumerated. */
+  WalkerMode walker_mode = WalkerMode::kParallel;
+  /**
+   * @brief An optional file-state cache, consulted before hashing a file and
+   * saved at the end of every scan. Not owned.
+   */
+  FileStateCache* cache = nullptr;
+  /** @brief The order in which discovered files are hashed. */
+  SchedulingMode scheduling = SchedulingMode::kFifo;
+  /**
+   * @brief If set, every scan measures the latency of its stages and reports
+   * it in ScanResult::metrics.
+   */
+  bool collect_metrics = false;
+  /**
+   * @brief If set, every scan traces the spans of its threads and writes
+   * them to this file as a Chrome trace when it ends.
+   */
+  std::optional<std::filesystem::path> trace_path;
+  /**
+   * @brief An optional channel every detection is sent to after it has been
+   * logged.
+   */
+  std::shared_ptr<IDetectionChannel> detections;
+  /** @brief The rules that restrict the traversal. */
+  TraversalFilter filter;
+  /**
+   * @brief The number of files collected and sorted together with
+   * SchedulingMode::kInodeOrder and kExtentOrder.
+   */
+  std::size_t read_order_window = kDefaultReadOrderWindow;
+};
+
 /**
  * @class Scanner
  * @brief The concrete, internal implementation of the IScanner interface.
@@ -27,9 +93,12 @@ public:
    * @param logger A reference to a logger implementation.
    * @param hasher A reference to a file hasher implementation.
    * @param num_threads The number of worker threads to use for scanning.
+   * @param options The optional settings.
+   * @throws std::runtime_error if a pattern of the filter is empty.
    */
   explicit Scanner(IHashDatabase& db, ILogger& logger, IFileHasher& hasher,
-                   std::size_t num_threads);
+                   std::size_t num_threads,
+                   ScannerOptions options = ScannerOptions());
 
   /**
    * @brief Scans the specified directory.
@@ -38,13 +107,62 @@ public:
    */
   ScanResult Scan(const std::filesystem::path& scan_path) override;
 
+  /**
+   * @brief Scans the files listed in a stream.
+   * @param paths The stream to read the paths from.
+   * @param delimiter The byte ending every path.
+   * @return The results of the scan.
+   */
+  ScanResult ScanFiles(std::istream& paths, char delimiter) override;
+
+  void SetProgressObserver(IProgressObserver* observer,
+                           std::chrono::milliseconds interval) override;
+
 private:
+  /** @brief The counters of the previous progress snapshot. */
+  struct ProgressSample {
+    std::chrono::steady_clock::time_point time;
+    std::uint64_t files_processed = 0;
+    std::uint64_t bytes_processed = 0;
+  };
+
+  /**
+   * @brief Takes a snapshot of the running scan from its counters.
+   * @param start_time The time the scan started.
+   * @param previous The previous snapshot, for the current rates; updated.
+   */
+  ScanProgress SampleProgress(std::chrono::steady_clock::time_point start_time,
+                              ProgressSample& previous) const;
+
+  /**
+   * @brief The task of the progress thread: reports a snapshot every
+   * interval until the scan is done.
+   * @param start_time The time the scan started.
+   * @param previous The counters at the start; updated with every snapshot.
+   */
+  void ProgressTask(std::chrono::steady_clock::time_point start_time,
+                    ProgressSample& previous);
+
+  /**
+   * @brief Runs a scan: resets the counters, lets the producer submit the
+   * files to a fresh thread pool, waits for every task and collects the
+   * results.
+   * @param produce Submits the files to scan; returns once all are submitted,
+   * false if some could not be enumerated. The file-state cache is saved only
+   * after a complete enumeration.
+   * @param scanned_root The directory being walked, whose files missing from
+   * the scan are dropped from the cache; null for a list of files.
+   */
+  ScanResult RunScan(const std::function<bool(ThreadPool&)>& produce,
+                     const std::filesystem::path* scanned_root);
+
   /**
    * @brief The task executed by the producer thread.
    *
    * Traverses the filesystem recursively from the given root path, enqueues
    * a consumer task for each regular file found, and signals completion or
-   * error via a promise.
+   * error via a promise. If the hasher supports batching, small files are
+   * grouped and enqueued as batch tasks instead.
    *
    * @param scan_path The root directory to traverse.
    * @param pool The thread pool to enqueue tasks into.
@@ -53,6 +171,102 @@ private:
   void ProducerTask(const std::filesystem::path& scan_path, ThreadPool& pool,
                     std::promise<void>& producer_promise);
 
+  /**
+   * @brief Walks the tree with a ParallelWalker, submitting the files of each
+   * directory as soon as it has been listed.
+   * @param scan_path The root directory to traverse.
+   * @param pool The thread pool that lists directories and hashes files.
+   * @return False if a directory could not be listed.
+   */
+  bool WalkInParallel(const std::filesystem::path& scan_path,
+                      ThreadPool& pool);
+
+  /**
+   * @brief Reads paths from a stream and submits them in chunks.
+   * @param paths The stream to read the paths from.
+   * @param delimiter The byte ending every path.
+   * @param pool The thread pool to enqueue the tasks into.
+   */
+  void SubmitListedFiles(std::istream& paths, char delimiter,
+                         ThreadPool& pool);
+
+  /**
+   * @brief Submits the files of one directory or one chunk of a path list,
+   * batching the small ones, and counts them as discovered.
+   * @param pool The thread pool to enqueue the tasks into.
+   * @param files The files; a size of 0 stands for an unknown size. Their
+   * paths are moved from.
+   */
+  void SubmitFiles(ThreadPool& pool, std::vector<WalkedFile>& files);
+
+  /**
+   * @brief Submits a consumer task for a batch of small files and replaces
+   * it with a spare batch.
+   * @param pool The thread pool to enqueue the task into.
+   * @param batch The paths of the files; no task is submitted if empty.
+   */
+  void SubmitBatch(ThreadPool& pool,
+                   std::vector<std::filesystem::path>& batch);
+
+  /**
+   * @brief Returns an empty path vector for the next batch, with the
+   * capacity of a finished one if any is spare.
+   */
+  std::vector<std::filesystem::path> TakeSpareBatch();
+
+  /**
+   * @brief Clears the paths of a finished or unused batch and keeps its
+   * capacity for TakeSpareBatch().
+   * @param batch The batch; left empty.
+   */
+  void RecycleBatch(std::vector<std::filesystem::path>& batch);
+
+  /**
+   * @brief Submits a consumer task for a file hashed on its own.
+   *
+   * With SchedulingMode::kLargestFirst, the file goes to the largest-first
+   * queue and the task hashes whichever queued file is largest once it runs.
+   * With the disk-order modes, the file goes to the read-order queue, and
+   * tasks are submitted only once its window is full; a key that has to be
+   * looked up is looked up by a task of its own.
+   *
+   * @param pool The thread pool to enqueue the task into.
+   * @param path The path of the file.
+   * @param size The size of the file in bytes, as seen by the traversal.
+   * @param inode The inode number of the file, or 0 if unknown.
+   */
+  void SubmitFile(ThreadPool& pool, std::filesystem::path path,
+                  std::uintmax_t size, std::uint64_t inode = 0);
+
+  /** @brief Returns true if files are read in disk order. */
+  bool ReadsInDiskOrder() const {
+    return scheduling_ == SchedulingMode::kInodeOrder ||
+           scheduling_ == SchedulingMode::kExtentOrder;
+  }
+
+  /** @brief The batch size to use: 1, i.e. none, when reading in disk order. */
+  std::size_t BatchSize() const {
+    return ReadsInDiskOrder() ? 1 : hasher_.PreferredBatchSize();
+  }
+
+  /**
+   * @brief Returns the key the read-order queue sorts a file by.
+   * @param path The path of the file.
+   * @param inode The inode number of the file, or 0 if unknown.
+   */
+  std::uint64_t ReadOrderKey(const std::filesystem::path& path,
+                             std::uint64_t inode) const;
+
+  /**
+   * @brief Submits a task for each file the read-order queue released.
+   * @param pool The thread pool to enqueue the tasks into.
+   * @param released The number of files released.
+   */
+  void SubmitReleasedFiles(ThreadPool& pool, std::size_t released);
+
+  /** @brief Records the time of a submission for the tail latency. */
+  void RecordSubmission();
+
   /**
    * @brief The task executed by consumer threads in the pool.
    *
@@ -61,17 +275,165 @@ private:
    * scan statistics.
    *
    * @param path The path of the file to process.
+   * @param queued The id TraceEnqueued() returned when the task was queued.
+   */
+  void ConsumerTask(const std::filesystem::path& path, std::uint64_t queued);
+
+  /**
+   * @brief The task executed by consumer threads with largest-first
+   * scheduling: processes the largest file of the largest-first queue.
+   * @param queued The id TraceEnqueued() returned when the task was queued.
+   */
+  void ConsumeLargestFileTask(std::uint64_t queued);
+
+  /**
+   * @brief The task executed by consumer threads with disk-order scheduling:
+   * processes the next file released by the read-order queue.
+   * @param queued The id TraceEnqueued() returned when the task was queued.
+   */
+  void ConsumeNextReadTask(std::uint64_t queued);
+
+  /**
+   * @brief The task executed by consumer threads for a batch of small files.
+   *
+   * Hashes all files with a single IFileHasher::HashFiles call, then
+   * processes each result like ConsumerTask does.
+   *
+   * @param paths The paths of the files to process; the paths of skipped
+   * files may be moved from.
+   * @param queued The id TraceEnqueued() returned when the task was queued.
+   */
+  void ConsumeBatchTask(std::vector<std::filesystem::path>& paths,
+                        std::uint64_t queued);
+
+  /**
+   * @brief What is known about a file between the checks before hashing it
+   * and the processing of its digest.
+   */
+  struct PendingFile {
+    std::optional<FileStatus> status;
+    // Set for the first path of a file with several hard links, which
+    // processes the paths queued for the other links.
+    bool owns_links = false;
+  };
+
+  /**
+   * @brief Counts a file as processed without reading it if no sample of
+   * the database has its size.
+   * @param size The size of the file in bytes.
+   * @return True if the file has been taken care of.
+   */
+  bool RejectSize(std::uint64_t size);
+
+  /**
+   * @brief Hashes the first kSamplePrefixSize bytes of a large file and
+   * completes it as clean if no sample of the database starts with them.
+   * @param path The path of the file.
+   * @param file What was learned about the file by SkipHashing().
+   * @return True if the file has been taken care of.
+   */
+  bool RejectPrefix(const std::filesystem::path& path,
+                    const PendingFile& file);
+
+  /**
+   * @brief Processes a file without hashing it if possible.
+   *
+   * A file is skipped if no sample of the database has its size, if another
+   * of its hard links has been or is being hashed, if the file-state cache
+   * knows its digest, or if no sample starts with the same bytes.
+   *
+   * @param path The path of the file.
+   * @param file Receives what was learned about the file.
+   * @return True if the file has been taken care of and needs no hashing.
    */
-  void ConsumerTask(const std::filesystem::path& path);
+  bool SkipHashing(const std::filesystem::path& path, PendingFile& file);
+
+  /**
+   * @brief Processes a file's digest or error once known, along with the
+   * paths of its other hard links that were waiting for it.
+   * @param path The path of the file.
+   * @param file What was learned about the file by SkipHashing().
+   * @param result The digest of the file, or the error hashing it raised.
+   * @param computed True if the digest was computed rather than cached.
+   */
+  void CompleteFile(const std::filesystem::path& path, const PendingFile& file,
+                    const FileHashResult& result, bool computed);
+
+  /**
+   * @brief Processes a digest or reports an error for a single path and
+   * counts the file and its size as processed.
+   * @param path The path of the file.
+   * @param result The digest of the file, or the error hashing it raised.
+   * @param size The size of the file, or 0 if unknown.
+   */
+  void ProcessResult(const std::filesystem::path& path,
+                     const FileHashResult& result, std::uint64_t size);
+
+  /**
+   * @brief Checks a file's digests against the database and logs a
+   * detection if any of them matches.
+   * @param path The path of the file.
+   * @param result The digests of the file's content.
+   * @param size The size of the file, or 0 if unknown.
+   */
+  void ProcessDigests(const std::filesystem::path& path,
+                      const FileHashResult& result, std::uint64_t size);
+
+  /**
+   * @brief Reports a failure to process a file and counts it as an error.
+   * @param path The path of the file.
+   * @param error The exception raised while processing it.
+   */
+  void ReportError(const std::filesystem::path& path,
+                   const std::exception_ptr& error);
 
   IHashDatabase& db_;
   ILogger& logger_;
   IFileHasher& hasher_;
   std::size_t num_threads_;
+  std::size_t max_queued_tasks_;
+  WalkerMode walker_mode_;
+  FileStateCache* cache_;
+  SchedulingMode scheduling_;
+  HardlinkTracker hardlinks_;
+  LargestFirstQueue largest_first_;
+  ReadOrderQueue read_order_;
+  // The path vectors of finished batches, so that batches stop allocating
+  // once as many are in flight as the queue holds.
+  std::mutex spare_batches_mutex_;
+  std::vector<std::vector<std::filesystem::path>> spare_batches_;
+  bool collect_metrics_;
+  std::optional<std::filesystem::path> trace_path_;
+  // Null unless metrics are collected or spans traced.
+  std::unique_ptr<ScanMetricsRecorder> metrics_;
+  std::shared_ptr<IDetectionChannel> detections_;
+  PathFilter filter_;
+  IProgressObserver* progress_observer_ = nullptr;
+  std::chrono::milliseconds progress_interval_{1000};
+
+  // Wakes the progress thread when the scan is done.
+  std::mutex progress_mutex_;
+  std::condition_variable progress_condition_;
+  bool scan_done_ = false;
 
   std::atomic<std::uint64_t> total_files_processed_{0};
+  // Next to the file count, whose cache line the processing thread already
+  // holds, so that counting bytes costs no further line transfer.
+  std::atomic<std::uint64_t> bytes_processed_{0};
   std::atomic<std::uint64_t> malicious_files_detected_{0};
   std::atomic<std::uint64_t> errors_{0};
+  std::atomic<std::uint64_t> cache_hits_{0};
+  std::atomic<std::uint64_t> cache_misses_{0};
+  std::atomic<std::uint64_t> deduplicated_files_{0};
+  std::atomic<std::uint64_t> deduplicated_bytes_{0};
+  std::atomic<std::uint64_t> size_rejected_{0};
+  std::atomic<std::uint64_t> prefix_checked_{0};
+  std::atomic<std::uint64_t> prefix_rejected_{0};
+  // Updated once per directory, or by the single sequential producer.
+  std::atomic<std::uint64_t> files_discovered_{0};
+  std::atomic<bool> traversal_complete_{false};
+  // The steady clock time of the latest submission, in clock ticks.
+  std::atomic<std::chrono::steady_clock::rep> last_submission_{0};
 };
 
 }  // namespace scanner
@@ -1,11 +1,18 @@
 #include "src/scanner_lib/scanner_builder.h"
 
+#include <algorithm>
 #include <stdexcept>
+#include <utility>
 
+#include "src/scanner_lib/async_file_logger.h"
+#include "src/scanner_lib/composite_file_hasher.h"
 #include "src/scanner_lib/csv_hash_database.h"
 #include "src/scanner_lib/file_logger.h"
+#include "src/scanner_lib/mapped_hash_database.h"
 #include "src/scanner_lib/md5_file_hasher.h"
+#include "src/scanner_lib/scan_metrics.h"
 #include "src/scanner_lib/scanner.h"
+#include "src/scanner_lib/sha256_file_hasher.h"
 
 namespace scanner {
 
@@ -15,9 +22,20 @@ std::unique_ptr<IScannerBuilder> CreateScannerBuilder() {
 
 IScannerBuilder& ScannerBuilder::WithCsvDatabase(
     const std::filesystem::path& path) {
-  auto db = std::make_unique<CsvHashDatabase>();
-  db->Load(path);
-  db_ = std::move(db);
+  db_format_ = DatabaseFormat::kCsv;
+  db_path_ = path;
+  return *this;
+}
+
+IScannerBuilder& ScannerBuilder::WithCompiledDatabase(
+    const std::filesystem::path& path) {
+  db_format_ = DatabaseFormat::kCompiled;
+  db_path_ = path;
+  return *this;
+}
+
+IScannerBuilder& ScannerBuilder::WithPrefilter(std::size_t bits_per_key) {
+  prefilter_bits_per_key_ = bits_per_key;
   return *this;
 }
 
@@ -27,8 +45,30 @@ IScannerBuilder& ScannerBuilder::WithFileLogger(
   return *this;
 }
 
+IScannerBuilder& ScannerBuilder::WithAsyncFileLogger(
+    const std::filesystem::path& path) {
+  logger_ = std::make_unique<AsyncFileLogger>(path);
+  return *this;
+}
+
 IScannerBuilder& ScannerBuilder::WithMd5Hasher() {
-  hasher_ = std::make_unique<Md5FileHasher>();
+  hasher_type_ = HasherType::kMd5;
+  return *this;
+}
+
+IScannerBuilder& ScannerBuilder::WithSha256Hasher() {
+  hasher_type_ = HasherType::kSha256;
+  return *this;
+}
+
+IScannerBuilder& ScannerBuilder::WithHashAlgorithms(
+    const std::vector<HashAlgorithm>& algorithms) {
+  algorithms_ = algorithms;
+  return *this;
+}
+
+IScannerBuilder& ScannerBuilder::WithIoOptions(const IoOptions& options) {
+  io_options_ = options;
   return *this;
 }
 
@@ -37,14 +77,125 @@ IScannerBuilder& ScannerBuilder::WithThreads(std::size_t num_threads) {
   return *this;
 }
 
+IScannerBuilder& ScannerBuilder::WithMaxQueuedTasks(
+    std::size_t max_queued_tasks) {
+  options_.max_queued_tasks = max_queued_tasks;
+  return *this;
+}
+
+IScannerBuilder& ScannerBuilder::WithWalkerMode(WalkerMode mode) {
+  options_.walker_mode = mode;
+  return *this;
+}
+
+IScannerBuilder& ScannerBuilder::WithScheduling(SchedulingMode mode) {
+  options_.scheduling = mode;
+  return *this;
+}
+
+IScannerBuilder& ScannerBuilder::WithReadOrderWindow(std::size_t files) {
+  options_.read_order_window = files;
+  return *this;
+}
+
+IScannerBuilder& ScannerBuilder::WithFileCache(
+    const std::filesystem::path& path) {
+  cache_ = std::make_unique<FileStateCache>(path);
+  return *this;
+}
+
+IScannerBuilder& ScannerBuilder::WithMetrics() {
+  options_.collect_metrics = true;
+  return *this;
+}
+
+IScannerBuilder& ScannerBuilder::WithTrace(const std::filesystem::path& path) {
+  options_.trace_path = path;
+  return *this;
+}
+
+IScannerBuilder& ScannerBuilder::WithTraversalFilter(
+    const TraversalFilter& filter) {
+  options_.filter = filter;
+  return *this;
+}
+
+IScannerBuilder& ScannerBuilder::WithDetectionChannel(
+    std::shared_ptr<IDetectionChannel> channel) {
+  options_.detections = std::move(channel);
+  return *this;
+}
+
 std::unique_ptr<IScanner> ScannerBuilder::Build() {
+  if (db_format_ == DatabaseFormat::kCsv) {
+    db_ = std::make_unique<CsvHashDatabase>(prefilter_bits_per_key_);
+  } else if (db_format_ == DatabaseFormat::kCompiled) {
+    db_ = std::make_unique<MappedHashDatabase>(prefilter_bits_per_key_);
+  }
+  if (db_) {
+    db_->Load(db_path_);
+  }
+
+  const bool md5_only =
+      std::all_of(algorithms_.begin(), algorithms_.end(),
+                  [](HashAlgorithm a) { return a == HashAlgorithm::kMd5; });
+  if (hasher_type_ == HasherType::kMd5 && md5_only) {
+    hasher_ = std::make_unique<Md5FileHasher>(Md5MultiBuffer::BestIsa(),
+                                              io_options_);
+  } else if (hasher_type_ == HasherType::kMd5) {
+    hasher_ = std::make_unique<CompositeFileHasher>(
+        algorithms_, Md5MultiBuffer::BestIsa(), io_options_);
+  } else if (hasher_type_ == HasherType::kSha256) {
+    hasher_ = std::make_unique<Sha256FileHasher>(
+        Sha256MultiBuffer::BestIsa(), io_options_);
+  }
+
   if (!db_ || !logger_ || !hasher_) {
     throw std::runtime_error(
         "Cannot build scanner: All dependencies (database, logger, hasher) "
         "must be configured.");
   }
 
-  return std::make_unique<Scanner>(*db_, *logger_, *hasher_, num_threads_);
+  if (hasher_type_ == HasherType::kSha256 &&
+      (!algorithms_.empty() || db_format_ == DatabaseFormat::kCompiled)) {
+    throw std::runtime_error(
+        "Cannot build scanner: The SHA-256 hasher computes no MD5 digest and "
+        "cannot be combined with further algorithms or a compiled database.");
+  }
+
+  if (db_format_ == DatabaseFormat::kCompiled && !md5_only) {
+    throw std::runtime_error(
+        "Cannot build scanner: A compiled database holds MD5 signatures only "
+        "and cannot be combined with SHA-1 or SHA-256 matching.");
+  }
+
+  if (cache_ && (!md5_only || hasher_type_ == HasherType::kSha256)) {
+    throw std::runtime_error(
+        "Cannot build scanner: The file cache stores MD5 digests only and "
+        "cannot be combined with SHA-1 or SHA-256 matching.");
+  }
+
+  if (options_.read_order_window == 0) {
+    throw std::runtime_error(
+        "Cannot build scanner: The read order window must hold at least one "
+        "file.");
+  }
+
+  if ((options_.collect_metrics || options_.trace_path) &&
+      !SCANNER_ENABLE_METRICS) {
+    throw std::runtime_error(
+        "Cannot build scanner: Metrics and tracing were disabled at compile "
+        "time (SCANNER_ENABLE_METRICS).");
+  }
+
+  if (cache_) {
+    cache_->Load();
+  }
+
+  ScannerOptions options = options_;
+  options.cache = cache_.get();
+  return std::make_unique<Scanner>(*db_, *logger_, *hasher_, num_threads_,
+                                   std::move(options));
 }
 
 }  // namespace scanner
\ No newline at end of file
@@ -1,26 +1,66 @@
 #ifndef SRC_SCANNER_LIB_SCANNER_BUILDER_H_
 #define SRC_SCANNER_LIB_SCANNER_BUILDER_H_
 
+#include <filesystem>
 #include <memory>
+#include <vector>
 
 #include "scanner/interfaces.h"
+#include "src/scanner_lib/file_state_cache.h"
+#include "src/scanner_lib/scanner.h"
 
 namespace scanner {
 
 class ScannerBuilder final : public IScannerBuilder {
 public:
   IScannerBuilder& WithCsvDatabase(const std::filesystem::path& path) override;
+  IScannerBuilder& WithCompiledDatabase(
+      const std::filesystem::path& path) override;
+  IScannerBuilder& WithPrefilter(std::size_t bits_per_key) override;
   IScannerBuilder& WithFileLogger(const std::filesystem::path& path) override;
+  IScannerBuilder& WithAsyncFileLogger(
+      const std::filesystem::path& path) override;
   IScannerBuilder& WithMd5Hasher() override;
+  IScannerBuilder& WithSha256Hasher() override;
+  IScannerBuilder& WithHashAlgorithms(
+      const std::vector<HashAlgorithm>& algorithms) override;
+  IScannerBuilder& WithIoOptions(const IoOptions& options) override;
   IScannerBuilder& WithThreads(std::size_t num_threads) override;
+  IScannerBuilder& WithMaxQueuedTasks(std::size_t max_queued_tasks) override;
+  IScannerBuilder& WithWalkerMode(WalkerMode mode) override;
+  IScannerBuilder& WithScheduling(SchedulingMode mode) override;
+  IScannerBuilder& WithReadOrderWindow(std::size_t files) override;
+  IScannerBuilder& WithFileCache(const std::filesystem::path& path) override;
+  IScannerBuilder& WithMetrics() override;
+  IScannerBuilder& WithTrace(const std::filesystem::path& path) override;
+  IScannerBuilder& WithTraversalFilter(const TraversalFilter& filter) override;
+  IScannerBuilder& WithDetectionChannel(
+      std::shared_ptr<IDetectionChannel> channel) override;
   std::unique_ptr<IScanner> Build() override;
 
 private:
+  enum class DatabaseFormat { kNone, kCsv, kCompiled };
+  enum class HasherType { kNone, kMd5, kSha256 };
+
+  // The database is loaded in Build() so that options such as the prefilter
+  // apply regardless of the order in which they were configured.
+  DatabaseFormat db_format_ = DatabaseFormat::kNone;
+  std::filesystem::path db_path_;
+  std::size_t prefilter_bits_per_key_ = 0;
+
+  // The hasher is likewise created in Build() to pick up the I/O options.
+  HasherType hasher_type_ = HasherType::kNone;
+  IoOptions io_options_;
+  std::vector<HashAlgorithm> algorithms_;
+
   std::unique_ptr<IHashDatabase> db_;
   std::unique_ptr<ILogger> logger_;
   std::unique_ptr<IFileHasher> hasher_;
+  std::unique_ptr<FileStateCache> cache_;
   std::size_t num_threads_ = 0;
+  // The cache is set from cache_ in Build().
+  ScannerOptions options_;
 };
 
 }  // namespace scanner
-#endif  // SRC_SCANNER_LIB_SCANNER_BUILDER_H_
\ No newline at end of file
+#endif  // SRC_SCANNER_LIB_SCANNER_BUILDER_H_
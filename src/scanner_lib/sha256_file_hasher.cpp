@@ -0,0 +1,93 @@
+#include "src/scanner_lib/sha256_file_hasher.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "src/scanner_lib/sha_engine.h"
+
+namespace scanner {
+
+Sha256FileHasher::Sha256FileHasher(Sha256Isa isa, const IoOptions& io_options)
+    : multi_buffer_(isa), reader_(io_options) {
+}
+
+Md5Digest Sha256FileHasher::HashFile(const std::filesystem::path& file_path) {
+  throw std::logic_error(
+      "Sha256FileHasher computes no MD5 digest; cannot hash " +
+      file_path.string());
+}
+
+void Sha256FileHasher::HashFileDigests(const std::filesystem::path& file_path,
+                                       FileHashResult& result) {
+  Sha256Engine engine;
+  reader_.Read(file_path,
+               [&engine](const std::uint8_t* data, std::size_t size) {
+                 engine.Update(data, size);
+               });
+  result.md5.reset();
+  result.sha1.reset();
+  result.sha256 = engine.Final();
+}
+
+void Sha256FileHasher::HashFiles(
+    const std::vector<std::filesystem::path>& file_paths,
+    std::vector<FileHashResult>& results) {
+  // Buffers are kept per thread so that steady-state batches reuse memory.
+  thread_local std::vector<FileReader::BatchEntry> entries;
+  thread_local std::vector<HashMessage> messages;
+  thread_local std::vector<std::size_t> message_files;
+  thread_local std::vector<Sha256Digest> digests;
+
+  results.resize(file_paths.size());
+  messages.clear();
+  message_files.clear();
+  for (FileHashResult& result : results) {
+    result.md5.reset();
+    result.sha1.reset();
+  }
+
+  try {
+    reader_.ReadBatch(file_paths, kMaxBatchedFileSize, entries);
+  } catch (...) {
+    for (FileHashResult& result : results) {
+      result.error = std::current_exception();
+    }
+    return;
+  }
+
+  for (std::size_t i = 0; i < file_paths.size(); ++i) {
+    results[i].error = entries[i].error;
+    if (results[i].error) {
+      continue;
+    }
+    if (entries[i].too_large) {
+      try {
+        HashFileDigests(file_paths[i], results[i]);
+      } catch (...) {
+        results[i].error = std::current_exception();
+      }
+      continue;
+    }
+    messages.push_back({entries[i].content.data(), entries[i].content.size()});
+    message_files.push_back(i);
+  }
+
+  digests.resize(messages.size());
+  multi_buffer_.Hash(messages.data(), messages.size(), digests.data());
+  for (std::size_t i = 0; i < messages.size(); ++i) {
+    results[message_files[i]].sha256 = digests[i];
+  }
+}
+
+std::size_t Sha256FileHasher::PreferredBatchSize() const {
+  if (reader_.Options().strategy == IoStrategy::kIoUring) {
+    return std::max(multi_buffer_.Lanes(), kMinIoUringBatchSize);
+  }
+  return multi_buffer_.Lanes();
+}
+
+std::uintmax_t Sha256FileHasher::MaxBatchedFileSize() const {
+  return PreferredBatchSize() > 1 ? kMaxBatchedFileSize : 0;
+}
+
+}  // namespace scanner
@@ -0,0 +1,91 @@
+#ifndef SRC_SCANNER_LIB_SHA256_FILE_HASHER_H_
+#define SRC_SCANNER_LIB_SHA256_FILE_HASHER_H_
+
+#include <cstdint>
+
+#include <filesystem>
+#include <vector>
+
+#include "scanner/domain.h"
+#include "scanner/interfaces.h"
+#include "src/scanner_lib/file_reader.h"
+#include "src/scanner_lib/sha256_multi_buffer.h"
+
+namespace scanner {
+
+/**
+ * @class Sha256FileHasher
+ * @brief An implementation of IFileHasher that calculates SHA-256 digests
+ * only, for databases of SHA-256 signatures.
+ *
+ * Single files are streamed through a FileReader and hashed with the SHA
+ * extensions where the CPU has them. Batches of small files are read whole
+ * and hashed by a Sha256MultiBuffer, across AVX2 lanes on CPUs without the
+ * SHA extensions. No MD5 digest is computed. It is an internal, non-exported
+ * class.
+ */
+class Sha256FileHasher final : public IFileHasher {
+public:
+  /** @brief The largest file hashed in memory as part of a batch. */
+  static constexpr std::uintmax_t kMaxBatchedFileSize = 128 * 1024;
+
+  /**
+   * @brief The smallest batch requested with IoStrategy::kIoUring, so that
+   * enough reads are in flight even without SIMD lanes to fill.
+   */
+  static constexpr std::size_t kMinIoUringBatchSize = 32;
+
+  /**
+   * @brief Constructs a hasher.
+   * @param isa The instruction set used for batches; defaults to the best one
+   * supported by the CPU.
+   * @param io_options How file contents are read.
+   */
+  explicit Sha256FileHasher(Sha256Isa isa = Sha256MultiBuffer::BestIsa(),
+                            const IoOptions& io_options = {});
+
+  /**
+   * @brief Not supported: this hasher computes no MD5 digest.
+   * @throws std::logic_error always; use HashFileDigests instead.
+   */
+  Md5Digest HashFile(const std::filesystem::path& file_path) override;
+
+  /**
+   * @brief Calculates the SHA-256 digest of a file.
+   * @param file_path The path to the file to be hashed.
+   * @param result Receives the digest in its sha256 member.
+   * @throws std::runtime_error if the file cannot be opened or read.
+   */
+  void HashFileDigests(const std::filesystem::path& file_path,
+                       FileHashResult& result) override;
+
+  /**
+   * @brief Hashes a batch of files.
+   *
+   * Files up to kMaxBatchedFileSize are read into per-thread buffers, through
+   * io_uring if configured, and hashed together; larger ones fall back to
+   * HashFileDigests.
+   *
+   * @param file_paths The files to hash.
+   * @param results Resized to match file_paths and filled in order.
+   */
+  void HashFiles(const std::vector<std::filesystem::path>& file_paths,
+                 std::vector<FileHashResult>& results) override;
+
+  /**
+   * @brief Returns the SIMD lane count, raised to at least
+   * kMinIoUringBatchSize with IoStrategy::kIoUring.
+   */
+  std::size_t PreferredBatchSize() const override;
+
+  /** @brief Returns kMaxBatchedFileSize, or 0 if batching is pointless. */
+  std::uintmax_t MaxBatchedFileSize() const override;
+
+private:
+  Sha256MultiBuffer multi_buffer_;
+  FileReader reader_;
+};
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_SHA256_FILE_HASHER_H_
@@ -0,0 +1,36 @@
+#ifndef SRC_SCANNER_LIB_SHA256_KERNELS_H_
+#define SRC_SCANNER_LIB_SHA256_KERNELS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace scanner {
+namespace sha256 {
+
+// Kernels are defined in separate translation units compiled for their
+// instruction set, and must only be called after checking CPU support.
+
+/**
+ * @brief Runs the SHA-256 compression function with the SHA extensions.
+ *
+ * Same contract as sha256::Transform; requires SHA-NI and SSE4.1.
+ */
+void TransformShaNi(std::uint32_t state[8], const std::uint8_t* blocks,
+                    std::size_t num_blocks);
+
+/**
+ * @brief Runs the SHA-256 compression function for 8 independent lanes using
+ * AVX2.
+ *
+ * @param state The chaining state in structure-of-arrays layout: word `r` of
+ * lane `l` is stored at `state[r * 8 + l]`.
+ * @param blocks One pointer per lane to at least num_blocks * 64 bytes.
+ * @param num_blocks The number of blocks to process in every lane.
+ */
+void CompressLanesAvx2(std::uint32_t* state, const std::uint8_t* const* blocks,
+                       std::size_t num_blocks);
+
+}  // namespace sha256
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_SHA256_KERNELS_H_
@@ -0,0 +1,166 @@
+// SHA-256 compression for 8 independent lanes using AVX2. This file is
+// compiled with AVX2 code generation enabled; see
+// src/scanner_lib/CMakeLists.txt.
+
+#include "src/scanner_lib/cpu_features.h"
+#include "src/scanner_lib/sha256_kernels.h"
+
+#ifdef SCANNER_ARCH_X86
+
+#include <immintrin.h>
+
+#include "src/scanner_lib/sha_engine.h"
+
+namespace scanner {
+namespace sha256 {
+namespace {
+
+constexpr std::size_t kLanes = 8;
+
+// Transposes an 8x8 matrix of 32-bit words held in eight rows.
+void Transpose8x8(__m256i r[8]) {
+  const __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+  const __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+  const __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+  const __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+  const __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+  const __m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+  const __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+  const __m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+
+  const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+  const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+  const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+  const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+  const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+  const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+  const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+  const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+
+  r[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+  r[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+  r[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+  r[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+  r[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+  r[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+  r[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+  r[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+template <int kBits>
+__m256i RotateRight(__m256i x) {
+  return _mm256_or_si256(_mm256_srli_epi32(x, kBits),
+                         _mm256_slli_epi32(x, 32 - kBits));
+}
+
+__m256i Add(__m256i x, __m256i y) {
+  return _mm256_add_epi32(x, y);
+}
+
+__m256i Xor3(__m256i x, __m256i y, __m256i z) {
+  return _mm256_xor_si256(_mm256_xor_si256(x, y), z);
+}
+
+// Loads one block per lane as 16 big-endian words, word-major.
+void LoadMessage(const std::uint8_t* const* ptrs, __m256i w[16]) {
+  const __m256i byte_swap = _mm256_set_epi8(
+      12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3, 12, 13, 14, 15, 8,
+      9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+  for (int half = 0; half < 2; ++half) {
+    __m256i* rows = w + half * 8;
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+      rows[lane] = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i*>(ptrs[lane] + half * 32));
+    }
+    Transpose8x8(rows);
+    for (int row = 0; row < 8; ++row) {
+      rows[row] = _mm256_shuffle_epi8(rows[row], byte_swap);
+    }
+  }
+}
+
+}  // namespace
+
+void CompressLanesAvx2(std::uint32_t* state, const std::uint8_t* const* blocks,
+                       std::size_t num_blocks) {
+  const std::uint8_t* ptrs[kLanes];
+  for (std::size_t lane = 0; lane < kLanes; ++lane) {
+    ptrs[lane] = blocks[lane];
+  }
+
+  __m256i s[8];
+  for (int word = 0; word < 8; ++word) {
+    s[word] = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(state + word * kLanes));
+  }
+
+  for (std::size_t block = 0; block < num_blocks; ++block) {
+    __m256i w[16];
+    LoadMessage(ptrs, w);
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+      ptrs[lane] += sha::kBlockSize;
+    }
+
+    __m256i a = s[0];
+    __m256i b = s[1];
+    __m256i c = s[2];
+    __m256i d = s[3];
+    __m256i e = s[4];
+    __m256i f = s[5];
+    __m256i g = s[6];
+    __m256i h = s[7];
+    for (int i = 0; i < 64; ++i) {
+      // The message schedule is extended in place in a 16-word window.
+      if (i >= 16) {
+        const __m256i w15 = w[(i + 1) & 15];
+        const __m256i w2 = w[(i + 14) & 15];
+        const __m256i s0 = Xor3(RotateRight<7>(w15), RotateRight<18>(w15),
+                                _mm256_srli_epi32(w15, 3));
+        const __m256i s1 = Xor3(RotateRight<17>(w2), RotateRight<19>(w2),
+                                _mm256_srli_epi32(w2, 10));
+        w[i & 15] = Add(Add(w[i & 15], s0), Add(w[(i + 9) & 15], s1));
+      }
+
+      const __m256i sum1 =
+          Xor3(RotateRight<6>(e), RotateRight<11>(e), RotateRight<25>(e));
+      const __m256i choice =
+          _mm256_xor_si256(g, _mm256_and_si256(e, _mm256_xor_si256(f, g)));
+      const __m256i temp1 = Add(
+          Add(h, sum1),
+          Add(choice,
+              Add(_mm256_set1_epi32(static_cast<int>(kRoundConstants[i])),
+                  w[i & 15])));
+      const __m256i sum0 =
+          Xor3(RotateRight<2>(a), RotateRight<13>(a), RotateRight<22>(a));
+      const __m256i majority = _mm256_or_si256(
+          _mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+      h = g;
+      g = f;
+      f = e;
+      e = Add(d, temp1);
+      d = c;
+      c = b;
+      b = a;
+      a = Add(temp1, Add(sum0, majority));
+    }
+
+    s[0] = Add(s[0], a);
+    s[1] = Add(s[1], b);
+    s[2] = Add(s[2], c);
+    s[3] = Add(s[3], d);
+    s[4] = Add(s[4], e);
+    s[5] = Add(s[5], f);
+    s[6] = Add(s[6], g);
+    s[7] = Add(s[7], h);
+  }
+
+  for (int word = 0; word < 8; ++word) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + word * kLanes),
+                        s[word]);
+  }
+}
+
+}  // namespace sha256
+}  // namespace scanner
+
+#endif  // SCANNER_ARCH_X86
@@ -0,0 +1,106 @@
+#include "src/scanner_lib/sha256_multi_buffer.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "src/scanner_lib/cpu_features.h"
+#include "src/scanner_lib/sha256_kernels.h"
+#include "src/scanner_lib/sha_engine.h"
+
+namespace scanner {
+namespace {
+
+// Adapts the SHA-256 primitives to multi_buffer::HashInLanes.
+struct Sha256Traits {
+  using Digest = Sha256Digest;
+  static constexpr std::size_t kBlockSize = sha::kBlockSize;
+  static constexpr std::size_t kStateWords = 8;
+  static constexpr const std::uint32_t* kInitialState = sha256::kInitialState;
+
+  static std::size_t PadFinalBlocks(const std::uint8_t* tail,
+                                    std::size_t tail_size,
+                                    std::uint64_t message_size,
+                                    std::uint8_t* out) {
+    return sha::PadFinalBlocks(tail, tail_size, message_size, out);
+  }
+  static void Transform(std::uint32_t* state, const std::uint8_t* blocks,
+                        std::size_t num_blocks) {
+    sha256::Transform(state, blocks, num_blocks);
+  }
+  static Sha256Digest StateToDigest(const std::uint32_t* state) {
+    return sha256::StateToDigest(state);
+  }
+};
+
+}  // namespace
+
+Sha256MultiBuffer::Sha256MultiBuffer(Sha256Isa isa)
+    : isa_(isa),
+      lanes_(1),
+      transform_(sha256::TransformScalar),
+      kernel_(nullptr) {
+  if (!IsSupported(isa)) {
+    throw std::runtime_error("SHA-256 instruction set is not supported by CPU");
+  }
+#ifdef SCANNER_ARCH_X86
+  switch (isa) {
+    case Sha256Isa::kScalar:
+      break;
+    case Sha256Isa::kShaNi:
+      transform_ = sha256::TransformShaNi;
+      break;
+    case Sha256Isa::kAvx2:
+      lanes_ = 8;
+      kernel_ = sha256::CompressLanesAvx2;
+      break;
+  }
+#endif
+}
+
+Sha256Isa Sha256MultiBuffer::BestIsa() {
+  for (const Sha256Isa isa : {Sha256Isa::kShaNi, Sha256Isa::kAvx2}) {
+    if (IsSupported(isa)) {
+      return isa;
+    }
+  }
+  return Sha256Isa::kScalar;
+}
+
+bool Sha256MultiBuffer::IsSupported(Sha256Isa isa) {
+  const CpuFeatures& features = GetCpuFeatures();
+  switch (isa) {
+    case Sha256Isa::kScalar:
+      return true;
+    case Sha256Isa::kShaNi:
+      return features.sha && features.sse41;
+    case Sha256Isa::kAvx2:
+      return features.avx2;
+  }
+  return false;
+}
+
+void Sha256MultiBuffer::Hash(const HashMessage* messages, std::size_t count,
+                             Sha256Digest* digests) const {
+  if (kernel_ != nullptr && count >= 2) {
+    multi_buffer::HashInLanes<Sha256Traits>(messages, count, digests, lanes_,
+                                            kernel_);
+    return;
+  }
+
+  for (std::size_t i = 0; i < count; ++i) {
+    const HashMessage& message = messages[i];
+    const std::size_t whole_blocks = message.size / sha::kBlockSize;
+    std::uint32_t state[8];
+    std::copy(sha256::kInitialState, sha256::kInitialState + 8, state);
+    transform_(state, message.data, whole_blocks);
+
+    std::uint8_t tail[2 * sha::kBlockSize];
+    const std::size_t tail_blocks = sha::PadFinalBlocks(
+        message.data + whole_blocks * sha::kBlockSize,
+        message.size % sha::kBlockSize, message.size, tail);
+    transform_(state, tail, tail_blocks);
+    digests[i] = sha256::StateToDigest(state);
+  }
+}
+
+}  // namespace scanner
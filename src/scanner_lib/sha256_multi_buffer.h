@@ -0,0 +1,77 @@
+#ifndef SRC_SCANNER_LIB_SHA256_MULTI_BUFFER_H_
+#define SRC_SCANNER_LIB_SHA256_MULTI_BUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "scanner/domain.h"
+#include "src/scanner_lib/multi_buffer.h"
+
+namespace scanner {
+
+/** @brief The instruction sets a Sha256MultiBuffer can run on. */
+enum class Sha256Isa { kScalar, kShaNi, kAvx2 };
+
+/**
+ * @class Sha256MultiBuffer
+ * @brief Hashes a set of in-memory messages with SHA-256.
+ *
+ * Two accelerated paths exist. The SHA extensions (SHA-NI) compress one
+ * message several times faster than portable code, and are preferred where
+ * available. Without them, an AVX2 kernel interleaves 8 messages, one per
+ * SIMD lane, the way Md5MultiBuffer does. This class is an internal,
+ * non-exported component of the scanner library.
+ */
+class Sha256MultiBuffer {
+public:
+  /**
+   * @brief Constructs an engine for the given instruction set.
+   * @param isa The instruction set to use; must satisfy IsSupported().
+   */
+  explicit Sha256MultiBuffer(Sha256Isa isa = BestIsa());
+
+  /**
+   * @brief Returns the fastest instruction set supported by this CPU:
+   * SHA-NI, then AVX2, then portable code.
+   */
+  static Sha256Isa BestIsa();
+
+  /** @brief Returns whether this CPU can run the given instruction set. */
+  static bool IsSupported(Sha256Isa isa);
+
+  /** @brief Returns the instruction set used by this engine. */
+  Sha256Isa Isa() const {
+    return isa_;
+  }
+
+  /** @brief Returns the number of messages hashed in parallel. */
+  std::size_t Lanes() const {
+    return lanes_;
+  }
+
+  /**
+   * @brief Computes the digests of a set of messages.
+   * @param messages The messages to hash.
+   * @param count The number of messages.
+   * @param digests Receives one digest per message, in order.
+   */
+  void Hash(const HashMessage* messages, std::size_t count,
+            Sha256Digest* digests) const;
+
+private:
+  using TransformFunction = void (*)(std::uint32_t* state,
+                                     const std::uint8_t* blocks,
+                                     std::size_t num_blocks);
+  using LanesKernel = void (*)(std::uint32_t* state,
+                               const std::uint8_t* const* blocks,
+                               std::size_t num_blocks);
+
+  Sha256Isa isa_;
+  std::size_t lanes_;
+  TransformFunction transform_;
+  LanesKernel kernel_;
+};
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_SHA256_MULTI_BUFFER_H_
@@ -0,0 +1,82 @@
+// SHA-256 compression using the x86 SHA extensions. This file is compiled
+// with SHA and SSE4.1 code generation enabled; see
+// src/scanner_lib/CMakeLists.txt.
+
+#include "src/scanner_lib/cpu_features.h"
+#include "src/scanner_lib/sha256_kernels.h"
+
+#ifdef SCANNER_ARCH_X86
+
+#include <immintrin.h>
+
+#include "src/scanner_lib/sha_engine.h"
+
+namespace scanner {
+namespace sha256 {
+
+void TransformShaNi(std::uint32_t state[8], const std::uint8_t* blocks,
+                    std::size_t num_blocks) {
+  // Reverses the bytes of each 32-bit word, as SHA-256 is big-endian.
+  const __m128i byte_swap =
+      _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+  // sha256rnds2 keeps the state as ABEF and CDGH halves.
+  __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state));
+  __m128i state1 =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4));
+  tmp = _mm_shuffle_epi32(tmp, 0xB1);             // CDAB
+  state1 = _mm_shuffle_epi32(state1, 0x1B);       // EFGH
+  __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);  // ABEF
+  state1 = _mm_blend_epi16(state1, tmp, 0xF0);       // CDGH
+
+  for (std::size_t block = 0; block < num_blocks; ++block) {
+    const std::uint8_t* data = blocks + block * sha::kBlockSize;
+    const __m128i abef_save = state0;
+    const __m128i cdgh_save = state1;
+
+    __m128i msg[4];
+    for (int i = 0; i < 4; ++i) {
+      msg[i] = _mm_shuffle_epi8(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 16)),
+          byte_swap);
+    }
+
+    // Each group runs four rounds while the message schedule for later
+    // groups is extended with sha256msg1/sha256msg2.
+    for (int group = 0; group < 16; ++group) {
+      const __m128i current = msg[group % 4];
+      __m128i words = _mm_add_epi32(
+          current, _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                       kRoundConstants + group * 4)));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, words);
+      if (group >= 3 && group <= 14) {
+        __m128i& next = msg[(group + 1) % 4];
+        next = _mm_add_epi32(
+            next, _mm_alignr_epi8(current, msg[(group + 3) % 4], 4));
+        next = _mm_sha256msg2_epu32(next, current);
+      }
+      words = _mm_shuffle_epi32(words, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, words);
+      if (group >= 1 && group <= 12) {
+        __m128i& previous = msg[(group + 3) % 4];
+        previous = _mm_sha256msg1_epu32(previous, current);
+      }
+    }
+
+    state0 = _mm_add_epi32(state0, abef_save);
+    state1 = _mm_add_epi32(state1, cdgh_save);
+  }
+
+  tmp = _mm_shuffle_epi32(state0, 0x1B);        // FEBA
+  state1 = _mm_shuffle_epi32(state1, 0xB1);     // DCHG
+  state0 = _mm_blend_epi16(tmp, state1, 0xF0);  // DCBA
+  state1 = _mm_alignr_epi8(state1, tmp, 8);     // ABEF
+
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(state), state0);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), state1);
+}
+
+}  // namespace sha256
+}  // namespace scanner
+
+#endif  // SCANNER_ARCH_X86
@@ -0,0 +1,276 @@
+#include "src/scanner_lib/sha_engine.h"
+
+#include <cstring>
+
+#include <algorithm>
+#include <type_traits>
+
+#include "src/scanner_lib/cpu_features.h"
+#include "src/scanner_lib/sha256_kernels.h"
+
+namespace scanner {
+namespace {
+
+inline std::uint32_t RotateLeft(std::uint32_t x, int bits) {
+  return (x << bits) | (x >> (32 - bits));
+}
+
+inline std::uint32_t RotateRight(std::uint32_t x, int bits) {
+  return (x >> bits) | (x << (32 - bits));
+}
+
+inline std::uint32_t LoadBigEndian(const std::uint8_t* p) {
+  return (std::uint32_t{p[0]} << 24) | (std::uint32_t{p[1]} << 16) |
+         (std::uint32_t{p[2]} << 8) | std::uint32_t{p[3]};
+}
+
+void Sha1Block(std::uint32_t state[5], const std::uint8_t* block) {
+  std::uint32_t w[80];
+  for (int i = 0; i < 16; ++i) {
+    w[i] = LoadBigEndian(block + i * 4);
+  }
+  for (int i = 16; i < 80; ++i) {
+    w[i] = RotateLeft(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+  }
+
+  std::uint32_t a = state[0];
+  std::uint32_t b = state[1];
+  std::uint32_t c = state[2];
+  std::uint32_t d = state[3];
+  std::uint32_t e = state[4];
+  for (int i = 0; i < 80; ++i) {
+    std::uint32_t f;
+    std::uint32_t k;
+    if (i < 20) {
+      f = d ^ (b & (c ^ d));
+      k = 0x5a827999;
+    } else if (i < 40) {
+      f = b ^ c ^ d;
+      k = 0x6ed9eba1;
+    } else if (i < 60) {
+      f = (b & c) | (d & (b | c));
+      k = 0x8f1bbcdc;
+    } else {
+      f = b ^ c ^ d;
+      k = 0xca62c1d6;
+    }
+    const std::uint32_t temp = RotateLeft(a, 5) + f + e + k + w[i];
+    e = d;
+    d = c;
+    c = RotateLeft(b, 30);
+    b = a;
+    a = temp;
+  }
+
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+}
+
+void Sha256Block(std::uint32_t state[8], const std::uint8_t* block) {
+  std::uint32_t w[64];
+  for (int i = 0; i < 16; ++i) {
+    w[i] = LoadBigEndian(block + i * 4);
+  }
+  for (int i = 16; i < 64; ++i) {
+    const std::uint32_t s0 = RotateRight(w[i - 15], 7) ^
+                             RotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    const std::uint32_t s1 = RotateRight(w[i - 2], 17) ^
+                             RotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  std::uint32_t a = state[0];
+  std::uint32_t b = state[1];
+  std::uint32_t c = state[2];
+  std::uint32_t d = state[3];
+  std::uint32_t e = state[4];
+  std::uint32_t f = state[5];
+  std::uint32_t g = state[6];
+  std::uint32_t h = state[7];
+  for (int i = 0; i < 64; ++i) {
+    const std::uint32_t s1 =
+        RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+    const std::uint32_t choice = g ^ (e & (f ^ g));
+    const std::uint32_t temp1 =
+        h + s1 + choice + sha256::kRoundConstants[i] + w[i];
+    const std::uint32_t s0 =
+        RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+    const std::uint32_t majority = (a & b) | (c & (a | b));
+    const std::uint32_t temp2 = s0 + majority;
+    h = g;
+    g = f;
+    f = e;
+    e = d + temp1;
+    d = c;
+    c = b;
+    b = a;
+    a = temp1 + temp2;
+  }
+
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+  state[5] += f;
+  state[6] += g;
+  state[7] += h;
+}
+
+using TransformFunction = void (*)(std::uint32_t* state,
+                                   const std::uint8_t* blocks,
+                                   std::size_t num_blocks);
+
+TransformFunction SelectSha256Transform() {
+#ifdef SCANNER_ARCH_X86
+  const CpuFeatures& features = GetCpuFeatures();
+  if (features.sha && features.sse41) {
+    return sha256::TransformShaNi;
+  }
+#endif
+  return sha256::TransformScalar;
+}
+
+template <class Digest>
+void StoreBigEndian(const std::uint32_t* state, Digest& digest) {
+  for (std::size_t i = 0; i < Digest::kSize / 4; ++i) {
+    for (std::size_t j = 0; j < 4; ++j) {
+      digest.bytes[i * 4 + j] =
+          static_cast<std::uint8_t>(state[i] >> (24 - 8 * j));
+    }
+  }
+}
+
+template <class Digest>
+void TransformBlocks(std::uint32_t* state, const std::uint8_t* blocks,
+                     std::size_t num_blocks) {
+  if constexpr (std::is_same_v<Digest, Sha1Digest>) {
+    sha1::Transform(state, blocks, num_blocks);
+  } else {
+    sha256::Transform(state, blocks, num_blocks);
+  }
+}
+
+}  // namespace
+
+namespace sha {
+
+std::size_t PadFinalBlocks(const std::uint8_t* tail, std::size_t tail_size,
+                           std::uint64_t message_size, std::uint8_t* out) {
+  const std::size_t num_blocks = tail_size + 9 <= kBlockSize ? 1 : 2;
+  const std::size_t padded_size = num_blocks * kBlockSize;
+  if (tail_size > 0) {
+    std::memcpy(out, tail, tail_size);
+  }
+  out[tail_size] = 0x80;
+  std::memset(out + tail_size + 1, 0, padded_size - tail_size - 1 - 8);
+  const std::uint64_t bit_length = message_size * 8;
+  for (int i = 0; i < 8; ++i) {
+    out[padded_size - 1 - i] = static_cast<std::uint8_t>(bit_length >> (8 * i));
+  }
+  return num_blocks;
+}
+
+}  // namespace sha
+
+namespace sha1 {
+
+void Transform(std::uint32_t state[5], const std::uint8_t* blocks,
+               std::size_t num_blocks) {
+  for (std::size_t i = 0; i < num_blocks; ++i) {
+    Sha1Block(state, blocks + i * sha::kBlockSize);
+  }
+}
+
+}  // namespace sha1
+
+namespace sha256 {
+
+void Transform(std::uint32_t state[8], const std::uint8_t* blocks,
+               std::size_t num_blocks) {
+  static const TransformFunction transform = SelectSha256Transform();
+  transform(state, blocks, num_blocks);
+}
+
+void TransformScalar(std::uint32_t state[8], const std::uint8_t* blocks,
+                     std::size_t num_blocks) {
+  for (std::size_t i = 0; i < num_blocks; ++i) {
+    Sha256Block(state, blocks + i * sha::kBlockSize);
+  }
+}
+
+Sha256Digest StateToDigest(const std::uint32_t state[8]) {
+  Sha256Digest digest;
+  StoreBigEndian(state, digest);
+  return digest;
+}
+
+}  // namespace sha256
+
+template <class Digest>
+ShaEngine<Digest>::ShaEngine() {
+  Reset();
+}
+
+template <class Digest>
+void ShaEngine<Digest>::Update(const std::uint8_t* data, std::size_t size) {
+  if (size == 0) {
+    return;
+  }
+  message_size_ += size;
+
+  if (buffer_size_ > 0) {
+    const std::size_t take = std::min(size, sha::kBlockSize - buffer_size_);
+    std::memcpy(buffer_ + buffer_size_, data, take);
+    buffer_size_ += take;
+    data += take;
+    size -= take;
+    if (buffer_size_ < sha::kBlockSize) {
+      return;
+    }
+    TransformBlocks<Digest>(state_, buffer_, 1);
+    buffer_size_ = 0;
+  }
+
+  const std::size_t full_blocks = size / sha::kBlockSize;
+  TransformBlocks<Digest>(state_, data, full_blocks);
+  data += full_blocks * sha::kBlockSize;
+  size -= full_blocks * sha::kBlockSize;
+
+  if (size > 0) {
+    std::memcpy(buffer_, data, size);
+    buffer_size_ = size;
+  }
+}
+
+template <class Digest>
+Digest ShaEngine<Digest>::Final() {
+  std::uint8_t final_blocks[2 * sha::kBlockSize];
+  const std::size_t num_blocks =
+      sha::PadFinalBlocks(buffer_, buffer_size_, message_size_, final_blocks);
+  TransformBlocks<Digest>(state_, final_blocks, num_blocks);
+
+  Digest digest;
+  StoreBigEndian(state_, digest);
+  Reset();
+  return digest;
+}
+
+template <class Digest>
+void ShaEngine<Digest>::Reset() {
+  if constexpr (std::is_same_v<Digest, Sha1Digest>) {
+    std::memcpy(state_, sha1::kInitialState, sizeof(state_));
+  } else {
+    std::memcpy(state_, sha256::kInitialState, sizeof(state_));
+  }
+  buffer_size_ = 0;
+  message_size_ = 0;
+}
+
+template class ShaEngine<Sha1Digest>;
+template class ShaEngine<Sha256Digest>;
+
+}  // namespace scanner
@@ -0,0 +1,136 @@
+#ifndef SRC_SCANNER_LIB_SHA_ENGINE_H_
+#define SRC_SCANNER_LIB_SHA_ENGINE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "scanner/domain.h"
+
+namespace scanner {
+namespace sha {
+
+/** @brief The block size of SHA-1 and SHA-256 in bytes. */
+inline constexpr std::size_t kBlockSize = 64;
+
+/**
+ * @brief Builds the padded final block(s) of a message.
+ *
+ * SHA-1 and SHA-256 share this padding: a 0x80 byte, zeros and the 64-bit
+ * big-endian bit length.
+ *
+ * @param tail The trailing bytes of the message that do not fill a block.
+ * @param tail_size The number of trailing bytes; must be < kBlockSize.
+ * @param message_size The total length of the message in bytes.
+ * @param out Receives the padded blocks; must hold 2 * kBlockSize bytes.
+ * @return The number of blocks written to out (1 or 2).
+ */
+std::size_t PadFinalBlocks(const std::uint8_t* tail, std::size_t tail_size,
+                           std::uint64_t message_size, std::uint8_t* out);
+
+}  // namespace sha
+
+namespace sha1 {
+
+/** @brief The SHA-1 chaining state before any block is processed. */
+inline constexpr std::uint32_t kInitialState[5] = {
+    0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+
+/**
+ * @brief Runs the SHA-1 compression function over consecutive blocks.
+ * @param state The five-word chaining state, updated in place.
+ * @param blocks The input; must hold num_blocks * sha::kBlockSize bytes.
+ * @param num_blocks The number of blocks to process.
+ */
+void Transform(std::uint32_t state[5], const std::uint8_t* blocks,
+               std::size_t num_blocks);
+
+}  // namespace sha1
+
+namespace sha256 {
+
+/** @brief The SHA-256 chaining state before any block is processed. */
+inline constexpr std::uint32_t kInitialState[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+/** @brief The SHA-256 round constants. */
+inline constexpr std::uint32_t kRoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+/**
+ * @brief Runs the SHA-256 compression function over consecutive blocks.
+ *
+ * Uses the SHA extensions (SHA-NI) when the CPU supports them and the
+ * portable code otherwise.
+ *
+ * @param state The eight-word chaining state, updated in place.
+ * @param blocks The input; must hold num_blocks * sha::kBlockSize bytes.
+ * @param num_blocks The number of blocks to process.
+ */
+void Transform(std::uint32_t state[8], const std::uint8_t* blocks,
+               std::size_t num_blocks);
+
+/** @brief The portable implementation of Transform. */
+void TransformScalar(std::uint32_t state[8], const std::uint8_t* blocks,
+                     std::size_t num_blocks);
+
+/** @brief Serializes a final chaining state into a digest. */
+Sha256Digest StateToDigest(const std::uint32_t state[8]);
+
+}  // namespace sha256
+
+/**
+ * @class ShaEngine
+ * @brief An incremental, portable SHA-1 or SHA-256 implementation.
+ *
+ * Data can be fed in arbitrarily sized pieces; the digest is produced by
+ * Final(). This class is an internal, non-exported component of the scanner
+ * library; use the Sha1Engine and Sha256Engine aliases.
+ *
+ * @tparam Digest Sha1Digest or Sha256Digest.
+ */
+template <class Digest>
+class ShaEngine {
+public:
+  ShaEngine();
+
+  /** @brief Appends data to the message. */
+  void Update(const std::uint8_t* data, std::size_t size);
+
+  /**
+   * @brief Completes the message and returns its digest.
+   *
+   * The engine is reset afterwards and can hash another message.
+   */
+  Digest Final();
+
+private:
+  static constexpr std::size_t kStateWords = Digest::kSize / 4;
+
+  void Reset();
+
+  std::uint32_t state_[kStateWords];
+  std::uint8_t buffer_[sha::kBlockSize];
+  std::size_t buffer_size_ = 0;
+  std::uint64_t message_size_ = 0;
+};
+
+using Sha1Engine = ShaEngine<Sha1Digest>;
+using Sha256Engine = ShaEngine<Sha256Digest>;
+
+extern template class ShaEngine<Sha1Digest>;
+extern template class ShaEngine<Sha256Digest>;
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_SHA_ENGINE_H_
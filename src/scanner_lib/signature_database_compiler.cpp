@@ -0,0 +1,229 @@
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "scanner/interfaces.h"
+#include "src/scanner_lib/csv_hash_database.h"
+#include "src/scanner_lib/signature_database_format.h"
+
+namespace scanner {
+namespace {
+
+static_assert(sizeof(Md5Digest) == Md5Digest::kSize,
+              "Prefix digests are written as raw bytes");
+
+struct Entry {
+  Md5Digest digest;
+  std::uint32_t verdict_id;
+};
+
+std::uint64_t AlignUp(std::uint64_t offset) {
+  return (offset + sigdb::kAlignment - 1) / sigdb::kAlignment *
+         sigdb::kAlignment;
+}
+
+std::uint32_t ChooseBucketBits(std::size_t entry_count) {
+  std::uint32_t bits = 0;
+  while (bits < sigdb::kMaxBucketBits &&
+         (std::uint64_t{1} << bits) * sigdb::kEntriesPerBucket < entry_count) {
+    bits++;
+  }
+  return bits;
+}
+
+// Writes a section at the given offset, zero-filling the alignment gap after
+// the previous section. Sections must be written in increasing offset order.
+void WriteSection(std::ofstream& out, std::uint64_t offset, const void* data,
+                  std::size_t size) {
+  static constexpr char kPadding[sigdb::kAlignment] = {};
+  const auto position = static_cast<std::uint64_t>(out.tellp());
+  out.write(kPadding, static_cast<std::streamsize>(offset - position));
+  out.write(static_cast<const char*>(data),
+            static_cast<std::streamsize>(size));
+}
+
+}  // namespace
+
+std::size_t CompileSignatureDatabase(const std::filesystem::path& csv_path,
+                                     const std::filesystem::path& output_path) {
+  std::vector<Entry> entries;
+  std::vector<std::string> verdicts;
+  std::unordered_map<std::string, std::uint32_t> verdict_ids;
+
+  std::size_t skipped = 0;
+  SampleIndex sample_index;
+  ReadCsvSignatures(csv_path, [&](const CsvSignature& signature) {
+    const auto* digest = std::get_if<Md5Digest>(&signature.digest);
+    if (!digest) {
+      skipped++;
+      return;
+    }
+    sample_index.Add(signature);
+    auto [it, inserted] = verdict_ids.try_emplace(
+        std::string(signature.verdict),
+        static_cast<std::uint32_t>(verdicts.size()));
+    if (inserted) {
+      verdicts.push_back(it->first);
+    }
+    entries.push_back({*digest, it->second});
+  });
+  if (skipped > 0) {
+    std::cerr << "Warning: Skipped " << skipped
+              << " SHA-1/SHA-256 signatures; compiled databases hold MD5 "
+                 "signatures only: "
+              << csv_path.string() << std::endl;
+  }
+
+  // Keep the last verdict for duplicated hashes, matching CsvHashDatabase.
+  std::stable_sort(entries.begin(), entries.end(),
+                   [](const Entry& lhs, const Entry& rhs) {
+                     return lhs.digest.bytes < rhs.digest.bytes;
+                   });
+  std::vector<Entry> unique_entries;
+  unique_entries.reserve(entries.size());
+  for (std::size_t i = 0; i < entries.size(); ++i) {
+    if (i + 1 < entries.size() &&
+        entries[i].digest == entries[i + 1].digest) {
+      continue;
+    }
+    unique_entries.push_back(entries[i]);
+  }
+  entries.clear();
+  entries.shrink_to_fit();
+
+  if (unique_entries.size() > std::numeric_limits<std::uint32_t>::max()) {
+    throw std::runtime_error("Too many signatures to compile: " +
+                             csv_path.string());
+  }
+
+  const std::uint32_t bucket_bits = ChooseBucketBits(unique_entries.size());
+  const std::size_t bucket_count = std::size_t{1} << bucket_bits;
+  std::vector<std::uint32_t> buckets(bucket_count + 1, 0);
+  {
+    std::size_t entry = 0;
+    for (std::size_t bucket = 0; bucket < bucket_count; ++bucket) {
+      while (entry < unique_entries.size() &&
+             sigdb::BucketOf(unique_entries[entry].digest.bytes.data(),
+                             bucket_bits) < bucket) {
+        entry++;
+      }
+      buckets[bucket] = static_cast<std::uint32_t>(entry);
+    }
+    buckets[bucket_count] = static_cast<std::uint32_t>(unique_entries.size());
+  }
+
+  std::vector<std::uint8_t> digests;
+  std::vector<std::uint32_t> entry_verdicts;
+  digests.reserve(unique_entries.size() * Md5Digest::kSize);
+  entry_verdicts.reserve(unique_entries.size());
+  for (const Entry& entry : unique_entries) {
+    digests.insert(digests.end(), entry.digest.bytes.begin(),
+                   entry.digest.bytes.end());
+    entry_verdicts.push_back(entry.verdict_id);
+  }
+
+  std::string strings;
+  std::vector<std::uint32_t> verdict_offsets;
+  verdict_offsets.reserve(verdicts.size() + 1);
+  for (const std::string& verdict : verdicts) {
+    verdict_offsets.push_back(static_cast<std::uint32_t>(strings.size()));
+    strings += verdict;
+  }
+  verdict_offsets.push_back(static_cast<std::uint32_t>(strings.size()));
+
+  sample_index.Finish();
+  if (!sample_index.HasSizes() && !sample_index.Sizes().empty()) {
+    std::cerr << "Warning: Not every signature gives a sample size; the size "
+                 "index is omitted: "
+              << csv_path.string() << std::endl;
+  }
+  if (!sample_index.HasPrefixes() && !sample_index.Prefixes().empty()) {
+    std::cerr << "Warning: Not every signature gives a prefix digest; the "
+                 "prefix index is omitted: "
+              << csv_path.string() << std::endl;
+  }
+  static const std::vector<std::uint64_t> kNoSizes;
+  static const std::vector<Md5Digest> kNoPrefixes;
+  const std::vector<std::uint64_t>& sizes =
+      sample_index.HasSizes() ? sample_index.Sizes() : kNoSizes;
+  const std::vector<Md5Digest>& prefixes =
+      sample_index.HasPrefixes() ? sample_index.Prefixes() : kNoPrefixes;
+
+  sigdb::FileHeader header{};
+  std::memcpy(header.magic, sigdb::kMagic, sizeof(header.magic));
+  header.version = sigdb::kVersion;
+  header.byte_order_mark = sigdb::kByteOrderMark;
+  header.bucket_bits = bucket_bits;
+  header.verdict_count = static_cast<std::uint32_t>(verdicts.size());
+  header.entry_count = unique_entries.size();
+  header.buckets_offset = AlignUp(sizeof(header));
+  header.digests_offset = AlignUp(header.buckets_offset +
+                                  buckets.size() * sizeof(std::uint32_t));
+  header.verdict_ids_offset =
+      AlignUp(header.digests_offset + digests.size());
+  header.verdict_offsets_offset =
+      AlignUp(header.verdict_ids_offset +
+              entry_verdicts.size() * sizeof(std::uint32_t));
+  header.strings_offset =
+      AlignUp(header.verdict_offsets_offset +
+              verdict_offsets.size() * sizeof(std::uint32_t));
+  header.strings_size = strings.size();
+  header.size_count = sizes.size();
+  header.sizes_offset = AlignUp(header.strings_offset + strings.size());
+  header.prefix_count = prefixes.size();
+  header.prefixes_offset =
+      AlignUp(header.sizes_offset + sizes.size() * sizeof(std::uint64_t));
+
+  // Write next to the destination and rename into place, so scanners that
+  // have the previous version mapped keep a consistent view of it.
+  std::filesystem::path temp_path = output_path;
+  temp_path += ".tmp";
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      throw std::runtime_error("Failed to open output file for writing: " +
+                               temp_path.string());
+    }
+    WriteSection(out, 0, &header, sizeof(header));
+    WriteSection(out, header.buckets_offset, buckets.data(),
+                 buckets.size() * sizeof(std::uint32_t));
+    WriteSection(out, header.digests_offset, digests.data(), digests.size());
+    WriteSection(out, header.verdict_ids_offset, entry_verdicts.data(),
+                 entry_verdicts.size() * sizeof(std::uint32_t));
+    WriteSection(out, header.verdict_offsets_offset, verdict_offsets.data(),
+                 verdict_offsets.size() * sizeof(std::uint32_t));
+    WriteSection(out, header.strings_offset, strings.data(), strings.size());
+    WriteSection(out, header.sizes_offset, sizes.data(),
+                 sizes.size() * sizeof(std::uint64_t));
+    WriteSection(out, header.prefixes_offset, prefixes.data(),
+                 prefixes.size() * Md5Digest::kSize);
+    out.close();
+    if (!out) {
+      throw std::runtime_error("Failed to write compiled database: " +
+                               temp_path.string());
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(temp_path, output_path, ec);
+  if (ec) {
+    std::filesystem::remove(temp_path, ec);
+    throw std::runtime_error("Failed to replace compiled database: " +
+                             output_path.string());
+  }
+
+  return unique_entries.size();
+}
+
+}  // namespace scanner
@@ -0,0 +1,97 @@
+#ifndef SRC_SCANNER_LIB_SIGNATURE_DATABASE_FORMAT_H_
+#define SRC_SCANNER_LIB_SIGNATURE_DATABASE_FORMAT_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace scanner {
+namespace sigdb {
+
+/**
+ * @file
+ * @brief On-disk layout of a compiled signature database.
+ *
+ * A compiled database is produced by CompileSignatureDatabase (the
+ * `scanner-dbc` tool) and consumed by MappedHashDatabase. All integers are
+ * stored in the byte order of the machine that compiled the file; the
+ * `byte_order_mark` field lets readers reject files from the other byte order.
+ *
+ * The file consists of the following sections, each aligned to kAlignment:
+ *   - FileHeader.
+ *   - Bucket table: `(1 << bucket_bits) + 1` uint32 values. Bucket `b` holds
+ *     the index of the first digest whose leading `bucket_bits` bits are >= b.
+ *   - Digests: `entry_count` 16-byte MD5 digests, sorted lexicographically.
+ *   - Verdict ids: `entry_count` uint32 values, parallel to the digests.
+ *   - Verdict offsets: `verdict_count + 1` uint32 offsets into the string
+ *     table; verdict `i` spans `[offsets[i], offsets[i + 1])`.
+ *   - String table: the unique verdict strings, concatenated.
+ *   - Sample sizes (optional): `size_count` sorted, distinct uint64 values,
+ *     the sizes of all samples.
+ *   - Sample prefixes (optional): `prefix_count` sorted, distinct 16-byte
+ *     MD5 digests of the first kSamplePrefixSize bytes of the samples.
+ *
+ * The optional sections are only written if they cover every signature, and
+ * have a count of zero otherwise. Version 1 files end their header before
+ * `size_count` and have neither.
+ *
+ * A lookup therefore reads one bucket pair and a handful of adjacent digests,
+ * and needs no parsing or allocation.
+ */
+
+inline constexpr char kMagic[8] = {'S', 'C', 'N', 'S', 'I', 'G', 'D', 'B'};
+inline constexpr std::uint32_t kVersion = 2;
+/** @brief The oldest version readers still accept. */
+inline constexpr std::uint32_t kMinVersion = 1;
+/** @brief The header size of version 1, which has no sample index. */
+inline constexpr std::size_t kVersion1HeaderSize = 80;
+inline constexpr std::uint32_t kByteOrderMark = 0x01020304;
+inline constexpr std::uint32_t kAlignment = 16;
+
+/** @brief The target average number of digests per bucket. */
+inline constexpr std::uint64_t kEntriesPerBucket = 4;
+/** @brief The upper bound on the bucket table size (64 MiB). */
+inline constexpr std::uint32_t kMaxBucketBits = 24;
+
+struct FileHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t byte_order_mark;
+  std::uint32_t bucket_bits;
+  std::uint32_t verdict_count;
+  std::uint64_t entry_count;
+  std::uint64_t buckets_offset;
+  std::uint64_t digests_offset;
+  std::uint64_t verdict_ids_offset;
+  std::uint64_t verdict_offsets_offset;
+  std::uint64_t strings_offset;
+  std::uint64_t strings_size;
+  // Added in version 2.
+  std::uint64_t size_count;
+  std::uint64_t sizes_offset;
+  std::uint64_t prefix_count;
+  std::uint64_t prefixes_offset;
+};
+
+static_assert(sizeof(FileHeader) == 112, "FileHeader layout must be stable");
+
+/**
+ * @brief Returns the bucket index of a digest given its first four bytes.
+ * @param leading_bytes The first four digest bytes.
+ * @param bucket_bits The number of bits used to select a bucket.
+ */
+inline std::uint32_t BucketOf(const std::uint8_t* leading_bytes,
+                              std::uint32_t bucket_bits) {
+  if (bucket_bits == 0) {
+    return 0;
+  }
+  const std::uint32_t prefix = (std::uint32_t{leading_bytes[0]} << 24) |
+                               (std::uint32_t{leading_bytes[1]} << 16) |
+                               (std::uint32_t{leading_bytes[2]} << 8) |
+                               std::uint32_t{leading_bytes[3]};
+  return prefix >> (32 - bucket_bits);
+}
+
+}  // namespace sigdb
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_SIGNATURE_DATABASE_FORMAT_H_
@@ -0,0 +1,135 @@
+#ifndef SRC_SCANNER_LIB_TASK_H_
+#define SRC_SCANNER_LIB_TASK_H_
+
+#include <cstddef>
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace scanner {
+
+/**
+ * @class Task
+ * @brief A move-only, type-erased `void()` callable with inline storage.
+ *
+ * Unlike std::function, Task accepts move-only callables such as
+ * std::packaged_task, and stores callables of up to kInlineSize bytes without
+ * a heap allocation. Larger callables fall back to the heap. This class is an
+ * internal, non-exported component of the scanner library.
+ */
+class Task {
+public:
+  /**
+   * @brief The largest callable stored without a heap allocation. Together
+   * with the vtable pointer, a task fills one 64-byte cache line.
+   */
+  static constexpr std::size_t kInlineSize = 56;
+
+  /** @brief Constructs an empty task. */
+  Task() = default;
+
+  /**
+   * @brief Wraps a callable.
+   * @param f The callable; invoked as `f()`, its result is discarded.
+   */
+  template <class F, class = std::enable_if_t<
+                         !std::is_same_v<std::decay_t<F>, Task>>>
+  Task(F&& f) {  // NOLINT(google-explicit-constructor)
+    using Callable = std::decay_t<F>;
+    if constexpr (kFitsInline<Callable>) {
+      ::new (static_cast<void*>(storage_)) Callable(std::forward<F>(f));
+      vtable_ = &kInlineVTable<Callable>;
+    } else {
+      ::new (static_cast<void*>(storage_))
+          Callable*(new Callable(std::forward<F>(f)));
+      vtable_ = &kHeapVTable<Callable>;
+    }
+  }
+
+  ~Task() {
+    Reset();
+  }
+
+  Task(Task&& other) noexcept {
+    MoveFrom(other);
+  }
+
+  Task& operator=(Task&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+
+  /** @brief Invokes the callable; the task must not be empty. */
+  void operator()() {
+    vtable_->invoke(storage_);
+  }
+
+  /** @brief Returns true if the task holds a callable. */
+  explicit operator bool() const {
+    return vtable_ != nullptr;
+  }
+
+private:
+  struct VTable {
+    void (*invoke)(void* storage);
+    // Move-constructs into dst and destroys src.
+    void (*relocate)(void* dst, void* src) noexcept;
+    void (*destroy)(void* storage) noexcept;
+  };
+
+  template <class Callable>
+  static constexpr bool kFitsInline =
+      sizeof(Callable) <= kInlineSize &&
+      alignof(Callable) <= alignof(std::max_align_t) &&
+      std::is_nothrow_move_constructible_v<Callable>;
+
+  template <class Callable>
+  static constexpr VTable kInlineVTable = {
+      [](void* storage) { (*static_cast<Callable*>(storage))(); },
+      [](void* dst, void* src) noexcept {
+        auto* source = static_cast<Callable*>(src);
+        ::new (dst) Callable(std::move(*source));
+        source->~Callable();
+      },
+      [](void* storage) noexcept {
+        static_cast<Callable*>(storage)->~Callable();
+      },
+  };
+
+  template <class Callable>
+  static constexpr VTable kHeapVTable = {
+      [](void* storage) { (**static_cast<Callable**>(storage))(); },
+      [](void* dst, void* src) noexcept {
+        ::new (dst) Callable*(*static_cast<Callable**>(src));
+      },
+      [](void* storage) noexcept { delete *static_cast<Callable**>(storage); },
+  };
+
+  void MoveFrom(Task& other) noexcept {
+    if (other.vtable_ != nullptr) {
+      other.vtable_->relocate(storage_, other.storage_);
+      vtable_ = std::exchange(other.vtable_, nullptr);
+    }
+  }
+
+  void Reset() noexcept {
+    if (vtable_ != nullptr) {
+      vtable_->destroy(storage_);
+      vtable_ = nullptr;
+    }
+  }
+
+  alignas(std::max_align_t) unsigned char storage_[kInlineSize];
+  const VTable* vtable_ = nullptr;
+};
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_TASK_H_
@@ -1,11 +1,21 @@
 #include "src/scanner_lib/thread_pool.h"
 
+#include <algorithm>
+#include <new>
 #include <stdexcept>
 #include <thread>
 
 namespace scanner {
+namespace {
 
-ThreadPool::ThreadPool(std::size_t num_threads) {
+// Identifies the pool and queue of the worker running on this thread.
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local std::size_t current_index = 0;
+
+}  // namespace
+
+ThreadPool::ThreadPool(std::size_t num_threads, std::size_t max_queued_tasks)
+    : max_pending_(max_queued_tasks), resume_pending_(max_queued_tasks / 2) {
   if (num_threads == 0) {
     num_threads = std::thread::hardware_concurrency();
     if (num_threads == 0) {
@@ -13,9 +23,14 @@ ThreadPool::ThreadPool(std::size_t num_threads) {
     }
   }
 
+  queues_.reserve(num_threads);
+  for (std::size_t i = 0; i < num_threads; ++i) {
+    queues_.push_back(std::make_unique<WorkerQueue>());
+    queues_.back()->spare_tasks.reserve(2 * kSpareTaskGroup);
+  }
   workers_.reserve(num_threads);
   for (std::size_t i = 0; i < num_threads; ++i) {
-    workers_.emplace_back(&ThreadPool::Worker, this);
+    workers_.emplace_back(&ThreadPool::Worker, this, i);
   }
 }
 
@@ -26,33 +41,216 @@ ThreadPool::~ThreadPool() {
       worker.join();
     }
   }
+
+  // A submission that raced with Stop() may have arrived after the workers
+  // exited; run it here so that every accepted task executes exactly once.
+  for (const auto& queue : queues_) {
+    while (Task* task = queue->deque.Steal()) {
+      (*task)();
+      task->~Task();
+      ReleaseTaskNode(task);
+    }
+    while (Task* task = TakeFromInbox(*queue, false)) {
+      (*task)();
+      task->~Task();
+      ReleaseTaskNode(task);
+    }
+  }
+
+  for (const auto& queue : queues_) {
+    for (void* node : queue->spare_tasks) {
+      ::operator delete(node);
+    }
+  }
+  for (void* node : spare_tasks_) {
+    ::operator delete(node);
+  }
 }
 
 void ThreadPool::Stop() {
   {
-    std::unique_lock<std::mutex> lock(queue_mutex_);
+    std::unique_lock<std::mutex> lock(idle_mutex_);
     if (stop_.load()) {
       return;
     }
     stop_.store(true);
   }
-  condition_.notify_all();
+  idle_condition_.notify_all();
+  {
+    std::lock_guard<std::mutex> lock(space_mutex_);
+  }
+  space_condition_.notify_all();
 }
 
-void ThreadPool::Worker() {
+bool ThreadPool::WaitForSpace() {
+  if (pending_.load() < max_pending_) {
+    return true;
+  }
+  if (current_pool == this) {
+    // Blocking a worker could deadlock the pool.
+    return false;
+  }
+  // Waiting for the queue to drain to half the high-water mark means workers
+  // signal once per many tasks rather than after every task. Pairs with the
+  // pending_ decrement in Worker(), like sleepers_ does for submissions.
+  std::unique_lock<std::mutex> lock(space_mutex_);
+  blocked_submitters_.fetch_add(1);
+  space_condition_.wait(lock, [this] {
+    return pending_.load() <= resume_pending_ || stop_.load();
+  });
+  blocked_submitters_.fetch_sub(1);
+  return true;
+}
+
+void* ThreadPool::AllocateTask() {
+  if (current_pool == this) {
+    std::vector<void*>& spare = queues_[current_index]->spare_tasks;
+    if (spare.empty()) {
+      std::lock_guard<std::mutex> lock(spare_tasks_mutex_);
+      const std::size_t count =
+          std::min(spare_tasks_.size(), kSpareTaskGroup);
+      spare.insert(spare.end(), spare_tasks_.end() - count,
+                   spare_tasks_.end());
+      spare_tasks_.resize(spare_tasks_.size() - count);
+    }
+    if (!spare.empty()) {
+      void* node = spare.back();
+      spare.pop_back();
+      return node;
+    }
+  } else {
+    std::lock_guard<std::mutex> lock(spare_tasks_mutex_);
+    if (!spare_tasks_.empty()) {
+      void* node = spare_tasks_.back();
+      spare_tasks_.pop_back();
+      return node;
+    }
+  }
+  return ::operator new(sizeof(Task));
+}
+
+void ThreadPool::ReleaseTaskNode(void* node) {
+  if (current_pool == this) {
+    // Workers that run more tasks than they submit, e.g. for a producer
+    // outside the pool, hand their surplus on.
+    std::vector<void*>& spare = queues_[current_index]->spare_tasks;
+    if (spare.size() == 2 * kSpareTaskGroup) {
+      std::lock_guard<std::mutex> lock(spare_tasks_mutex_);
+      spare_tasks_.insert(spare_tasks_.end(), spare.end() - kSpareTaskGroup,
+                          spare.end());
+      spare.resize(kSpareTaskGroup);
+    }
+    spare.push_back(node);
+    return;
+  }
+  std::lock_guard<std::mutex> lock(spare_tasks_mutex_);
+  spare_tasks_.push_back(node);
+}
+
+void ThreadPool::Push(Task* task) {
+  // Counting the task before publishing it keeps pending_ from underflowing
+  // when a worker takes the task right away. It also pairs with the
+  // sleepers_ increment in Worker(): either the worker sees the task before
+  // sleeping, or this thread sees the sleeper below.
+  const std::size_t depth = pending_.fetch_add(1) + 1;
+  std::size_t peak = peak_pending_.load(std::memory_order_relaxed);
+  while (depth > peak && !peak_pending_.compare_exchange_weak(
+                             peak, depth, std::memory_order_relaxed)) {
+  }
+  if (current_pool == this) {
+    queues_[current_index]->deque.Push(task);
+  } else {
+    WorkerQueue& queue =
+        *queues_[next_inbox_.fetch_add(1, std::memory_order_relaxed) %
+                 queues_.size()];
+    std::lock_guard<std::mutex> lock(queue.inbox_mutex);
+    queue.inbox.push_back(task);
+  }
+
+  if (sleepers_.load() > 0) {
+    std::lock_guard<std::mutex> lock(idle_mutex_);
+    idle_condition_.notify_one();
+  }
+}
+
+Task* ThreadPool::TakeFromInbox(WorkerQueue& queue, bool keep_rest) {
+  std::lock_guard<std::mutex> lock(queue.inbox_mutex);
+  if (queue.inbox.empty()) {
+    return nullptr;
+  }
+  Task* task = queue.inbox.front();
+  queue.inbox.pop_front();
+  if (keep_rest) {
+    // Move the rest into the owner's deque, where other workers can steal
+    // them without taking this lock.
+    while (!queue.inbox.empty()) {
+      queue.deque.Push(queue.inbox.front());
+      queue.inbox.pop_front();
+    }
+  }
+  return task;
+}
+
+Task* ThreadPool::FindTask(std::size_t index) {
+  WorkerQueue& own = *queues_[index];
+  if (Task* task = own.deque.Pop()) {
+    return task;
+  }
+  if (Task* task = TakeFromInbox(own, true)) {
+    return task;
+  }
+  for (std::size_t offset = 1; offset < queues_.size(); ++offset) {
+    WorkerQueue& victim = *queues_[(index + offset) % queues_.size()];
+    if (Task* task = victim.deque.Steal()) {
+      return task;
+    }
+    if (Task* task = TakeFromInbox(victim, false)) {
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+void ThreadPool::WaitIdle() {
+  std::unique_lock<std::mutex> lock(drained_mutex_);
+  drained_condition_.wait(lock, [this] {
+    return pending_.load() == 0 && active_.load() == 0;
+  });
+}
+
+void ThreadPool::Worker(std::size_t index) {
+  current_pool = this;
+  current_index = index;
+
   for (;;) {
-    std::function<void()> task;
-    {
-      std::unique_lock<std::mutex> lock(queue_mutex_);
-      condition_.wait(lock, [this] { return stop_.load() || !tasks_.empty(); });
-      if (stop_.load() && tasks_.empty()) {
-        return;
+    if (Task* task = FindTask(index)) {
+      // Counted as running before it stops counting as pending, so the pool
+      // never looks idle in between.
+      active_.fetch_add(1);
+      const std::size_t depth = pending_.fetch_sub(1) - 1;
+      if (depth == resume_pending_ && blocked_submitters_.load() > 0) {
+        std::lock_guard<std::mutex> lock(space_mutex_);
+        space_condition_.notify_all();
+      }
+      (*task)();
+      task->~Task();
+      ReleaseTaskNode(task);
+      if (active_.fetch_sub(1) == 1 && pending_.load() == 0) {
+        std::lock_guard<std::mutex> lock(drained_mutex_);
+        drained_condition_.notify_all();
       }
-      task = std::move(tasks_.front());
-      tasks_.pop();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(idle_mutex_);
+    sleepers_.fetch_add(1);
+    idle_condition_.wait(
+        lock, [this] { return pending_.load() > 0 || stop_.load(); });
+    sleepers_.fetch_sub(1);
+    if (stop_.load() && pending_.load() == 0) {
+      return;
     }
-    task();
   }
 }
 
-}  // namespace scanner
\ No newline at end of file
+}  // namespace scanner
@@ -4,14 +4,21 @@
 #include <condition_variable>
 
 #include <atomic>
+#include <deque>
 #include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <new>
+#include <stdexcept>
 #include <thread>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "src/scanner_lib/task.h"
+#include "src/scanner_lib/work_stealing_deque.h"
+
 namespace scanner {
 
 /**
@@ -22,6 +29,16 @@ namespace scanner {
  * tasks to be enqueued for execution. It provides a graceful shutdown mechanism
  * that can be initiated manually via Stop() or automatically in the destructor.
  * Once stopped, no new tasks can be enqueued.
+ *
+ * Each worker owns a lock-free work-stealing deque. Tasks submitted from a
+ * worker go to its own deque; tasks submitted from other threads are spread
+ * round-robin over per-worker inboxes. Idle workers steal from the others, so
+ * there is no single queue lock for all threads to contend on.
+ *
+ * The number of queued tasks can be bounded to keep memory flat when tasks
+ * are produced faster than they run. Once the high-water mark is reached,
+ * submitting threads outside the pool block until workers catch up, while
+ * workers run their own submissions inline.
  */
 class ThreadPool {
 public:
@@ -29,8 +46,11 @@ public:
    * @brief Constructs a thread pool with a specified number of threads.
    * @param num_threads The number of worker threads to create. If 0, it
    * defaults to the number of hardware concurrency units, with a minimum of 1.
+   * @param max_queued_tasks The high-water mark of tasks waiting to run; 0
+   * means unbounded.
    */
-  explicit ThreadPool(std::size_t num_threads = 0);
+  explicit ThreadPool(std::size_t num_threads = 0,
+                      std::size_t max_queued_tasks = 0);
 
   /**
    * @brief Destructor. Initiates a graceful shutdown and joins all threads.
@@ -70,15 +90,95 @@ public:
   auto Enqueue(F&& f, Args&&... args)
       -> std::future<std::invoke_result_t<F, Args...>>;
 
-private:
-  void Worker();
+  /**
+   * @brief Submits a fire-and-forget task.
+   *
+   * Cheaper than Enqueue: no future or shared state is created, and small
+   * callables are stored inline in the task. This method is thread-safe.
+   *
+   * If the queue is at its high-water mark, the call blocks until a task is
+   * taken, or runs f inline when called from a worker of this pool.
+   *
+   * @param f The callable to run; it must not throw.
+   * @throws std::runtime_error if the pool has been stopped.
+   */
+  template <class F>
+  void Submit(F&& f);
 
-  std::vector<std::thread> workers_;
-  std::queue<std::function<void()>> tasks_;
+  /**
+   * @brief Blocks until no task is queued or running.
+   *
+   * Unlike the destructor, this leaves the pool running, which lets tasks
+   * that submit further tasks (e.g., a directory walk) be waited for as a
+   * whole. Must not be called from a worker of this pool.
+   */
+  void WaitIdle();
 
-  std::mutex queue_mutex_;
-  std::condition_variable condition_;
+  /** @brief Returns the number of worker threads. */
+  std::size_t Size() const {
+    return workers_.size();
+  }
+
+  /** @brief Returns the largest number of tasks that were waiting to run. */
+  std::size_t PeakQueuedTasks() const {
+    return peak_pending_.load(std::memory_order_relaxed);
+  }
+
+private:
+  // Task nodes move between the workers and the shared spares in groups of
+  // this many, so that the spares' lock is taken once per group.
+  static constexpr std::size_t kSpareTaskGroup = 64;
+
+  // A worker's queues: the deque for tasks it submits itself and the inbox
+  // for tasks submitted from other threads. Its spare task nodes are
+  // touched by the worker only.
+  struct WorkerQueue {
+    WorkStealingDeque<Task> deque;
+    std::mutex inbox_mutex;
+    std::deque<Task*> inbox;
+    std::vector<void*> spare_tasks;
+  };
+
+  // Blocks while the queue is full. Returns false instead if the caller is a
+  // worker of this pool, which must then run its task inline.
+  bool WaitForSpace();
+  // Returns the memory for a task, reusing the node of a finished one once
+  // the pool has warmed up.
+  void* AllocateTask();
+  // Keeps the node of a destroyed task for AllocateTask().
+  void ReleaseTaskNode(void* node);
+  void Push(Task* task);
+  Task* FindTask(std::size_t index);
+  Task* TakeFromInbox(WorkerQueue& queue, bool keep_rest);
+  void Worker(std::size_t index);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  // Task nodes beyond those the workers keep, and all nodes released by
+  // threads outside the pool.
+  std::mutex spare_tasks_mutex_;
+  std::vector<void*> spare_tasks_;
+  std::vector<std::thread> workers_;
+  std::atomic<std::size_t> next_inbox_{0};
+
+  // Tasks submitted but not yet taken by a worker.
+  std::atomic<std::size_t> pending_{0};
+  std::atomic<std::size_t> peak_pending_{0};
+  std::atomic<std::size_t> sleepers_{0};
+  std::mutex idle_mutex_;
+  std::condition_variable idle_condition_;
   std::atomic<bool> stop_{false};
+
+  // Tasks taken by a worker and still running.
+  std::atomic<std::size_t> active_{0};
+  std::mutex drained_mutex_;
+  std::condition_variable drained_condition_;
+
+  const std::size_t max_pending_;
+  // Blocked submitters resume once the queue drains to this depth.
+  const std::size_t resume_pending_;
+  std::atomic<std::size_t> blocked_submitters_{0};
+  std::mutex space_mutex_;
+  std::condition_variable space_condition_;
 };
 
 template <class F, class... Args>
@@ -86,24 +186,34 @@ auto ThreadPool::Enqueue(F&& f, Args&&... args)
     -> std::future<std::invoke_result_t<F, Args...>> {
   using return_type = std::invoke_result_t<F, Args...>;
 
-  auto task = std::make_shared<std::packaged_task<return_type()>>(
+  std::packaged_task<return_type()> task(
       std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+  std::future<return_type> res = task.get_future();
+  Submit(std::move(task));
+  return res;
+}
 
-  std::future<return_type> res = task->get_future();
-  {
-    std::unique_lock<std::mutex> lock(queue_mutex_);
-
-    // Don't allow enqueueing after stopping.
-    if (stop_.load()) {
-      throw std::runtime_error("Enqueue on stopped ThreadPool");
-    }
-
-    tasks_.emplace([task]() { (*task)(); });
+template <class F>
+void ThreadPool::Submit(F&& f) {
+  // Don't allow enqueueing after stopping.
+  if (stop_.load()) {
+    throw std::runtime_error("Enqueue on stopped ThreadPool");
   }
-  condition_.notify_one();
-  return res;
+  if (max_pending_ != 0 && !WaitForSpace()) {
+    f();
+    return;
+  }
+  void* node = AllocateTask();
+  Task* task;
+  try {
+    task = ::new (node) Task(std::forward<F>(f));
+  } catch (...) {
+    ReleaseTaskNode(node);
+    throw;
+  }
+  Push(task);
 }
 
 }  // namespace scanner
 
-#endif  // SRC_SCANNER_LIB_THREAD_POOL_H_
\ No newline at end of file
+#endif  // SRC_SCANNER_LIB_THREAD_POOL_H_
@@ -0,0 +1,157 @@
+#ifndef SRC_SCANNER_LIB_WORK_STEALING_DEQUE_H_
+#define SRC_SCANNER_LIB_WORK_STEALING_DEQUE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace scanner {
+
+/**
+ * @class WorkStealingDeque
+ * @brief A lock-free Chase-Lev work-stealing deque of pointers.
+ *
+ * The owning thread pushes and pops at the bottom without contention; other
+ * threads steal from the top. The buffer grows on demand and retired buffers
+ * are kept until destruction, so that concurrent thieves never read freed
+ * memory. Follows "Correct and Efficient Work-Stealing for Weak Memory
+ * Models" (Le et al., PPoPP 2013). This class is an internal, non-exported
+ * component of the scanner library.
+ *
+ * @tparam T The pointee type; the deque stores T* and never owns it.
+ */
+template <class T>
+class WorkStealingDeque {
+public:
+  /**
+   * @brief Constructs an empty deque.
+   * @param capacity The initial capacity; rounded up to a power of two.
+   */
+  explicit WorkStealingDeque(std::size_t capacity = 256) {
+    std::size_t rounded = 1;
+    while (rounded < capacity) {
+      rounded <<= 1;
+    }
+    buffers_.push_back(std::make_unique<Buffer>(rounded));
+    buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+  }
+
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+  /** @brief Pushes an item at the bottom. Owner thread only. */
+  void Push(T* item) {
+    const std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    const std::int64_t top = top_.load(std::memory_order_acquire);
+    Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+    if (bottom - top > static_cast<std::int64_t>(buffer->mask)) {
+      buffer = Grow(buffer, top, bottom);
+    }
+    buffer->Put(bottom, item);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Pops the most recently pushed item. Owner thread only.
+   * @return The item, or nullptr if the deque is empty.
+   */
+  T* Pop() {
+    const std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t top = top_.load(std::memory_order_relaxed);
+
+    if (top > bottom) {  // Empty.
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    T* item = buffer->Get(bottom);
+    if (top == bottom) {
+      // Last item: race against thieves for it.
+      if (!top_.compare_exchange_strong(top, top + 1,
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        item = nullptr;
+      }
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return item;
+  }
+
+  /**
+   * @brief Steals the least recently pushed item. Any thread.
+   * @return The item, or nullptr if the deque is empty or the steal lost a
+   * race with another thread.
+   */
+  T* Steal() {
+    std::int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) {
+      return nullptr;
+    }
+    Buffer* buffer = buffer_.load(std::memory_order_acquire);
+    T* item = buffer->Get(top);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return item;
+  }
+
+  /** @brief Returns an estimate of the number of items. Any thread. */
+  std::size_t SizeEstimate() const {
+    const std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    const std::int64_t top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+  }
+
+private:
+  struct Buffer {
+    explicit Buffer(std::size_t capacity)
+        : mask(capacity - 1),
+          slots(std::make_unique<std::atomic<T*>[]>(capacity)) {
+    }
+
+    T* Get(std::int64_t index) const {
+      return slots[static_cast<std::size_t>(index) & mask].load(
+          std::memory_order_relaxed);
+    }
+
+    void Put(std::int64_t index, T* item) {
+      slots[static_cast<std::size_t>(index) & mask].store(
+          item, std::memory_order_relaxed);
+    }
+
+    std::size_t mask;
+    std::unique_ptr<std::atomic<T*>[]> slots;
+  };
+
+  Buffer* Grow(Buffer* old_buffer, std::int64_t top, std::int64_t bottom) {
+    auto new_buffer = std::make_unique<Buffer>(2 * (old_buffer->mask + 1));
+    for (std::int64_t i = top; i < bottom; ++i) {
+      new_buffer->Put(i, old_buffer->Get(i));
+    }
+    Buffer* raw = new_buffer.get();
+    buffers_.push_back(std::move(new_buffer));
+    buffer_.store(raw, std::memory_order_release);
+    return raw;
+  }
+
+  // Top and bottom are written by different threads, so they live on
+  // separate cache lines.
+  alignas(64) std::atomic<std::int64_t> top_{0};
+  alignas(64) std::atomic<std::int64_t> bottom_{0};
+  std::atomic<Buffer*> buffer_{nullptr};
+  // Every buffer ever used; only the owner appends to it.
+  std::vector<std::unique_ptr<Buffer>> buffers_;
+};
+
+}  // namespace scanner
+
+#endif  // SRC_SCANNER_LIB_WORK_STEALING_DEQUE_H_
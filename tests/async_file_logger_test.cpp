@@ -0,0 +1,152 @@
+#include "src/scanner_lib/async_file_logger.h"
+
+#include <chrono>
+#include <cstdint>
+
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace scanner {
+namespace {
+
+constexpr char kHash1[] = "5eb63bbbe01eeed093cb22bb8f5acdc3";
+
+class AsyncFileLoggerTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    const std::string test_name =
+        ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    temp_dir_ = std::filesystem::temp_directory_path() /
+                ("scanner_async_log_tests_" + test_name);
+    std::filesystem::create_directory(temp_dir_);
+    log_path_ = temp_dir_ / "detections.log";
+  }
+
+  void TearDown() override {
+    std::error_code ec;
+    std::filesystem::remove_all(temp_dir_, ec);
+    (void)ec;
+  }
+
+  std::vector<std::string> ReadLines() const {
+    std::ifstream log_file(log_path_);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(log_file, line)) {
+      lines.push_back(line);
+    }
+    return lines;
+  }
+
+  std::filesystem::path temp_dir_;
+  std::filesystem::path log_path_;
+};
+
+TEST_F(AsyncFileLoggerTest, LogsSingleEntryCorrectly) {
+  {
+    AsyncFileLogger logger(log_path_);
+    logger.LogDetection(R"(c:\temp\file.txt)", *Md5Digest::FromHex(kHash1),
+                        "Verdict1");
+  }
+
+  const std::vector<std::string> lines = ReadLines();
+  ASSERT_EQ(lines.size(), 1);
+  EXPECT_EQ(
+      lines[0],
+      R"({"path": "c:\\temp\\file.txt", "hash": "5eb63bbbe01eeed093cb22bb8f5acdc3", "verdict": "Verdict1"})");
+}
+
+TEST_F(AsyncFileLoggerTest, ThrowsOnNonExistentDirectory) {
+  EXPECT_THROW(AsyncFileLogger logger(temp_dir_ / "missing" / "test.log"),
+               std::runtime_error);
+}
+
+TEST_F(AsyncFileLoggerTest, FlushMakesDetectionsVisible) {
+  // Neither threshold is reached, so only Flush() writes the batch.
+  AsyncFileLogger logger(log_path_, AsyncFileLogger::kDefaultCapacity,
+                         AsyncFileLogger::kDefaultFlushBytes,
+                         std::chrono::hours(1));
+  logger.LogDetection("first", Md5Digest{}, "Verdict");
+  logger.Flush();
+  EXPECT_EQ(ReadLines().size(), 1);
+
+  logger.LogDetection("second", Md5Digest{}, "Verdict");
+  logger.LogDetection("third", Md5Digest{}, "Verdict");
+  logger.Flush();
+  EXPECT_EQ(ReadLines().size(), 3);
+}
+
+TEST_F(AsyncFileLoggerTest, WritesPendingBatchAfterFlushInterval) {
+  AsyncFileLogger logger(log_path_, AsyncFileLogger::kDefaultCapacity,
+                         AsyncFileLogger::kDefaultFlushBytes,
+                         std::chrono::milliseconds(10));
+  // The ring is far from full and nobody flushes after the late line, so
+  // only the interval gets it written.
+  logger.LogDetection("file", Md5Digest{}, "Verdict");
+  logger.Flush();
+  logger.LogDetection("late", Md5Digest{}, "Verdict");
+
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (ReadLines().size() < 2 &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  EXPECT_EQ(ReadLines().size(), 2);
+}
+
+TEST_F(AsyncFileLoggerTest, HandlesConcurrentWritesWithBackpressure) {
+  constexpr int kNumThreads = 8;
+  constexpr int kLogsPerThread = 500;
+
+  {
+    // A tiny ring and batch make producers wait for the writer constantly.
+    AsyncFileLogger logger(log_path_, 4, 256, std::chrono::milliseconds(1));
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kNumThreads; ++i) {
+      threads.emplace_back([&logger, i] {
+        for (int j = 0; j < kLogsPerThread; ++j) {
+          Md5Digest hash;
+          hash.bytes[0] = static_cast<std::uint8_t>(j);
+          logger.LogDetection(
+              "file_" + std::to_string(i) + "_" + std::to_string(j), hash,
+              "Verdict" + std::to_string(i));
+        }
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+
+  const std::vector<std::string> lines = ReadLines();
+  ASSERT_EQ(lines.size(), kNumThreads * kLogsPerThread);
+  std::set<std::string> unique_paths;
+  for (const std::string& line : lines) {
+    ASSERT_EQ(line.front(), '{');
+    ASSERT_EQ(line.back(), '}');
+    unique_paths.insert(line.substr(0, line.find(',')));
+  }
+  EXPECT_EQ(unique_paths.size(), lines.size());
+}
+
+TEST_F(AsyncFileLoggerTest, AppendsToExistingLog) {
+  std::ofstream(log_path_) << "previous\n";
+  {
+    AsyncFileLogger logger(log_path_);
+    logger.LogDetection("file", Md5Digest{}, "Verdict");
+  }
+  const std::vector<std::string> lines = ReadLines();
+  ASSERT_EQ(lines.size(), 2);
+  EXPECT_EQ(lines[0], "previous");
+}
+
+}  // namespace
+}  // namespace scanner
@@ -0,0 +1,67 @@
+#include "src/scanner_lib/blocked_bloom_filter.h"
+
+#include <cstdint>
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace scanner {
+namespace {
+
+Md5Digest MakeDigest(std::uint32_t seed) {
+  Md5Digest digest;
+  std::uint32_t state = seed * 2654435761U + 1;
+  for (auto& byte : digest.bytes) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    byte = static_cast<std::uint8_t>(state);
+  }
+  return digest;
+}
+
+TEST(BlockedBloomFilterTest, HasNoFalseNegatives) {
+  constexpr std::uint32_t kNumKeys = 10000;
+  BlockedBloomFilter filter(kNumKeys, 10);
+  for (std::uint32_t i = 0; i < kNumKeys; ++i) {
+    filter.Add(MakeDigest(i));
+  }
+  for (std::uint32_t i = 0; i < kNumKeys; ++i) {
+    EXPECT_TRUE(filter.MayContain(MakeDigest(i))) << "key " << i;
+  }
+}
+
+TEST(BlockedBloomFilterTest, RejectsMostAbsentKeys) {
+  constexpr std::uint32_t kNumKeys = 10000;
+  BlockedBloomFilter filter(kNumKeys, 10);
+  for (std::uint32_t i = 0; i < kNumKeys; ++i) {
+    filter.Add(MakeDigest(i));
+  }
+
+  std::uint32_t false_positives = 0;
+  for (std::uint32_t i = kNumKeys; i < 2 * kNumKeys; ++i) {
+    if (filter.MayContain(MakeDigest(i))) {
+      false_positives++;
+    }
+  }
+  // Ten bits per key should stay well under a 5% false-positive rate.
+  EXPECT_LT(false_positives, kNumKeys / 20);
+  EXPECT_LT(filter.EstimateFalsePositiveRate(), 0.05);
+  EXPECT_GT(filter.EstimateFalsePositiveRate(), 0.0);
+}
+
+TEST(BlockedBloomFilterTest, EmptyFilterRejectsEverything) {
+  BlockedBloomFilter filter(0, 10);
+  EXPECT_FALSE(filter.MayContain(MakeDigest(1)));
+  EXPECT_EQ(filter.EstimateFalsePositiveRate(), 0.0);
+}
+
+TEST(BlockedBloomFilterTest, ReportsMemoryInWholeCacheLines) {
+  BlockedBloomFilter filter(1000, 8);
+  EXPECT_EQ(filter.MemoryBytes() % 64, 0);
+  EXPECT_GE(filter.MemoryBytes(), 1000 * 8 / 8);
+}
+
+}  // namespace
+}  // namespace scanner
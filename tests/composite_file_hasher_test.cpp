@@ -0,0 +1,108 @@
+#include "src/scanner_lib/composite_file_hasher.h"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/scanner_lib/md5_file_hasher.h"
+
+namespace scanner {
+namespace {
+
+const std::vector<HashAlgorithm> kAllAlgorithms = {
+    HashAlgorithm::kMd5, HashAlgorithm::kSha1, HashAlgorithm::kSha256};
+
+class CompositeFileHasherTest : public ::testing::Test {
+protected:
+  static void SetUpTestSuite() {
+    temp_dir_ =
+        std::filesystem::temp_directory_path() / "scanner_composite_tests";
+    std::filesystem::create_directory(temp_dir_);
+
+    known_content_path_ = temp_dir_ / "known_content.txt";
+    std::ofstream(known_content_path_) << "hello world";
+  }
+
+  static void TearDownTestSuite() {
+    std::error_code ec;
+    std::filesystem::remove_all(temp_dir_, ec);
+    (void)ec;
+  }
+
+  static std::filesystem::path temp_dir_;
+  static std::filesystem::path known_content_path_;
+};
+
+std::filesystem::path CompositeFileHasherTest::temp_dir_;
+std::filesystem::path CompositeFileHasherTest::known_content_path_;
+
+TEST_F(CompositeFileHasherTest, ComputesEveryConfiguredDigest) {
+  CompositeFileHasher hasher(kAllAlgorithms);
+  FileHashResult result;
+  hasher.HashFileDigests(known_content_path_, result);
+
+  ASSERT_TRUE(result.md5);
+  EXPECT_EQ(result.md5->ToHex(), "5eb63bbbe01eeed093cb22bb8f5acdc3");
+  ASSERT_TRUE(result.sha1);
+  EXPECT_EQ(result.sha1->ToHex(), "2aae6c35c94fcfb415dbe95f408b9ce91ee846ed");
+  ASSERT_TRUE(result.sha256);
+  EXPECT_EQ(result.sha256->ToHex(),
+            "b94d27b9934d3e08a52e52d7da7dabfac484efe37a5380ee9088f7ace2efcde9");
+}
+
+TEST_F(CompositeFileHasherTest, LeavesUnconfiguredDigestsUnset) {
+  CompositeFileHasher hasher({HashAlgorithm::kSha256});
+  FileHashResult result;
+  result.sha1 = Sha1Digest{};
+  hasher.HashFileDigests(known_content_path_, result);
+
+  EXPECT_FALSE(result.sha1);
+  EXPECT_TRUE(result.sha256);
+  EXPECT_EQ(hasher.HashFile(known_content_path_), result.md5);
+}
+
+TEST_F(CompositeFileHasherTest, ThrowsOnNonExistentFile) {
+  CompositeFileHasher hasher(kAllAlgorithms);
+  FileHashResult result;
+  EXPECT_THROW(
+      hasher.HashFileDigests(temp_dir_ / "non_existent.txt", result),
+      std::runtime_error);
+}
+
+TEST_F(CompositeFileHasherTest, HashFilesMatchesHashFileDigests) {
+  // Sizes straddle the padding boundaries and the batching size limit.
+  const std::vector<std::size_t> sizes = {0,  1,   55,   56,    63,
+                                          64, 65,  500,  4096,  70000,
+                                          200000, 3};
+  std::vector<std::filesystem::path> paths;
+  for (std::size_t i = 0; i < sizes.size(); ++i) {
+    paths.push_back(temp_dir_ / ("batch_" + std::to_string(i) + ".bin"));
+    std::ofstream file(paths.back(), std::ios::binary);
+    for (std::size_t j = 0; j < sizes[i]; ++j) {
+      file.put(static_cast<char>((i * 31 + j * 7) & 0xFF));
+    }
+  }
+  paths.push_back(temp_dir_ / "non_existent.bin");
+
+  CompositeFileHasher hasher(kAllAlgorithms);
+  Md5FileHasher md5_hasher;
+  std::vector<FileHashResult> results;
+  hasher.HashFiles(paths, results);
+
+  ASSERT_EQ(results.size(), paths.size());
+  for (std::size_t i = 0; i + 1 < paths.size(); ++i) {
+    ASSERT_FALSE(results[i].error) << paths[i];
+    FileHashResult expected;
+    hasher.HashFileDigests(paths[i], expected);
+    EXPECT_EQ(results[i].md5, md5_hasher.HashFile(paths[i])) << paths[i];
+    EXPECT_EQ(results[i].sha1, expected.sha1) << paths[i];
+    EXPECT_EQ(results[i].sha256, expected.sha256) << paths[i];
+  }
+  EXPECT_TRUE(results.back().error);
+}
+
+}  // namespace
+}  // namespace scanner
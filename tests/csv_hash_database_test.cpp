@@ -11,6 +11,16 @@
 namespace scanner {
 namespace {
 
+constexpr char kHashA[] = "0cc175b9c0f1b6a831c399e269772661";
+constexpr char kHashB[] = "92eb5ffee6ae2fec3ad71c777531578f";
+constexpr char kHashC[] = "4a8a08f09d37b73795649038408b5f33";
+constexpr char kHashD[] = "8277e0910d750195b448797616e091ad";
+constexpr char kHashE[] = "e1671797c52e15f763380b45e841ec32";
+
+Md5Digest Digest(const char* hex) {
+  return *Md5Digest::FromHex(hex);
+}
+
 class CsvHashDatabaseTest : public ::testing::Test {
 protected:
   void SetUp() override {
@@ -40,59 +50,186 @@ protected:
 };
 
 TEST_F(CsvHashDatabaseTest, LoadsValidFile) {
-  const std::string content =
-      "a;Verdict1\n"
-      "b;Verdict2\n"
-      "c;Verdict3";
+  const std::string content = std::string(kHashA) + ";Verdict1\n" + kHashB +
+                              ";Verdict2\n" + kHashC + ";Verdict3";
   const auto db_path = CreateDbFile("valid.csv", content);
 
   CsvHashDatabase db;
   EXPECT_EQ(db.Load(db_path), 3);
 
-  EXPECT_EQ(db.FindHash("a").value_or(""), "Verdict1");
-  EXPECT_EQ(db.FindHash("b").value_or(""), "Verdict2");
-  EXPECT_EQ(db.FindHash("c").value_or(""), "Verdict3");
-  EXPECT_FALSE(db.FindHash("d").has_value());
+  EXPECT_EQ(db.FindHash(Digest(kHashA)).value_or(""), "Verdict1");
+  EXPECT_EQ(db.FindHash(Digest(kHashB)).value_or(""), "Verdict2");
+  EXPECT_EQ(db.FindHash(Digest(kHashC)).value_or(""), "Verdict3");
+  EXPECT_FALSE(db.FindHash(Digest(kHashD)).has_value());
+}
+
+TEST_F(CsvHashDatabaseTest, MatchesUppercaseHashes) {
+  const auto db_path =
+      CreateDbFile("upper.csv", "0CC175B9C0F1B6A831C399E269772661;Verdict1");
+
+  CsvHashDatabase db;
+  EXPECT_EQ(db.Load(db_path), 1);
+  EXPECT_EQ(db.FindHash(Digest(kHashA)).value_or(""), "Verdict1");
 }
 
 TEST_F(CsvHashDatabaseTest, HandlesEmptyFile) {
   const auto db_path = CreateDbFile("empty.csv", "");
   CsvHashDatabase db;
   EXPECT_EQ(db.Load(db_path), 0);
-  EXPECT_FALSE(db.FindHash("a").has_value());
+  EXPECT_FALSE(db.FindHash(Digest(kHashA)).has_value());
 }
 
 TEST_F(CsvHashDatabaseTest, ClearsPreviousDataOnLoad) {
-  const auto db_path1 = CreateDbFile("db1.csv", "a;VerdictA");
+  const auto db_path1 =
+      CreateDbFile("db1.csv", std::string(kHashA) + ";VerdictA");
   CsvHashDatabase db;
   db.Load(db_path1);
-  ASSERT_TRUE(db.FindHash("a").has_value());
+  ASSERT_TRUE(db.FindHash(Digest(kHashA)).has_value());
 
-  const auto db_path2 = CreateDbFile("db2.csv", "b;VerdictB");
+  const auto db_path2 =
+      CreateDbFile("db2.csv", std::string(kHashB) + ";VerdictB");
   EXPECT_EQ(db.Load(db_path2), 1);
-  EXPECT_FALSE(db.FindHash("a").has_value());
-  EXPECT_TRUE(db.FindHash("b").has_value());
+  EXPECT_FALSE(db.FindHash(Digest(kHashA)).has_value());
+  EXPECT_TRUE(db.FindHash(Digest(kHashB)).has_value());
 }
 
 TEST_F(CsvHashDatabaseTest, SkipsMalformedLines) {
   const std::string content =
-      "a;Verdict1\n"        // Valid
-      "\n"                  // Blank
-      "b;\n"                // Malformed (empty verdict)
-      ";Verdict2\n"         // Malformed (empty hash)
-      "c;Verdict3;Extra\n"  // Malformed (too many parts)
-      "d\n"                 // Malformed (too few parts)
-      "e;Verdict5";         // Valid
+      std::string(kHashA) + ";Verdict1\n" +  // Valid
+      "\n" +                                 // Blank
+      kHashB + ";\n" +                       // Malformed (empty verdict)
+      ";Verdict2\n" +                        // Malformed (empty hash)
+      kHashC + ";Verdict3;Extra\n" +         // Malformed (invalid size)
+      kHashD + "\n" +                        // Malformed (too few parts)
+      "not-a-hash;Verdict4\n" +              // Malformed (invalid hash)
+      kHashE + ";Verdict5";                  // Valid
   const auto db_path = CreateDbFile("malformed.csv", content);
 
   CsvHashDatabase db;
   EXPECT_EQ(db.Load(db_path), 2);
 
-  EXPECT_TRUE(db.FindHash("a").has_value());
-  EXPECT_FALSE(db.FindHash("b").has_value());
-  EXPECT_FALSE(db.FindHash("c").has_value());
-  EXPECT_FALSE(db.FindHash("d").has_value());
-  EXPECT_TRUE(db.FindHash("e").has_value());
+  EXPECT_TRUE(db.FindHash(Digest(kHashA)).has_value());
+  EXPECT_FALSE(db.FindHash(Digest(kHashB)).has_value());
+  EXPECT_FALSE(db.FindHash(Digest(kHashC)).has_value());
+  EXPECT_FALSE(db.FindHash(Digest(kHashD)).has_value());
+  EXPECT_TRUE(db.FindHash(Digest(kHashE)).has_value());
+}
+
+TEST_F(CsvHashDatabaseTest, IgnoresEmptyTrailingFields) {
+  const std::string content =
+      std::string(kHashA) + ";Verdict1;\n" +  // Valid
+      kHashB + ";Verdict2;100;\n" +           // Valid
+      kHashC + ";Verdict3;;\n" +              // Valid
+      kHashD + ";;\n";                        // Malformed (empty verdict)
+  const auto db_path = CreateDbFile("trailing.csv", content);
+
+  CsvHashDatabase db;
+  EXPECT_EQ(db.Load(db_path), 3);
+
+  EXPECT_EQ(db.FindHash(Digest(kHashA)).value_or(""), "Verdict1");
+  EXPECT_EQ(db.FindHash(Digest(kHashB)).value_or(""), "Verdict2");
+  EXPECT_EQ(db.FindHash(Digest(kHashC)).value_or(""), "Verdict3");
+  EXPECT_FALSE(db.FindHash(Digest(kHashD)).has_value());
+}
+
+TEST_F(CsvHashDatabaseTest, LoadsShaSignaturesByHashLength) {
+  const std::string sha1 = "2aae6c35c94fcfb415dbe95f408b9ce91ee846ed";
+  const std::string sha256 =
+      "b94d27b9934d3e08a52e52d7da7dabfac484efe37a5380ee9088f7ace2efcde9";
+  const std::string content = std::string(kHashA) + ";Verdict1\n" + sha1 +
+                              ";Verdict2\n" + sha256 + ";Verdict3";
+  const auto db_path = CreateDbFile("mixed.csv", content);
+
+  CsvHashDatabase db;
+  EXPECT_EQ(db.Load(db_path), 3);
+
+  EXPECT_EQ(db.FindHash(Digest(kHashA)).value_or(""), "Verdict1");
+  EXPECT_EQ(db.FindSha1(*Sha1Digest::FromHex(sha1)).value_or(""),
+            "Verdict2");
+  EXPECT_EQ(db.FindSha256(*Sha256Digest::FromHex(sha256)).value_or(""),
+            "Verdict3");
+  EXPECT_FALSE(db.FindSha1(Sha1Digest{}).has_value());
+  EXPECT_FALSE(db.FindSha256(Sha256Digest{}).has_value());
+}
+
+TEST_F(CsvHashDatabaseTest, SkipsLinesWithMalformedSampleFields) {
+  const std::string content =
+      std::string(kHashA) + ";Verdict1;10\n" +  // Valid
+      kHashB + ";Verdict2;-1\n" +               // Malformed (negative size)
+      kHashC + ";Verdict3;10;" + kHashA + "0\n" +  // Malformed (prefix)
+      kHashD + ";Verdict4;10;" + kHashA + ";x\n" +  // Too many parts
+      kHashE + ";Verdict5;;" + kHashA;              // Malformed (no size)
+  const auto db_path = CreateDbFile("malformed_samples.csv", content);
+
+  CsvHashDatabase db;
+  EXPECT_EQ(db.Load(db_path), 1);
+  EXPECT_TRUE(db.FindHash(Digest(kHashA)).has_value());
+}
+
+TEST_F(CsvHashDatabaseTest, IndexesSampleSizesAndPrefixes) {
+  const std::string content =
+      std::string(kHashA) + ";Verdict1;100\n" +  // Too small for a prefix
+      kHashB + ";Verdict2;5000;" + kHashD + "\n" + kHashC +
+      ";Verdict3;100000;" + kHashE;
+  const auto db_path = CreateDbFile("samples.csv", content);
+
+  CsvHashDatabase db;
+  EXPECT_EQ(db.Load(db_path), 3);
+  EXPECT_EQ(db.FindHash(Digest(kHashB)).value_or(""), "Verdict2");
+
+  ASSERT_TRUE(db.HasSizeIndex());
+  EXPECT_TRUE(db.MayMatchSize(100));
+  EXPECT_TRUE(db.MayMatchSize(5000));
+  EXPECT_TRUE(db.MayMatchSize(100000));
+  EXPECT_FALSE(db.MayMatchSize(0));
+  EXPECT_FALSE(db.MayMatchSize(4999));
+
+  ASSERT_TRUE(db.HasPrefixIndex());
+  EXPECT_TRUE(db.MayMatchPrefix(Digest(kHashD)));
+  EXPECT_TRUE(db.MayMatchPrefix(Digest(kHashE)));
+  EXPECT_FALSE(db.MayMatchPrefix(Digest(kHashA)));
+}
+
+TEST_F(CsvHashDatabaseTest, IncompleteSampleIndexRulesNothingOut) {
+  const std::string content = std::string(kHashA) + ";Verdict1;100\n" +
+                              kHashB + ";Verdict2;5000\n" + kHashC +
+                              ";Verdict3";
+  const auto db_path = CreateDbFile("partial_samples.csv", content);
+
+  CsvHashDatabase db;
+  EXPECT_EQ(db.Load(db_path), 3);
+  EXPECT_FALSE(db.HasSizeIndex());
+  EXPECT_TRUE(db.MayMatchSize(4999));
+  // The 5000-byte sample has no prefix digest.
+  EXPECT_FALSE(db.HasPrefixIndex());
+  EXPECT_TRUE(db.MayMatchPrefix(Digest(kHashA)));
+}
+
+TEST_F(CsvHashDatabaseTest, PrefilterKeepsAllSignatures) {
+  const std::string content = std::string(kHashA) + ";Verdict1\n" + kHashB +
+                              ";Verdict2\n" + kHashC + ";Verdict3";
+  const auto db_path = CreateDbFile("prefiltered.csv", content);
+
+  CsvHashDatabase db(10);
+  EXPECT_EQ(db.Load(db_path), 3);
+
+  EXPECT_EQ(db.FindHash(Digest(kHashA)).value_or(""), "Verdict1");
+  EXPECT_EQ(db.FindHash(Digest(kHashB)).value_or(""), "Verdict2");
+  EXPECT_EQ(db.FindHash(Digest(kHashC)).value_or(""), "Verdict3");
+  EXPECT_FALSE(db.FindHash(Digest(kHashD)).has_value());
+
+  const auto stats = db.GetPrefilterStats();
+  ASSERT_TRUE(stats.has_value());
+  EXPECT_GT(stats->memory_bytes, 0);
+  EXPECT_LT(stats->false_positive_rate, 0.05);
+}
+
+TEST_F(CsvHashDatabaseTest, NoPrefilterStatsByDefault) {
+  const auto db_path =
+      CreateDbFile("plain.csv", std::string(kHashA) + ";Verdict1");
+  CsvHashDatabase db;
+  db.Load(db_path);
+  EXPECT_FALSE(db.GetPrefilterStats().has_value());
 }
 
 TEST_F(CsvHashDatabaseTest, ThrowsOnNonExistentFile) {
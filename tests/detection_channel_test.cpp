@@ -0,0 +1,163 @@
+#include "src/scanner_lib/detection_channel.h"
+
+#include <cstdint>
+
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace scanner {
+namespace {
+
+TEST(DetectionChannelTest, ReceivesDetectionsInOrderSent) {
+  DetectionChannel channel(8);
+  ASSERT_TRUE(channel.Send("a", Md5Digest{}, "Verdict1", 10));
+  ASSERT_TRUE(channel.Send("b", Sha256Digest{}, "Verdict2", 20));
+
+  std::vector<Detection> batch;
+  ASSERT_TRUE(channel.Receive(batch, 16));
+  ASSERT_EQ(batch.size(), 2);
+  EXPECT_EQ(batch[0].path, "a");
+  EXPECT_TRUE(std::holds_alternative<Md5Digest>(batch[0].digest));
+  EXPECT_EQ(batch[0].verdict, "Verdict1");
+  EXPECT_EQ(batch[0].size, 10);
+  EXPECT_EQ(batch[1].path, "b");
+  EXPECT_TRUE(std::holds_alternative<Sha256Digest>(batch[1].digest));
+  EXPECT_EQ(batch[1].verdict, "Verdict2");
+  EXPECT_EQ(batch[1].size, 20);
+}
+
+TEST(DetectionChannelTest, ReceivesAtMostMaxCount) {
+  DetectionChannel channel(8);
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(channel.Send(std::to_string(i), Md5Digest{}, "Verdict", 0));
+  }
+
+  std::vector<Detection> batch;
+  ASSERT_TRUE(channel.Receive(batch, 2));
+  EXPECT_EQ(batch.size(), 2);
+  ASSERT_TRUE(channel.Receive(batch, 2));
+  ASSERT_EQ(batch.size(), 1);
+  EXPECT_EQ(batch[0].path, "2");
+}
+
+TEST(DetectionChannelTest, ReceiveReturnsFalseOnceClosedAndDrained) {
+  DetectionChannel channel(8);
+  ASSERT_TRUE(channel.Send("a", Md5Digest{}, "Verdict", 0));
+  channel.Close();
+  EXPECT_FALSE(channel.Send("b", Md5Digest{}, "Verdict", 0));
+
+  std::vector<Detection> batch;
+  ASSERT_TRUE(channel.Receive(batch, 16));
+  ASSERT_EQ(batch.size(), 1);
+  EXPECT_EQ(batch[0].path, "a");
+  EXPECT_FALSE(channel.Receive(batch, 16));
+  EXPECT_TRUE(batch.empty());
+}
+
+TEST(DetectionChannelTest, CloseWakesWaitingConsumer) {
+  DetectionChannel channel(8);
+  std::thread consumer([&] {
+    std::vector<Detection> batch;
+    EXPECT_FALSE(channel.Receive(batch, 16));
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  channel.Close();
+  consumer.join();
+}
+
+TEST(DetectionChannelTest, DeliversEveryDetectionFromConcurrentSenders) {
+  constexpr int kThreads = 8;
+  constexpr int kPerThread = 2000;
+  // Far smaller than the number of detections, so senders block on it.
+  DetectionChannel channel(16);
+
+  std::set<std::string> received;
+  std::uint64_t total_size = 0;
+  std::thread consumer([&] {
+    std::vector<Detection> batch;
+    while (channel.Receive(batch, 64)) {
+      for (const Detection& detection : batch) {
+        received.insert(detection.path.string());
+        total_size += detection.size;
+      }
+    }
+  });
+
+  std::vector<std::thread> senders;
+  for (int t = 0; t < kThreads; ++t) {
+    senders.emplace_back([&channel, t] {
+      for (int i = 0; i < kPerThread; ++i) {
+        const std::string path = std::to_string(t) + "/" + std::to_string(i);
+        EXPECT_TRUE(channel.Send(path, Md5Digest{}, "Verdict", 1));
+      }
+    });
+  }
+  for (auto& sender : senders) {
+    sender.join();
+  }
+  channel.Close();
+  consumer.join();
+
+  EXPECT_EQ(received.size(), kThreads * kPerThread);
+  EXPECT_EQ(total_size, kThreads * kPerThread);
+}
+
+TEST(DetectionChannelTest, CloseWakesSendersBlockedOnFullChannel) {
+  DetectionChannel channel(2);
+  ASSERT_TRUE(channel.Send("a", Md5Digest{}, "Verdict", 0));
+  ASSERT_TRUE(channel.Send("b", Md5Digest{}, "Verdict", 0));
+  std::thread sender([&] {
+    EXPECT_FALSE(channel.Send("blocked", Md5Digest{}, "Verdict", 0));
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  channel.Close();
+  sender.join();
+}
+
+TEST(DetectionChannelTest, EverySuccessfulSendIsReceivedWhenRacingClose) {
+  constexpr int kThreads = 8;
+  for (int round = 0; round < 200; ++round) {
+    DetectionChannel channel(4);
+    std::atomic<int> sent{0};
+    int received = 0;
+    std::thread consumer([&] {
+      std::vector<Detection> batch;
+      while (channel.Receive(batch, 3)) {
+        received += static_cast<int>(batch.size());
+      }
+    });
+    std::vector<std::thread> senders;
+    for (int t = 0; t < kThreads; ++t) {
+      senders.emplace_back([&] {
+        while (channel.Send("a", Md5Digest{}, "Verdict", 0)) {
+          sent++;
+        }
+      });
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(10 * (round % 20)));
+    channel.Close();
+    for (auto& sender : senders) {
+      sender.join();
+    }
+    consumer.join();
+    ASSERT_EQ(received, sent.load()) << "round " << round;
+  }
+}
+
+TEST(DetectionChannelTest, FactoryCreatesWorkingChannel) {
+  const auto channel = CreateDetectionChannel(4);
+  ASSERT_NE(channel, nullptr);
+  ASSERT_TRUE(channel->Send("a", Md5Digest{}, "Verdict", 0));
+  std::vector<Detection> batch;
+  ASSERT_TRUE(channel->Receive(batch, 1));
+  EXPECT_EQ(batch[0].path, "a");
+}
+
+}  // namespace
+}  // namespace scanner
@@ -0,0 +1,124 @@
+#include "scanner/domain.h"
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+
+#include "gtest/gtest.h"
+
+namespace scanner {
+namespace {
+
+TEST(Md5DigestTest, RoundTripsThroughHex) {
+  const std::string hex = "5eb63bbbe01eeed093cb22bb8f5acdc3";
+  const auto digest = Md5Digest::FromHex(hex);
+  ASSERT_TRUE(digest.has_value());
+  EXPECT_EQ(digest->bytes[0], 0x5e);
+  EXPECT_EQ(digest->bytes[15], 0xc3);
+  EXPECT_EQ(digest->ToHex(), hex);
+}
+
+TEST(Md5DigestTest, ParsesUppercaseHex) {
+  const auto lower = Md5Digest::FromHex("5eb63bbbe01eeed093cb22bb8f5acdc3");
+  const auto upper = Md5Digest::FromHex("5EB63BBBE01EEED093CB22BB8F5ACDC3");
+  ASSERT_TRUE(lower.has_value());
+  ASSERT_TRUE(upper.has_value());
+  EXPECT_EQ(*lower, *upper);
+}
+
+TEST(Md5DigestTest, RejectsMalformedHex) {
+  EXPECT_FALSE(Md5Digest::FromHex("").has_value());
+  EXPECT_FALSE(
+      Md5Digest::FromHex("5eb63bbbe01eeed093cb22bb8f5acdc").has_value());
+  EXPECT_FALSE(
+      Md5Digest::FromHex("5eb63bbbe01eeed093cb22bb8f5acdc3a").has_value());
+  EXPECT_FALSE(
+      Md5Digest::FromHex("5eb63bbbe01eeed093cb22bb8f5acdcg").has_value());
+}
+
+TEST(Md5DigestTest, StreamsAsLowercaseHex) {
+  const auto digest = Md5Digest::FromHex("D41D8CD98F00B204E9800998ECF8427E");
+  ASSERT_TRUE(digest.has_value());
+  std::ostringstream os;
+  os << *digest;
+  EXPECT_EQ(os.str(), "d41d8cd98f00b204e9800998ecf8427e");
+}
+
+TEST(Md5DigestTest, WorksAsUnorderedKey) {
+  std::unordered_set<Md5Digest, Md5DigestHash> digests;
+  digests.insert(*Md5Digest::FromHex("5eb63bbbe01eeed093cb22bb8f5acdc3"));
+  digests.insert(*Md5Digest::FromHex("d41d8cd98f00b204e9800998ecf8427e"));
+  digests.insert(*Md5Digest::FromHex("5eb63bbbe01eeed093cb22bb8f5acdc3"));
+  EXPECT_EQ(digests.size(), 2);
+  EXPECT_EQ(digests.count(*Md5Digest::FromHex(
+                "d41d8cd98f00b204e9800998ecf8427e")),
+            1);
+}
+
+TEST(ScanResultTest, FormatsAsJson) {
+  ScanResult result;
+  result.total_files_processed = 3;
+  result.malicious_files_detected = 1;
+  result.execution_time = std::chrono::milliseconds(42);
+  EXPECT_EQ(ToJson(result),
+            "{\"total_files_processed\": 3, \"malicious_files_detected\": 1, "
+            "\"errors\": 0, \"execution_time_ms\": 42, "
+            "\"peak_queue_depth\": 0, \"tail_latency_ms\": 0, "
+            "\"deduplicated_files\": 0, \"deduplicated_bytes\": 0}");
+
+  ScanMetrics metrics;
+  metrics.bytes_read = 2048;
+  metrics.stages[static_cast<std::size_t>(ScanStage::kHash)].count = 2;
+  metrics.stages[static_cast<std::size_t>(ScanStage::kHash)].p99 =
+      std::chrono::nanoseconds(1500);
+  result.metrics = metrics;
+  const std::string json = ToJson(result);
+  EXPECT_NE(json.find("\"metrics\": {\"bytes_read\": 2048"),
+            std::string::npos);
+  EXPECT_NE(json.find("\"hash\": {\"count\": 2, \"total_ns\": 0, "
+                      "\"p50_ns\": 0, \"p90_ns\": 0, \"p99_ns\": 1500"),
+            std::string::npos);
+  EXPECT_EQ(json.back(), '}');
+}
+
+TEST(ScanResultTest, StreamsMetricsPerStage) {
+  ScanResult result;
+  result.metrics = ScanMetrics{};
+  std::ostringstream os;
+  os << result;
+  for (std::size_t i = 0; i < kScanStageCount; ++i) {
+    EXPECT_NE(os.str().find(ToString(static_cast<ScanStage>(i))),
+              std::string::npos);
+  }
+}
+
+TEST(ScanProgressTest, FormatsAsJsonAndText) {
+  ScanProgress progress;
+  progress.files_discovered = 10;
+  progress.files_processed = 4;
+  progress.bytes_processed = 4096;
+  progress.elapsed = std::chrono::milliseconds(2000);
+  progress.files_per_second = 2;
+  EXPECT_EQ(ToJson(progress),
+            "{\"files_discovered\": 10, \"traversal_complete\": false, "
+            "\"files_processed\": 4, \"bytes_processed\": 4096, "
+            "\"malicious_files_detected\": 0, \"errors\": 0, "
+            "\"elapsed_ms\": 2000, \"files_per_second\": 2, "
+            "\"bytes_per_second\": 0}");
+  std::ostringstream os;
+  os << progress;
+  EXPECT_NE(os.str().find("4 of 10+ files"), std::string::npos);
+  EXPECT_NE(os.str().find("ETA unknown"), std::string::npos);
+
+  progress.traversal_complete = true;
+  progress.eta = std::chrono::seconds(3);
+  EXPECT_NE(ToJson(progress).find("\"eta_s\": 3}"), std::string::npos);
+  os.str("");
+  os << progress;
+  EXPECT_NE(os.str().find("4 of 10 files"), std::string::npos);
+  EXPECT_NE(os.str().find("ETA 3 s"), std::string::npos);
+}
+
+}  // namespace
+}  // namespace scanner
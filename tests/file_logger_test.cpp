@@ -1,5 +1,7 @@
 #include "src/scanner_lib/file_logger.h"
 
+#include <cstdint>
+
 #include <atomic>
 #include <filesystem>
 #include <fstream>
@@ -14,6 +16,8 @@
 namespace scanner {
 namespace {
 
+constexpr char kHash1[] = "5eb63bbbe01eeed093cb22bb8f5acdc3";
+
 class FileLoggerTest : public ::testing::Test {
 protected:
   void SetUp() override {
@@ -37,7 +41,8 @@ TEST_F(FileLoggerTest, LogsSingleEntryCorrectly) {
   const auto log_path = temp_dir_ / "single.log";
   {
     FileLogger logger(log_path);
-    logger.LogDetection(R"(c:\temp\file.txt)", "hash1", "Verdict1");
+    logger.LogDetection(R"(c:\temp\file.txt)", *Md5Digest::FromHex(kHash1),
+                        "Verdict1");
   }  // Logger goes out of scope, closes file.
 
   std::ifstream log_file(log_path);
@@ -45,7 +50,7 @@ TEST_F(FileLoggerTest, LogsSingleEntryCorrectly) {
   ASSERT_TRUE(std::getline(log_file, line));
 
   const std::string expected =
-      R"({"path": "c:\\temp\\file.txt", "hash": "hash1", "verdict": "Verdict1"})";
+      R"({"path": "c:\\temp\\file.txt", "hash": "5eb63bbbe01eeed093cb22bb8f5acdc3", "verdict": "Verdict1"})";
   EXPECT_EQ(line, expected);
 
   EXPECT_FALSE(std::getline(log_file, line));  // No more lines
@@ -75,7 +80,8 @@ TEST_F(FileLoggerTest, HandlesConcurrentWritesWithoutCorruption) {
         for (int j = 0; j < kLogsPerThread; ++j) {
           const std::string path =
               "file_" + std::to_string(i) + "_" + std::to_string(j);
-          const std::string hash = "hash_" + std::to_string(j);
+          Md5Digest hash;
+          hash.bytes[0] = static_cast<std::uint8_t>(j);
           const std::string verdict = "Verdict" + std::to_string(i);
           logger.LogDetection(path, hash, verdict);
         }
@@ -0,0 +1,189 @@
+#include "src/scanner_lib/file_reader.h"
+
+#include <cstdint>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace scanner {
+namespace {
+
+class FileReaderTest : public ::testing::TestWithParam<IoStrategy> {
+protected:
+  void SetUp() override {
+    temp_dir_ = std::filesystem::temp_directory_path() / "file_reader_tests";
+    std::filesystem::create_directory(temp_dir_);
+  }
+
+  void TearDown() override {
+    std::error_code ec;
+    std::filesystem::remove_all(temp_dir_, ec);
+    (void)ec;
+  }
+
+  std::filesystem::path CreateFile(const std::string& name, std::size_t size) {
+    const auto path = temp_dir_ / name;
+    std::ofstream file(path, std::ios::binary);
+    for (std::size_t i = 0; i < size; ++i) {
+      file.put(static_cast<char>((i * 7 + i / 251) & 0xFF));
+    }
+    return path;
+  }
+
+  static std::vector<std::uint8_t> ReadExpected(
+      const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(file),
+                                     std::istreambuf_iterator<char>());
+  }
+
+  std::filesystem::path temp_dir_;
+};
+
+TEST_P(FileReaderTest, ReadsWholeContentInOrder) {
+  IoOptions options;
+  options.strategy = GetParam();
+  options.read_block_size = 1000;  // Not a divisor of any size below.
+  const FileReader reader(options);
+
+  for (const std::size_t size :
+       {std::size_t{0}, std::size_t{1}, std::size_t{4096},
+        std::size_t{256 * 1024 + 1}, std::size_t{1 << 20}}) {
+    const auto path = CreateFile("file_" + std::to_string(size), size);
+
+    std::vector<std::uint8_t> content;
+    reader.Read(path, [&content](const std::uint8_t* data, std::size_t n) {
+      content.insert(content.end(), data, data + n);
+    });
+    EXPECT_EQ(content, ReadExpected(path)) << "size " << size;
+  }
+}
+
+TEST_P(FileReaderTest, ThrowsOnNonExistentFile) {
+  IoOptions options;
+  options.strategy = GetParam();
+  const FileReader reader(options);
+  const auto ignore = [](const std::uint8_t*, std::size_t) {};
+  EXPECT_THROW(reader.Read(temp_dir_ / "missing.bin", ignore),
+               std::runtime_error);
+}
+
+TEST_P(FileReaderTest, ReadBatchReportsEachFile) {
+  IoOptions options;
+  options.strategy = GetParam();
+  options.io_queue_depth = 4;  // Forces several io_uring rounds.
+  const FileReader reader(options);
+
+  const std::vector<std::size_t> sizes = {0, 1, 100, 5000, 64, 3000, 17};
+  std::vector<std::filesystem::path> paths;
+  for (std::size_t i = 0; i < sizes.size(); ++i) {
+    paths.push_back(CreateFile("batch_" + std::to_string(i), sizes[i]));
+  }
+  paths.push_back(temp_dir_ / "missing.bin");
+
+  std::vector<FileReader::BatchEntry> entries;
+  reader.ReadBatch(paths, 4096, entries);
+
+  ASSERT_GE(entries.size(), paths.size());
+  for (std::size_t i = 0; i < sizes.size(); ++i) {
+    ASSERT_FALSE(entries[i].error) << paths[i];
+    if (sizes[i] > 4096) {
+      EXPECT_TRUE(entries[i].too_large) << paths[i];
+    } else {
+      EXPECT_FALSE(entries[i].too_large) << paths[i];
+      EXPECT_EQ(entries[i].content, ReadExpected(paths[i])) << paths[i];
+    }
+  }
+  EXPECT_TRUE(entries.back().error);
+
+  // Entries are reused by the next batch.
+  reader.ReadBatch({paths[2]}, 4096, entries);
+  EXPECT_FALSE(entries[0].error);
+  EXPECT_EQ(entries[0].content, ReadExpected(paths[2]));
+}
+
+TEST_P(FileReaderTest, ThrowsIfFileIsTruncatedWhileRead) {
+  IoOptions options;
+  options.strategy = GetParam();
+  const FileReader reader(options);
+  const auto path = CreateFile("shrinking.bin", 1 << 20);
+
+  // A mapped file loses its pages past the new end; touching them must not
+  // bring the process down.
+  std::size_t seen = 0;
+  bool truncated = false;
+  const auto truncate_then_touch = [&](const std::uint8_t* data,
+                                       std::size_t n) {
+    if (!truncated) {
+      std::filesystem::resize_file(path, 0);
+      truncated = true;
+    }
+    for (std::size_t i = 0; i < n; i += 4096) {
+      seen += data[i];
+    }
+  };
+  try {
+    reader.Read(path, truncate_then_touch);
+    // Strategies that copy the file hand out what was read before the
+    // truncation, and stop.
+    EXPECT_NE(GetParam(), IoStrategy::kMmap);
+  } catch (const std::runtime_error& e) {
+    EXPECT_NE(std::string(e.what()).find("truncated"), std::string::npos);
+  }
+  EXPECT_TRUE(truncated);
+
+  // The reader is still usable afterwards.
+  const auto intact = CreateFile("intact.bin", 1 << 20);
+  std::vector<std::uint8_t> content;
+  reader.Read(intact, [&content](const std::uint8_t* data, std::size_t n) {
+    content.insert(content.end(), data, data + n);
+  });
+  EXPECT_EQ(content, ReadExpected(intact));
+}
+
+INSTANTIATE_TEST_SUITE_P(AllStrategies, FileReaderTest,
+                         ::testing::Values(IoStrategy::kAuto, IoStrategy::kMmap,
+                                           IoStrategy::kPread,
+                                           IoStrategy::kRead,
+                                           IoStrategy::kIoUring));
+
+TEST(FileReaderStrategyTest, AutoNeverMapsFiles) {
+  // Mapping needs a SIGBUS handler, so it is only used when selected.
+  const FileReader reader;
+  EXPECT_EQ(reader.StrategyFor(0), IoStrategy::kPread);
+  EXPECT_EQ(reader.StrategyFor(1ULL << 40), IoStrategy::kPread);
+}
+
+TEST(FileReaderStrategyTest, ExplicitStrategyIsAlwaysUsed) {
+  IoOptions options;
+  options.strategy = IoStrategy::kRead;
+  const FileReader reader(options);
+  EXPECT_EQ(reader.StrategyFor(0), IoStrategy::kRead);
+  EXPECT_EQ(reader.StrategyFor(1ULL << 40), IoStrategy::kRead);
+}
+
+TEST(FileReaderStrategyTest, IoUringReadsSingleFilesLikeAuto) {
+  IoOptions options;
+  options.strategy = IoStrategy::kIoUring;
+  const FileReader reader(options);
+  EXPECT_EQ(reader.StrategyFor(0), IoStrategy::kPread);
+  EXPECT_EQ(reader.StrategyFor(1ULL << 40), IoStrategy::kPread);
+}
+
+TEST(FileReaderStrategyTest, RejectsInvalidOptions) {
+  IoOptions zero_block_size;
+  zero_block_size.read_block_size = 0;
+  EXPECT_THROW(FileReader{zero_block_size}, std::invalid_argument);
+
+  IoOptions shallow_queue;
+  shallow_queue.io_queue_depth = 1;
+  EXPECT_THROW(FileReader{shallow_queue}, std::invalid_argument);
+}
+
+}  // namespace
+}  // namespace scanner
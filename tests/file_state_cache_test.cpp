@@ -0,0 +1,216 @@
+#include "src/scanner_lib/file_state_cache.h"
+
+#include <chrono>
+#include <cstdint>
+
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace scanner {
+namespace {
+
+Md5Digest MakeDigest(std::uint8_t fill) {
+  Md5Digest digest;
+  digest.bytes.fill(fill);
+  return digest;
+}
+
+// A state whose modification time is safely outside the racy window.
+FileState MakeState(std::uint64_t inode) {
+  FileState state;
+  state.device = 1;
+  state.inode = inode;
+  state.size = 100;
+  state.mtime_ns = 1'600'000'000'000'000'000;
+  state.ctime_ns = 1'600'000'000'000'000'000;
+  return state;
+}
+
+class FileStateCacheTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    const std::string test_name =
+        ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    temp_dir_ = std::filesystem::temp_directory_path() /
+                ("file_state_cache_tests_" + test_name);
+    std::filesystem::create_directories(temp_dir_);
+    cache_path_ = temp_dir_ / "scan.cache";
+  }
+
+  void TearDown() override {
+    std::error_code ec;
+    std::filesystem::remove_all(temp_dir_, ec);
+    (void)ec;
+  }
+
+  std::filesystem::path temp_dir_;
+  std::filesystem::path cache_path_;
+};
+
+TEST_F(FileStateCacheTest, MissingFileLoadsEmpty) {
+  FileStateCache cache(cache_path_);
+  EXPECT_NO_THROW(cache.Load());
+  EXPECT_EQ(cache.Size(), 0);
+  EXPECT_FALSE(cache.Find(MakeState(1)).has_value());
+}
+
+TEST_F(FileStateCacheTest, InsertedEntriesSurviveSaveAndLoad) {
+  {
+    FileStateCache cache(cache_path_);
+    cache.Load();
+    cache.Insert(MakeState(1), MakeDigest(0x11), temp_dir_ / "a");
+    cache.Insert(MakeState(2), MakeDigest(0x22), temp_dir_ / "b");
+    // Entries become visible only once saved.
+    EXPECT_FALSE(cache.Find(MakeState(1)).has_value());
+    cache.Save();
+    EXPECT_EQ(cache.Find(MakeState(1)), MakeDigest(0x11));
+  }
+
+  FileStateCache cache(cache_path_);
+  cache.Load();
+  EXPECT_EQ(cache.Size(), 2);
+  EXPECT_EQ(cache.Find(MakeState(1)), MakeDigest(0x11));
+  EXPECT_EQ(cache.Find(MakeState(2)), MakeDigest(0x22));
+}
+
+TEST_F(FileStateCacheTest, AnyChangedFieldIsAMiss) {
+  FileStateCache cache(cache_path_);
+  cache.Insert(MakeState(1), MakeDigest(0x11), temp_dir_ / "a");
+  cache.Save();
+
+  FileState state = MakeState(1);
+  state.size++;
+  EXPECT_FALSE(cache.Find(state).has_value());
+  state = MakeState(1);
+  state.mtime_ns++;
+  EXPECT_FALSE(cache.Find(state).has_value());
+  state = MakeState(1);
+  state.ctime_ns++;
+  EXPECT_FALSE(cache.Find(state).has_value());
+  state = MakeState(1);
+  state.device++;
+  EXPECT_FALSE(cache.Find(state).has_value());
+  EXPECT_TRUE(cache.Find(MakeState(1)).has_value());
+}
+
+TEST_F(FileStateCacheTest, SaveDropsUnusedEntriesUnderTheScannedRoot) {
+  FileStateCache cache(cache_path_);
+  cache.Insert(MakeState(1), MakeDigest(0x11), temp_dir_ / "a");
+  cache.Insert(MakeState(2), MakeDigest(0x22), temp_dir_ / "b");
+  cache.Save();
+
+  ASSERT_TRUE(cache.Find(MakeState(2)).has_value());
+  cache.Save(temp_dir_);
+
+  EXPECT_EQ(cache.Size(), 1);
+  EXPECT_FALSE(cache.Find(MakeState(1)).has_value());
+  EXPECT_TRUE(cache.Find(MakeState(2)).has_value());
+}
+
+TEST_F(FileStateCacheTest, SaveKeepsUnusedEntriesOutsideTheScannedRoot) {
+  FileStateCache cache(cache_path_);
+  cache.Insert(MakeState(1), MakeDigest(0x11), temp_dir_ / "one" / "a");
+  cache.Insert(MakeState(2), MakeDigest(0x22), temp_dir_ / "one_more" / "b");
+  cache.Insert(MakeState(3), MakeDigest(0x33), temp_dir_ / "two" / "c");
+  cache.Save();
+
+  // A sibling sharing the root's name as a prefix is outside the root.
+  cache.Save(temp_dir_ / "one");
+  EXPECT_EQ(cache.Size(), 2);
+  EXPECT_FALSE(cache.Find(MakeState(1)).has_value());
+
+  // Without a root, as after a scan of listed files, nothing is dropped.
+  cache.Save();
+  cache.Load();
+  EXPECT_EQ(cache.Size(), 2);
+  EXPECT_TRUE(cache.Find(MakeState(2)).has_value());
+  EXPECT_TRUE(cache.Find(MakeState(3)).has_value());
+}
+
+TEST_F(FileStateCacheTest, SaveDropsEntriesReplacedForTheSamePath) {
+  FileStateCache cache(cache_path_);
+  cache.Insert(MakeState(1), MakeDigest(0x11), temp_dir_ / "a");
+  cache.Save();
+
+  // The file was rewritten, and its new state hashed.
+  cache.Insert(MakeState(2), MakeDigest(0x22), temp_dir_ / "a");
+  cache.Save();
+
+  EXPECT_EQ(cache.Size(), 1);
+  EXPECT_TRUE(cache.Find(MakeState(2)).has_value());
+}
+
+TEST_F(FileStateCacheTest, RecentlyModifiedFilesAreNotCached) {
+  FileStateCache cache(cache_path_);
+  FileState state = MakeState(1);
+  state.mtime_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::system_clock::now().time_since_epoch())
+                       .count();
+  cache.Insert(state, MakeDigest(0x11), temp_dir_ / "a");
+  cache.Save();
+  EXPECT_EQ(cache.Size(), 0);
+}
+
+TEST_F(FileStateCacheTest, RejectsForeignFiles) {
+  std::ofstream(cache_path_) << "definitely not a cache file";
+  FileStateCache cache(cache_path_);
+  EXPECT_THROW(cache.Load(), std::runtime_error);
+}
+
+TEST_F(FileStateCacheTest, RejectsTruncatedFiles) {
+  {
+    FileStateCache cache(cache_path_);
+    cache.Insert(MakeState(1), MakeDigest(0x11), temp_dir_ / "a");
+    cache.Save();
+  }
+  std::filesystem::resize_file(cache_path_,
+                               std::filesystem::file_size(cache_path_) - 1);
+
+  FileStateCache cache(cache_path_);
+  EXPECT_THROW(cache.Load(), std::runtime_error);
+  EXPECT_EQ(cache.Size(), 0);
+}
+
+#ifndef _WIN32
+
+TEST_F(FileStateCacheTest, StatFileTracksFileChanges) {
+  const auto path = temp_dir_ / "file.txt";
+  std::ofstream(path) << "content";
+
+  const std::optional<FileStatus> before = StatFile(path);
+  ASSERT_TRUE(before.has_value());
+  EXPECT_EQ(before->state.size, 7);
+  EXPECT_EQ(before->link_count, 1);
+  EXPECT_TRUE(StatFile(path)->state == before->state);
+
+  std::ofstream(path, std::ios::app) << "!";
+  const std::optional<FileStatus> after = StatFile(path);
+  ASSERT_TRUE(after.has_value());
+  EXPECT_FALSE(after->state == before->state);
+
+  EXPECT_FALSE(StatFile(temp_dir_ / "missing").has_value());
+  EXPECT_FALSE(StatFile(temp_dir_).has_value());
+}
+
+TEST_F(FileStateCacheTest, StatFileCountsHardLinks) {
+  const auto path = temp_dir_ / "file.txt";
+  std::ofstream(path) << "content";
+  std::filesystem::create_hard_link(path, temp_dir_ / "link.txt");
+
+  const std::optional<FileStatus> original = StatFile(path);
+  const std::optional<FileStatus> link = StatFile(temp_dir_ / "link.txt");
+  ASSERT_TRUE(original.has_value());
+  ASSERT_TRUE(link.has_value());
+  EXPECT_EQ(original->link_count, 2);
+  EXPECT_EQ(link->state.inode, original->state.inode);
+}
+
+#endif
+
+}  // namespace
+}  // namespace scanner
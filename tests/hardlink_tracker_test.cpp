@@ -0,0 +1,157 @@
+#include "src/scanner_lib/hardlink_tracker.h"
+
+#include <cstdint>
+
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace scanner {
+namespace {
+
+FileStatus MakeStatus(std::uint64_t device, std::uint64_t inode,
+                      std::uint64_t link_count) {
+  FileStatus status;
+  status.state.device = device;
+  status.state.inode = inode;
+  status.link_count = link_count;
+  return status;
+}
+
+TEST(HardlinkTrackerTest, FirstPathClaimsTheFile) {
+  HardlinkTracker tracker;
+  FileHashResult result;
+  EXPECT_EQ(tracker.Register(MakeStatus(1, 10, 2), "a", result),
+            HardlinkTracker::Claim::kFirst);
+  // The same inode on another device is another file.
+  EXPECT_EQ(tracker.Register(MakeStatus(2, 10, 2), "b", result),
+            HardlinkTracker::Claim::kFirst);
+}
+
+TEST(HardlinkTrackerTest, QueuesPathsUntilResolved) {
+  HardlinkTracker tracker;
+  const FileStatus status = MakeStatus(1, 10, 4);
+  FileHashResult result;
+  ASSERT_EQ(tracker.Register(status, "a", result),
+            HardlinkTracker::Claim::kFirst);
+  EXPECT_EQ(tracker.Register(status, "b", result),
+            HardlinkTracker::Claim::kQueued);
+  EXPECT_EQ(tracker.Register(status, "c", result),
+            HardlinkTracker::Claim::kQueued);
+
+  FileHashResult hashed;
+  hashed.md5.emplace().bytes.fill(0xAB);
+  const std::vector<std::filesystem::path> queued =
+      tracker.Resolve(status.state, hashed);
+  EXPECT_EQ(queued, (std::vector<std::filesystem::path>{"b", "c"}));
+
+  FileHashResult late;
+  EXPECT_EQ(tracker.Register(status, "d", late),
+            HardlinkTracker::Claim::kResolved);
+  EXPECT_EQ(late.md5, hashed.md5);
+  EXPECT_FALSE(late.error);
+}
+
+TEST(HardlinkTrackerTest, SharesErrors) {
+  HardlinkTracker tracker;
+  const FileStatus status = MakeStatus(1, 10, 2);
+  FileHashResult result;
+  ASSERT_EQ(tracker.Register(status, "a", result),
+            HardlinkTracker::Claim::kFirst);
+
+  FileHashResult failed;
+  failed.error = std::make_exception_ptr(std::runtime_error("unreadable"));
+  tracker.Resolve(status.state, failed);
+
+  ASSERT_EQ(tracker.Register(status, "b", result),
+            HardlinkTracker::Claim::kResolved);
+  EXPECT_TRUE(result.error);
+}
+
+TEST(HardlinkTrackerTest, ForgetsFileOnceEveryLinkIsSeen) {
+  HardlinkTracker tracker;
+  const FileStatus status = MakeStatus(1, 10, 3);
+  FileHashResult result;
+  ASSERT_EQ(tracker.Register(status, "a", result),
+            HardlinkTracker::Claim::kFirst);
+  tracker.Resolve(status.state, FileHashResult{});
+  EXPECT_EQ(tracker.Register(status, "b", result),
+            HardlinkTracker::Claim::kResolved);
+  EXPECT_EQ(tracker.Register(status, "c", result),
+            HardlinkTracker::Claim::kResolved);
+  // All three links were seen, so the file was dropped; a fourth path
+  // could only come from a link made since, and is hashed afresh.
+  EXPECT_EQ(tracker.Register(status, "d", result),
+            HardlinkTracker::Claim::kFirst);
+}
+
+TEST(HardlinkTrackerTest, ForgetsFileWhenLastLinkWasQueued) {
+  HardlinkTracker tracker;
+  const FileStatus status = MakeStatus(1, 10, 2);
+  FileHashResult result;
+  ASSERT_EQ(tracker.Register(status, "a", result),
+            HardlinkTracker::Claim::kFirst);
+  ASSERT_EQ(tracker.Register(status, "b", result),
+            HardlinkTracker::Claim::kQueued);
+  EXPECT_EQ(tracker.Resolve(status.state, FileHashResult{}),
+            (std::vector<std::filesystem::path>{"b"}));
+  EXPECT_EQ(tracker.Register(status, "c", result),
+            HardlinkTracker::Claim::kFirst);
+}
+
+TEST(HardlinkTrackerTest, ClearForgetsFiles) {
+  HardlinkTracker tracker;
+  const FileStatus status = MakeStatus(1, 10, 2);
+  FileHashResult result;
+  tracker.Register(status, "a", result);
+  tracker.Clear();
+  EXPECT_EQ(tracker.Register(status, "a", result),
+            HardlinkTracker::Claim::kFirst);
+}
+
+TEST(HardlinkTrackerTest, EveryPathIsHandledExactlyOnceUnderContention) {
+  HardlinkTracker tracker;
+  const int kThreads = 8;
+  const int kFiles = 200;
+  std::atomic<int> claimed{0};
+  std::atomic<int> handled{0};
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < kFiles; ++i) {
+        const FileStatus status = MakeStatus(1, i, kThreads);
+        FileHashResult result;
+        const std::string path = std::to_string(t);
+        switch (tracker.Register(status, path, result)) {
+          case HardlinkTracker::Claim::kFirst:
+            claimed++;
+            handled += 1 + static_cast<int>(
+                               tracker.Resolve(status.state, FileHashResult{})
+                                   .size());
+            break;
+          case HardlinkTracker::Claim::kResolved:
+            handled++;
+            break;
+          case HardlinkTracker::Claim::kQueued:
+            break;
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(claimed.load(), kFiles);
+  EXPECT_EQ(handled.load(), kThreads * kFiles);
+}
+
+}  // namespace
+}  // namespace scanner
@@ -1,5 +1,7 @@
+#include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
 #include <string>
 #include <vector>
 
@@ -108,6 +110,230 @@ TEST_F(ScannerIntegrationTest, FullScanDetectsThreatsAndReportsCorrectly) {
   EXPECT_THAT(console_output, testing::HasSubstr("Malicious detections: 2"));
   EXPECT_THAT(console_output, testing::HasSubstr("Errors: 0"));
   EXPECT_THAT(console_output, testing::HasSubstr("Execution time:"));
+  EXPECT_THAT(console_output, testing::HasSubstr("Peak queue depth:"));
+  EXPECT_THAT(console_output, testing::Not(testing::HasSubstr("Prefilter")));
+}
+
+TEST_F(ScannerIntegrationTest, FileCacheServesUnchangedFilesOnRescan) {
+  // Files modified within the last seconds are not cached.
+  for (const auto& entry :
+       std::filesystem::recursive_directory_iterator(scan_dir_)) {
+    if (entry.is_regular_file()) {
+      std::filesystem::last_write_time(
+          entry.path(), std::filesystem::file_time_type::clock::now() -
+                            std::chrono::hours(1));
+    }
+  }
+
+  const std::string scanner_path = STRINGIFY(SCANNER_EXECUTABLE_PATH);
+  std::string command = scanner_path;
+  command += " --path " + scan_dir_.string();
+  command += " --base " + base_path_.string();
+  command += " --log " + log_path_.string();
+  command += " --cache " + (root_dir_ / "scan.cache").string();
+
+  const std::string first_output = tests::Execute(command);
+  const std::string second_output = tests::Execute(command);
+
+  EXPECT_THAT(first_output, testing::HasSubstr("Malicious detections: 2"));
+  EXPECT_THAT(second_output, testing::HasSubstr("Malicious detections: 2"));
+  EXPECT_THAT(second_output, testing::HasSubstr("Errors: 0"));
+#ifdef _WIN32
+  EXPECT_THAT(second_output, testing::HasSubstr("File cache hit rate: "));
+#else
+  EXPECT_THAT(first_output,
+              testing::HasSubstr("File cache hit rate: 0.00% (0 of 5 files)"));
+  EXPECT_THAT(
+      second_output,
+      testing::HasSubstr("File cache hit rate: 100.00% (5 of 5 files)"));
+#endif
+}
+
+TEST_F(ScannerIntegrationTest, PrefilterIsReportedWhenEnabled) {
+  const std::string scanner_path = STRINGIFY(SCANNER_EXECUTABLE_PATH);
+  std::string command = scanner_path;
+  command += " --path " + scan_dir_.string();
+  command += " --base " + base_path_.string();
+  command += " --log " + log_path_.string();
+  command += " --prefilter 10";
+
+  const std::string console_output = tests::Execute(command);
+
+  EXPECT_THAT(console_output, testing::HasSubstr("Malicious detections: 2"));
+  EXPECT_THAT(console_output, testing::HasSubstr("Prefilter memory: "));
+  EXPECT_THAT(console_output,
+              testing::HasSubstr("Prefilter false positive rate: "));
+}
+
+TEST_F(ScannerIntegrationTest, EveryIoStrategyDetectsThreats) {
+  const std::string scanner_path = STRINGIFY(SCANNER_EXECUTABLE_PATH);
+  for (const std::string strategy :
+       {"auto", "mmap", "pread", "read", "io_uring"}) {
+    std::string command = scanner_path;
+    command += " --path " + scan_dir_.string();
+    command += " --base " + base_path_.string();
+    command += " --log " + log_path_.string();
+    command += " --io-strategy " + strategy;
+    command += " --read-block-size 7";
+
+    const std::string console_output = tests::Execute(command);
+
+    EXPECT_THAT(console_output, testing::HasSubstr("Malicious detections: 2"))
+        << strategy;
+    EXPECT_THAT(console_output, testing::HasSubstr("Errors: 0")) << strategy;
+  }
+}
+
+TEST_F(ScannerIntegrationTest, EveryWalkerModeDetectsThreats) {
+  const std::string scanner_path = STRINGIFY(SCANNER_EXECUTABLE_PATH);
+  for (const std::string mode : {"parallel", "sequential"}) {
+    std::string command = scanner_path;
+    command += " --path " + scan_dir_.string();
+    command += " --base " + base_path_.string();
+    command += " --log " + log_path_.string();
+    command += " --walker " + mode;
+
+    const std::string console_output = tests::Execute(command);
+
+    EXPECT_THAT(console_output, testing::HasSubstr("Processed files: 5"))
+        << mode;
+    EXPECT_THAT(console_output, testing::HasSubstr("Malicious detections: 2"))
+        << mode;
+    EXPECT_THAT(console_output, testing::HasSubstr("Errors: 0")) << mode;
+  }
+}
+
+TEST_F(ScannerIntegrationTest, EverySchedulingModeDetectsThreats) {
+  const std::string scanner_path = STRINGIFY(SCANNER_EXECUTABLE_PATH);
+  for (const std::string mode :
+       {"fifo", "largest-first", "inode", "extent"}) {
+    std::string command = scanner_path;
+    command += " --path " + scan_dir_.string();
+    command += " --base " + base_path_.string();
+    command += " --log " + log_path_.string();
+    command += " --schedule " + mode;
+
+    const std::string console_output = tests::Execute(command);
+
+    EXPECT_THAT(console_output, testing::HasSubstr("Processed files: 5"))
+        << mode;
+    EXPECT_THAT(console_output, testing::HasSubstr("Malicious detections: 2"))
+        << mode;
+    EXPECT_THAT(console_output, testing::HasSubstr("Tail latency: ")) << mode;
+  }
+}
+
+TEST_F(ScannerIntegrationTest, ShaSignaturesMatchWhenAlgorithmsEnabled) {
+  // SHA-1 of "EVIL" and SHA-256 of "MALWARE".
+  std::ofstream base_file(base_path_);
+  base_file << "2a373a4af6717d1f4a2ff4a68bb0a571107a670f;Exploit\n";
+  base_file << "d789d09c824e58b32812a9bd684eb065e4422de629261c3fd1e39ce0e1d28112"
+               ";Dropper\n";
+  base_file.close();
+
+  const std::string scanner_path = STRINGIFY(SCANNER_EXECUTABLE_PATH);
+  std::string command = scanner_path;
+  command += " --path " + scan_dir_.string();
+  command += " --base " + base_path_.string();
+  command += " --log " + log_path_.string();
+
+  std::string console_output = tests::Execute(command);
+  EXPECT_THAT(console_output, testing::HasSubstr("Malicious detections: 0"));
+
+  command += " --algorithms md5,sha1,sha256";
+  console_output = tests::Execute(command);
+  EXPECT_THAT(console_output, testing::HasSubstr("Processed files: 5"));
+  EXPECT_THAT(console_output, testing::HasSubstr("Malicious detections: 2"));
+  EXPECT_THAT(console_output, testing::HasSubstr("Errors: 0"));
+}
+
+TEST_F(ScannerIntegrationTest, Sha256HasherDetectsSha256Signatures) {
+  // SHA-256 of "EVIL" and "MALWARE".
+  const std::string sha256_1 =
+      "a4cae81b6d0480d3ab6b52a6dfb5eae63346252bd00c4df5e27fcf96851bb84e";
+  const std::string sha256_2 =
+      "d789d09c824e58b32812a9bd684eb065e4422de629261c3fd1e39ce0e1d28112";
+  std::ofstream base_file(base_path_);
+  base_file << sha256_1 << ";Exploit\n" << sha256_2 << ";Dropper\n";
+  base_file.close();
+
+  const std::string scanner_path = STRINGIFY(SCANNER_EXECUTABLE_PATH);
+  std::string command = scanner_path;
+  command += " --path " + scan_dir_.string();
+  command += " --base " + base_path_.string();
+  command += " --log " + log_path_.string();
+  command += " --hasher sha256";
+
+  const std::string console_output = tests::Execute(command);
+  EXPECT_THAT(console_output, testing::HasSubstr("Processed files: 5"));
+  EXPECT_THAT(console_output, testing::HasSubstr("Malicious detections: 2"));
+  EXPECT_THAT(console_output, testing::HasSubstr("Errors: 0"));
+
+  std::ifstream log_file(log_path_);
+  const std::string log((std::istreambuf_iterator<char>(log_file)),
+                        std::istreambuf_iterator<char>());
+  EXPECT_THAT(log, testing::HasSubstr("\"hash\": \"" + sha256_1 + "\""));
+  EXPECT_THAT(log, testing::HasSubstr("\"hash\": \"" + sha256_2 + "\""));
+}
+
+TEST_F(ScannerIntegrationTest, FileListScansOnlyListedFiles) {
+  const auto list_path = root_dir_ / "changed.list";
+  {
+    std::ofstream list(list_path, std::ios::binary);
+    list << (scan_dir_ / "bad_file1.exe").string() << '\0'
+         << (scan_dir_ / "nested" / "good_file2.log").string() << '\0';
+  }
+
+  const std::string scanner_path = STRINGIFY(SCANNER_EXECUTABLE_PATH);
+  const std::string options =
+      " --base " + base_path_.string() + " --log " + log_path_.string();
+  for (const std::string& source :
+       {" --files-from " + list_path.string(),
+        " --files-from - < " + list_path.string()}) {
+    const std::string console_output =
+        tests::Execute(scanner_path + source + options);
+
+    EXPECT_THAT(console_output, testing::HasSubstr("Processed files: 2"))
+        << source;
+    EXPECT_THAT(console_output, testing::HasSubstr("Malicious detections: 1"))
+        << source;
+    EXPECT_THAT(console_output, testing::HasSubstr("Errors: 0")) << source;
+  }
+}
+
+TEST_F(ScannerIntegrationTest, CompiledDatabaseScanDetectsThreats) {
+  const auto sigdb_path = root_dir_ / "base.sigdb";
+  const std::string dbc_path = STRINGIFY(SCANNER_DBC_EXECUTABLE_PATH);
+  const std::string dbc_output = tests::Execute(
+      dbc_path + " --input " + base_path_.string() + " --output " +
+      sigdb_path.string());
+  ASSERT_TRUE(std::filesystem::exists(sigdb_path)) << dbc_output;
+  EXPECT_THAT(dbc_output, testing::HasSubstr("Wrote 2 signatures"));
+
+  const std::string scanner_path = STRINGIFY(SCANNER_EXECUTABLE_PATH);
+  std::string command = scanner_path;
+  command += " --path " + scan_dir_.string();
+  command += " --base " + sigdb_path.string();
+  command += " --log " + log_path_.string();
+
+  const std::string console_output = tests::Execute(command);
+
+  std::ifstream log_file(log_path_);
+  std::string log_line;
+  std::vector<std::string> log_entries;
+  while (std::getline(log_file, log_line)) {
+    log_entries.push_back(log_line);
+  }
+
+  EXPECT_THAT(
+      log_entries,
+      testing::UnorderedElementsAre(
+          testing::AllOf(testing::HasSubstr("\"hash\": \"" + bad_hash1_ + "\""),
+                         testing::HasSubstr(R"("verdict": "Exploit")")),
+          testing::AllOf(testing::HasSubstr("\"hash\": \"" + bad_hash2_ + "\""),
+                         testing::HasSubstr(R"("verdict": "Dropper")"))));
+  EXPECT_THAT(console_output, testing::HasSubstr("Processed files: 5"));
+  EXPECT_THAT(console_output, testing::HasSubstr("Malicious detections: 2"));
 }
 
 }  // namespace
\ No newline at end of file
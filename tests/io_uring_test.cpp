@@ -0,0 +1,114 @@
+#include "src/scanner_lib/io_uring.h"
+
+#include <cstdint>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#endif
+
+namespace scanner {
+namespace {
+
+#ifdef __linux__
+
+class IoUringTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    ring_ = IoUring::Create(8);
+    if (!ring_) {
+      GTEST_SKIP() << "io_uring is not available";
+    }
+    temp_dir_ = std::filesystem::temp_directory_path() / "io_uring_tests";
+    std::filesystem::create_directory(temp_dir_);
+  }
+
+  void TearDown() override {
+    std::error_code ec;
+    std::filesystem::remove_all(temp_dir_, ec);
+    (void)ec;
+  }
+
+  std::unique_ptr<IoUring> ring_;
+  std::filesystem::path temp_dir_;
+};
+
+TEST_F(IoUringTest, CapacityIsAtLeastRequested) {
+  EXPECT_GE(ring_->Capacity(), 8u);
+}
+
+TEST_F(IoUringTest, OpensReadsAndClosesFiles) {
+  const std::string content = "hello io_uring";
+  const auto path = temp_dir_ / "file.txt";
+  std::ofstream(path) << content;
+  const auto missing = temp_dir_ / "missing.txt";
+
+  std::int32_t results[2] = {};
+  ring_->PrepareOpenAt(path.c_str(), O_RDONLY | O_CLOEXEC, 0);
+  ring_->PrepareOpenAt(missing.c_str(), O_RDONLY | O_CLOEXEC, 1);
+  ring_->SubmitAndWait([&results](std::uint64_t user_data,
+                                  std::int32_t result) {
+    results[user_data] = result;
+  });
+  ASSERT_GE(results[0], 0);
+  EXPECT_LT(results[1], 0);
+
+  const int fd = results[0];
+  std::vector<char> buffer(64);
+  std::int32_t bytes_read = -1;
+  ring_->PrepareRead(fd, buffer.data(), static_cast<unsigned>(buffer.size()),
+                     0, 7);
+  ring_->SubmitAndWait([&bytes_read](std::uint64_t user_data,
+                                     std::int32_t result) {
+    EXPECT_EQ(user_data, 7u);
+    bytes_read = result;
+  });
+  ASSERT_EQ(bytes_read, static_cast<std::int32_t>(content.size()));
+  EXPECT_EQ(std::string(buffer.data(), content.size()), content);
+
+  std::int32_t close_result = -1;
+  ring_->PrepareClose(fd, 0);
+  ring_->SubmitAndWait([&close_result](std::uint64_t, std::int32_t result) {
+    close_result = result;
+  });
+  EXPECT_EQ(close_result, 0);
+}
+
+TEST_F(IoUringTest, ThrowsWhenSubmissionQueueIsFull) {
+  const auto path = temp_dir_ / "file.txt";
+  std::ofstream(path) << "x";
+  for (unsigned i = 0; i < ring_->Capacity(); ++i) {
+    ring_->PrepareOpenAt(path.c_str(), O_RDONLY | O_CLOEXEC, i);
+  }
+  EXPECT_THROW(ring_->PrepareOpenAt(path.c_str(), O_RDONLY, 0),
+               std::logic_error);
+
+  std::vector<int> fds;
+  ring_->SubmitAndWait([&fds](std::uint64_t, std::int32_t result) {
+    fds.push_back(result);
+  });
+  EXPECT_EQ(fds.size(), ring_->Capacity());
+  for (const int fd : fds) {
+    ASSERT_GE(fd, 0);
+    ring_->PrepareClose(fd, 0);
+  }
+  ring_->SubmitAndWait([](std::uint64_t, std::int32_t) {});
+}
+
+#else
+
+TEST(IoUringTest, IsUnavailableOffLinux) {
+  EXPECT_EQ(IoUring::Create(8), nullptr);
+}
+
+#endif  // __linux__
+
+}  // namespace
+}  // namespace scanner
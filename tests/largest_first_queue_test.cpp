@@ -0,0 +1,72 @@
+#include "src/scanner_lib/largest_first_queue.h"
+
+#include <cstdint>
+
+#include <algorithm>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace scanner {
+namespace {
+
+TEST(LargestFirstQueueTest, EmptyQueuePopsNothing) {
+  LargestFirstQueue queue;
+  EXPECT_FALSE(queue.Pop().has_value());
+}
+
+TEST(LargestFirstQueueTest, PopsLargestFileFirst) {
+  LargestFirstQueue queue;
+  queue.Push("medium", 500);
+  queue.Push("small", 10);
+  queue.Push("huge", 1'000'000);
+  queue.Push("empty", 0);
+
+  EXPECT_EQ(queue.Pop(), std::filesystem::path("huge"));
+  // A larger file pushed later overtakes the remaining ones.
+  queue.Push("large", 900);
+  EXPECT_EQ(queue.Pop(), std::filesystem::path("large"));
+  EXPECT_EQ(queue.Pop(), std::filesystem::path("medium"));
+  EXPECT_EQ(queue.Pop(), std::filesystem::path("small"));
+  EXPECT_EQ(queue.Pop(), std::filesystem::path("empty"));
+  EXPECT_FALSE(queue.Pop().has_value());
+}
+
+TEST(LargestFirstQueueTest, EveryFileIsPoppedOnceUnderContention) {
+  LargestFirstQueue queue;
+  const int kThreads = 4;
+  const int kFilesPerThread = 1000;
+
+  std::vector<std::thread> threads;
+  std::vector<std::vector<std::string>> popped(kThreads);
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < kFilesPerThread; ++i) {
+        queue.Push(std::to_string(t) + "_" + std::to_string(i),
+                   static_cast<std::uint64_t>(i));
+        const std::optional<std::filesystem::path> path = queue.Pop();
+        ASSERT_TRUE(path.has_value());
+        popped[t].push_back(path->string());
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  std::vector<std::string> all;
+  for (const auto& paths : popped) {
+    all.insert(all.end(), paths.begin(), paths.end());
+  }
+  std::sort(all.begin(), all.end());
+  EXPECT_EQ(std::unique(all.begin(), all.end()), all.end());
+  EXPECT_EQ(all.size(), kThreads * kFilesPerThread);
+  EXPECT_FALSE(queue.Pop().has_value());
+}
+
+}  // namespace
+}  // namespace scanner
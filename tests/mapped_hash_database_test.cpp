@@ -0,0 +1,246 @@
+#include "src/scanner_lib/mapped_hash_database.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "scanner/interfaces.h"
+#include "src/scanner_lib/signature_database_format.h"
+
+namespace scanner {
+namespace {
+
+constexpr char kHashA[] = "0cc175b9c0f1b6a831c399e269772661";
+constexpr char kHashB[] = "92eb5ffee6ae2fec3ad71c777531578f";
+constexpr char kHashC[] = "4a8a08f09d37b73795649038408b5f33";
+constexpr char kHashD[] = "8277e0910d750195b448797616e091ad";
+
+Md5Digest Digest(const char* hex) {
+  return *Md5Digest::FromHex(hex);
+}
+
+class MappedHashDatabaseTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    const std::string test_name =
+        ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    temp_dir_ = std::filesystem::temp_directory_path() /
+                ("scanner_sigdb_tests_" + test_name);
+    std::filesystem::create_directory(temp_dir_);
+  }
+
+  void TearDown() override {
+    std::error_code ec;
+    std::filesystem::remove_all(temp_dir_, ec);
+    (void)ec;
+  }
+
+  std::filesystem::path CreateFile(const std::string& filename,
+                                   const std::string& content) const {
+    const std::filesystem::path file_path = temp_dir_ / filename;
+    std::ofstream file(file_path, std::ios::binary);
+    file << content;
+    return file_path;
+  }
+
+  std::filesystem::path Compile(const std::string& csv_content) const {
+    const auto csv_path = CreateFile("base.csv", csv_content);
+    const auto sigdb_path = temp_dir_ / "base.sigdb";
+    CompileSignatureDatabase(csv_path, sigdb_path);
+    return sigdb_path;
+  }
+
+  std::filesystem::path temp_dir_;
+};
+
+TEST_F(MappedHashDatabaseTest, FindsCompiledSignatures) {
+  const auto db_path =
+      Compile(std::string(kHashA) + ";Verdict1\n" + kHashB + ";Verdict2\n" +
+              kHashC + ";Verdict1");
+
+  MappedHashDatabase db;
+  EXPECT_EQ(db.Load(db_path), 3);
+
+  EXPECT_EQ(db.FindHash(Digest(kHashA)).value_or(""), "Verdict1");
+  EXPECT_EQ(db.FindHash(Digest(kHashB)).value_or(""), "Verdict2");
+  EXPECT_EQ(db.FindHash(Digest(kHashC)).value_or(""), "Verdict1");
+  EXPECT_FALSE(db.FindHash(Digest(kHashD)).has_value());
+}
+
+TEST_F(MappedHashDatabaseTest, LastDuplicateWins) {
+  const auto db_path = Compile(std::string(kHashA) + ";Old\n" + kHashB +
+                               ";Other\n" + kHashA + ";New\n");
+
+  MappedHashDatabase db;
+  EXPECT_EQ(db.Load(db_path), 2);
+  EXPECT_EQ(db.FindHash(Digest(kHashA)).value_or(""), "New");
+}
+
+TEST_F(MappedHashDatabaseTest, HandlesEmptyDatabase) {
+  const auto db_path = Compile("");
+
+  MappedHashDatabase db;
+  EXPECT_EQ(db.Load(db_path), 0);
+  EXPECT_FALSE(db.FindHash(Digest(kHashA)).has_value());
+}
+
+TEST_F(MappedHashDatabaseTest, FindsEveryEntryOfLargeDatabase) {
+  // Enough entries to span many buckets.
+  constexpr int kNumEntries = 5000;
+  std::string content;
+  std::vector<Md5Digest> digests;
+  for (int i = 0; i < kNumEntries; ++i) {
+    Md5Digest digest;
+    for (std::size_t j = 0; j < Md5Digest::kSize; ++j) {
+      digest.bytes[j] = static_cast<std::uint8_t>(i * 131 + j * 17);
+    }
+    digest.bytes[14] = static_cast<std::uint8_t>(i >> 8);
+    digest.bytes[15] = static_cast<std::uint8_t>(i);
+    digests.push_back(digest);
+    content += digest.ToHex() + ";Verdict" + std::to_string(i % 7) + "\n";
+  }
+  const auto db_path = Compile(content);
+
+  MappedHashDatabase db;
+  EXPECT_EQ(db.Load(db_path), kNumEntries);
+  for (int i = 0; i < kNumEntries; ++i) {
+    EXPECT_EQ(db.FindHash(digests[i]).value_or(""),
+              "Verdict" + std::to_string(i % 7));
+  }
+  EXPECT_FALSE(db.FindHash(Digest(kHashD)).has_value());
+}
+
+TEST_F(MappedHashDatabaseTest, PrefilterKeepsAllSignatures) {
+  const auto db_path =
+      Compile(std::string(kHashA) + ";Verdict1\n" + kHashB + ";Verdict2\n");
+
+  MappedHashDatabase db(10);
+  EXPECT_EQ(db.Load(db_path), 2);
+  EXPECT_EQ(db.FindHash(Digest(kHashA)).value_or(""), "Verdict1");
+  EXPECT_EQ(db.FindHash(Digest(kHashB)).value_or(""), "Verdict2");
+  EXPECT_FALSE(db.FindHash(Digest(kHashC)).has_value());
+
+  const auto stats = db.GetPrefilterStats();
+  ASSERT_TRUE(stats.has_value());
+  EXPECT_GT(stats->memory_bytes, 0);
+}
+
+TEST_F(MappedHashDatabaseTest, ReplacesPreviousDataOnLoad) {
+  const auto csv1 = CreateFile("db1.csv", std::string(kHashA) + ";VerdictA");
+  const auto csv2 = CreateFile("db2.csv", std::string(kHashB) + ";VerdictB");
+  CompileSignatureDatabase(csv1, temp_dir_ / "db1.sigdb");
+  CompileSignatureDatabase(csv2, temp_dir_ / "db2.sigdb");
+
+  MappedHashDatabase db;
+  db.Load(temp_dir_ / "db1.sigdb");
+  ASSERT_TRUE(db.FindHash(Digest(kHashA)).has_value());
+
+  EXPECT_EQ(db.Load(temp_dir_ / "db2.sigdb"), 1);
+  EXPECT_FALSE(db.FindHash(Digest(kHashA)).has_value());
+  EXPECT_TRUE(db.FindHash(Digest(kHashB)).has_value());
+}
+
+TEST_F(MappedHashDatabaseTest, StoresSampleSizesAndPrefixes) {
+  const auto db_path =
+      Compile(std::string(kHashA) + ";Verdict1;100\n" + kHashB +
+              ";Verdict2;5000;" + kHashC + "\n" + kHashD + ";Verdict3;100");
+
+  MappedHashDatabase db;
+  EXPECT_EQ(db.Load(db_path), 3);
+  EXPECT_EQ(db.FindHash(Digest(kHashB)).value_or(""), "Verdict2");
+
+  ASSERT_TRUE(db.HasSizeIndex());
+  EXPECT_TRUE(db.MayMatchSize(100));
+  EXPECT_TRUE(db.MayMatchSize(5000));
+  EXPECT_FALSE(db.MayMatchSize(101));
+
+  ASSERT_TRUE(db.HasPrefixIndex());
+  EXPECT_TRUE(db.MayMatchPrefix(Digest(kHashC)));
+  EXPECT_FALSE(db.MayMatchPrefix(Digest(kHashA)));
+}
+
+TEST_F(MappedHashDatabaseTest, OmitsIncompleteSampleIndex) {
+  const auto db_path = Compile(std::string(kHashA) + ";Verdict1;100\n" +
+                               kHashB + ";Verdict2;5000\n" + kHashC +
+                               ";Verdict3");
+
+  MappedHashDatabase db;
+  EXPECT_EQ(db.Load(db_path), 3);
+  EXPECT_FALSE(db.HasSizeIndex());
+  EXPECT_TRUE(db.MayMatchSize(101));
+  EXPECT_FALSE(db.HasPrefixIndex());
+  EXPECT_TRUE(db.MayMatchPrefix(Digest(kHashA)));
+}
+
+TEST_F(MappedHashDatabaseTest, LoadsVersion1Files) {
+  // One signature, laid out by hand as version 1 wrote it.
+  sigdb::FileHeader header{};
+  std::memcpy(header.magic, sigdb::kMagic, sizeof(header.magic));
+  header.version = 1;
+  header.byte_order_mark = sigdb::kByteOrderMark;
+  header.bucket_bits = 0;
+  header.verdict_count = 1;
+  header.entry_count = 1;
+  header.buckets_offset = 80;
+  header.digests_offset = 96;
+  header.verdict_ids_offset = 112;
+  header.verdict_offsets_offset = 128;
+  header.strings_offset = 144;
+  header.strings_size = 8;
+
+  std::string content(152, '\0');
+  std::memcpy(content.data(), &header, sigdb::kVersion1HeaderSize);
+  const std::uint32_t buckets[] = {0, 1};
+  std::memcpy(content.data() + 80, buckets, sizeof(buckets));
+  const Md5Digest digest = Digest(kHashA);
+  std::memcpy(content.data() + 96, digest.bytes.data(), Md5Digest::kSize);
+  const std::uint32_t verdict_offsets[] = {0, 8};
+  std::memcpy(content.data() + 128, verdict_offsets, sizeof(verdict_offsets));
+  std::memcpy(content.data() + 144, "Verdict1", 8);
+  const auto db_path = CreateFile("v1.sigdb", content);
+
+  MappedHashDatabase db;
+  EXPECT_EQ(db.Load(db_path), 1);
+  EXPECT_EQ(db.FindHash(digest).value_or(""), "Verdict1");
+  EXPECT_FALSE(db.HasSizeIndex());
+  EXPECT_FALSE(db.HasPrefixIndex());
+}
+
+TEST_F(MappedHashDatabaseTest, RejectsCsvFile) {
+  const auto csv_path = CreateFile("plain.csv", std::string(kHashA) +
+                                                    ";Verdict1\n" + kHashB +
+                                                    ";Verdict2\n" + kHashC +
+                                                    ";Verdict3\n");
+  MappedHashDatabase db;
+  EXPECT_THROW(static_cast<void>(db.Load(csv_path)), std::runtime_error);
+}
+
+TEST_F(MappedHashDatabaseTest, RejectsTruncatedFile) {
+  const auto db_path = Compile(std::string(kHashA) + ";Verdict1");
+  std::filesystem::resize_file(db_path, 100);
+
+  MappedHashDatabase db;
+  EXPECT_THROW(static_cast<void>(db.Load(db_path)), std::runtime_error);
+}
+
+TEST_F(MappedHashDatabaseTest, ThrowsOnNonExistentFile) {
+  MappedHashDatabase db;
+  EXPECT_THROW(static_cast<void>(db.Load(temp_dir_ / "missing.sigdb")),
+               std::runtime_error);
+}
+
+TEST_F(MappedHashDatabaseTest, CompileThrowsOnNonExistentSource) {
+  EXPECT_THROW(static_cast<void>(CompileSignatureDatabase(
+                   temp_dir_ / "missing.csv", temp_dir_ / "out.sigdb")),
+               std::runtime_error);
+  EXPECT_FALSE(std::filesystem::exists(temp_dir_ / "out.sigdb"));
+}
+
+}  // namespace
+}  // namespace scanner
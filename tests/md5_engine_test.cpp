@@ -0,0 +1,70 @@
+#include "src/scanner_lib/md5_engine.h"
+
+#include <cstdint>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace scanner {
+namespace {
+
+std::string HashString(const std::string& input) {
+  Md5Engine engine;
+  engine.Update(reinterpret_cast<const std::uint8_t*>(input.data()),
+                input.size());
+  return engine.Final().ToHex();
+}
+
+TEST(Md5EngineTest, MatchesRfc1321TestSuite) {
+  const std::vector<std::pair<std::string, std::string>> vectors = {
+      {"", "d41d8cd98f00b204e9800998ecf8427e"},
+      {"a", "0cc175b9c0f1b6a831c399e269772661"},
+      {"abc", "900150983cd24fb0d6963f7d28e17f72"},
+      {"message digest", "f96b697d7cb7938d525a2f31aaf161d0"},
+      {"abcdefghijklmnopqrstuvwxyz", "c3fcd3d76192e4007dfb496cca67e13b"},
+      {"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+       "d174ab98d277d9f5a5611c2c9f419d9f"},
+      {"1234567890123456789012345678901234567890123456789012345678901234567"
+       "8901234567890",
+       "57edf4a22be3c955ac49da2e2107b67a"},
+  };
+  for (const auto& [input, expected] : vectors) {
+    EXPECT_EQ(HashString(input), expected) << '"' << input << '"';
+  }
+}
+
+TEST(Md5EngineTest, IncrementalUpdatesMatchSingleUpdate) {
+  std::vector<std::uint8_t> data(1000);
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<std::uint8_t>(i * 13);
+  }
+
+  Md5Engine whole;
+  whole.Update(data.data(), data.size());
+  const Md5Digest expected = whole.Final();
+
+  for (const std::size_t piece : {1, 7, 63, 64, 65, 333}) {
+    Md5Engine engine;
+    for (std::size_t offset = 0; offset < data.size(); offset += piece) {
+      const std::size_t size = std::min(piece, data.size() - offset);
+      engine.Update(data.data() + offset, size);
+    }
+    EXPECT_EQ(engine.Final(), expected) << "piece size " << piece;
+  }
+}
+
+TEST(Md5EngineTest, FinalResetsTheEngine) {
+  Md5Engine engine;
+  const std::string input = "abc";
+  engine.Update(reinterpret_cast<const std::uint8_t*>(input.data()),
+                input.size());
+  static_cast<void>(engine.Final());
+  EXPECT_EQ(engine.Final().ToHex(), "d41d8cd98f00b204e9800998ecf8427e");
+}
+
+}  // namespace
+}  // namespace scanner
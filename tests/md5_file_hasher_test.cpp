@@ -4,6 +4,7 @@
 #include <fstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -43,13 +44,13 @@ std::filesystem::path Md5FileHasherTest::empty_file_path_;
 TEST_F(Md5FileHasherTest, HashesKnownFileCorrectly) {
   Md5FileHasher hasher;
   const std::string expected_hash = "5eb63bbbe01eeed093cb22bb8f5acdc3";
-  EXPECT_EQ(hasher.HashFile(known_content_path_), expected_hash);
+  EXPECT_EQ(hasher.HashFile(known_content_path_).ToHex(), expected_hash);
 }
 
 TEST_F(Md5FileHasherTest, HashesEmptyFileCorrectly) {
   Md5FileHasher hasher;
   const std::string expected_hash = "d41d8cd98f00b204e9800998ecf8427e";
-  EXPECT_EQ(hasher.HashFile(empty_file_path_), expected_hash);
+  EXPECT_EQ(hasher.HashFile(empty_file_path_).ToHex(), expected_hash);
 }
 
 TEST_F(Md5FileHasherTest, ThrowsOnNonExistentFile) {
@@ -60,5 +61,74 @@ TEST_F(Md5FileHasherTest, ThrowsOnNonExistentFile) {
                std::runtime_error);
 }
 
+TEST_F(Md5FileHasherTest, HashFilesMatchesHashFileForEachIsa) {
+  // Sizes straddle the padding boundaries and the batching size limit.
+  const std::vector<std::size_t> sizes = {0,   1,   55,   56,     63,
+                                          64,  65,  119,  120,    128,
+                                          500, 4096, 70000, 200000, 3};
+  std::vector<std::filesystem::path> paths;
+  for (std::size_t i = 0; i < sizes.size(); ++i) {
+    paths.push_back(temp_dir_ / ("batch_" + std::to_string(i) + ".bin"));
+    std::ofstream file(paths.back(), std::ios::binary);
+    for (std::size_t j = 0; j < sizes[i]; ++j) {
+      file.put(static_cast<char>((i * 31 + j * 7) & 0xFF));
+    }
+  }
+  paths.push_back(temp_dir_ / "non_existent.bin");
+
+  for (const Md5Isa isa : {Md5Isa::kScalar, Md5Isa::kSse2, Md5Isa::kAvx2,
+                           Md5Isa::kAvx512}) {
+    if (!Md5MultiBuffer::IsSupported(isa)) {
+      continue;
+    }
+    Md5FileHasher hasher(isa);
+    std::vector<FileHashResult> results;
+    hasher.HashFiles(paths, results);
+
+    ASSERT_EQ(results.size(), paths.size());
+    for (std::size_t i = 0; i + 1 < paths.size(); ++i) {
+      ASSERT_FALSE(results[i].error) << paths[i];
+      EXPECT_EQ(results[i].md5, hasher.HashFile(paths[i])) << paths[i];
+    }
+    EXPECT_TRUE(results.back().error);
+  }
+}
+
+TEST_F(Md5FileHasherTest, HashFilesThroughIoUringMatchesHashFile) {
+  std::vector<std::filesystem::path> paths = {known_content_path_,
+                                              empty_file_path_};
+  for (std::size_t i = 0; i < 40; ++i) {
+    paths.push_back(temp_dir_ / ("uring_" + std::to_string(i) + ".bin"));
+    std::ofstream(paths.back(), std::ios::binary) << std::string(i * 97, 'u');
+  }
+  paths.push_back(temp_dir_ / "non_existent.bin");
+
+  IoOptions io_options;
+  io_options.strategy = IoStrategy::kIoUring;
+  Md5FileHasher hasher(Md5MultiBuffer::BestIsa(), io_options);
+  EXPECT_GE(hasher.PreferredBatchSize(), Md5FileHasher::kMinIoUringBatchSize);
+
+  std::vector<FileHashResult> results;
+  hasher.HashFiles(paths, results);
+  ASSERT_EQ(results.size(), paths.size());
+  for (std::size_t i = 0; i + 1 < paths.size(); ++i) {
+    ASSERT_FALSE(results[i].error) << paths[i];
+    EXPECT_EQ(results[i].md5, hasher.HashFile(paths[i])) << paths[i];
+  }
+  EXPECT_TRUE(results.back().error);
+}
+
+TEST_F(Md5FileHasherTest, ReportsBatchingLimits) {
+  Md5FileHasher scalar_hasher(Md5Isa::kScalar);
+  EXPECT_EQ(scalar_hasher.PreferredBatchSize(), 1);
+  EXPECT_EQ(scalar_hasher.MaxBatchedFileSize(), 0);
+
+  Md5FileHasher best_hasher;
+  if (best_hasher.PreferredBatchSize() > 1) {
+    EXPECT_EQ(best_hasher.MaxBatchedFileSize(),
+              Md5FileHasher::kMaxBatchedFileSize);
+  }
+}
+
 }  // namespace
 }  // namespace scanner
\ No newline at end of file
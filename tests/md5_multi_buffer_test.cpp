@@ -0,0 +1,85 @@
+#include "src/scanner_lib/md5_multi_buffer.h"
+
+#include <cstdint>
+
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/scanner_lib/md5_engine.h"
+
+namespace scanner {
+namespace {
+
+Md5Digest HashScalar(const std::vector<std::uint8_t>& data) {
+  Md5Engine engine;
+  engine.Update(data.data(), data.size());
+  return engine.Final();
+}
+
+class Md5MultiBufferTest : public ::testing::TestWithParam<Md5Isa> {
+protected:
+  void SetUp() override {
+    if (!Md5MultiBuffer::IsSupported(GetParam())) {
+      GTEST_SKIP() << "Instruction set not supported by this CPU";
+    }
+  }
+
+  // Hashes the messages in one call and compares against the scalar engine.
+  void ExpectMatchesScalar(const std::vector<std::size_t>& sizes) {
+    std::vector<std::vector<std::uint8_t>> data(sizes.size());
+    std::vector<HashMessage> messages;
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+      data[i].resize(sizes[i]);
+      for (std::size_t j = 0; j < sizes[i]; ++j) {
+        data[i][j] = static_cast<std::uint8_t>(i * 29 + j * 3 + (j >> 8));
+      }
+      messages.push_back({data[i].data(), data[i].size()});
+    }
+
+    const Md5MultiBuffer multi_buffer(GetParam());
+    std::vector<Md5Digest> digests(messages.size());
+    multi_buffer.Hash(messages.data(), messages.size(), digests.data());
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+      EXPECT_EQ(digests[i], HashScalar(data[i])) << "message " << i
+                                                 << ", size " << sizes[i];
+    }
+  }
+};
+
+TEST_P(Md5MultiBufferTest, HashesMessagesAroundPaddingBoundaries) {
+  ExpectMatchesScalar({0, 1, 55, 56, 57, 63, 64, 65, 119, 120, 127, 128});
+}
+
+TEST_P(Md5MultiBufferTest, HashesMixedLengthsWithLaneRefills) {
+  std::vector<std::size_t> sizes;
+  for (std::size_t i = 0; i < 50; ++i) {
+    sizes.push_back((i * 977) % 5000);
+  }
+  sizes.push_back(100000);
+  ExpectMatchesScalar(sizes);
+}
+
+TEST_P(Md5MultiBufferTest, HashesFewerMessagesThanLanes) {
+  ExpectMatchesScalar({});
+  ExpectMatchesScalar({10});
+  ExpectMatchesScalar({10, 200});
+  ExpectMatchesScalar({64, 64, 64});
+}
+
+INSTANTIATE_TEST_SUITE_P(AllIsas, Md5MultiBufferTest,
+                         ::testing::Values(Md5Isa::kScalar, Md5Isa::kSse2,
+                                           Md5Isa::kAvx2, Md5Isa::kAvx512));
+
+TEST(Md5MultiBufferIsaTest, BestIsaIsSupported) {
+  const Md5Isa best = Md5MultiBuffer::BestIsa();
+  EXPECT_TRUE(Md5MultiBuffer::IsSupported(best));
+  EXPECT_EQ(Md5MultiBuffer(best).Isa(), best);
+}
+
+TEST(Md5MultiBufferIsaTest, ScalarUsesOneLane) {
+  EXPECT_EQ(Md5MultiBuffer(Md5Isa::kScalar).Lanes(), 1);
+}
+
+}  // namespace
+}  // namespace scanner
@@ -0,0 +1,91 @@
+#include "src/scanner_lib/mpsc_ring.h"
+
+#include <atomic>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace scanner {
+namespace {
+
+TEST(MpscRingTest, RoundsCapacityUpToAPowerOfTwo) {
+  EXPECT_EQ(MpscRing<int>(0).Capacity(), 2);
+  EXPECT_EQ(MpscRing<int>(5).Capacity(), 8);
+  EXPECT_EQ(MpscRing<int>(16).Capacity(), 16);
+}
+
+TEST(MpscRingTest, PopsItemsInFifoOrder) {
+  MpscRing<int> ring(4);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(ring.TryPush([i](int& slot) { slot = i; }),
+              std::optional<std::size_t>(i));
+  }
+  for (int i = 0; i < 3; ++i) {
+    int value = -1;
+    ASSERT_TRUE(ring.TryPop([&value](int& slot) { value = slot; }));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(ring.TryPop([](int&) {}));
+}
+
+TEST(MpscRingTest, RejectsPushesWhenFull) {
+  MpscRing<int> ring(2);
+  ASSERT_TRUE(ring.TryPush([](int& slot) { slot = 1; }));
+  ASSERT_TRUE(ring.TryPush([](int& slot) { slot = 2; }));
+  EXPECT_FALSE(ring.TryPush([](int& slot) { slot = 3; }));
+
+  ASSERT_TRUE(ring.TryPop([](int&) {}));
+  // Positions keep counting across wrap-arounds.
+  EXPECT_EQ(ring.TryPush([](int& slot) { slot = 3; }),
+            std::optional<std::size_t>(2));
+}
+
+TEST(MpscRingTest, DeliversEveryItemOnceInPerProducerOrder) {
+  constexpr int kProducers = 4;
+  constexpr int kItemsPerProducer = 20000;
+  struct Item {
+    int producer = 0;
+    int sequence = 0;
+  };
+  MpscRing<Item> ring(64);
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&ring, p] {
+      for (int i = 0; i < kItemsPerProducer; ++i) {
+        while (!ring.TryPush([p, i](Item& slot) { slot = Item{p, i}; })) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  std::vector<int> next(kProducers, 0);
+  int received = 0;
+  bool in_order = true;
+  while (received < kProducers * kItemsPerProducer) {
+    const bool popped = ring.TryPop([&](Item& item) {
+      in_order = in_order && item.sequence == next[item.producer];
+      next[item.producer] = item.sequence + 1;
+    });
+    if (popped) {
+      received++;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  for (std::thread& producer : producers) {
+    producer.join();
+  }
+
+  EXPECT_TRUE(in_order);
+  EXPECT_FALSE(ring.TryPop([](Item&) {}));
+  for (int p = 0; p < kProducers; ++p) {
+    EXPECT_EQ(next[p], kItemsPerProducer);
+  }
+}
+
+}  // namespace
+}  // namespace scanner
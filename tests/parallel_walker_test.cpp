@@ -0,0 +1,243 @@
+#include "src/scanner_lib/parallel_walker.h"
+
+#include <cstdint>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/scanner_lib/thread_pool.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace scanner {
+namespace {
+
+class ParallelWalkerTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    const std::string test_name =
+        ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    temp_dir_ = std::filesystem::temp_directory_path() /
+                ("parallel_walker_tests_" + test_name);
+    std::filesystem::create_directories(temp_dir_);
+  }
+
+  void TearDown() override {
+    std::error_code ec;
+    std::filesystem::permissions(temp_dir_ / "locked",
+                                 std::filesystem::perms::owner_all, ec);
+    std::filesystem::remove_all(temp_dir_, ec);
+    (void)ec;
+  }
+
+  void CreateFile(const std::filesystem::path& path, std::size_t size) {
+    std::filesystem::create_directories((temp_dir_ / path).parent_path());
+    std::ofstream file(temp_dir_ / path, std::ios::binary);
+    file << std::string(size, 'x');
+  }
+
+  // Walks root and returns the files found, keyed by path, with their sizes.
+  std::map<std::filesystem::path, std::uint64_t> Walk(
+      const std::filesystem::path& root, const PathFilter* filter = nullptr) {
+    std::map<std::filesystem::path, std::uint64_t> files;
+    std::mutex mutex;
+    ThreadPool pool(4);
+    ParallelWalker walker(
+        pool,
+        [&](std::vector<WalkedFile>& batch) {
+          std::lock_guard<std::mutex> lock(mutex);
+          for (const WalkedFile& file : batch) {
+            EXPECT_TRUE(files.emplace(file.path, file.size).second)
+                << "Reported twice: " << file.path;
+          }
+        },
+        [this](const std::filesystem::path&, const std::string&) {
+          errors_++;
+        },
+        nullptr, nullptr, filter);
+    walker.Walk(root);
+    return files;
+  }
+
+  std::filesystem::path temp_dir_;
+  std::atomic<int> errors_{0};
+};
+
+TEST_F(ParallelWalkerTest, FindsEveryFileOnceWithItsSize) {
+  std::map<std::filesystem::path, std::uint64_t> expected;
+  for (int i = 0; i < 8; ++i) {
+    const std::filesystem::path dir = "d" + std::to_string(i);
+    for (int j = 0; j < 8; ++j) {
+      const auto relative = dir / ("e" + std::to_string(j)) / "file.bin";
+      CreateFile(relative, i * 8 + j);
+      expected[temp_dir_ / relative] = i * 8 + j;
+    }
+    CreateFile(dir / "top.txt", 3);
+    expected[temp_dir_ / dir / "top.txt"] = 3;
+  }
+  std::filesystem::create_directories(temp_dir_ / "empty" / "dir");
+
+  EXPECT_EQ(Walk(temp_dir_), expected);
+  EXPECT_EQ(errors_.load(), 0);
+}
+
+TEST_F(ParallelWalkerTest, WalksTreesWiderThanTheOpenDirectoryLimit) {
+  const std::size_t kDirectories = ParallelWalker::kMaxOpenDirectories + 64;
+  for (std::size_t i = 0; i < kDirectories; ++i) {
+    CreateFile(std::filesystem::path("w" + std::to_string(i)) / "sub" / "f",
+               1);
+  }
+
+  EXPECT_EQ(Walk(temp_dir_).size(), kDirectories);
+  EXPECT_EQ(errors_.load(), 0);
+}
+
+TEST_F(ParallelWalkerTest, ReportsListedOnceAfterEveryDirectory) {
+  for (int i = 0; i < 16; ++i) {
+    CreateFile(std::filesystem::path("l" + std::to_string(i % 4)) /
+                   ("m" + std::to_string(i)) / "f",
+               1);
+  }
+
+  for (const auto& root : {temp_dir_, temp_dir_ / "missing"}) {
+    std::atomic<int> files{0};
+    std::atomic<int> listed_calls{0};
+    std::atomic<int> files_when_listed{-1};
+    ThreadPool pool(4);
+    ParallelWalker walker(
+        pool,
+        [&](std::vector<WalkedFile>& batch) {
+          files += static_cast<int>(batch.size());
+        },
+        [](const std::filesystem::path&, const std::string&) {}, nullptr,
+        [&] {
+          listed_calls++;
+          files_when_listed = files.load();
+        });
+    walker.Walk(root);
+    EXPECT_EQ(listed_calls.load(), 1);
+    EXPECT_EQ(files_when_listed.load(), files.load());
+  }
+}
+
+TEST_F(ParallelWalkerTest, AppliesExclusionsDepthAndSizeLimits) {
+  CreateFile("keep/a.txt", 1);
+  CreateFile("keep/big.bin", 100);
+  CreateFile("node_modules/x.js", 1);
+  CreateFile("src/.git/objects/o", 1);
+  CreateFile("src/deep/g.txt", 1);
+  CreateFile("src/deep/er/f.txt", 1);
+  CreateFile("top.log", 1);
+  TraversalFilter rules;
+  rules.exclude = {"node_modules", ".git", "*.log"};
+  rules.max_file_size = 50;
+  rules.max_depth = 2;
+  const PathFilter filter(rules);
+
+  const std::map<std::filesystem::path, std::uint64_t> expected = {
+      {temp_dir_ / "keep" / "a.txt", 1},
+      {temp_dir_ / "src" / "deep" / "g.txt", 1},
+  };
+  EXPECT_EQ(Walk(temp_dir_, &filter), expected);
+  EXPECT_EQ(errors_.load(), 0);
+}
+
+TEST_F(ParallelWalkerTest, InclusionsSelectFilesButDoNotPruneDirectories) {
+  CreateFile("a.exe", 1);
+  CreateFile("sub/b.exe", 2);
+  CreateFile("sub/c.txt", 3);
+  CreateFile("bin/x/y.dat", 4);
+  TraversalFilter rules;
+  rules.include = {"*.exe", "bin/**"};
+  const PathFilter filter(rules);
+
+  const std::map<std::filesystem::path, std::uint64_t> expected = {
+      {temp_dir_ / "a.exe", 1},
+      {temp_dir_ / "sub" / "b.exe", 2},
+      {temp_dir_ / "bin" / "x" / "y.dat", 4},
+  };
+  EXPECT_EQ(Walk(temp_dir_, &filter), expected);
+}
+
+TEST_F(ParallelWalkerTest, OneFileSystemKeepsTheScannedFilesystem) {
+  CreateFile("a/b/c.bin", 5);
+  TraversalFilter rules;
+  rules.one_file_system = true;
+  const PathFilter filter(rules);
+
+  const std::map<std::filesystem::path, std::uint64_t> expected = {
+      {temp_dir_ / "a" / "b" / "c.bin", 5},
+  };
+  EXPECT_EQ(Walk(temp_dir_, &filter), expected);
+}
+
+TEST_F(ParallelWalkerTest, ReportsMissingRoot) {
+  EXPECT_TRUE(Walk(temp_dir_ / "missing").empty());
+  EXPECT_EQ(errors_.load(), 1);
+}
+
+#ifndef _WIN32
+
+TEST_F(ParallelWalkerTest, ReportsFileLinksButDoesNotFollowDirectoryLinks) {
+  CreateFile("real/file.txt", 5);
+  std::filesystem::create_symlink(temp_dir_ / "real" / "file.txt",
+                                  temp_dir_ / "file_link");
+  std::filesystem::create_directory_symlink(temp_dir_ / "real",
+                                            temp_dir_ / "dir_link");
+  std::filesystem::create_symlink(temp_dir_ / "nowhere",
+                                  temp_dir_ / "dangling_link");
+
+  const std::map<std::filesystem::path, std::uint64_t> expected = {
+      {temp_dir_ / "file_link", 5},
+      {temp_dir_ / "real" / "file.txt", 5},
+  };
+  EXPECT_EQ(Walk(temp_dir_), expected);
+  EXPECT_EQ(errors_.load(), 0);
+}
+
+TEST_F(ParallelWalkerTest, FollowsARootThatIsALink) {
+  CreateFile("real/file.txt", 5);
+  std::filesystem::create_directory_symlink(temp_dir_ / "real",
+                                            temp_dir_ / "root_link");
+
+  EXPECT_EQ(Walk(temp_dir_ / "root_link").size(), 1);
+  EXPECT_EQ(errors_.load(), 0);
+}
+
+TEST_F(ParallelWalkerTest, SkipsDirectoriesWithoutPermission) {
+  if (::geteuid() == 0) {
+    GTEST_SKIP() << "Permissions are not enforced for root";
+  }
+  CreateFile("locked/file.txt", 1);
+  CreateFile("open/file.txt", 1);
+  std::filesystem::permissions(temp_dir_ / "locked",
+                               std::filesystem::perms::none);
+
+  EXPECT_EQ(Walk(temp_dir_).size(), 1);
+  EXPECT_EQ(errors_.load(), 0);
+}
+
+TEST_F(ParallelWalkerTest, ReportsAnUnreadableRoot) {
+  if (::geteuid() == 0) {
+    GTEST_SKIP() << "Permissions are not enforced for root";
+  }
+  CreateFile("locked/file.txt", 1);
+  std::filesystem::permissions(temp_dir_ / "locked",
+                               std::filesystem::perms::none);
+
+  EXPECT_TRUE(Walk(temp_dir_ / "locked").empty());
+  EXPECT_EQ(errors_.load(), 1);
+}
+
+#endif
+
+}  // namespace
+}  // namespace scanner
@@ -0,0 +1,120 @@
+#include "src/scanner_lib/path_filter.h"
+
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace scanner {
+namespace {
+
+TEST(GlobTest, StarAndQuestionMarkStayWithinAComponent) {
+  const Glob glob("*.t?t");
+  EXPECT_TRUE(glob.Matches("notes.txt"));
+  EXPECT_TRUE(glob.Matches(".tat"));
+  EXPECT_FALSE(glob.Matches("notes.text"));
+  EXPECT_FALSE(glob.Matches("dir/notes.txt"));
+  EXPECT_FALSE(glob.MatchesPaths());
+}
+
+TEST(GlobTest, GlobstarMatchesAnyNumberOfComponents) {
+  const Glob glob("src/**/test_*.cpp");
+  EXPECT_TRUE(glob.MatchesPaths());
+  EXPECT_TRUE(glob.Matches("src/test_a.cpp"));
+  EXPECT_TRUE(glob.Matches("src/a/b/test_c.cpp"));
+  EXPECT_FALSE(glob.Matches("lib/src/test_a.cpp"));
+
+  const Glob tail("build/**");
+  EXPECT_TRUE(tail.Matches("build/"));
+  EXPECT_TRUE(tail.Matches("build/x/y.o"));
+  EXPECT_FALSE(tail.Matches("builds/x"));
+
+  const Glob leading("**/cache");
+  EXPECT_TRUE(leading.Matches("cache"));
+  EXPECT_TRUE(leading.Matches("a/b/cache"));
+  EXPECT_FALSE(leading.Matches("a/b/cache/x"));
+}
+
+TEST(GlobTest, ClassesRangesNegationAndEscapes) {
+  const Glob digits("v[0-9][!a-z]");
+  EXPECT_TRUE(digits.Matches("v1A"));
+  EXPECT_FALSE(digits.Matches("v1a"));
+  EXPECT_FALSE(digits.Matches("vx1"));
+
+  const Glob escaped("\\*.\\[");
+  EXPECT_TRUE(escaped.Matches("*.["));
+  EXPECT_FALSE(escaped.Matches("a.["));
+
+  // An unterminated class matches itself.
+  EXPECT_TRUE(Glob("a[b").Matches("a[b"));
+}
+
+TEST(GlobTest, ReportsLiteralPatterns) {
+  EXPECT_EQ(Glob("node_modules").Literal(), "node_modules");
+  EXPECT_FALSE(Glob("*.o").Literal().has_value());
+  EXPECT_TRUE(Glob("/proc").MatchesPaths());
+  EXPECT_TRUE(Glob("/proc").Matches("proc"));
+}
+
+TEST(PathFilterTest, DefaultFilterIsInactive) {
+  EXPECT_FALSE(PathFilter().Active());
+  EXPECT_FALSE(PathFilter(TraversalFilter()).Active());
+}
+
+TEST(PathFilterTest, ExcludesByNameAtAnyDepthAndByPath) {
+  TraversalFilter rules;
+  rules.exclude = {".git", "*.tmp", "/media/raw"};
+  const PathFilter filter(rules);
+  ASSERT_TRUE(filter.Active());
+
+  EXPECT_TRUE(filter.ExcludesDirectory(".git"));
+  EXPECT_TRUE(filter.ExcludesDirectory("a/b/.git"));
+  EXPECT_TRUE(filter.ExcludesDirectory("media/raw"));
+  EXPECT_FALSE(filter.ExcludesDirectory("other/media/raw"));
+  EXPECT_FALSE(filter.ExcludesDirectory("a/b"));
+  EXPECT_TRUE(filter.ExcludesFile("a/x.tmp"));
+  EXPECT_FALSE(filter.ExcludesFile("a/x.txt"));
+}
+
+TEST(PathFilterTest, InclusionsApplyToFilesOnly) {
+  TraversalFilter rules;
+  rules.include = {"*.exe"};
+  const PathFilter filter(rules);
+
+  EXPECT_FALSE(filter.ExcludesFile("a/b.exe"));
+  EXPECT_TRUE(filter.ExcludesFile("a/b.dll"));
+  EXPECT_FALSE(filter.ExcludesDirectory("a"));
+}
+
+TEST(PathFilterTest, LimitsDepthAndSize) {
+  TraversalFilter rules;
+  rules.max_depth = 1;
+  rules.max_file_size = 10;
+  const PathFilter filter(rules);
+
+  EXPECT_FALSE(filter.ExcludesDirectory("a"));
+  EXPECT_TRUE(filter.ExcludesDirectory("a/b"));
+  EXPECT_TRUE(filter.LimitsSize());
+  EXPECT_FALSE(filter.ExceedsSize(10));
+  EXPECT_TRUE(filter.ExceedsSize(11));
+
+  rules.max_depth = 0;
+  EXPECT_TRUE(PathFilter(rules).ExcludesDirectory("a"));
+}
+
+TEST(PathFilterTest, ThrowsOnEmptyPattern) {
+  TraversalFilter rules;
+  rules.exclude = {""};
+  EXPECT_THROW(PathFilter filter(rules), std::runtime_error);
+}
+
+TEST(PathFilterTest, RelativeTextStripsTheRoot) {
+  const std::filesystem::path root = std::filesystem::path("scan") / "root";
+  const std::size_t prefix = PathFilter::PrefixLength(root);
+  EXPECT_EQ(PathFilter::RelativeText(root / "a" / "b.txt", prefix), "a/b.txt");
+  EXPECT_EQ(PathFilter::PrefixLength(root / ""), prefix);
+}
+
+}  // namespace
+}  // namespace scanner
@@ -0,0 +1,93 @@
+#include "src/scanner_lib/read_order_queue.h"
+
+#include <cstdint>
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace scanner {
+namespace {
+
+TEST(ReadOrderQueueTest, HoldsFilesUntilTheWindowIsFull) {
+  ReadOrderQueue queue(3);
+  EXPECT_EQ(queue.Push("c", 30), 0u);
+  EXPECT_EQ(queue.Push("a", 10), 0u);
+  EXPECT_FALSE(queue.Pop().has_value());
+
+  EXPECT_EQ(queue.Push("b", 20), 3u);
+  EXPECT_EQ(queue.Pop(), std::filesystem::path("a"));
+  EXPECT_EQ(queue.Pop(), std::filesystem::path("b"));
+  EXPECT_EQ(queue.Pop(), std::filesystem::path("c"));
+  EXPECT_FALSE(queue.Pop().has_value());
+}
+
+TEST(ReadOrderQueueTest, SortsEachWindowOnItsOwn) {
+  ReadOrderQueue queue(2);
+  EXPECT_EQ(queue.Push("late", 9), 0u);
+  EXPECT_EQ(queue.Push("early", 1), 2u);
+  // A lower key in the next window does not overtake released files.
+  EXPECT_EQ(queue.Push("first", 0), 0u);
+  EXPECT_EQ(queue.Flush(), 1u);
+
+  EXPECT_EQ(queue.Pop(), std::filesystem::path("early"));
+  EXPECT_EQ(queue.Pop(), std::filesystem::path("late"));
+  EXPECT_EQ(queue.Pop(), std::filesystem::path("first"));
+  EXPECT_FALSE(queue.Pop().has_value());
+}
+
+TEST(ReadOrderQueueTest, EqualKeysKeepDiscoveryOrder) {
+  ReadOrderQueue queue(8);
+  queue.Push("x", 5);
+  queue.Push("y", 5);
+  queue.Push("z", 1);
+  EXPECT_EQ(queue.Flush(), 3u);
+  EXPECT_EQ(queue.Flush(), 0u);
+
+  EXPECT_EQ(queue.Pop(), std::filesystem::path("z"));
+  EXPECT_EQ(queue.Pop(), std::filesystem::path("x"));
+  EXPECT_EQ(queue.Pop(), std::filesystem::path("y"));
+}
+
+TEST(ReadOrderQueueTest, EveryFileIsReleasedOnceUnderContention) {
+  ReadOrderQueue queue(64);
+  const int kThreads = 4;
+  const int kFilesPerThread = 1000;
+
+  std::vector<std::thread> threads;
+  std::vector<std::vector<std::string>> popped(kThreads);
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < kFilesPerThread; ++i) {
+        const std::size_t released =
+            queue.Push(std::to_string(t) + "_" + std::to_string(i),
+                       static_cast<std::uint64_t>(kFilesPerThread - i));
+        for (std::size_t j = 0; j < released; ++j) {
+          popped[t].push_back(queue.Pop()->string());
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  for (std::size_t released = queue.Flush(); released > 0; --released) {
+    popped[0].push_back(queue.Pop()->string());
+  }
+
+  std::vector<std::string> all;
+  for (const auto& paths : popped) {
+    all.insert(all.end(), paths.begin(), paths.end());
+  }
+  std::sort(all.begin(), all.end());
+  EXPECT_EQ(std::unique(all.begin(), all.end()), all.end());
+  EXPECT_EQ(all.size(), kThreads * kFilesPerThread);
+  EXPECT_FALSE(queue.Pop().has_value());
+}
+
+}  // namespace
+}  // namespace scanner
@@ -0,0 +1,232 @@
+// Replaces the global allocation functions of the test binary to count the
+// heap allocations of a scan. Counting is off except within a test's scope,
+// so the other tests linked into the binary are unaffected.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "scanner/interfaces.h"
+#include "src/scanner_lib/async_file_logger.h"
+#include "src/scanner_lib/csv_hash_database.h"
+#include "src/scanner_lib/file_reader.h"
+#include "src/scanner_lib/md5_file_hasher.h"
+#include "src/scanner_lib/scanner.h"
+
+namespace {
+
+std::atomic<bool> counting{false};
+std::atomic<std::uint64_t> allocations{0};
+
+void* Allocate(std::size_t size) {
+  if (counting.load(std::memory_order_relaxed)) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void* AllocateAligned(std::size_t size, std::align_val_t alignment) {
+  if (counting.load(std::memory_order_relaxed)) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  const auto align = static_cast<std::size_t>(alignment);
+  // aligned_alloc wants a multiple of the alignment.
+  if (void* p = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  return Allocate(size);
+}
+void* operator new[](std::size_t size) {
+  return Allocate(size);
+}
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return AllocateAligned(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return AllocateAligned(size, alignment);
+}
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+void operator delete[](void* p) noexcept {
+  std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept {
+  std::free(p);
+}
+void operator delete[](void* p, std::size_t) noexcept {
+  std::free(p);
+}
+void operator delete(void* p, std::align_val_t) noexcept {
+  std::free(p);
+}
+void operator delete[](void* p, std::align_val_t) noexcept {
+  std::free(p);
+}
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+  std::free(p);
+}
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+  std::free(p);
+}
+
+namespace scanner {
+namespace {
+
+class NullLogger final : public ILogger {
+public:
+  void LogDetection(const std::filesystem::path&, const AnyDigest&,
+                    const std::string&) override {
+  }
+};
+
+// Allocations that do not depend on the number of files: each scan starts
+// fresh pool threads, whose buffers and task nodes warm up again. With a
+// single worker, both scans warm up the same buffers, so little else varies.
+constexpr std::uint64_t kSlack = 64;
+
+class ScanAllocationTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    temp_dir_ = std::filesystem::temp_directory_path() /
+                "scanner_scan_allocation_test";
+    std::filesystem::remove_all(temp_dir_);
+    std::filesystem::create_directories(temp_dir_);
+    std::ofstream(temp_dir_ / "base.csv")
+        << "00112233445566778899aabbccddeeff;Never.Matches\n";
+    db_.Load(temp_dir_ / "base.csv");
+  }
+
+  void TearDown() override {
+    std::error_code ec;
+    std::filesystem::remove_all(temp_dir_, ec);
+  }
+
+  // Creates a directory of files of the given size. Unless all files are to
+  // have the same content, their contents differ.
+  std::filesystem::path MakeTree(const std::string& name, int files,
+                                 std::size_t size = 300,
+                                 bool same_content = false) {
+    const std::filesystem::path dir = temp_dir_ / name;
+    std::filesystem::create_directories(dir);
+    for (int i = 0; i < files; ++i) {
+      const char fill = same_content ? 'x' : static_cast<char>('a' + i % 26);
+      std::ofstream(dir / ("f" + std::to_string(i)), std::ios::binary)
+          << std::string(size, fill);
+    }
+    return dir;
+  }
+
+  // What composing one file path in dir costs, as the walker does it.
+  static std::uint64_t PathCost(const std::filesystem::path& dir) {
+    allocations.store(0);
+    counting.store(true);
+    {
+      std::string child;
+      child.reserve(dir.native().size() + 6);
+      child.append(dir.native()).append("/f1234");
+      const std::filesystem::path path(std::move(child));
+    }
+    counting.store(false);
+    return allocations.load();
+  }
+
+  // The allocations of a scan with a scanner that already ran once.
+  std::uint64_t CountScanAllocations(Scanner& scanner,
+                                     const std::filesystem::path& dir,
+                                     std::uint64_t expected_detections = 0) {
+    scanner.Scan(dir);
+    allocations.store(0);
+    counting.store(true);
+    const ScanResult result = scanner.Scan(dir);
+    counting.store(false);
+    EXPECT_EQ(result.errors, 0);
+    EXPECT_EQ(result.malicious_files_detected, expected_detections);
+    return allocations.load();
+  }
+
+  // Scans a tree of files and one of twice as many, and checks that the
+  // larger scan allocates no more than the paths of the additional files.
+  void ExpectOnlyPathsAllocated(Scanner& scanner, int files, std::size_t size,
+                                bool detected = false) {
+    const auto small = MakeTree("small", files, size, detected);
+    const auto large = MakeTree("large", 2 * files, size, detected);
+    const std::uint64_t path_cost = PathCost(large);
+
+    const std::uint64_t small_scan =
+        CountScanAllocations(scanner, small, detected ? files : 0);
+    const std::uint64_t large_scan =
+        CountScanAllocations(scanner, large, detected ? 2 * files : 0);
+    EXPECT_LE(large_scan, small_scan + files * path_cost + kSlack)
+        << "small scan: " << small_scan << ", large scan: " << large_scan
+        << ", per path: " << path_cost;
+  }
+
+  std::filesystem::path temp_dir_;
+  CsvHashDatabase db_;
+  NullLogger logger_;
+};
+
+// The paths of the files found are the only allocations that grow with the
+// number of files: reading, hashing, batching and task submission reuse their
+// storage once a scan has warmed up.
+TEST_F(ScanAllocationTest, SteadyStateScanAllocatesOnlyDiscoveredPaths) {
+  Md5FileHasher hasher;
+  ScannerOptions options;
+  options.max_queued_tasks = 64;
+  Scanner scanner(db_, logger_, hasher, 1, options);
+  ExpectOnlyPathsAllocated(scanner, 2000, 300);
+}
+
+// Files too large to be batched are hashed by a task each.
+TEST_F(ScanAllocationTest, SingleFileTasksAllocateOnlyDiscoveredPaths) {
+  Md5FileHasher hasher;
+  ScannerOptions options;
+  options.max_queued_tasks = 64;
+  Scanner scanner(db_, logger_, hasher, 1, options);
+  ExpectOnlyPathsAllocated(scanner, 100,
+                           Md5FileHasher::kMaxBatchedFileSize + 1);
+}
+
+// Files larger than a single read are read in several chunks.
+TEST_F(ScanAllocationTest, ChunkedReadsAllocateOnlyDiscoveredPaths) {
+  Md5FileHasher hasher;
+  Scanner scanner(db_, logger_, hasher, 1);
+  ExpectOnlyPathsAllocated(scanner, 2, FileReader::kMaxPreadSize + 1);
+}
+
+// Logging a detection reuses the logger's ring slots and line buffers.
+TEST_F(ScanAllocationTest, DetectionsAllocateOnlyDiscoveredPaths) {
+  const auto sample = MakeTree("sample", 1, 300, true);
+  Md5FileHasher hasher;
+  std::ofstream(temp_dir_ / "matching.csv")
+      << hasher.HashFile(sample / "f0").ToHex() << ";Test.Detection\n";
+  CsvHashDatabase db;
+  db.Load(temp_dir_ / "matching.csv");
+
+  // A ring small enough for the warm-up scan to fill every slot.
+  AsyncFileLogger logger(temp_dir_ / "detections.log", 64);
+  ScannerOptions options;
+  options.max_queued_tasks = 64;
+  Scanner scanner(db, logger, hasher, 1, options);
+  ExpectOnlyPathsAllocated(scanner, 500, 300, true);
+}
+
+}  // namespace
+}  // namespace scanner
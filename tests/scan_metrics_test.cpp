@@ -0,0 +1,182 @@
+#include "src/scanner_lib/scan_metrics.h"
+
+#include <chrono>
+#include <cstdint>
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace scanner {
+namespace {
+
+TEST(LatencyHistogramTest, EmptyHistogramReportsZero) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.Count(), 0);
+  EXPECT_EQ(histogram.Quantile(0.5), 0);
+  EXPECT_EQ(histogram.Max(), 0);
+}
+
+TEST(LatencyHistogramTest, BucketsCoverEveryValueInOrder) {
+  EXPECT_EQ(LatencyHistogram::BucketOf(0), 0);
+  EXPECT_EQ(LatencyHistogram::BucketOf(15), 15);
+  EXPECT_EQ(LatencyHistogram::BucketOf(16), 16);
+  EXPECT_EQ(LatencyHistogram::BucketOf(~std::uint64_t{0}),
+            LatencyHistogram::kBucketCount - 1);
+  const std::uint64_t values[] = {0, 1, 17, 1000, 123456789,
+                                  ~std::uint64_t{0}};
+  for (const std::uint64_t value : values) {
+    const std::size_t bucket = LatencyHistogram::BucketOf(value);
+    EXPECT_GE(LatencyHistogram::BucketUpperBound(bucket), value);
+    if (bucket > 0) {
+      EXPECT_LT(LatencyHistogram::BucketUpperBound(bucket - 1), value);
+    }
+  }
+}
+
+TEST(LatencyHistogramTest, QuantilesAreWithinBucketWidth) {
+  LatencyHistogram histogram;
+  for (std::uint64_t value = 1; value <= 10000; ++value) {
+    histogram.Record(value);
+  }
+  EXPECT_EQ(histogram.Count(), 10000);
+  EXPECT_EQ(histogram.Total(), 10000ull * 10001 / 2);
+  EXPECT_EQ(histogram.Max(), 10000);
+  for (const double quantile : {0.5, 0.9, 0.99}) {
+    const double exact = quantile * 10000;
+    const auto estimate = static_cast<double>(histogram.Quantile(quantile));
+    EXPECT_GE(estimate, exact);
+    EXPECT_LE(estimate, exact * (1 + 1.0 / 16));
+  }
+  EXPECT_EQ(histogram.Quantile(1.0), 10000);
+}
+
+TEST(LatencyHistogramTest, MergeAddsCounts) {
+  LatencyHistogram a;
+  LatencyHistogram b;
+  a.Record(10, 3);
+  b.Record(1000);
+  a.Merge(b);
+  EXPECT_EQ(a.Count(), 4);
+  EXPECT_EQ(a.Total(), 1030);
+  EXPECT_EQ(a.Quantile(0.5), 10);
+  EXPECT_EQ(a.Quantile(1.0), 1000);
+}
+
+TEST(ScanMetricsRecorderTest, CollectsTheMeasurementsOfAllThreads) {
+  ScanMetricsRecorder recorder;
+  recorder.Reset();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&recorder] {
+      ScopedThreadMetrics scope(&recorder);
+      ThreadMetrics* metrics = CurrentThreadMetrics();
+      ASSERT_NE(metrics, nullptr);
+      metrics->Record(ScanStage::kHash, 300, 3);
+      metrics->Record(ScanStage::kRead, 50);
+      metrics->bytes_read += 1000;
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const ScanMetrics metrics =
+      recorder.Collect(8, std::chrono::milliseconds(500));
+  const StageLatency& hash =
+      metrics.stages[static_cast<std::size_t>(ScanStage::kHash)];
+  EXPECT_EQ(hash.count, 12);
+  EXPECT_EQ(hash.total, std::chrono::nanoseconds(1200));
+  EXPECT_EQ(hash.max, std::chrono::nanoseconds(100));
+  EXPECT_EQ(metrics.stages[static_cast<std::size_t>(ScanStage::kRead)].count,
+            4);
+  EXPECT_EQ(metrics.stages[static_cast<std::size_t>(ScanStage::kLog)].count,
+            0);
+  EXPECT_EQ(metrics.bytes_read, 4000);
+  EXPECT_DOUBLE_EQ(metrics.files_per_second, 16.0);
+  EXPECT_DOUBLE_EQ(metrics.megabytes_per_second, 0.008);
+
+  // A reset discards the slots of the previous scan.
+  recorder.Reset();
+  EXPECT_EQ(recorder.Collect(0, std::chrono::seconds(1)).bytes_read, 0);
+}
+
+TEST(ScanMetricsRecorderTest, ScopesNestAndRestoreThePreviousSlot) {
+  ScanMetricsRecorder recorder;
+  recorder.Reset();
+  EXPECT_EQ(CurrentThreadMetrics(), nullptr);
+  {
+    ScopedThreadMetrics outer(&recorder);
+    ThreadMetrics* slot = CurrentThreadMetrics();
+    ASSERT_NE(slot, nullptr);
+    {
+      ScopedThreadMetrics inner(nullptr);
+      EXPECT_EQ(CurrentThreadMetrics(), nullptr);
+      // Timers of a thread that measures nothing record nothing.
+      StageTimer timer(ScanStage::kLookup);
+    }
+    EXPECT_EQ(CurrentThreadMetrics(), slot);
+  }
+  EXPECT_EQ(CurrentThreadMetrics(), nullptr);
+  EXPECT_EQ(recorder.Collect(0, std::chrono::seconds(1))
+                .stages[static_cast<std::size_t>(ScanStage::kLookup)]
+                .count,
+            0);
+}
+
+#if SCANNER_ENABLE_METRICS
+
+TEST(StageTimerTest, HashTimerExcludesNestedIo) {
+  ScanMetricsRecorder recorder;
+  recorder.Reset();
+  {
+    ScopedThreadMetrics scope(&recorder);
+    StageTimer hash(ScanStage::kHash, 1, /*exclude_io=*/true);
+    StageTimer read(ScanStage::kRead);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+  const ScanMetrics metrics = recorder.Collect(1, std::chrono::seconds(1));
+  const StageLatency& read =
+      metrics.stages[static_cast<std::size_t>(ScanStage::kRead)];
+  const StageLatency& hash =
+      metrics.stages[static_cast<std::size_t>(ScanStage::kHash)];
+  ASSERT_EQ(read.count, 1);
+  ASSERT_EQ(hash.count, 1);
+  EXPECT_GE(read.total, std::chrono::milliseconds(20));
+  EXPECT_LT(hash.total, std::chrono::milliseconds(10));
+}
+
+TEST(StageTimerTest, TracesSpansOnlyIfTheRecorderTraces) {
+  const auto trace_of = [](bool trace) {
+    ScanMetricsRecorder recorder(trace);
+    recorder.Reset();
+    ScopedThreadMetrics scope(&recorder);
+    {
+      TraceSpan task("batch", 2);
+      const std::uint64_t queued = TraceEnqueued();
+      TraceDequeued(queued);
+      StageTimer hash(ScanStage::kHash, 2);
+    }
+    return CurrentThreadMetrics()->trace;
+  };
+
+  EXPECT_TRUE(trace_of(false).empty());
+
+  const std::vector<TraceEvent> trace = trace_of(true);
+  ASSERT_EQ(trace.size(), 4);
+  EXPECT_EQ(trace[0].phase, TraceEvent::Phase::kAsyncBegin);
+  EXPECT_EQ(trace[1].phase, TraceEvent::Phase::kAsyncEnd);
+  EXPECT_NE(trace[0].id, 0);
+  EXPECT_EQ(trace[0].id, trace[1].id);
+  // Spans are kept in the order they end, so inner spans come first.
+  EXPECT_STREQ(trace[2].name, "hash");
+  EXPECT_EQ(trace[2].files, 2);
+  EXPECT_STREQ(trace[3].name, "batch");
+  EXPECT_GE(trace[3].duration, trace[2].duration);
+}
+
+#endif  // SCANNER_ENABLE_METRICS
+
+}  // namespace
+}  // namespace scanner
@@ -0,0 +1,62 @@
+#include "src/scanner_lib/scan_trace.h"
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace scanner {
+namespace {
+
+TEST(ScanTraceTest, WritesEmptyTrace) {
+  std::ostringstream os;
+  WriteChromeTrace(os, {}, std::chrono::steady_clock::now());
+  EXPECT_EQ(os.str(),
+            "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n"
+            "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, "
+            "\"tid\": 0, \"args\": {\"name\": \"scanner\"}}\n]}\n");
+}
+
+TEST(ScanTraceTest, WritesSpansAndQueuedEventsPerThread) {
+  const auto origin = std::chrono::steady_clock::now();
+  TraceEvent span;
+  span.name = "file";
+  span.start = origin + std::chrono::nanoseconds(1500);
+  span.duration = std::chrono::nanoseconds(2000042);
+  span.files = 1;
+  span.path = "dir/\"quoted\"\n.bin";
+  TraceEvent begin;
+  begin.name = "queued";
+  begin.phase = TraceEvent::Phase::kAsyncBegin;
+  begin.start = origin;
+  begin.id = 7;
+  TraceEvent end = begin;
+  end.phase = TraceEvent::Phase::kAsyncEnd;
+  end.start = origin + std::chrono::microseconds(1);
+
+  const std::vector<TraceEvent> producer = {begin};
+  const std::vector<TraceEvent> worker = {end, span};
+  std::ostringstream os;
+  WriteChromeTrace(os, {&producer, &worker}, origin);
+  const std::string trace = os.str();
+
+  EXPECT_NE(trace.find("{\"name\": \"queued\", \"cat\": \"scan\", \"ph\": "
+                       "\"b\", \"pid\": 1, \"tid\": 1, \"ts\": 0.000, "
+                       "\"id\": 7}"),
+            std::string::npos);
+  EXPECT_NE(trace.find("{\"name\": \"queued\", \"cat\": \"scan\", \"ph\": "
+                       "\"e\", \"pid\": 1, \"tid\": 2, \"ts\": 1.000, "
+                       "\"id\": 7}"),
+            std::string::npos);
+  EXPECT_NE(trace.find("{\"name\": \"file\", \"cat\": \"scan\", \"ph\": "
+                       "\"X\", \"pid\": 1, \"tid\": 2, \"ts\": 1.500, "
+                       "\"dur\": 2000.042, \"args\": {\"files\": 1, "
+                       "\"path\": \"dir/\\\"quoted\\\"\\u000a.bin\"}}"),
+            std::string::npos);
+  EXPECT_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+}
+
+}  // namespace
+}  // namespace scanner
@@ -14,7 +14,7 @@ protected:
     std::filesystem::create_directory(temp_dir_);
     db_path_ = temp_dir_ / "db.csv";
     log_path_ = temp_dir_ / "log.txt";
-    std::ofstream(db_path_) << "hash;verdict\n";
+    std::ofstream(db_path_) << "5eb63bbbe01eeed093cb22bb8f5acdc3;verdict\n";
   }
 
   void TearDown() override {
@@ -40,6 +40,194 @@ TEST_F(ScannerBuilderTest, BuildSucceedsWithAllDependencies) {
   });
 }
 
+TEST_F(ScannerBuilderTest, BuildSucceedsWithPrefilterConfiguredLast) {
+  auto builder = CreateScannerBuilder();
+  builder->WithCsvDatabase(db_path_)
+      .WithFileLogger(log_path_)
+      .WithMd5Hasher()
+      .WithPrefilter(10);
+  EXPECT_NE(builder->Build(), nullptr);
+}
+
+TEST_F(ScannerBuilderTest, BuildSucceedsWithIoOptionsConfiguredLast) {
+  IoOptions io_options;
+  io_options.strategy = IoStrategy::kRead;
+  io_options.read_block_size = 4096;
+
+  auto builder = CreateScannerBuilder();
+  builder->WithCsvDatabase(db_path_)
+      .WithFileLogger(log_path_)
+      .WithMd5Hasher()
+      .WithIoOptions(io_options);
+  EXPECT_NE(builder->Build(), nullptr);
+}
+
+TEST_F(ScannerBuilderTest, BuildSucceedsWithUnboundedQueue) {
+  auto builder = CreateScannerBuilder();
+  builder->WithCsvDatabase(db_path_)
+      .WithFileLogger(log_path_)
+      .WithMd5Hasher()
+      .WithMaxQueuedTasks(0);
+  EXPECT_NE(builder->Build(), nullptr);
+}
+
+TEST_F(ScannerBuilderTest, BuildSucceedsWithSequentialWalker) {
+  auto builder = CreateScannerBuilder();
+  builder->WithCsvDatabase(db_path_)
+      .WithFileLogger(log_path_)
+      .WithMd5Hasher()
+      .WithWalkerMode(WalkerMode::kSequential);
+  EXPECT_NE(builder->Build(), nullptr);
+}
+
+TEST_F(ScannerBuilderTest, BuildSucceedsWithLargestFirstScheduling) {
+  auto builder = CreateScannerBuilder();
+  builder->WithCsvDatabase(db_path_)
+      .WithFileLogger(log_path_)
+      .WithMd5Hasher()
+      .WithScheduling(SchedulingMode::kLargestFirst);
+  EXPECT_NE(builder->Build(), nullptr);
+}
+
+TEST_F(ScannerBuilderTest, BuildSucceedsWithInodeOrderScheduling) {
+  auto builder = CreateScannerBuilder();
+  builder->WithCsvDatabase(db_path_)
+      .WithFileLogger(log_path_)
+      .WithMd5Hasher()
+      .WithScheduling(SchedulingMode::kInodeOrder)
+      .WithReadOrderWindow(64);
+  EXPECT_NE(builder->Build(), nullptr);
+}
+
+TEST_F(ScannerBuilderTest, BuildThrowsOnEmptyReadOrderWindow) {
+  auto builder = CreateScannerBuilder();
+  builder->WithCsvDatabase(db_path_)
+      .WithFileLogger(log_path_)
+      .WithMd5Hasher()
+      .WithScheduling(SchedulingMode::kExtentOrder)
+      .WithReadOrderWindow(0);
+  EXPECT_THROW(builder->Build(), std::runtime_error);
+}
+
+TEST_F(ScannerBuilderTest, BuildSucceedsWithAsyncFileLogger) {
+  auto builder = CreateScannerBuilder();
+  builder->WithCsvDatabase(db_path_)
+      .WithAsyncFileLogger(log_path_)
+      .WithMd5Hasher();
+  EXPECT_NE(builder->Build(), nullptr);
+}
+
+TEST_F(ScannerBuilderTest, BuildSucceedsWithHashAlgorithmsConfiguredFirst) {
+  auto builder = CreateScannerBuilder();
+  builder->WithHashAlgorithms({HashAlgorithm::kSha1, HashAlgorithm::kSha256})
+      .WithCsvDatabase(db_path_)
+      .WithFileLogger(log_path_)
+      .WithMd5Hasher();
+  EXPECT_NE(builder->Build(), nullptr);
+}
+
+TEST_F(ScannerBuilderTest, BuildThrowsWithShaAlgorithmsAndFileCache) {
+  auto builder = CreateScannerBuilder();
+  builder->WithCsvDatabase(db_path_)
+      .WithFileLogger(log_path_)
+      .WithMd5Hasher()
+      .WithHashAlgorithms({HashAlgorithm::kSha256})
+      .WithFileCache(temp_dir_ / "cache.bin");
+  EXPECT_THROW(builder->Build(), std::runtime_error);
+}
+
+TEST_F(ScannerBuilderTest, BuildThrowsWithShaAlgorithmsAndCompiledDatabase) {
+  const auto sigdb_path = temp_dir_ / "db.sigdb";
+  CompileSignatureDatabase(db_path_, sigdb_path);
+  for (const HashAlgorithm algorithm :
+       {HashAlgorithm::kSha1, HashAlgorithm::kSha256}) {
+    auto builder = CreateScannerBuilder();
+    builder->WithCompiledDatabase(sigdb_path)
+        .WithFileLogger(log_path_)
+        .WithMd5Hasher()
+        .WithHashAlgorithms({HashAlgorithm::kMd5, algorithm});
+    EXPECT_THROW(builder->Build(), std::runtime_error);
+  }
+
+  auto builder = CreateScannerBuilder();
+  builder->WithCompiledDatabase(sigdb_path)
+      .WithFileLogger(log_path_)
+      .WithMd5Hasher()
+      .WithHashAlgorithms({HashAlgorithm::kMd5});
+  EXPECT_NE(builder->Build(), nullptr);
+}
+
+TEST_F(ScannerBuilderTest, BuildSucceedsWithSha256Hasher) {
+  auto builder = CreateScannerBuilder();
+  builder->WithCsvDatabase(db_path_)
+      .WithFileLogger(log_path_)
+      .WithSha256Hasher();
+  EXPECT_NE(builder->Build(), nullptr);
+}
+
+TEST_F(ScannerBuilderTest, BuildThrowsWithSha256HasherAndHashAlgorithms) {
+  auto builder = CreateScannerBuilder();
+  builder->WithCsvDatabase(db_path_)
+      .WithFileLogger(log_path_)
+      .WithSha256Hasher()
+      .WithHashAlgorithms({HashAlgorithm::kSha1});
+  EXPECT_THROW(builder->Build(), std::runtime_error);
+}
+
+TEST_F(ScannerBuilderTest, BuildSucceedsWithMetrics) {
+  auto builder = CreateScannerBuilder();
+  builder->WithCsvDatabase(db_path_)
+      .WithFileLogger(log_path_)
+      .WithMd5Hasher()
+      .WithMetrics();
+#if SCANNER_ENABLE_METRICS
+  EXPECT_NE(builder->Build(), nullptr);
+#else
+  EXPECT_THROW(builder->Build(), std::runtime_error);
+#endif
+}
+
+TEST_F(ScannerBuilderTest, BuildSucceedsWithTrace) {
+  auto builder = CreateScannerBuilder();
+  builder->WithCsvDatabase(db_path_)
+      .WithFileLogger(log_path_)
+      .WithMd5Hasher()
+      .WithTrace(temp_dir_ / "scan.trace.json");
+#if SCANNER_ENABLE_METRICS
+  EXPECT_NE(builder->Build(), nullptr);
+#else
+  EXPECT_THROW(builder->Build(), std::runtime_error);
+#endif
+}
+
+TEST_F(ScannerBuilderTest, BuildSucceedsWithDetectionChannel) {
+  auto builder = CreateScannerBuilder();
+  builder->WithCsvDatabase(db_path_)
+      .WithFileLogger(log_path_)
+      .WithMd5Hasher()
+      .WithDetectionChannel(CreateDetectionChannel());
+  EXPECT_NE(builder->Build(), nullptr);
+}
+
+TEST_F(ScannerBuilderTest, BuildThrowsOnEmptyTraversalPattern) {
+  TraversalFilter filter;
+  filter.exclude = {"build", ""};
+  auto builder = CreateScannerBuilder();
+  builder->WithCsvDatabase(db_path_)
+      .WithFileLogger(log_path_)
+      .WithMd5Hasher()
+      .WithTraversalFilter(filter);
+  EXPECT_THROW(builder->Build(), std::runtime_error);
+}
+
+TEST_F(ScannerBuilderTest, BuildThrowsOnMissingDatabaseFile) {
+  auto builder = CreateScannerBuilder();
+  builder->WithCsvDatabase(temp_dir_ / "missing.csv")
+      .WithFileLogger(log_path_)
+      .WithMd5Hasher();
+  EXPECT_THROW(builder->Build(), std::runtime_error);
+}
+
 TEST_F(ScannerBuilderTest, BuildThrowsWithoutDatabase) {
   auto builder = CreateScannerBuilder();
   builder->WithFileLogger(log_path_).WithMd5Hasher();
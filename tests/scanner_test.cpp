@@ -1,15 +1,25 @@
 #include "src/scanner_lib/scanner.h"
 
+#include <chrono>
+#include <cstdint>
+
+#include <algorithm>
+#include <exception>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
 #include <memory>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "scanner/interfaces.h"
+#include "src/scanner_lib/md5_engine.h"
 #include "src/scanner_lib/thread_pool.h"
 
 namespace scanner {
@@ -19,7 +29,29 @@ namespace {
 
 class MockFileHasher : public IFileHasher {
 public:
-  MOCK_METHOD(std::string, HashFile, (const std::filesystem::path& file_path),
+  MOCK_METHOD(Md5Digest, HashFile, (const std::filesystem::path& file_path),
+              (override));
+};
+
+class MockBatchingFileHasher : public IFileHasher {
+public:
+  MOCK_METHOD(Md5Digest, HashFile, (const std::filesystem::path& file_path),
+              (override));
+  MOCK_METHOD(void, HashFiles,
+              (const std::vector<std::filesystem::path>& file_paths,
+               std::vector<FileHashResult>& results),
+              (override));
+  MOCK_METHOD(std::size_t, PreferredBatchSize, (), (const, override));
+  MOCK_METHOD(std::uintmax_t, MaxBatchedFileSize, (), (const, override));
+};
+
+class MockSha256FileHasher : public IFileHasher {
+public:
+  MOCK_METHOD(Md5Digest, HashFile, (const std::filesystem::path& file_path),
+              (override));
+  MOCK_METHOD(void, HashFileDigests,
+              (const std::filesystem::path& file_path,
+               FileHashResult& result),
               (override));
 };
 
@@ -27,18 +59,40 @@ class MockHashDatabase : public IHashDatabase {
 public:
   MOCK_METHOD(std::size_t, Load, (const std::filesystem::path& source_path),
               (override));
-  MOCK_METHOD(std::optional<std::string>, FindHash, (const std::string& hash),
+  MOCK_METHOD(std::optional<std::string>, FindHash, (const Md5Digest& hash),
+              (const, override));
+  MOCK_METHOD(std::optional<std::string>, FindSha256,
+              (const Sha256Digest& hash), (const, override));
+};
+
+class MockIndexedHashDatabase : public MockHashDatabase {
+public:
+  MOCK_METHOD(bool, HasSizeIndex, (), (const, override));
+  MOCK_METHOD(bool, MayMatchSize, (std::uint64_t size), (const, override));
+  MOCK_METHOD(bool, HasPrefixIndex, (), (const, override));
+  MOCK_METHOD(bool, MayMatchPrefix, (const Md5Digest& prefix_digest),
               (const, override));
 };
 
 class MockLogger : public ILogger {
 public:
   MOCK_METHOD(void, LogDetection,
-              (const std::filesystem::path& path, const std::string& hash,
+              (const std::filesystem::path& path, const AnyDigest& hash,
                const std::string& verdict),
               (override));
 };
 
+class MockFlushingLogger : public MockLogger {
+public:
+  MOCK_METHOD(void, Flush, (), (override));
+};
+
+Md5Digest MakeDigest(std::uint8_t fill) {
+  Md5Digest digest;
+  digest.bytes.fill(fill);
+  return digest;
+}
+
 // --- Test Fixture ---
 
 class ScannerTest : public ::testing::Test {
@@ -62,6 +116,17 @@ protected:
     f << "dummy content";
   }
 
+  // Moves a file's modification time out of the file cache's racy window.
+  void Backdate(const std::filesystem::path& path) {
+    std::filesystem::last_write_time(
+        temp_dir_ / path,
+        std::filesystem::file_time_type::clock::now() - std::chrono::hours(1));
+  }
+
+  const Md5Digest good_hash_ = MakeDigest(0x11);
+  const Md5Digest bad_hash_ = MakeDigest(0xBA);
+  const Md5Digest some_hash_ = MakeDigest(0x55);
+
   testing::StrictMock<MockFileHasher> mock_hasher_;
   testing::StrictMock<MockHashDatabase> mock_db_;
   testing::StrictMock<MockLogger> mock_logger_;
@@ -76,17 +141,18 @@ TEST_F(ScannerTest, FindsAndLogsMaliciousFiles) {
   CreateDummyFile("bad_file.exe");
 
   EXPECT_CALL(mock_hasher_, HashFile(temp_dir_ / "good_file.txt"))
-      .WillOnce(testing::Return("good_hash"));
+      .WillOnce(testing::Return(good_hash_));
   EXPECT_CALL(mock_hasher_, HashFile(temp_dir_ / "bad_file.exe"))
-      .WillOnce(testing::Return("bad_hash"));
+      .WillOnce(testing::Return(bad_hash_));
 
-  EXPECT_CALL(mock_db_, FindHash("good_hash"))
+  EXPECT_CALL(mock_db_, FindHash(good_hash_))
       .WillOnce(testing::Return(std::nullopt));
-  EXPECT_CALL(mock_db_, FindHash("bad_hash"))
+  EXPECT_CALL(mock_db_, FindHash(bad_hash_))
       .WillOnce(testing::Return("EvilWare"));
 
   EXPECT_CALL(mock_logger_,
-              LogDetection(temp_dir_ / "bad_file.exe", "bad_hash", "EvilWare"))
+              LogDetection(temp_dir_ / "bad_file.exe", AnyDigest(bad_hash_),
+                           "EvilWare"))
       .Times(1);
 
   auto scanner =
@@ -98,16 +164,51 @@ TEST_F(ScannerTest, FindsAndLogsMaliciousFiles) {
   EXPECT_EQ(result.errors, 0);
 }
 
+TEST_F(ScannerTest, MatchesAndLogsSha256DigestsWithoutMd5) {
+  CreateDummyFile("good_file.txt");
+  CreateDummyFile("bad_file.exe");
+
+  Sha256Digest good_sha256;
+  good_sha256.bytes.fill(0x22);
+  Sha256Digest bad_sha256;
+  bad_sha256.bytes.fill(0xBB);
+
+  testing::StrictMock<MockSha256FileHasher> hasher;
+  EXPECT_CALL(hasher, HashFileDigests(testing::_, testing::_))
+      .Times(2)
+      .WillRepeatedly([&](const std::filesystem::path& path,
+                          FileHashResult& result) {
+        result.sha256 =
+            path.filename() == "bad_file.exe" ? bad_sha256 : good_sha256;
+      });
+
+  EXPECT_CALL(mock_db_, FindSha256(good_sha256))
+      .WillOnce(testing::Return(std::nullopt));
+  EXPECT_CALL(mock_db_, FindSha256(bad_sha256))
+      .WillOnce(testing::Return("EvilWare"));
+  EXPECT_CALL(mock_logger_,
+              LogDetection(temp_dir_ / "bad_file.exe", AnyDigest(bad_sha256),
+                           "EvilWare"))
+      .Times(1);
+
+  Scanner scanner(mock_db_, mock_logger_, hasher, 2);
+  const ScanResult result = scanner.Scan(temp_dir_);
+
+  EXPECT_EQ(result.total_files_processed, 2);
+  EXPECT_EQ(result.malicious_files_detected, 1);
+  EXPECT_EQ(result.errors, 0);
+}
+
 TEST_F(ScannerTest, HandlesHashingErrorsGracefully) {
   CreateDummyFile("good_file.txt");
   CreateDummyFile("permission_denied.sys");
 
   EXPECT_CALL(mock_hasher_, HashFile(temp_dir_ / "good_file.txt"))
-      .WillOnce(testing::Return("good_hash"));
+      .WillOnce(testing::Return(good_hash_));
   EXPECT_CALL(mock_hasher_, HashFile(temp_dir_ / "permission_denied.sys"))
       .WillOnce(testing::Throw(std::runtime_error("Permission denied")));
 
-  EXPECT_CALL(mock_db_, FindHash("good_hash"))
+  EXPECT_CALL(mock_db_, FindHash(good_hash_))
       .WillOnce(testing::Return(std::nullopt));
 
   EXPECT_CALL(mock_logger_, LogDetection(testing::_, testing::_, testing::_))
@@ -137,6 +238,65 @@ TEST_F(ScannerTest, HandlesEmptyDirectory) {
   EXPECT_EQ(result.errors, 0);
 }
 
+TEST_F(ScannerTest, FlushesLoggerWhenScanCompletes) {
+  testing::StrictMock<MockFlushingLogger> logger;
+  EXPECT_CALL(logger, Flush())
+      .WillOnce(testing::Return())
+      .WillOnce(testing::Throw(std::runtime_error("disk full")));
+
+  Scanner scanner(mock_db_, logger, mock_hasher_, 2);
+  EXPECT_EQ(scanner.Scan(temp_dir_).errors, 0);
+  // A failed flush means detections may be missing from the log.
+  EXPECT_EQ(scanner.Scan(temp_dir_).errors, 1);
+}
+
+TEST_F(ScannerTest, StreamsDetectionsToChannelWhileScanning) {
+  CreateDummyFile("good_file.txt");
+  CreateDummyFile("bad_file.exe");
+  CreateDummyFile("worse_file.exe");
+  EXPECT_CALL(mock_hasher_, HashFile(temp_dir_ / "good_file.txt"))
+      .WillOnce(testing::Return(good_hash_));
+  EXPECT_CALL(mock_hasher_, HashFile(temp_dir_ / "bad_file.exe"))
+      .WillOnce(testing::Return(bad_hash_));
+  EXPECT_CALL(mock_hasher_, HashFile(temp_dir_ / "worse_file.exe"))
+      .WillOnce(testing::Return(some_hash_));
+  EXPECT_CALL(mock_db_, FindHash(good_hash_))
+      .WillOnce(testing::Return(std::nullopt));
+  EXPECT_CALL(mock_db_, FindHash(bad_hash_)).WillOnce(testing::Return("Evil"));
+  EXPECT_CALL(mock_db_, FindHash(some_hash_))
+      .WillOnce(testing::Return("Worse"));
+  EXPECT_CALL(mock_logger_, LogDetection(testing::_, testing::_, testing::_))
+      .Times(2);
+
+  const auto channel = CreateDetectionChannel(2);
+  std::vector<Detection> detections;
+  std::thread consumer([&] {
+    std::vector<Detection> batch;
+    while (channel->Receive(batch, 1)) {
+      detections.insert(detections.end(), batch.begin(), batch.end());
+    }
+  });
+  ScannerOptions options;
+  options.detections = channel;
+  Scanner scanner(mock_db_, mock_logger_, mock_hasher_, 2, options);
+  const ScanResult result = scanner.Scan(temp_dir_);
+  channel->Close();
+  consumer.join();
+
+  EXPECT_EQ(result.malicious_files_detected, 2);
+  ASSERT_EQ(detections.size(), 2);
+  std::sort(detections.begin(), detections.end(),
+            [](const Detection& a, const Detection& b) {
+              return a.path < b.path;
+            });
+  EXPECT_EQ(detections[0].path, temp_dir_ / "bad_file.exe");
+  EXPECT_EQ(detections[0].digest, AnyDigest(bad_hash_));
+  EXPECT_EQ(detections[0].verdict, "Evil");
+  EXPECT_EQ(detections[0].size, std::string("dummy content").size());
+  EXPECT_EQ(detections[1].path, temp_dir_ / "worse_file.exe");
+  EXPECT_EQ(detections[1].verdict, "Worse");
+}
+
 TEST_F(ScannerTest, HandlesDeeplyNestedDirectories) {
   const auto dir_a = temp_dir_ / "a";
   const auto dir_b = dir_a / "b";
@@ -150,9 +310,9 @@ TEST_F(ScannerTest, HandlesDeeplyNestedDirectories) {
 
   EXPECT_CALL(mock_hasher_, HashFile(testing::_))
       .Times(4)
-      .WillRepeatedly(testing::Return("some_hash"));
+      .WillRepeatedly(testing::Return(some_hash_));
 
-  EXPECT_CALL(mock_db_, FindHash("some_hash"))
+  EXPECT_CALL(mock_db_, FindHash(some_hash_))
       .Times(4)
       .WillRepeatedly(testing::Return(std::nullopt));
 
@@ -168,6 +328,396 @@ TEST_F(ScannerTest, HandlesDeeplyNestedDirectories) {
   EXPECT_EQ(result.errors, 0);
 }
 
+TEST_F(ScannerTest, SequentialWalkerFindsTheSameFiles) {
+  const auto dir_b = temp_dir_ / "a" / "b";
+  std::filesystem::create_directories(dir_b);
+  CreateDummyFile("file1.txt");
+  CreateDummyFile(dir_b / "file2.txt");
+
+  EXPECT_CALL(mock_hasher_, HashFile(temp_dir_ / "file1.txt"))
+      .WillOnce(testing::Return(some_hash_));
+  EXPECT_CALL(mock_hasher_, HashFile(dir_b / "file2.txt"))
+      .WillOnce(testing::Return(some_hash_));
+  EXPECT_CALL(mock_db_, FindHash(some_hash_))
+      .Times(2)
+      .WillRepeatedly(testing::Return(std::nullopt));
+
+  ScannerOptions options;
+  options.walker_mode = WalkerMode::kSequential;
+  Scanner scanner(mock_db_, mock_logger_, mock_hasher_, 2, options);
+  const ScanResult result = scanner.Scan(temp_dir_);
+
+  EXPECT_EQ(result.total_files_processed, 2);
+  EXPECT_EQ(result.errors, 0);
+}
+
+class RecordingProgressObserver : public IProgressObserver {
+public:
+  void OnProgress(const ScanProgress& progress) override {
+    snapshots.push_back(progress);
+  }
+
+  std::vector<ScanProgress> snapshots;
+};
+
+TEST_F(ScannerTest, ReportsProgressUntilEveryFileIsProcessed) {
+  const auto sub_dir = temp_dir_ / "sub";
+  std::filesystem::create_directories(sub_dir);
+  CreateDummyFile("good_file.txt");
+  CreateDummyFile(sub_dir / "bad_file.exe");
+  const std::uint64_t file_size =
+      std::filesystem::file_size(temp_dir_ / "good_file.txt");
+
+  EXPECT_CALL(mock_hasher_, HashFile(temp_dir_ / "good_file.txt"))
+      .Times(2)
+      .WillRepeatedly(testing::Return(good_hash_));
+  EXPECT_CALL(mock_hasher_, HashFile(sub_dir / "bad_file.exe"))
+      .Times(2)
+      .WillRepeatedly(testing::Return(bad_hash_));
+  EXPECT_CALL(mock_db_, FindHash(good_hash_))
+      .Times(2)
+      .WillRepeatedly(testing::Return(std::nullopt));
+  EXPECT_CALL(mock_db_, FindHash(bad_hash_))
+      .Times(2)
+      .WillRepeatedly(testing::Return("EvilWare"));
+  EXPECT_CALL(mock_logger_, LogDetection(sub_dir / "bad_file.exe",
+                                         AnyDigest(bad_hash_), "EvilWare"))
+      .Times(2);
+
+  for (const WalkerMode mode :
+       {WalkerMode::kParallel, WalkerMode::kSequential}) {
+    ScannerOptions options;
+    options.walker_mode = mode;
+    Scanner scanner(mock_db_, mock_logger_, mock_hasher_, 2, options);
+    RecordingProgressObserver observer;
+    scanner.SetProgressObserver(&observer, std::chrono::milliseconds(1));
+    scanner.Scan(temp_dir_);
+
+    ASSERT_FALSE(observer.snapshots.empty());
+    for (const ScanProgress& progress : observer.snapshots) {
+      EXPECT_LE(progress.files_processed, 2);
+    }
+    const ScanProgress& last = observer.snapshots.back();
+    EXPECT_TRUE(last.traversal_complete);
+    EXPECT_EQ(last.files_discovered, 2);
+    EXPECT_EQ(last.files_processed, 2);
+    EXPECT_EQ(last.bytes_processed, 2 * file_size);
+    EXPECT_EQ(last.malicious_files_detected, 1);
+    ASSERT_TRUE(last.eta.has_value());
+    EXPECT_EQ(last.eta->count(), 0);
+  }
+}
+
+TEST_F(ScannerTest, ReportsMetricsOnlyIfCollected) {
+  CreateDummyFile("file.txt");
+  EXPECT_CALL(mock_hasher_, HashFile(temp_dir_ / "file.txt"))
+      .Times(2)
+      .WillRepeatedly(testing::Return(some_hash_));
+  EXPECT_CALL(mock_db_, FindHash(some_hash_))
+      .Times(2)
+      .WillRepeatedly(testing::Return(std::nullopt));
+
+  Scanner plain(mock_db_, mock_logger_, mock_hasher_, 2);
+  EXPECT_FALSE(plain.Scan(temp_dir_).metrics.has_value());
+
+  ScannerOptions options;
+  options.collect_metrics = true;
+  Scanner measured(mock_db_, mock_logger_, mock_hasher_, 2, options);
+  EXPECT_TRUE(measured.Scan(temp_dir_).metrics.has_value());
+}
+
+#if SCANNER_ENABLE_METRICS
+
+TEST_F(ScannerTest, MeasuresEveryStageWithBothWalkers) {
+  const auto sub_dir = temp_dir_ / "sub";
+  std::filesystem::create_directories(sub_dir);
+  CreateDummyFile("good_file.txt");
+  CreateDummyFile(sub_dir / "bad_file.exe");
+
+  EXPECT_CALL(mock_hasher_, HashFile(temp_dir_ / "good_file.txt"))
+      .Times(2)
+      .WillRepeatedly(testing::Return(good_hash_));
+  EXPECT_CALL(mock_hasher_, HashFile(sub_dir / "bad_file.exe"))
+      .Times(2)
+      .WillRepeatedly(testing::Return(bad_hash_));
+  EXPECT_CALL(mock_db_, FindHash(good_hash_))
+      .Times(2)
+      .WillRepeatedly(testing::Return(std::nullopt));
+  EXPECT_CALL(mock_db_, FindHash(bad_hash_))
+      .Times(2)
+      .WillRepeatedly(testing::Return("EvilWare"));
+  EXPECT_CALL(mock_logger_, LogDetection(sub_dir / "bad_file.exe",
+                                         AnyDigest(bad_hash_), "EvilWare"))
+      .Times(2);
+
+  for (const WalkerMode mode :
+       {WalkerMode::kParallel, WalkerMode::kSequential}) {
+    ScannerOptions options;
+    options.walker_mode = mode;
+    options.collect_metrics = true;
+    Scanner scanner(mock_db_, mock_logger_, mock_hasher_, 2, options);
+    const ScanResult result = scanner.Scan(temp_dir_);
+    ASSERT_TRUE(result.metrics.has_value());
+    const auto& stages = result.metrics->stages;
+    EXPECT_GE(stages[static_cast<std::size_t>(ScanStage::kTraversal)].count,
+              2);
+    EXPECT_EQ(stages[static_cast<std::size_t>(ScanStage::kHash)].count, 2);
+    EXPECT_EQ(stages[static_cast<std::size_t>(ScanStage::kLookup)].count, 2);
+    EXPECT_EQ(stages[static_cast<std::size_t>(ScanStage::kLog)].count, 1);
+    // The mock hasher reads nothing.
+    EXPECT_EQ(stages[static_cast<std::size_t>(ScanStage::kRead)].count, 0);
+    EXPECT_EQ(result.metrics->bytes_read, 0);
+  }
+}
+
+TEST_F(ScannerTest, WritesChromeTraceOfEveryScan) {
+  const auto sub_dir = temp_dir_ / "sub";
+  std::filesystem::create_directories(sub_dir);
+  CreateDummyFile(sub_dir / "bad_file.exe");
+  EXPECT_CALL(mock_hasher_, HashFile(sub_dir / "bad_file.exe"))
+      .WillOnce(testing::Return(bad_hash_));
+  EXPECT_CALL(mock_db_, FindHash(bad_hash_)).WillOnce(testing::Return("Evil"));
+  EXPECT_CALL(mock_logger_, LogDetection(sub_dir / "bad_file.exe",
+                                         AnyDigest(bad_hash_), "Evil"));
+
+  // Outside the scanned tree, so that it is not scanned itself.
+  const auto trace_path = temp_dir_.parent_path() /
+                          (temp_dir_.filename().string() + ".trace.json");
+  ScannerOptions options;
+  options.trace_path = trace_path;
+  Scanner scanner(mock_db_, mock_logger_, mock_hasher_, 2, options);
+  const ScanResult result = scanner.Scan(temp_dir_);
+  EXPECT_EQ(result.errors, 0);
+  EXPECT_FALSE(result.metrics.has_value());
+
+  std::ifstream file(trace_path);
+  const std::string trace((std::istreambuf_iterator<char>(file)),
+                          std::istreambuf_iterator<char>());
+  file.close();
+  std::filesystem::remove(trace_path);
+  EXPECT_EQ(trace.rfind("{\"displayTimeUnit\"", 0), 0);
+  for (const char* name : {"traversal", "enqueue", "queued", "file", "hash",
+                           "lookup", "log"}) {
+    EXPECT_NE(trace.find("\"name\": \"" + std::string(name) + "\""),
+              std::string::npos)
+        << name;
+  }
+  EXPECT_NE(trace.find("bad_file.exe"), std::string::npos);
+}
+
+#endif  // SCANNER_ENABLE_METRICS
+
+TEST_F(ScannerTest, LargestFirstSchedulingHashesLargeFilesFirst) {
+  const std::vector<std::pair<std::string, std::size_t>> files = {
+      {"small.bin", 10}, {"huge.bin", 4000}, {"medium.bin", 300},
+      {"large.bin", 2000}, {"tiny.bin", 1}};
+  for (const auto& [name, size] : files) {
+    std::ofstream(temp_dir_ / name) << std::string(size, 'x');
+  }
+
+  // With a single worker, the root directory is listed before any file task
+  // runs, so every task sees all files.
+  testing::Sequence by_size;
+  for (const char* name :
+       {"huge.bin", "large.bin", "medium.bin", "small.bin", "tiny.bin"}) {
+    EXPECT_CALL(mock_hasher_, HashFile(temp_dir_ / name))
+        .InSequence(by_size)
+        .WillOnce(testing::Return(some_hash_));
+  }
+  EXPECT_CALL(mock_db_, FindHash(some_hash_))
+      .Times(5)
+      .WillRepeatedly(testing::Return(std::nullopt));
+
+  ScannerOptions options;
+  options.scheduling = SchedulingMode::kLargestFirst;
+  Scanner scanner(mock_db_, mock_logger_, mock_hasher_, 1, options);
+  const ScanResult result = scanner.Scan(temp_dir_);
+
+  EXPECT_EQ(result.total_files_processed, 5);
+  EXPECT_EQ(result.errors, 0);
+  EXPECT_LE(result.tail_latency, result.execution_time);
+}
+
+TEST_F(ScannerTest, LargestFirstSchedulingWorksWithSequentialWalker) {
+  std::ofstream(temp_dir_ / "small.bin") << "x";
+  std::ofstream(temp_dir_ / "large.bin") << std::string(1000, 'x');
+
+  EXPECT_CALL(mock_hasher_, HashFile(testing::_))
+      .Times(2)
+      .WillRepeatedly(testing::Return(some_hash_));
+  EXPECT_CALL(mock_db_, FindHash(some_hash_))
+      .Times(2)
+      .WillRepeatedly(testing::Return(std::nullopt));
+
+  ScannerOptions options;
+  options.walker_mode = WalkerMode::kSequential;
+  options.scheduling = SchedulingMode::kLargestFirst;
+  Scanner scanner(mock_db_, mock_logger_, mock_hasher_, 2, options);
+  const ScanResult result = scanner.Scan(temp_dir_);
+
+  EXPECT_EQ(result.total_files_processed, 2);
+  EXPECT_EQ(result.errors, 0);
+}
+
+TEST_F(ScannerTest, InodeOrderReadsFilesByAscendingInode) {
+  std::vector<std::pair<std::uint64_t, std::filesystem::path>> by_inode;
+  for (const char* name : {"a.bin", "b.bin", "c.bin", "d.bin", "e.bin"}) {
+    CreateDummyFile(name);
+    const std::optional<FileStatus> status = StatFile(temp_dir_ / name);
+    if (!status) {
+      GTEST_SKIP() << "The platform provides no inode numbers";
+    }
+    by_inode.emplace_back(status->state.inode, temp_dir_ / name);
+  }
+  std::sort(by_inode.begin(), by_inode.end());
+
+  // The sequential walker leaves the inode numbers to the scanner.
+  for (const WalkerMode mode :
+       {WalkerMode::kParallel, WalkerMode::kSequential}) {
+    // With a single worker and a window larger than the tree, no file is
+    // read before all have been sorted.
+    testing::Sequence in_order;
+    for (const auto& [inode, path] : by_inode) {
+      EXPECT_CALL(mock_hasher_, HashFile(path))
+          .InSequence(in_order)
+          .WillOnce(testing::Return(some_hash_));
+    }
+    EXPECT_CALL(mock_db_, FindHash(some_hash_))
+        .Times(5)
+        .WillRepeatedly(testing::Return(std::nullopt));
+
+    ScannerOptions options;
+    options.walker_mode = mode;
+    options.scheduling = SchedulingMode::kInodeOrder;
+    Scanner scanner(mock_db_, mock_logger_, mock_hasher_, 1, options);
+    const ScanResult result = scanner.Scan(temp_dir_);
+
+    EXPECT_EQ(result.total_files_processed, 5);
+    EXPECT_EQ(result.errors, 0);
+    testing::Mock::VerifyAndClearExpectations(&mock_hasher_);
+  }
+
+  // Listed files are looked up by the workers, here in reverse order.
+  testing::Sequence in_order;
+  std::string list;
+  for (const auto& [inode, path] : by_inode) {
+    EXPECT_CALL(mock_hasher_, HashFile(path))
+        .InSequence(in_order)
+        .WillOnce(testing::Return(some_hash_));
+    list = path.string() + "\n" + list;
+  }
+  EXPECT_CALL(mock_db_, FindHash(some_hash_))
+      .Times(5)
+      .WillRepeatedly(testing::Return(std::nullopt));
+  ScannerOptions options;
+  options.scheduling = SchedulingMode::kInodeOrder;
+  Scanner scanner(mock_db_, mock_logger_, mock_hasher_, 1, options);
+  std::istringstream paths(list);
+  const ScanResult result = scanner.ScanFiles(paths, '\n');
+  EXPECT_EQ(result.total_files_processed, 5);
+  EXPECT_EQ(result.errors, 0);
+}
+
+TEST_F(ScannerTest, ExtentOrderHashesEveryFileWithoutBatching) {
+  std::filesystem::create_directories(temp_dir_ / "sub");
+  for (const char* name : {"a.bin", "b.bin", "sub/c.bin", "sub/d.bin"}) {
+    CreateDummyFile(name);
+  }
+  std::ofstream(temp_dir_ / "empty.bin").close();
+
+  // Batches would defeat the order, so even a batching hasher gets single
+  // files; the strict mock fails on any HashFiles call.
+  testing::StrictMock<MockBatchingFileHasher> hasher;
+  EXPECT_CALL(hasher, PreferredBatchSize())
+      .WillRepeatedly(testing::Return(4));
+  EXPECT_CALL(hasher, MaxBatchedFileSize())
+      .WillRepeatedly(testing::Return(1024));
+  EXPECT_CALL(hasher, HashFile(testing::_))
+      .Times(5)
+      .WillRepeatedly(testing::Return(some_hash_));
+  EXPECT_CALL(mock_db_, FindHash(some_hash_))
+      .Times(5)
+      .WillRepeatedly(testing::Return(std::nullopt));
+
+  // A window of 2 releases files while the walk is still going.
+  ScannerOptions options;
+  options.scheduling = SchedulingMode::kExtentOrder;
+  options.read_order_window = 2;
+  Scanner scanner(mock_db_, mock_logger_, hasher, 2, options);
+  const ScanResult result = scanner.Scan(temp_dir_);
+
+  EXPECT_EQ(result.total_files_processed, 5);
+  EXPECT_EQ(result.errors, 0);
+}
+
+TEST_F(ScannerTest, TraversalFilterAppliesToBothWalkers) {
+  std::filesystem::create_directories(temp_dir_ / "skip" / "nested");
+  std::filesystem::create_directories(temp_dir_ / "keep");
+  CreateDummyFile("skip/nested/bad_file.exe");
+  CreateDummyFile("keep/bad_file.exe");
+  CreateDummyFile("keep/notes.tmp");
+  TraversalFilter filter;
+  filter.exclude = {"skip", "*.tmp"};
+
+  for (const WalkerMode mode :
+       {WalkerMode::kParallel, WalkerMode::kSequential}) {
+    // The mocks are strict, so a filtered file would fail the test.
+    EXPECT_CALL(mock_hasher_, HashFile(temp_dir_ / "keep" / "bad_file.exe"))
+        .WillOnce(testing::Return(bad_hash_));
+    EXPECT_CALL(mock_db_, FindHash(bad_hash_))
+        .WillOnce(testing::Return("Evil"));
+    EXPECT_CALL(mock_logger_,
+                LogDetection(temp_dir_ / "keep" / "bad_file.exe",
+                             AnyDigest(bad_hash_), "Evil"));
+    ScannerOptions options;
+    options.walker_mode = mode;
+    options.filter = filter;
+    Scanner scanner(mock_db_, mock_logger_, mock_hasher_, 2, options);
+    const ScanResult result = scanner.Scan(temp_dir_);
+    EXPECT_EQ(result.total_files_processed, 1);
+    EXPECT_EQ(result.errors, 0);
+    testing::Mock::VerifyAndClearExpectations(&mock_hasher_);
+  }
+}
+
+TEST_F(ScannerTest, ScansListedFilesWithoutTraversal) {
+  CreateDummyFile("good_file.txt");
+  CreateDummyFile("bad_file.exe");
+  CreateDummyFile("unlisted.txt");  // Never hashed: the mock is strict.
+  EXPECT_CALL(mock_hasher_, HashFile(temp_dir_ / "good_file.txt"))
+      .WillOnce(testing::Return(good_hash_));
+  EXPECT_CALL(mock_hasher_, HashFile(temp_dir_ / "bad_file.exe"))
+      .WillOnce(testing::Return(bad_hash_));
+  EXPECT_CALL(mock_db_, FindHash(good_hash_))
+      .WillOnce(testing::Return(std::nullopt));
+  EXPECT_CALL(mock_db_, FindHash(bad_hash_)).WillOnce(testing::Return("Evil"));
+  EXPECT_CALL(mock_logger_, LogDetection(temp_dir_ / "bad_file.exe",
+                                         AnyDigest(bad_hash_), "Evil"));
+
+  // An empty entry is skipped, and the last path needs no delimiter.
+  std::istringstream list((temp_dir_ / "good_file.txt").string() +
+                          std::string(2, '\0') +
+                          (temp_dir_ / "bad_file.exe").string());
+  Scanner scanner(mock_db_, mock_logger_, mock_hasher_, 2);
+  const ScanResult result = scanner.ScanFiles(list, '\0');
+
+  EXPECT_EQ(result.total_files_processed, 2);
+  EXPECT_EQ(result.malicious_files_detected, 1);
+  EXPECT_EQ(result.errors, 0);
+}
+
+TEST_F(ScannerTest, ReportsListedFilesThatCannotBeHashed) {
+  EXPECT_CALL(mock_hasher_, HashFile(temp_dir_ / "missing.txt"))
+      .WillOnce(testing::Throw(std::runtime_error("No such file")));
+
+  std::istringstream list((temp_dir_ / "missing.txt").string() + "\n");
+  Scanner scanner(mock_db_, mock_logger_, mock_hasher_, 2);
+  const ScanResult result = scanner.ScanFiles(list, '\n');
+
+  EXPECT_EQ(result.total_files_processed, 1);
+  EXPECT_EQ(result.errors, 1);
+}
+
 TEST_F(ScannerTest, HandlesInvalidScanPath) {
   const auto invalid_path = temp_dir_ / "not_a_directory.txt";
   CreateDummyFile("not_a_directory.txt");
@@ -184,5 +734,368 @@ TEST_F(ScannerTest, HandlesInvalidScanPath) {
   EXPECT_GE(result.errors, 1);
 }
 
+TEST_F(ScannerTest, BoundedQueueLimitsQueueDepth) {
+  const int kNumFiles = 200;
+  for (int i = 0; i < kNumFiles; ++i) {
+    CreateDummyFile("file_" + std::to_string(i) + ".txt");
+  }
+
+  EXPECT_CALL(mock_hasher_, HashFile(testing::_))
+      .Times(kNumFiles)
+      .WillRepeatedly(testing::Return(some_hash_));
+  EXPECT_CALL(mock_db_, FindHash(some_hash_))
+      .Times(kNumFiles)
+      .WillRepeatedly(testing::Return(std::nullopt));
+
+  ScannerOptions options;
+  options.max_queued_tasks = 3;
+  Scanner scanner(mock_db_, mock_logger_, mock_hasher_, 2, options);
+  const ScanResult result = scanner.Scan(temp_dir_);
+
+  EXPECT_EQ(result.total_files_processed, kNumFiles);
+  EXPECT_EQ(result.errors, 0);
+  EXPECT_GE(result.peak_queue_depth, 1);
+  EXPECT_LE(result.peak_queue_depth, 3);
+}
+
+TEST_F(ScannerTest, BatchesSmallFilesAndStreamsLargeOnes) {
+  CreateDummyFile("good_file.txt");
+  CreateDummyFile("bad_file.exe");
+  CreateDummyFile("broken_file.sys");
+  {
+    std::ofstream f(temp_dir_ / "large_file.bin");
+    f << std::string(64, 'x');
+  }
+
+  testing::StrictMock<MockBatchingFileHasher> hasher;
+  EXPECT_CALL(hasher, PreferredBatchSize())
+      .WillRepeatedly(testing::Return(2));
+  EXPECT_CALL(hasher, MaxBatchedFileSize())
+      .WillRepeatedly(testing::Return(32));
+  EXPECT_CALL(hasher, HashFile(temp_dir_ / "large_file.bin"))
+      .WillOnce(testing::Return(some_hash_));
+  EXPECT_CALL(hasher, HashFiles(testing::_, testing::_))
+      .Times(2)
+      .WillRepeatedly([this](const std::vector<std::filesystem::path>& paths,
+                             std::vector<FileHashResult>& results) {
+        EXPECT_LE(paths.size(), 2);
+        results.assign(paths.size(), FileHashResult{});
+        for (std::size_t i = 0; i < paths.size(); ++i) {
+          const std::string name = paths[i].filename().string();
+          if (name == "broken_file.sys") {
+            results[i].error = std::make_exception_ptr(
+                std::runtime_error("Permission denied"));
+          } else {
+            results[i].md5 = name == "bad_file.exe" ? bad_hash_ : good_hash_;
+          }
+        }
+      });
+
+  EXPECT_CALL(mock_db_, FindHash(good_hash_))
+      .WillOnce(testing::Return(std::nullopt));
+  EXPECT_CALL(mock_db_, FindHash(bad_hash_))
+      .WillOnce(testing::Return("EvilWare"));
+  EXPECT_CALL(mock_db_, FindHash(some_hash_))
+      .WillOnce(testing::Return(std::nullopt));
+  EXPECT_CALL(mock_logger_,
+              LogDetection(temp_dir_ / "bad_file.exe", AnyDigest(bad_hash_),
+                           "EvilWare"))
+      .Times(1);
+
+  Scanner scanner(mock_db_, mock_logger_, hasher, 2);
+  const ScanResult result = scanner.Scan(temp_dir_);
+
+  EXPECT_EQ(result.total_files_processed, 4);
+  EXPECT_EQ(result.malicious_files_detected, 1);
+  EXPECT_EQ(result.errors, 1);
+}
+
+#ifndef _WIN32
+
+TEST_F(ScannerTest, HashesHardLinkedFilesOnceAndLogsEveryPath) {
+  std::filesystem::create_directories(temp_dir_ / "snapshot");
+  CreateDummyFile("bad_file.exe");
+  CreateDummyFile("good_file.txt");
+  std::filesystem::create_hard_link(temp_dir_ / "bad_file.exe",
+                                    temp_dir_ / "bad_link.exe");
+  std::filesystem::create_hard_link(temp_dir_ / "bad_file.exe",
+                                    temp_dir_ / "snapshot" / "bad_file.exe");
+
+  EXPECT_CALL(mock_hasher_, HashFile(testing::_))
+      .Times(2)
+      .WillRepeatedly([this](const std::filesystem::path& path) {
+        return path.filename() == "good_file.txt" ? good_hash_ : bad_hash_;
+      });
+  EXPECT_CALL(mock_db_, FindHash(good_hash_))
+      .WillOnce(testing::Return(std::nullopt));
+  EXPECT_CALL(mock_db_, FindHash(bad_hash_))
+      .Times(3)
+      .WillRepeatedly(testing::Return("EvilWare"));
+  for (const auto& path :
+       {temp_dir_ / "bad_file.exe", temp_dir_ / "bad_link.exe",
+        temp_dir_ / "snapshot" / "bad_file.exe"}) {
+    EXPECT_CALL(mock_logger_, LogDetection(path, AnyDigest(bad_hash_), "EvilWare"));
+  }
+
+  Scanner scanner(mock_db_, mock_logger_, mock_hasher_, 2);
+  RecordingProgressObserver observer;
+  scanner.SetProgressObserver(&observer, std::chrono::milliseconds(1));
+  const ScanResult result = scanner.Scan(temp_dir_);
+
+  const std::uint64_t file_size = std::string("dummy content").size();
+  EXPECT_EQ(result.total_files_processed, 4);
+  EXPECT_EQ(result.malicious_files_detected, 3);
+  EXPECT_EQ(result.errors, 0);
+  EXPECT_EQ(result.deduplicated_files, 2);
+  EXPECT_EQ(result.deduplicated_bytes, 2 * file_size);
+  // Every path counted as processed adds its size, deduplicated or not.
+  ASSERT_FALSE(observer.snapshots.empty());
+  EXPECT_EQ(observer.snapshots.back().files_processed, 4);
+  EXPECT_EQ(observer.snapshots.back().bytes_processed, 4 * file_size);
+}
+
+TEST_F(ScannerTest, HardLinksShareHashingErrors) {
+  CreateDummyFile("broken.sys");
+  std::filesystem::create_hard_link(temp_dir_ / "broken.sys",
+                                    temp_dir_ / "broken_link.sys");
+
+  EXPECT_CALL(mock_hasher_, HashFile(testing::_))
+      .WillOnce(testing::Throw(std::runtime_error("Permission denied")));
+
+  Scanner scanner(mock_db_, mock_logger_, mock_hasher_, 2);
+  const ScanResult result = scanner.Scan(temp_dir_);
+
+  EXPECT_EQ(result.total_files_processed, 2);
+  EXPECT_EQ(result.errors, 2);
+  EXPECT_EQ(result.deduplicated_files, 1);
+}
+
+TEST_F(ScannerTest, FileCacheSkipsHashingUnchangedFiles) {
+  CreateDummyFile("good_file.txt");
+  CreateDummyFile("bad_file.exe");
+  Backdate("good_file.txt");
+  Backdate("bad_file.exe");
+
+  FileStateCache cache(temp_dir_ / ".." / "scanner_test_cache");
+  ScannerOptions options;
+  options.cache = &cache;
+  Scanner scanner(mock_db_, mock_logger_, mock_hasher_, 2, options);
+  EXPECT_CALL(mock_db_, FindHash(good_hash_))
+      .WillRepeatedly(testing::Return(std::nullopt));
+  EXPECT_CALL(mock_db_, FindHash(bad_hash_))
+      .WillRepeatedly(testing::Return("EvilWare"));
+  // Cached digests are still looked up, so the detection is logged again.
+  EXPECT_CALL(mock_logger_,
+              LogDetection(temp_dir_ / "bad_file.exe", AnyDigest(bad_hash_),
+                           "EvilWare"))
+      .Times(3);
+
+  EXPECT_CALL(mock_hasher_, HashFile(temp_dir_ / "good_file.txt"))
+      .WillOnce(testing::Return(good_hash_));
+  EXPECT_CALL(mock_hasher_, HashFile(temp_dir_ / "bad_file.exe"))
+      .WillOnce(testing::Return(bad_hash_));
+  ScanResult result = scanner.Scan(temp_dir_);
+  ASSERT_TRUE(result.file_cache.has_value());
+  EXPECT_EQ(result.file_cache->hits, 0);
+  EXPECT_EQ(result.file_cache->misses, 2);
+  testing::Mock::VerifyAndClearExpectations(&mock_hasher_);
+
+  // Nothing changed, so nothing is hashed.
+  result = scanner.Scan(temp_dir_);
+  EXPECT_EQ(result.total_files_processed, 2);
+  EXPECT_EQ(result.malicious_files_detected, 1);
+  EXPECT_EQ(result.file_cache->hits, 2);
+  EXPECT_EQ(result.file_cache->misses, 0);
+
+  // Only the rewritten file is hashed again.
+  std::ofstream(temp_dir_ / "good_file.txt") << "new content";
+  Backdate("good_file.txt");
+  EXPECT_CALL(mock_hasher_, HashFile(temp_dir_ / "good_file.txt"))
+      .WillOnce(testing::Return(good_hash_));
+  result = scanner.Scan(temp_dir_);
+  EXPECT_EQ(result.total_files_processed, 2);
+  EXPECT_EQ(result.file_cache->hits, 1);
+  EXPECT_EQ(result.file_cache->misses, 1);
+  EXPECT_EQ(result.errors, 0);
+
+  std::filesystem::remove(temp_dir_ / ".." / "scanner_test_cache");
+}
+
+TEST_F(ScannerTest, FileCacheKeepsEntriesOfOtherScannedTrees) {
+  std::filesystem::create_directory(temp_dir_ / "a");
+  std::filesystem::create_directory(temp_dir_ / "b");
+  CreateDummyFile("a/first.txt");
+  CreateDummyFile("b/second.txt");
+  Backdate("a/first.txt");
+  Backdate("b/second.txt");
+
+  FileStateCache cache(temp_dir_ / ".." / "scanner_trees_test_cache");
+  ScannerOptions options;
+  options.cache = &cache;
+  Scanner scanner(mock_db_, mock_logger_, mock_hasher_, 2, options);
+  EXPECT_CALL(mock_db_, FindHash(some_hash_))
+      .WillRepeatedly(testing::Return(std::nullopt));
+  EXPECT_CALL(mock_hasher_, HashFile(testing::_))
+      .Times(2)
+      .WillRepeatedly(testing::Return(some_hash_));
+
+  EXPECT_EQ(scanner.Scan(temp_dir_ / "a").file_cache->misses, 1);
+  EXPECT_EQ(scanner.Scan(temp_dir_ / "b").file_cache->misses, 1);
+  const ScanResult result = scanner.Scan(temp_dir_ / "a");
+  EXPECT_EQ(result.file_cache->hits, 1);
+  EXPECT_EQ(result.file_cache->misses, 0);
+
+  std::filesystem::remove(temp_dir_ / ".." / "scanner_trees_test_cache");
+}
+
+TEST_F(ScannerTest, FileCacheIsNotSavedAfterAFailedWalk) {
+  CreateDummyFile("first.txt");
+  Backdate("first.txt");
+
+  const auto cache_path = temp_dir_ / ".." / "scanner_failed_test_cache";
+  FileStateCache cache(cache_path);
+  ScannerOptions options;
+  options.cache = &cache;
+  Scanner scanner(mock_db_, mock_logger_, mock_hasher_, 2, options);
+  EXPECT_CALL(mock_db_, FindHash(some_hash_))
+      .WillRepeatedly(testing::Return(std::nullopt));
+  EXPECT_CALL(mock_hasher_, HashFile(temp_dir_ / "first.txt"))
+      .WillOnce(testing::Return(some_hash_));
+  scanner.Scan(temp_dir_);
+  const auto saved = std::filesystem::last_write_time(cache_path);
+
+  EXPECT_EQ(scanner.Scan(temp_dir_ / "missing").errors, 1);
+  EXPECT_EQ(std::filesystem::last_write_time(cache_path), saved);
+  EXPECT_EQ(scanner.Scan(temp_dir_).file_cache->hits, 1);
+
+  std::filesystem::remove(cache_path);
+}
+
+TEST_F(ScannerTest, FileCacheSkipsHashingInBatches) {
+  CreateDummyFile("first.txt");
+  CreateDummyFile("second.txt");
+  Backdate("first.txt");
+  Backdate("second.txt");
+
+  testing::StrictMock<MockBatchingFileHasher> hasher;
+  EXPECT_CALL(hasher, PreferredBatchSize())
+      .WillRepeatedly(testing::Return(4));
+  EXPECT_CALL(hasher, MaxBatchedFileSize())
+      .WillRepeatedly(testing::Return(1024));
+  EXPECT_CALL(mock_db_, FindHash(some_hash_))
+      .WillRepeatedly(testing::Return(std::nullopt));
+
+  FileStateCache cache(temp_dir_ / ".." / "scanner_batch_test_cache");
+  ScannerOptions options;
+  options.cache = &cache;
+  Scanner scanner(mock_db_, mock_logger_, hasher, 2, options);
+
+  EXPECT_CALL(hasher, HashFiles(testing::_, testing::_))
+      .WillOnce([this](const std::vector<std::filesystem::path>& paths,
+                       std::vector<FileHashResult>& results) {
+        EXPECT_EQ(paths.size(), 2);
+        results.assign(paths.size(), FileHashResult{});
+        for (FileHashResult& result : results) {
+          result.md5 = some_hash_;
+        }
+      });
+  EXPECT_EQ(scanner.Scan(temp_dir_).file_cache->misses, 2);
+  testing::Mock::VerifyAndClearExpectations(&hasher);
+
+  EXPECT_CALL(hasher, PreferredBatchSize())
+      .WillRepeatedly(testing::Return(4));
+  EXPECT_CALL(hasher, MaxBatchedFileSize())
+      .WillRepeatedly(testing::Return(1024));
+  const ScanResult result = scanner.Scan(temp_dir_);
+  EXPECT_EQ(result.total_files_processed, 2);
+  EXPECT_EQ(result.file_cache->hits, 2);
+  EXPECT_EQ(result.errors, 0);
+
+  std::filesystem::remove(temp_dir_ / ".." / "scanner_batch_test_cache");
+}
+
+TEST_F(ScannerTest, SizeIndexSkipsFilesOfOtherSizes) {
+  CreateDummyFile("sample_size.bin");
+  {
+    std::ofstream f(temp_dir_ / "other_size.bin");
+    f << "content of another size";
+  }
+
+  testing::StrictMock<MockIndexedHashDatabase> db;
+  EXPECT_CALL(db, HasSizeIndex()).WillRepeatedly(testing::Return(true));
+  EXPECT_CALL(db, HasPrefixIndex()).WillRepeatedly(testing::Return(false));
+  EXPECT_CALL(db, MayMatchSize(testing::_))
+      .WillRepeatedly([](std::uint64_t size) {
+        return size == std::string("dummy content").size();
+      });
+  EXPECT_CALL(db, FindHash(some_hash_))
+      .Times(2)
+      .WillRepeatedly(testing::Return(std::nullopt));
+  EXPECT_CALL(mock_hasher_, HashFile(temp_dir_ / "sample_size.bin"))
+      .Times(2)
+      .WillRepeatedly(testing::Return(some_hash_));
+
+  for (const WalkerMode mode :
+       {WalkerMode::kParallel, WalkerMode::kSequential}) {
+    ScannerOptions options;
+    options.walker_mode = mode;
+    Scanner scanner(db, mock_logger_, mock_hasher_, 2, options);
+    const ScanResult result = scanner.Scan(temp_dir_);
+    EXPECT_EQ(result.total_files_processed, 2);
+    EXPECT_EQ(result.errors, 0);
+    ASSERT_TRUE(result.sample_index.has_value());
+    EXPECT_EQ(result.sample_index->size_rejected, 1);
+  }
+}
+
+TEST_F(ScannerTest, PrefixIndexSkipsFilesWithOtherPrefixes) {
+  const std::string sample_prefix(kSamplePrefixSize, 'a');
+  {
+    std::ofstream f(temp_dir_ / "sample_prefix.bin", std::ios::binary);
+    f << sample_prefix << "tail";
+    std::ofstream g(temp_dir_ / "other_prefix.bin", std::ios::binary);
+    g << std::string(kSamplePrefixSize, 'b') << "tail";
+  }
+  CreateDummyFile("small.txt");
+  Md5Engine engine;
+  engine.Update(reinterpret_cast<const std::uint8_t*>(sample_prefix.data()),
+                sample_prefix.size());
+  const Md5Digest sample_prefix_digest = engine.Final();
+
+  testing::StrictMock<MockIndexedHashDatabase> db;
+  EXPECT_CALL(db, HasSizeIndex()).WillRepeatedly(testing::Return(false));
+  EXPECT_CALL(db, HasPrefixIndex()).WillRepeatedly(testing::Return(true));
+  EXPECT_CALL(db, MayMatchPrefix(testing::_))
+      .Times(2)
+      .WillRepeatedly([&](const Md5Digest& prefix_digest) {
+        return prefix_digest == sample_prefix_digest;
+      });
+  // Files no larger than the prefix are hashed without a prefix check.
+  EXPECT_CALL(mock_hasher_, HashFile(temp_dir_ / "small.txt"))
+      .WillOnce(testing::Return(good_hash_));
+  EXPECT_CALL(mock_hasher_, HashFile(temp_dir_ / "sample_prefix.bin"))
+      .WillOnce(testing::Return(bad_hash_));
+  EXPECT_CALL(db, FindHash(good_hash_))
+      .WillOnce(testing::Return(std::nullopt));
+  EXPECT_CALL(db, FindHash(bad_hash_)).WillOnce(testing::Return("EvilWare"));
+  EXPECT_CALL(mock_logger_,
+              LogDetection(temp_dir_ / "sample_prefix.bin",
+                           AnyDigest(bad_hash_), "EvilWare"))
+      .Times(1);
+
+  Scanner scanner(db, mock_logger_, mock_hasher_, 2);
+  const ScanResult result = scanner.Scan(temp_dir_);
+
+  EXPECT_EQ(result.total_files_processed, 3);
+  EXPECT_EQ(result.malicious_files_detected, 1);
+  EXPECT_EQ(result.errors, 0);
+  ASSERT_TRUE(result.sample_index.has_value());
+  EXPECT_EQ(result.sample_index->size_rejected, 0);
+  EXPECT_EQ(result.sample_index->prefix_checked, 2);
+  EXPECT_EQ(result.sample_index->prefix_rejected, 1);
+}
+
+#endif
+
 }  // namespace
 }  // namespace scanner
\ No newline at end of file
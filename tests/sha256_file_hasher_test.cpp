@@ -0,0 +1,102 @@
+#include "src/scanner_lib/sha256_file_hasher.h"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace scanner {
+namespace {
+
+class Sha256FileHasherTest : public ::testing::Test {
+protected:
+  static void SetUpTestSuite() {
+    temp_dir_ =
+        std::filesystem::temp_directory_path() / "scanner_sha256_tests";
+    std::filesystem::create_directory(temp_dir_);
+
+    known_content_path_ = temp_dir_ / "known_content.txt";
+    std::ofstream(known_content_path_) << "hello world";
+  }
+
+  static void TearDownTestSuite() {
+    std::error_code ec;
+    std::filesystem::remove_all(temp_dir_, ec);
+    (void)ec;
+  }
+
+  static std::filesystem::path temp_dir_;
+  static std::filesystem::path known_content_path_;
+};
+
+std::filesystem::path Sha256FileHasherTest::temp_dir_;
+std::filesystem::path Sha256FileHasherTest::known_content_path_;
+
+TEST_F(Sha256FileHasherTest, HashesKnownFileCorrectly) {
+  Sha256FileHasher hasher;
+  FileHashResult result;
+  result.md5 = Md5Digest{};
+  hasher.HashFileDigests(known_content_path_, result);
+
+  EXPECT_FALSE(result.md5);
+  EXPECT_FALSE(result.sha1);
+  ASSERT_TRUE(result.sha256);
+  EXPECT_EQ(result.sha256->ToHex(),
+            "b94d27b9934d3e08a52e52d7da7dabfac484efe37a5380ee9088f7ace2efcde9");
+}
+
+TEST_F(Sha256FileHasherTest, HashFileIsNotSupported) {
+  Sha256FileHasher hasher;
+  EXPECT_THROW(static_cast<void>(hasher.HashFile(known_content_path_)),
+               std::logic_error);
+}
+
+TEST_F(Sha256FileHasherTest, ThrowsOnNonExistentFile) {
+  Sha256FileHasher hasher;
+  FileHashResult result;
+  EXPECT_THROW(
+      hasher.HashFileDigests(temp_dir_ / "non_existent.txt", result),
+      std::runtime_error);
+}
+
+TEST_F(Sha256FileHasherTest, HashFilesMatchesHashFileDigestsForEachIsa) {
+  // Sizes straddle the padding boundaries and the batching size limit.
+  const std::vector<std::size_t> sizes = {0,   1,   55,   56,     63,
+                                          64,  65,  119,  120,    128,
+                                          500, 4096, 70000, 200000, 3};
+  std::vector<std::filesystem::path> paths;
+  for (std::size_t i = 0; i < sizes.size(); ++i) {
+    paths.push_back(temp_dir_ / ("batch_" + std::to_string(i) + ".bin"));
+    std::ofstream file(paths.back(), std::ios::binary);
+    for (std::size_t j = 0; j < sizes[i]; ++j) {
+      file.put(static_cast<char>((i * 31 + j * 7) & 0xFF));
+    }
+  }
+  paths.push_back(temp_dir_ / "non_existent.bin");
+
+  for (const Sha256Isa isa :
+       {Sha256Isa::kScalar, Sha256Isa::kShaNi, Sha256Isa::kAvx2}) {
+    if (!Sha256MultiBuffer::IsSupported(isa)) {
+      continue;
+    }
+    Sha256FileHasher hasher(isa);
+    std::vector<FileHashResult> results;
+    hasher.HashFiles(paths, results);
+
+    ASSERT_EQ(results.size(), paths.size());
+    for (std::size_t i = 0; i + 1 < paths.size(); ++i) {
+      ASSERT_FALSE(results[i].error) << paths[i];
+      FileHashResult expected;
+      hasher.HashFileDigests(paths[i], expected);
+      EXPECT_FALSE(results[i].md5) << paths[i];
+      EXPECT_EQ(results[i].sha256, expected.sha256) << paths[i];
+    }
+    EXPECT_TRUE(results.back().error);
+  }
+}
+
+}  // namespace
+}  // namespace scanner
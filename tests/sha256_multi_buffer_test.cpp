@@ -0,0 +1,113 @@
+#include "src/scanner_lib/sha256_multi_buffer.h"
+
+#include <cstdint>
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/scanner_lib/sha_engine.h"
+
+namespace scanner {
+namespace {
+
+// Hashes with the portable compression function, independently of the
+// kernel Sha256Engine dispatches to.
+Sha256Digest HashScalar(const std::vector<std::uint8_t>& data) {
+  std::uint32_t state[8];
+  std::copy(sha256::kInitialState, sha256::kInitialState + 8, state);
+  const std::size_t whole_blocks = data.size() / sha::kBlockSize;
+  sha256::TransformScalar(state, data.data(), whole_blocks);
+  std::uint8_t tail[2 * sha::kBlockSize];
+  const std::size_t tail_blocks = sha::PadFinalBlocks(
+      data.data() + whole_blocks * sha::kBlockSize,
+      data.size() % sha::kBlockSize, data.size(), tail);
+  sha256::TransformScalar(state, tail, tail_blocks);
+  return sha256::StateToDigest(state);
+}
+
+class Sha256MultiBufferTest : public ::testing::TestWithParam<Sha256Isa> {
+protected:
+  void SetUp() override {
+    if (!Sha256MultiBuffer::IsSupported(GetParam())) {
+      GTEST_SKIP() << "Instruction set not supported by this CPU";
+    }
+  }
+
+  // Hashes the messages in one call and compares against the scalar code.
+  void ExpectMatchesScalar(const std::vector<std::size_t>& sizes) {
+    std::vector<std::vector<std::uint8_t>> data(sizes.size());
+    std::vector<HashMessage> messages;
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+      data[i].resize(sizes[i]);
+      for (std::size_t j = 0; j < sizes[i]; ++j) {
+        data[i][j] = static_cast<std::uint8_t>(i * 29 + j * 3 + (j >> 8));
+      }
+      messages.push_back({data[i].data(), data[i].size()});
+    }
+
+    const Sha256MultiBuffer multi_buffer(GetParam());
+    std::vector<Sha256Digest> digests(messages.size());
+    multi_buffer.Hash(messages.data(), messages.size(), digests.data());
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+      EXPECT_EQ(digests[i], HashScalar(data[i])) << "message " << i
+                                                 << ", size " << sizes[i];
+    }
+  }
+};
+
+TEST_P(Sha256MultiBufferTest, HashesMessagesAroundPaddingBoundaries) {
+  ExpectMatchesScalar({0, 1, 55, 56, 57, 63, 64, 65, 119, 120, 127, 128});
+}
+
+TEST_P(Sha256MultiBufferTest, HashesMixedLengthsWithLaneRefills) {
+  std::vector<std::size_t> sizes;
+  for (std::size_t i = 0; i < 50; ++i) {
+    sizes.push_back((i * 977) % 5000);
+  }
+  sizes.push_back(100000);
+  ExpectMatchesScalar(sizes);
+}
+
+TEST_P(Sha256MultiBufferTest, HashesFewerMessagesThanLanes) {
+  ExpectMatchesScalar({});
+  ExpectMatchesScalar({10});
+  ExpectMatchesScalar({10, 200});
+  ExpectMatchesScalar({64, 64, 64});
+}
+
+TEST_P(Sha256MultiBufferTest, MatchesFips180TestVector) {
+  const std::vector<std::uint8_t> data = {'a', 'b', 'c'};
+  const HashMessage messages[2] = {{data.data(), data.size()},
+                                   {data.data(), data.size()}};
+  Sha256Digest digests[2];
+  Sha256MultiBuffer(GetParam()).Hash(messages, 2, digests);
+  for (const Sha256Digest& digest : digests) {
+    EXPECT_EQ(digest.ToHex(),
+              "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(AllIsas, Sha256MultiBufferTest,
+                         ::testing::Values(Sha256Isa::kScalar,
+                                           Sha256Isa::kShaNi,
+                                           Sha256Isa::kAvx2));
+
+TEST(Sha256MultiBufferIsaTest, BestIsaIsSupported) {
+  const Sha256Isa best = Sha256MultiBuffer::BestIsa();
+  EXPECT_TRUE(Sha256MultiBuffer::IsSupported(best));
+  EXPECT_EQ(Sha256MultiBuffer(best).Isa(), best);
+}
+
+TEST(Sha256MultiBufferIsaTest, OnlyAvx2UsesSeveralLanes) {
+  EXPECT_EQ(Sha256MultiBuffer(Sha256Isa::kScalar).Lanes(), 1);
+  if (Sha256MultiBuffer::IsSupported(Sha256Isa::kShaNi)) {
+    EXPECT_EQ(Sha256MultiBuffer(Sha256Isa::kShaNi).Lanes(), 1);
+  }
+  if (Sha256MultiBuffer::IsSupported(Sha256Isa::kAvx2)) {
+    EXPECT_EQ(Sha256MultiBuffer(Sha256Isa::kAvx2).Lanes(), 8);
+  }
+}
+
+}  // namespace
+}  // namespace scanner
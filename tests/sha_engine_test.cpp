@@ -0,0 +1,96 @@
+#include "src/scanner_lib/sha_engine.h"
+
+#include <cstdint>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace scanner {
+namespace {
+
+template <class Engine>
+std::string HashString(const std::string& input) {
+  Engine engine;
+  engine.Update(reinterpret_cast<const std::uint8_t*>(input.data()),
+                input.size());
+  return engine.Final().ToHex();
+}
+
+// Inputs from FIPS 180-2 Appendix A/B and their padding-boundary neighbours.
+const std::vector<std::string>& TestInputs() {
+  static const std::vector<std::string> inputs = {
+      "",
+      "abc",
+      "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+      std::string(1000000, 'a'),
+  };
+  return inputs;
+}
+
+TEST(ShaEngineTest, Sha1MatchesFips180TestVectors) {
+  const std::vector<std::string> expected = {
+      "da39a3ee5e6b4b0d3255bfef95601890afd80709",
+      "a9993e364706816aba3e25717850c26c9cd0d89d",
+      "84983e441c3bd26ebaae4aa1f95129e5e54670f1",
+      "34aa973cd4c4daa4f61eeb2bdbad27316534016f",
+  };
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(HashString<Sha1Engine>(TestInputs()[i]), expected[i])
+        << "vector " << i;
+  }
+}
+
+TEST(ShaEngineTest, Sha256MatchesFips180TestVectors) {
+  const std::vector<std::string> expected = {
+      "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+      "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+      "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1",
+      "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0",
+  };
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(HashString<Sha256Engine>(TestInputs()[i]), expected[i])
+        << "vector " << i;
+  }
+}
+
+template <class Engine>
+void ExpectIncrementalUpdatesMatchSingleUpdate() {
+  std::vector<std::uint8_t> data(1000);
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<std::uint8_t>(i * 13);
+  }
+
+  Engine whole;
+  whole.Update(data.data(), data.size());
+  const auto expected = whole.Final();
+
+  for (const std::size_t piece : {1, 7, 55, 56, 63, 64, 65, 333}) {
+    Engine engine;
+    for (std::size_t offset = 0; offset < data.size(); offset += piece) {
+      const std::size_t size = std::min(piece, data.size() - offset);
+      engine.Update(data.data() + offset, size);
+    }
+    EXPECT_EQ(engine.Final(), expected) << "piece size " << piece;
+  }
+}
+
+TEST(ShaEngineTest, IncrementalUpdatesMatchSingleUpdate) {
+  ExpectIncrementalUpdatesMatchSingleUpdate<Sha1Engine>();
+  ExpectIncrementalUpdatesMatchSingleUpdate<Sha256Engine>();
+}
+
+TEST(ShaEngineTest, FinalResetsTheEngine) {
+  Sha256Engine engine;
+  const std::string input = "abc";
+  engine.Update(reinterpret_cast<const std::uint8_t*>(input.data()),
+                input.size());
+  EXPECT_EQ(engine.Final().ToHex(), HashString<Sha256Engine>("abc"));
+  EXPECT_EQ(engine.Final().ToHex(), HashString<Sha256Engine>(""));
+}
+
+}  // namespace
+}  // namespace scanner
@@ -0,0 +1,73 @@
+#include "src/scanner_lib/task.h"
+
+#include <array>
+#include <future>
+#include <memory>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+namespace scanner {
+namespace {
+
+TEST(TaskTest, DefaultConstructedTaskIsEmpty) {
+  Task task;
+  EXPECT_FALSE(task);
+}
+
+TEST(TaskTest, InvokesSmallCallable) {
+  int calls = 0;
+  Task task([&calls] { calls++; });
+  ASSERT_TRUE(task);
+  task();
+  task();
+  EXPECT_EQ(calls, 2);
+}
+
+TEST(TaskTest, InvokesLargeCallable) {
+  std::array<int, 64> values{};
+  values[63] = 7;
+  int result = 0;
+  Task task([values, &result] { result = values[63]; });
+  task();
+  EXPECT_EQ(result, 7);
+}
+
+TEST(TaskTest, AcceptsMoveOnlyCallables) {
+  auto value = std::make_unique<int>(42);
+  int result = 0;
+  Task task([value = std::move(value), &result] { result = *value; });
+  task();
+  EXPECT_EQ(result, 42);
+
+  std::packaged_task<int()> packaged([] { return 5; });
+  auto future = packaged.get_future();
+  Task packaged_task(std::move(packaged));
+  packaged_task();
+  EXPECT_EQ(future.get(), 5);
+}
+
+TEST(TaskTest, MoveTransfersCallableAndDestroysOnce) {
+  auto counter = std::make_shared<int>(0);
+  std::array<char, 128> padding{};
+  {
+    Task small([counter] { (*counter)++; });
+    Task large([counter, padding] { (*counter) += padding.size() > 0; });
+    EXPECT_EQ(counter.use_count(), 3);
+
+    Task moved_small(std::move(small));
+    Task moved_large;
+    moved_large = std::move(large);
+    EXPECT_FALSE(small);  // NOLINT(bugprone-use-after-move)
+    EXPECT_FALSE(large);  // NOLINT(bugprone-use-after-move)
+    EXPECT_EQ(counter.use_count(), 3);
+
+    moved_small();
+    moved_large();
+    EXPECT_EQ(*counter, 2);
+  }
+  EXPECT_EQ(counter.use_count(), 1);
+}
+
+}  // namespace
+}  // namespace scanner
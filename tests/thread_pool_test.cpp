@@ -3,7 +3,10 @@
 #include <chrono>
 
 #include <atomic>
+#include <functional>
 #include <future>
+#include <mutex>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <thread>
@@ -88,6 +91,140 @@ TEST(ThreadPoolTest, ThrowsWhenEnqueueingAfterStop) {
   EXPECT_THROW(pool.Enqueue([]() {}), std::runtime_error);
 }
 
+TEST(ThreadPoolTest, SubmitRunsFireAndForgetTasks) {
+  const int kNumTasks = 10000;
+  std::atomic<int> counter{0};
+  {
+    ThreadPool pool(4);
+    for (int i = 0; i < kNumTasks; ++i) {
+      pool.Submit([&counter] { counter++; });
+    }
+  }
+  EXPECT_EQ(counter.load(), kNumTasks);
+}
+
+TEST(ThreadPoolTest, TasksSubmittedFromWorkersAreStolen) {
+  ThreadPool pool(4);
+  std::atomic<int> counter{0};
+  std::mutex ids_mutex;
+  std::set<std::thread::id> thread_ids;
+  std::promise<void> all_done;
+  const int kNumChildren = 64;
+
+  // A single task fans out into children on its own worker's deque; the
+  // other workers have to steal them.
+  pool.Submit([&] {
+    for (int i = 0; i < kNumChildren; ++i) {
+      pool.Submit([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        {
+          std::lock_guard<std::mutex> lock(ids_mutex);
+          thread_ids.insert(std::this_thread::get_id());
+        }
+        if (++counter == kNumChildren) {
+          all_done.set_value();
+        }
+      });
+    }
+  });
+
+  all_done.get_future().get();
+  EXPECT_EQ(counter.load(), kNumChildren);
+  EXPECT_GT(thread_ids.size(), 1u);
+}
+
+TEST(ThreadPoolTest, SubmitThrowsAfterStop) {
+  ThreadPool pool(1);
+  pool.Stop();
+  EXPECT_THROW(pool.Submit([] {}), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, BoundedQueueBlocksExternalSubmitters) {
+  const std::size_t kMaxQueued = 4;
+  ThreadPool pool(1, kMaxQueued);
+  std::promise<void> gate;
+  std::shared_future<void> gate_future = gate.get_future().share();
+  std::atomic<int> counter{0};
+
+  // Occupy the only worker, then fill the queue.
+  std::promise<void> started;
+  pool.Submit([&started, gate_future] {
+    started.set_value();
+    gate_future.wait();
+  });
+  started.get_future().wait();
+  for (std::size_t i = 0; i < kMaxQueued; ++i) {
+    pool.Submit([&counter] { counter++; });
+  }
+
+  std::atomic<bool> submitted{false};
+  std::thread submitter([&] {
+    pool.Submit([&counter] { counter++; });
+    submitted.store(true);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(submitted.load());
+
+  gate.set_value();
+  submitter.join();
+  EXPECT_TRUE(submitted.load());
+  pool.Stop();
+  while (counter.load() < static_cast<int>(kMaxQueued) + 1) {
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(pool.PeakQueuedTasks(), kMaxQueued);
+}
+
+TEST(ThreadPoolTest, BoundedQueueRunsWorkerSubmissionsInline) {
+  ThreadPool pool(1, 1);
+  std::atomic<int> counter{0};
+  std::promise<void> done;
+  const int kNumChildren = 8;
+
+  pool.Submit([&] {
+    for (int i = 0; i < kNumChildren; ++i) {
+      pool.Submit([&] {
+        if (++counter == kNumChildren) {
+          done.set_value();
+        }
+      });
+    }
+  });
+
+  done.get_future().get();
+  EXPECT_EQ(counter.load(), kNumChildren);
+  EXPECT_LE(pool.PeakQueuedTasks(), 1u);
+}
+
+TEST(ThreadPoolTest, WaitIdleWaitsForTasksSubmittedByTasks) {
+  ThreadPool pool(4);
+  std::atomic<int> counter{0};
+
+  // Each task fans out into two more until depth 10: 2^11 - 1 tasks.
+  std::function<void(int)> spawn = [&](int depth) {
+    counter.fetch_add(1);
+    if (depth < 10) {
+      pool.Submit([&spawn, depth] { spawn(depth + 1); });
+      pool.Submit([&spawn, depth] { spawn(depth + 1); });
+    }
+  };
+  pool.Submit([&spawn] { spawn(0); });
+  pool.WaitIdle();
+
+  EXPECT_EQ(counter.load(), 2047);
+
+  // The pool keeps running after becoming idle.
+  pool.Submit([&counter] { counter.fetch_add(1); });
+  pool.WaitIdle();
+  EXPECT_EQ(counter.load(), 2048);
+}
+
+TEST(ThreadPoolTest, WaitIdleReturnsImmediatelyWhenIdle) {
+  ThreadPool pool(2);
+  pool.WaitIdle();
+  SUCCEED();
+}
+
 TEST(ThreadPoolTest, DefaultConstruction) {
   EXPECT_NO_THROW({
     ThreadPool pool;
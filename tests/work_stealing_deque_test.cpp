@@ -0,0 +1,87 @@
+#include "src/scanner_lib/work_stealing_deque.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace scanner {
+namespace {
+
+TEST(WorkStealingDequeTest, OwnerPopsInLifoOrder) {
+  WorkStealingDeque<int> deque(2);
+  int items[5] = {0, 1, 2, 3, 4};
+  for (int& item : items) {
+    deque.Push(&item);
+  }
+  EXPECT_EQ(deque.SizeEstimate(), 5);
+  for (int i = 4; i >= 0; --i) {
+    EXPECT_EQ(deque.Pop(), &items[i]);
+  }
+  EXPECT_EQ(deque.Pop(), nullptr);
+}
+
+TEST(WorkStealingDequeTest, ThievesStealInFifoOrder) {
+  WorkStealingDeque<int> deque;
+  int items[3] = {0, 1, 2};
+  for (int& item : items) {
+    deque.Push(&item);
+  }
+  EXPECT_EQ(deque.Steal(), &items[0]);
+  EXPECT_EQ(deque.Steal(), &items[1]);
+  EXPECT_EQ(deque.Pop(), &items[2]);
+  EXPECT_EQ(deque.Steal(), nullptr);
+}
+
+TEST(WorkStealingDequeTest, EveryItemIsTakenExactlyOnceUnderContention) {
+  constexpr int kNumItems = 200000;
+  constexpr int kNumThieves = 3;
+  std::vector<int> items(kNumItems);
+  std::vector<std::atomic<int>> taken(kNumItems);
+  WorkStealingDeque<int> deque(4);  // Small, so that it grows while in use.
+
+  std::atomic<bool> done{false};
+  std::atomic<int> total{0};
+  const auto take = [&](int* item) {
+    taken[item - items.data()]++;
+    total++;
+  };
+
+  std::vector<std::thread> thieves;
+  for (int t = 0; t < kNumThieves; ++t) {
+    thieves.emplace_back([&] {
+      while (!done.load()) {
+        if (int* item = deque.Steal()) {
+          take(item);
+        }
+      }
+    });
+  }
+
+  for (int i = 0; i < kNumItems; ++i) {
+    deque.Push(&items[i]);
+    if (i % 3 == 0) {
+      if (int* item = deque.Pop()) {
+        take(item);
+      }
+    }
+  }
+  while (int* item = deque.Pop()) {
+    take(item);
+  }
+  while (total.load() < kNumItems) {
+    std::this_thread::yield();
+  }
+  done.store(true);
+  for (std::thread& thief : thieves) {
+    thief.join();
+  }
+
+  for (int i = 0; i < kNumItems; ++i) {
+    ASSERT_EQ(taken[i].load(), 1) << "item " << i;
+  }
+}
+
+}  // namespace
+}  // namespace scanner